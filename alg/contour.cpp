@@ -42,6 +42,18 @@
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
@@ -379,6 +391,422 @@ CPLErr GDALContourGenerate(GDALRasterBandH hBand, double dfContourInterval,
     return err;
 }
 
+/************************************************************************/
+/*                  GDALContourGenerateMultiThreaded()                  */
+/************************************************************************/
+
+namespace
+{
+
+// Contour line traced in a stripe, or assembled from several stripes.
+struct GDALContourFragment
+{
+    double dfLevel = 0;
+    marching_squares::LineString oLS{};
+    bool bClosed = false;
+};
+
+struct GDALContourStripe
+{
+    int nYOff = 0;
+    int nYSize = 0;
+    // Lines that do not end on the border with another stripe.
+    std::vector<GDALContourFragment> aoCompleteLines{};
+    // Lines with at least one end on the border with another stripe.
+    std::vector<GDALContourFragment> aoBorderLines{};
+    bool bDone = false;
+    CPLErr eErr = CE_None;
+};
+
+// Line writer of the segment merger of a stripe, that sorts the lines
+// depending on whether they must be stitched with the ones of the
+// neighbouring stripes.
+struct GDALContourStripeWriter
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALContourStripeWriter)
+
+    GDALContourStripeWriter(GDALContourStripe &sStripe, double dfTopY,
+                            double dfBottomY)
+        : sStripe_(sStripe), dfTopY_(dfTopY), dfBottomY_(dfBottomY)
+    {
+    }
+
+    void addLine(double level, marching_squares::LineString &ls, bool closed)
+    {
+        GDALContourFragment oFragment;
+        oFragment.dfLevel = level;
+        oFragment.oLS.swap(ls);
+        oFragment.bClosed = closed;
+        if (!closed && (IsOnBorder(oFragment.oLS.front()) ||
+                        IsOnBorder(oFragment.oLS.back())))
+            sStripe_.aoBorderLines.push_back(std::move(oFragment));
+        else
+            sStripe_.aoCompleteLines.push_back(std::move(oFragment));
+    }
+
+  private:
+    GDALContourStripe &sStripe_;
+    // NaN when the stripe is at the top or bottom of the raster
+    const double dfTopY_;
+    const double dfBottomY_;
+
+    bool IsOnBorder(const marching_squares::Point &p) const
+    {
+        return p.y == dfTopY_ || p.y == dfBottomY_;
+    }
+};
+
+template <typename LevelIterator> class GDALContourMTContext
+{
+    GDALRasterBandH hBand_;
+    bool bUseNoData_;
+    double dfNoDataValue_;
+    LevelIterator &oLevels_;
+
+  public:
+    const int nXSize;
+    const int nYSize;
+
+    std::vector<GDALContourStripe> asStripes{};
+
+    // Protects band accesses, and the done flags of stripes.
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    std::atomic<bool> bStop{false};
+
+    GDALContourMTContext(GDALRasterBandH hBand, bool bUseNoData,
+                         double dfNoDataValue, LevelIterator &oLevels)
+        : hBand_(hBand), bUseNoData_(bUseNoData),
+          dfNoDataValue_(dfNoDataValue), oLevels_(oLevels),
+          nXSize(GDALGetRasterBandXSize(hBand)),
+          nYSize(GDALGetRasterBandYSize(hBand))
+    {
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALContourMTContext)
+
+    // Trace the contours of the squares between the line above the stripe
+    // and its last line.
+    bool ProcessStripe(GDALContourStripe &sStripe)
+    {
+        using namespace marching_squares;
+
+        const int nFirstLine = std::max(0, sStripe.nYOff - 1);
+        const int nLines = sStripe.nYOff + sStripe.nYSize - nFirstLine;
+        std::vector<double> adfLines(static_cast<size_t>(nXSize) * nLines);
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            if (bStop)
+                return false;
+            if (GDALRasterIO(hBand_, GF_Read, 0, nFirstLine, nXSize, nLines,
+                             adfLines.data(), nXSize, nLines, GDT_Float64, 0,
+                             0) != CE_None)
+                return false;
+        }
+
+        const bool bLastStripe = sStripe.nYOff + sStripe.nYSize == nYSize;
+        GDALContourStripeWriter oWriter(
+            sStripe, sStripe.nYOff > 0 ? sStripe.nYOff - .5 : NaN,
+            bLastStripe ? NaN : sStripe.nYOff + sStripe.nYSize - .5);
+        // Lines still being merged are written to oWriter when oMerger
+        // goes out of scope.
+        SegmentMerger<GDALContourStripeWriter, LevelIterator> oMerger(
+            oWriter, oLevels_, /* polygonize */ false);
+        ContourGenerator<decltype(oMerger), LevelIterator> oCG(
+            nXSize, nYSize, bUseNoData_, dfNoDataValue_, oMerger, oLevels_);
+        const double *padfLine = adfLines.data();
+        if (sStripe.nYOff > 0)
+        {
+            oCG.setStartLine(sStripe.nYOff, padfLine);
+            padfLine += nXSize;
+        }
+        for (int iLine = 0; iLine < sStripe.nYSize && !bStop; ++iLine)
+        {
+            oCG.feedLine(padfLine);
+            padfLine += nXSize;
+        }
+        return !bStop;
+    }
+};
+
+template <typename LevelIterator> struct GDALContourMTJob
+{
+    GDALContourMTContext<LevelIterator> *poContext = nullptr;
+    int iStripe = 0;
+
+    static void Process(void *pData)
+    {
+        auto psJob = static_cast<GDALContourMTJob *>(pData);
+        auto poContext = psJob->poContext;
+        auto &sStripe = poContext->asStripes[psJob->iStripe];
+        bool bOK = false;
+        try
+        {
+            bOK = poContext->ProcessStripe(sStripe);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
+        }
+        if (!bOK)
+            poContext->bStop = true;
+
+        std::lock_guard<std::mutex> oLock(poContext->oMutex);
+        if (!bOK)
+            sStripe.eErr = CE_Failure;
+        sStripe.bDone = true;
+        poContext->oCV.notify_all();
+    }
+};
+
+}  // namespace
+
+// Join the lines of aoOpenLines, that end on the top border of a stripe, with
+// the lines of the stripe that end on that border. Lines that are finished
+// are written, and the ones ending on the bottom border of the stripe are
+// returned in aoOpenLines.
+static void GDALContourStitchStripe(
+    std::vector<GDALContourFragment> &aoOpenLines,
+    std::vector<GDALContourFragment> &aoBorderLines, double dfTopY,
+    double dfBottomY, GDALRingAppender &oAppender)
+{
+    // Fragments are numbered with the open lines first. The ends of fragment
+    // i are 2 * i for its first point and 2 * i + 1 for its last point.
+    const size_t nOpenLines = aoOpenLines.size();
+    const size_t nFragments = nOpenLines + aoBorderLines.size();
+    const auto GetFragment = [&](size_t i) -> GDALContourFragment &
+    {
+        return i < nOpenLines ? aoOpenLines[i]
+                              : aoBorderLines[i - nOpenLines];
+    };
+    const auto GetEnd = [&](size_t iEnd) -> const marching_squares::Point &
+    {
+        const auto &oLS = GetFragment(iEnd / 2).oLS;
+        return (iEnd % 2) == 0 ? oLS.front() : oLS.back();
+    };
+
+    // Link the ends that are on the top border, at the same position and
+    // for the same level.
+    constexpr size_t NOT_LINKED = std::numeric_limits<size_t>::max();
+    std::vector<size_t> anLinkedEnd(2 * nFragments, NOT_LINKED);
+    std::map<std::pair<double, double>, size_t> oMapTopEnds;
+    for (size_t iEnd = 0; iEnd < 2 * nOpenLines; ++iEnd)
+    {
+        const auto &oPoint = GetEnd(iEnd);
+        if (oPoint.y == dfTopY)
+            oMapTopEnds.emplace(
+                std::make_pair(GetFragment(iEnd / 2).dfLevel, oPoint.x), iEnd);
+    }
+    for (size_t iEnd = 2 * nOpenLines; iEnd < 2 * nFragments; ++iEnd)
+    {
+        const auto &oPoint = GetEnd(iEnd);
+        if (oPoint.y != dfTopY)
+            continue;
+        const auto oIter = oMapTopEnds.find(
+            std::make_pair(GetFragment(iEnd / 2).dfLevel, oPoint.x));
+        if (oIter != oMapTopEnds.end() &&
+            anLinkedEnd[oIter->second] == NOT_LINKED)
+        {
+            anLinkedEnd[oIter->second] = iEnd;
+            anLinkedEnd[iEnd] = oIter->second;
+        }
+    }
+
+    // Assemble the chains of linked fragments.
+    std::vector<GDALContourFragment> aoNewOpenLines;
+    std::vector<bool> abVisited(nFragments);
+    for (size_t i = 0; i < nFragments; ++i)
+    {
+        if (abVisited[i])
+            continue;
+
+        // Go back to the first fragment of the chain, or detect a ring.
+        size_t iStartEnd = 2 * i;
+        while (anLinkedEnd[iStartEnd] != NOT_LINKED)
+        {
+            const size_t iPrevOtherEnd = anLinkedEnd[iStartEnd] ^ 1;
+            if (iPrevOtherEnd / 2 == i)
+            {
+                iStartEnd = 2 * i;
+                break;
+            }
+            iStartEnd = iPrevOtherEnd;
+        }
+
+        GDALContourFragment oLine;
+        oLine.dfLevel = GetFragment(i).dfLevel;
+        size_t iEnd = iStartEnd;
+        while (true)
+        {
+            abVisited[iEnd / 2] = true;
+            auto &oLS = GetFragment(iEnd / 2).oLS;
+            if ((iEnd % 2) != 0)
+                oLS.reverse();
+            if (!oLine.oLS.empty())
+                oLS.pop_front();
+            oLine.oLS.splice(oLine.oLS.end(), oLS);
+            iEnd = anLinkedEnd[iEnd ^ 1];
+            if (iEnd == NOT_LINKED)
+                break;
+            if (iEnd == iStartEnd)
+            {
+                oLine.bClosed = true;
+                break;
+            }
+        }
+
+        if (!oLine.bClosed && (oLine.oLS.front().y == dfBottomY ||
+                               oLine.oLS.back().y == dfBottomY))
+            aoNewOpenLines.push_back(std::move(oLine));
+        else
+            oAppender.addLine(oLine.dfLevel, oLine.oLS, oLine.bClosed);
+    }
+
+    aoOpenLines = std::move(aoNewOpenLines);
+    aoBorderLines.clear();
+}
+
+// Trace the contours of horizontal stripes of the raster in parallel. Lines
+// crossing stripe borders are stitched through their ends, which have the
+// same coordinates on both sides of the border, and lines are written in the
+// order of the stripes as soon as they are finished.
+template <typename LevelIterator>
+static bool GDALContourGenerateMultiThreaded(
+    GDALRasterBandH hBand, bool bUseNoData, double dfNoDataValue,
+    LevelIterator &oLevels, GDALRingAppender &oAppender, int nLinesPerStripe,
+    int nNumThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using ContextType = GDALContourMTContext<LevelIterator>;
+    using JobType = GDALContourMTJob<LevelIterator>;
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        return false;
+
+    ContextType oContext(hBand, bUseNoData, dfNoDataValue, oLevels);
+    const int nYSize = oContext.nYSize;
+    const int nStripes = (nYSize + nLinesPerStripe - 1) / nLinesPerStripe;
+    std::vector<JobType> asJobs(nStripes);
+    oContext.asStripes.resize(nStripes);
+    for (int iStripe = 0; iStripe < nStripes; ++iStripe)
+    {
+        auto &sStripe = oContext.asStripes[iStripe];
+        sStripe.nYOff = iStripe * nLinesPerStripe;
+        sStripe.nYSize = std::min(nLinesPerStripe, nYSize - sStripe.nYOff);
+        asJobs[iStripe].poContext = &oContext;
+        asJobs[iStripe].iStripe = iStripe;
+    }
+
+    // Only a limited number of stripes are processed ahead of the one being
+    // written, to bound memory use.
+    const int nMaxStripesAhead = 2 * nNumThreads;
+    int iNextStripeToSubmit = 0;
+    std::vector<GDALContourFragment> aoOpenLines;
+    bool bOK = true;
+    try
+    {
+        for (int iStripe = 0; bOK && iStripe < nStripes; ++iStripe)
+        {
+            for (; iNextStripeToSubmit < nStripes &&
+                   iNextStripeToSubmit < iStripe + nMaxStripesAhead;
+                 ++iNextStripeToSubmit)
+            {
+                poJobQueue->SubmitJob(JobType::Process,
+                                      &asJobs[iNextStripeToSubmit]);
+            }
+
+            auto &sStripe = oContext.asStripes[iStripe];
+            {
+                std::unique_lock<std::mutex> oLock(oContext.oMutex);
+                oContext.oCV.wait(oLock,
+                                  [&sStripe]() { return sStripe.bDone; });
+            }
+            if (sStripe.eErr != CE_None)
+            {
+                bOK = false;
+                break;
+            }
+
+            for (auto &oLine : sStripe.aoCompleteLines)
+                oAppender.addLine(oLine.dfLevel, oLine.oLS, oLine.bClosed);
+            sStripe.aoCompleteLines.clear();
+            sStripe.aoCompleteLines.shrink_to_fit();
+
+            const bool bLastStripe = iStripe + 1 == nStripes;
+            GDALContourStitchStripe(
+                aoOpenLines, sStripe.aoBorderLines, sStripe.nYOff - .5,
+                bLastStripe ? marching_squares::NaN
+                            : sStripe.nYOff + sStripe.nYSize - .5,
+                oAppender);
+            sStripe.aoBorderLines.shrink_to_fit();
+
+            if (!pfnProgress(double(iStripe + 1) / nStripes, "",
+                             pProgressArg))
+            {
+                bOK = false;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
+        bOK = false;
+    }
+
+    if (!bOK)
+        oContext.bStop = true;
+    poJobQueue->WaitCompletion();
+    return bOK;
+}
+
+// Generate contour lines, using nNumThreads threads if the raster is large
+// enough.
+template <typename LevelIterator>
+static bool GDALContourGenerateLines(GDALRasterBandH hBand, bool useNoData,
+                                     double noDataValue, LevelIterator &levels,
+                                     GDALRingAppender &appender,
+                                     int nNumThreads,
+                                     GDALProgressFunc pfnProgress,
+                                     void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    if (nNumThreads > 1)
+    {
+        const int nXSize = GDALGetRasterBandXSize(hBand);
+        const int nYSize = GDALGetRasterBandYSize(hBand);
+        // Stripes small enough to be spread over the threads, with a read
+        // buffer of at most 64 MB.
+        const int nMaxLinesPerBuffer = static_cast<int>(std::min<size_t>(
+            INT_MAX,
+            std::max<size_t>(1, (64 * 1024 * 1024) /
+                                    (sizeof(double) *
+                                     static_cast<size_t>(nXSize)))));
+        int nLinesPerStripe =
+            std::min(nMaxLinesPerBuffer,
+                     static_cast<int>(
+                         (static_cast<GIntBig>(nYSize) + 4 * nNumThreads - 1) /
+                         (4 * nNumThreads)));
+        nLinesPerStripe =
+            static_cast<int>(GDALGetTestChunkSize(nLinesPerStripe, nYSize));
+
+        if (nLinesPerStripe < nYSize)
+        {
+            return GDALContourGenerateMultiThreaded(
+                hBand, useNoData, noDataValue, levels, appender,
+                nLinesPerStripe, nNumThreads, pfnProgress, pProgressArg);
+        }
+    }
+
+    SegmentMerger<GDALRingAppender, LevelIterator> writer(
+        appender, levels, /* polygonize */ false);
+    ContourGeneratorFromRaster<decltype(writer), LevelIterator> cg(
+        hBand, useNoData, noDataValue, writer, levels);
+    return cg.process(pfnProgress, pProgressArg);
+}
+
 /**
  * Create vector contours from raster DEM.
  *
@@ -545,6 +973,15 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=number_of_threads/ALL_CPUS
+ *
+ * (GDAL >= 3.10) Number of threads used to trace the contours of horizontal
+ * stripes of the raster in parallel. Lines crossing stripe borders are
+ * joined, so the same lines are generated as with a single thread, but they
+ * may be written in a different order, and closed lines may start at a
+ * different point. Only used in line contouring mode. Defaults to the value
+ * of the GDAL_NUM_THREADS configuration option, or 1.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -643,6 +1080,13 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        options, "NUM_THREADS", CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nNumThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -740,32 +1184,23 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
             {
                 FixedLevelRangeIterator levels(&fixedLevels[0],
                                                fixedLevels.size());
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateLines(hBand, useNoData, noDataValue,
+                                              levels, appender, nNumThreads,
+                                              pfnProgress, pProgressArg);
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateLines(hBand, useNoData, noDataValue,
+                                              levels, appender, nNumThreads,
+                                              pfnProgress, pProgressArg);
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateLines(hBand, useNoData, noDataValue,
+                                              levels, appender, nNumThreads,
+                                              pfnProgress, pProgressArg);
             }
         }
     }
@@ -34,13 +34,18 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -49,6 +54,31 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+namespace
+{
+struct GDALProximityEDTParams
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    double dfMaxDist = 0;
+    double dfDistMult = 1;
+    const double *pdfSrcNoDataValue = nullptr;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+};
+}  // namespace
+
+static CPLErr GDALComputeProximityEDT(GDALRasterBandH hSrcBand,
+                                      GDALRasterBandH hWorkProximityBand,
+                                      GDALRasterBandH hProximityBand,
+                                      const GDALProximityEDTParams &sParams,
+                                      int nNumThreads,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -105,6 +135,20 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[TWO_PASS]/EDT
+
+(GDAL >= 3.10) Selects the algorithm. TWO_PASS, the default, propagates
+the nearest target found on the previous line and pixel, in two passes
+over the image, which is fast but may slightly overestimate some
+distances. EDT computes the exact euclidean distance transform, in a
+separable way, and can use several threads: the vertical passes are split
+by strips of columns, and the horizontal one by strips of lines.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.10) Number of worker threads used by ALGORITHM=EDT. Defaults
+to the value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -241,6 +285,32 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm, and how many threads?                          */
+    /* -------------------------------------------------------------------- */
+    bool bEDT = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EDT"))
+            bEDT = true;
+        else if (!EQUAL(pszOpt, "TWO_PASS"))
+        {
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "Unrecognized ALGORITHM value '%s', should be TWO_PASS or EDT.",
+                pszOpt);
+            CPLFree(panTargetValues);
+            return CE_Failure;
+        }
+    }
+
+    pszOpt = CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                                  CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    int nNumThreads =
+        EQUAL(pszOpt, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszOpt);
+    nNumThreads = std::max(1, std::min(128, nNumThreads));
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -294,6 +364,25 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
     }
 
+    if (bEDT)
+    {
+        GDALProximityEDTParams sParams;
+        sParams.nXSize = nXSize;
+        sParams.nYSize = nYSize;
+        sParams.dfMaxDist = dfMaxDist;
+        sParams.dfDistMult = dfDistMult;
+        sParams.pdfSrcNoDataValue = pdfSrcNoData;
+        sParams.nTargetValues = nTargetValues;
+        sParams.panTargetValues = panTargetValues;
+        sParams.fNoDataValue = fNoDataValue;
+        sParams.bFixedBufVal = bFixedBufVal;
+        sParams.dfFixedBufVal = dfFixedBufVal;
+        eErr = GDALComputeProximityEDT(hSrcBand, hWorkProximityBand,
+                                       hProximityBand, sParams, nNumThreads,
+                                       pfnProgress, pProgressArg);
+        goto end;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffer for two scanlines of distances as floats        */
     /*      (the current and last line).                                    */
@@ -589,3 +678,388 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                      Exact distance transform                        */
+/************************************************************************/
+
+namespace
+{
+// Rows of a chunk of lines processed by the second pass.
+struct GDALProximityEDTJob
+{
+    const GDALProximityEDTParams *psParams = nullptr;
+    const GInt32 *panSrc = nullptr;
+    // Vertical distance to the nearest target in the column, or infinity.
+    const float *pafColDist = nullptr;
+    float *pafProximity = nullptr;
+    int nLines = 0;
+
+    static void Process(void *pData);
+};
+
+// Strip of columns of a chunk of lines processed by the vertical passes.
+struct GDALProximityEDTColumnJob
+{
+    const GDALProximityEDTParams *psParams = nullptr;
+    const GInt32 *panSrc = nullptr;
+    float *pafColDist = nullptr;
+    // Distance to the nearest target above (top to bottom pass) or below
+    // (bottom to top pass) in each column, carried from chunk to chunk.
+    float *pafNearest = nullptr;
+    int nLines = 0;
+    int nXOff = 0;
+    int nXCount = 0;
+    bool bTopToBottom = true;
+
+    static void Process(void *pData);
+};
+}  // namespace
+
+static bool IsProximityTarget(GInt32 nValue, int nTargetValues,
+                              const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                        ProcessProximityRowEDT()                      */
+/*                                                                      */
+/*      Compute the squared distance of each pixel of a line to the     */
+/*      nearest target, from the vertical distances to the nearest      */
+/*      target in each column, as the lower envelope of the parabolas   */
+/*      (x - q)^2 + colDist(q)^2 (Felzenszwalb & Huttenlocher, 2012).   */
+/************************************************************************/
+
+static void ProcessProximityRowEDT(const float *pafColDist, int nXSize,
+                                   double dfMaxDist, int *panParabolaX,
+                                   double *padfParabolaF,
+                                   double *padfEnvelopeStart,
+                                   double *padfDistSq)
+{
+    int k = -1;
+    for (int q = 0; q < nXSize; q++)
+    {
+        // Columns without target within dfMaxDist cannot contribute.
+        if (!(pafColDist[q] <= dfMaxDist))
+            continue;
+        const double dfF = static_cast<double>(pafColDist[q]) * pafColDist[q];
+        double dfStart = -std::numeric_limits<double>::infinity();
+        while (k >= 0)
+        {
+            const double dfQ = q;
+            const double dfV = panParabolaX[k];
+            dfStart = ((dfF + dfQ * dfQ) - (padfParabolaF[k] + dfV * dfV)) /
+                      (2 * (dfQ - dfV));
+            if (dfStart > padfEnvelopeStart[k])
+                break;
+            dfStart = -std::numeric_limits<double>::infinity();
+            --k;
+        }
+        ++k;
+        panParabolaX[k] = q;
+        padfParabolaF[k] = dfF;
+        padfEnvelopeStart[k] = dfStart;
+    }
+
+    if (k < 0)
+    {
+        std::fill(padfDistSq, padfDistSq + nXSize,
+                  std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    const int nParabolas = k + 1;
+    k = 0;
+    for (int p = 0; p < nXSize; p++)
+    {
+        while (k + 1 < nParabolas && padfEnvelopeStart[k + 1] < p)
+            ++k;
+        const double dfDX = p - panParabolaX[k];
+        padfDistSq[p] = dfDX * dfDX + padfParabolaF[k];
+    }
+}
+
+void GDALProximityEDTJob::Process(void *pData)
+{
+    const auto psJob = static_cast<const GDALProximityEDTJob *>(pData);
+    const auto &sParams = *(psJob->psParams);
+    const int nXSize = sParams.nXSize;
+    const double dfMaxDistSq = sParams.dfMaxDist * sParams.dfMaxDist;
+
+    std::vector<int> anParabolaX(nXSize);
+    std::vector<double> adfParabolaF(nXSize);
+    std::vector<double> adfEnvelopeStart(nXSize);
+    std::vector<double> adfDistSq(nXSize);
+
+    for (int iLine = 0; iLine < psJob->nLines; iLine++)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panSrc = psJob->panSrc + nOffset;
+        float *pafProximity = psJob->pafProximity + nOffset;
+
+        ProcessProximityRowEDT(psJob->pafColDist + nOffset, nXSize,
+                               sParams.dfMaxDist, anParabolaX.data(),
+                               adfParabolaF.data(), adfEnvelopeStart.data(),
+                               adfDistSq.data());
+
+        for (int i = 0; i < nXSize; i++)
+        {
+            const double dfDistSq = adfDistSq[i];
+            if (dfDistSq == 0)
+                pafProximity[i] = 0.0f;
+            else if (!(dfDistSq <= dfMaxDistSq) ||
+                     (sParams.pdfSrcNoDataValue != nullptr &&
+                      panSrc[i] == *(sParams.pdfSrcNoDataValue)))
+                pafProximity[i] = sParams.fNoDataValue;
+            else if (sParams.bFixedBufVal)
+                pafProximity[i] = static_cast<float>(sParams.dfFixedBufVal);
+            else
+                pafProximity[i] =
+                    static_cast<float>(sqrt(dfDistSq) * sParams.dfDistMult);
+        }
+    }
+}
+
+void GDALProximityEDTColumnJob::Process(void *pData)
+{
+    const auto psJob = static_cast<const GDALProximityEDTColumnJob *>(pData);
+    const auto &sParams = *(psJob->psParams);
+    const size_t nXSize = static_cast<size_t>(sParams.nXSize);
+    const int nXOff = psJob->nXOff;
+    const int nXEnd = nXOff + psJob->nXCount;
+    float *pafNearest = psJob->pafNearest;
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    if (psJob->bTopToBottom)
+    {
+        for (int iLine = 0; iLine < psJob->nLines; iLine++)
+        {
+            const GInt32 *panSrc = psJob->panSrc + iLine * nXSize;
+            float *pafColDist = psJob->pafColDist + iLine * nXSize;
+            for (int i = nXOff; i < nXEnd; i++)
+            {
+                pafNearest[i] = IsProximityTarget(panSrc[i],
+                                                  sParams.nTargetValues,
+                                                  sParams.panTargetValues)
+                                    ? 0.0f
+                                    : pafNearest[i] + 1.0f;
+                // Store "no target within MAXDIST" as -1 in the work band.
+                pafColDist[i] =
+                    pafNearest[i] <= sParams.dfMaxDist ? pafNearest[i] : -1.0f;
+            }
+        }
+    }
+    else
+    {
+        for (int iLine = psJob->nLines - 1; iLine >= 0; iLine--)
+        {
+            const GInt32 *panSrc = psJob->panSrc + iLine * nXSize;
+            float *pafColDist = psJob->pafColDist + iLine * nXSize;
+            for (int i = nXOff; i < nXEnd; i++)
+            {
+                pafNearest[i] = IsProximityTarget(panSrc[i],
+                                                  sParams.nTargetValues,
+                                                  sParams.panTargetValues)
+                                    ? 0.0f
+                                    : pafNearest[i] + 1.0f;
+                const float fNearestAbove =
+                    pafColDist[i] < 0 ? INF : pafColDist[i];
+                pafColDist[i] = std::min(fNearestAbove, pafNearest[i]);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALComputeProximityEDT()                       */
+/*                                                                      */
+/*      Exact euclidean distance transform, computed separably: the     */
+/*      first pass, top to bottom, stores in the work band the          */
+/*      vertical distance to the nearest target above each pixel. The   */
+/*      second pass, bottom to top, combines it with the distance to    */
+/*      the nearest target below, and then processes each line with     */
+/*      ProcessProximityRowEDT(). Columns are independent in the        */
+/*      vertical passes, which are dispatched over worker threads by    */
+/*      strips of columns, and lines are independent in the last step,  */
+/*      which is dispatched by strips of lines.                         */
+/************************************************************************/
+
+static CPLErr GDALComputeProximityEDT(GDALRasterBandH hSrcBand,
+                                      GDALRasterBandH hWorkProximityBand,
+                                      GDALRasterBandH hProximityBand,
+                                      const GDALProximityEDTParams &sParams,
+                                      int nNumThreads,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // Limit the memory of the chunk buffers to ~ 64 MB per thread, but use
+    // at least 4 lines per thread.
+    const size_t nBytesPerLine =
+        static_cast<size_t>(nXSize) * (sizeof(GInt32) + 2 * sizeof(float));
+    int nChunkLines = static_cast<int>(std::min<size_t>(
+        nYSize, std::max<size_t>(4 * nNumThreads,
+                                 nNumThreads * (64 * 1024 * 1024) /
+                                     std::max<size_t>(1, nBytesPerLine))));
+    nChunkLines = static_cast<int>(GDALGetTestChunkSize(nChunkLines, nYSize));
+
+    std::vector<GInt32> anSrc;
+    std::vector<float> afColDist;
+    std::vector<float> afProximity;
+    std::vector<float> afNearestBelow;
+    try
+    {
+        const size_t nChunkSize = static_cast<size_t>(nChunkLines) * nXSize;
+        anSrc.resize(nChunkSize);
+        afColDist.resize(nChunkSize);
+        afProximity.resize(nChunkSize);
+        afNearestBelow.resize(nXSize, INF);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALComputeProximity()");
+        return CE_Failure;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    // Dispatch the columns of a chunk over the worker threads, by strips
+    // whose width is a multiple of 64 pixels, to avoid false sharing.
+    const int nColumnJobs = poJobQueue ? std::max(1, std::min(nNumThreads,
+                                                              nXSize / 64))
+                                       : 1;
+    const int nColumnsPerJob =
+        ((nXSize + nColumnJobs - 1) / nColumnJobs + 63) / 64 * 64;
+    std::vector<GDALProximityEDTColumnJob> asColumnJobs(nColumnJobs);
+    const auto ProcessColumns = [&](int nLines, bool bTopToBottom)
+    {
+        for (int iJob = 0; iJob < nColumnJobs; ++iJob)
+        {
+            const int nXOff = iJob * nColumnsPerJob;
+            if (nXOff >= nXSize)
+                break;
+            auto &sJob = asColumnJobs[iJob];
+            sJob.psParams = &sParams;
+            sJob.panSrc = anSrc.data();
+            sJob.pafColDist = afColDist.data();
+            sJob.pafNearest = afNearestBelow.data();
+            sJob.nLines = nLines;
+            sJob.nXOff = nXOff;
+            sJob.nXCount = std::min(nColumnsPerJob, nXSize - nXOff);
+            sJob.bTopToBottom = bTopToBottom;
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALProximityEDTColumnJob::Process,
+                                      &sJob);
+            else
+                GDALProximityEDTColumnJob::Process(&sJob);
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      Top to bottom: distance to the nearest target above, stored in  */
+    /*      afNearestBelow during that pass.                                */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    for (int iChunkYOff = 0; eErr == CE_None && iChunkYOff < nYSize;
+         iChunkYOff += nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, nYSize - iChunkYOff);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iChunkYOff, nXSize, nLines,
+                            anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        ProcessColumns(nLines, /* bTopToBottom = */ true);
+
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, iChunkYOff, nXSize,
+                            nLines, afColDist.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
+        if (eErr == CE_None &&
+            !pfnProgress(0.5 * (iChunkYOff + nLines) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Bottom to top: combine with the distance to the nearest target  */
+    /*      below, and compute the distance along lines.                    */
+    /* -------------------------------------------------------------------- */
+    std::fill(afNearestBelow.begin(), afNearestBelow.end(), INF);
+    std::vector<GDALProximityEDTJob> asJobs(nNumThreads);
+    for (int iChunkYEnd = nYSize; eErr == CE_None && iChunkYEnd > 0;
+         iChunkYEnd -= nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, iChunkYEnd);
+        const int iChunkYOff = iChunkYEnd - nLines;
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, iChunkYOff, nXSize,
+                            nLines, afColDist.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iChunkYOff, nXSize,
+                                nLines, anSrc.data(), nXSize, nLines,
+                                GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        ProcessColumns(nLines, /* bTopToBottom = */ false);
+
+        // Dispatch the lines of the chunk over the worker threads
+        const int nJobs = poJobQueue ? nNumThreads : 1;
+        const int nLinesPerJob = (nLines + nJobs - 1) / nJobs;
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            const int iFirstLine = iJob * nLinesPerJob;
+            if (iFirstLine >= nLines)
+                break;
+            const size_t nOffset = static_cast<size_t>(iFirstLine) * nXSize;
+            auto &sJob = asJobs[iJob];
+            sJob.psParams = &sParams;
+            sJob.panSrc = anSrc.data() + nOffset;
+            sJob.pafColDist = afColDist.data() + nOffset;
+            sJob.pafProximity = afProximity.data() + nOffset;
+            sJob.nLines = std::min(nLinesPerJob, nLines - iFirstLine);
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALProximityEDTJob::Process, &sJob);
+            else
+                GDALProximityEDTJob::Process(&sJob);
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iChunkYOff, nXSize,
+                            nLines, afProximity.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
+        if (eErr == CE_None &&
+            !pfnProgress(0.5 + 0.5 * (nYSize - iChunkYOff) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
@@ -32,11 +32,15 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
@@ -45,9 +49,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -829,6 +835,692 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
     return CE_None;
 }
 
+/************************************************************************/
+/*                     GDALRasterizeGetNumThreads()                     */
+/************************************************************************/
+
+static int GDALRasterizeGetNumThreads(CSLConstList papszOptions)
+{
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                ? CPLGetNumCPUs()
+                                : atoi(pszNumThreads);
+    return std::max(1, std::min(128, nNumThreads));
+}
+
+namespace
+{
+// Per worker state: a chunk buffer, and a transformer that is not used
+// concurrently by other workers.
+struct GDALRasterizeMTSlot
+{
+    std::vector<GByte> abyChunkBuf{};
+    void *pTransformArg = nullptr;
+    bool bOwnTransformArg = false;
+};
+
+struct GDALRasterizeMTContext
+{
+    GDALDataset *poDS = nullptr;
+    int nBandCount = 0;
+    const int *panBandList = nullptr;
+    GDALDataType eType = GDT_Unknown;
+    int nYChunkSize = 0;
+    int nChunks = 0;
+
+    int nGeomCount = 0;
+    const OGRGeometryH *pahGeometries = nullptr;
+    GDALDataType eBurnValueType = GDT_Float64;
+    const double *padfGeomBurnValues = nullptr;
+    const int64_t *panGeomBurnValues = nullptr;
+    int bAllTouched = FALSE;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+    GDALTransformerFunc pfnTransformer = nullptr;
+
+    // Range of chunks touched by each geometry (-1 if none).
+    std::vector<int> anGeomFirstChunk{};
+    std::vector<int> anGeomLastChunk{};
+
+    // Indices of the geometries touching each chunk, in increasing order:
+    // those of chunk i are in
+    // anChunkGeoms[anChunkGeomsStart[i]:anChunkGeomsStart[i+1]].
+    std::vector<size_t> anChunkGeomsStart{};
+    std::vector<int> anChunkGeoms{};
+
+    std::vector<GDALRasterizeMTSlot> asSlots{};
+    std::vector<int> anFreeSlots{};
+    std::condition_variable oCV{};
+
+    // Protects dataset accesses, anFreeSlots and eErr.
+    std::mutex oMutex{};
+    CPLErr eErr = CE_None;
+
+    bool ComputeGeometryChunks(int iFirst, int iLast,
+                               GDALRasterizeMTSlot &sSlot);
+    bool ProcessChunk(int iFirst, int iLast, GDALRasterizeMTSlot &sSlot);
+};
+
+struct GDALRasterizeMTJob
+{
+    GDALRasterizeMTContext *poContext = nullptr;
+    int iFirst = 0;
+    int iLast = 0;
+    bool (GDALRasterizeMTContext::*pfnProcess)(int, int,
+                                               GDALRasterizeMTSlot &) = nullptr;
+
+    static void Process(void *pData)
+    {
+        auto psJob = static_cast<GDALRasterizeMTJob *>(pData);
+        auto poContext = psJob->poContext;
+        int iSlot;
+        {
+            std::unique_lock<std::mutex> oLock(poContext->oMutex);
+            if (poContext->eErr != CE_None)
+                return;
+            poContext->oCV.wait(oLock, [poContext]
+                                { return !poContext->anFreeSlots.empty(); });
+            iSlot = poContext->anFreeSlots.back();
+            poContext->anFreeSlots.pop_back();
+        }
+        const bool bOK = (poContext->*(psJob->pfnProcess))(
+            psJob->iFirst, psJob->iLast, poContext->asSlots[iSlot]);
+        {
+            std::lock_guard<std::mutex> oLock(poContext->oMutex);
+            if (!bOK)
+                poContext->eErr = CE_Failure;
+            poContext->anFreeSlots.push_back(iSlot);
+        }
+        poContext->oCV.notify_one();
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                       ComputeGeometryChunks()                        */
+/*                                                                      */
+/*      Compute the range of chunks touched by geometries iFirst to     */
+/*      iLast, from the lines of their vertices in pixel space, with    */
+/*      a margin of one line for pixels touched by segments.            */
+/************************************************************************/
+
+bool GDALRasterizeMTContext::ComputeGeometryChunks(int iFirst, int iLast,
+                                                   GDALRasterizeMTSlot &sSlot)
+{
+    const int nYSize = poDS->GetRasterYSize();
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    std::vector<int> anSuccess;
+    for (int iShape = iFirst; iShape <= iLast; iShape++)
+    {
+        anGeomFirstChunk[iShape] = -1;
+        anGeomLastChunk[iShape] = -1;
+
+        const OGRGeometry *poShape =
+            OGRGeometry::FromHandle(pahGeometries[iShape]);
+        aPointX.clear();
+        aPointY.clear();
+        aPartSize.clear();
+        GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
+                                     aPartSize, GBV_UserBurnValue);
+        if (aPointX.empty())
+            continue;
+
+        anSuccess.resize(aPointX.size());
+        pfnTransformer(sSlot.pTransformArg, FALSE,
+                       static_cast<int>(aPointX.size()), aPointX.data(),
+                       aPointY.data(), nullptr, anSuccess.data());
+
+        double dfMinY = std::numeric_limits<double>::infinity();
+        double dfMaxY = -std::numeric_limits<double>::infinity();
+        bool bAllChunks = false;
+        for (const double dfY : aPointY)
+        {
+            // Be conservative with points that failed to transform.
+            if (!std::isfinite(dfY))
+            {
+                bAllChunks = true;
+                break;
+            }
+            dfMinY = std::min(dfMinY, dfY);
+            dfMaxY = std::max(dfMaxY, dfY);
+        }
+        if (bAllChunks)
+        {
+            anGeomFirstChunk[iShape] = 0;
+            anGeomLastChunk[iShape] = nChunks - 1;
+        }
+        else if (dfMaxY >= -1 && dfMinY <= nYSize + 1)
+        {
+            const int nMinLine =
+                std::max(0, static_cast<int>(std::floor(dfMinY)) - 1);
+            const int nMaxLine = static_cast<int>(
+                std::min<double>(nYSize - 1, std::floor(dfMaxY) + 1));
+            if (nMinLine <= nMaxLine)
+            {
+                anGeomFirstChunk[iShape] = nMinLine / nYChunkSize;
+                anGeomLastChunk[iShape] = nMaxLine / nYChunkSize;
+            }
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            ProcessChunk()                            */
+/*                                                                      */
+/*      Burn the geometries touching chunks iFirst to iLast.            */
+/************************************************************************/
+
+bool GDALRasterizeMTContext::ProcessChunk(int iFirst, int iLast,
+                                          GDALRasterizeMTSlot &sSlot)
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    try
+    {
+        sSlot.abyChunkBuf.resize(static_cast<size_t>(nYChunkSize) * nXSize *
+                                 nBandCount * GDALGetDataTypeSizeBytes(eType));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        return false;
+    }
+
+    for (int iChunk = iFirst; iChunk <= iLast; iChunk++)
+    {
+        // Nothing to do on chunks that are not touched by any geometry
+        if (anChunkGeomsStart[iChunk] == anChunkGeomsStart[iChunk + 1])
+            continue;
+
+        const int iY = iChunk * nYChunkSize;
+        const int nThisYChunkSize = std::min(nYChunkSize, nYSize - iY);
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            if (poDS->RasterIO(GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                               sSlot.abyChunkBuf.data(), nXSize,
+                               nThisYChunkSize, eType, nBandCount,
+                               const_cast<int *>(panBandList), 0, 0, 0,
+                               nullptr) != CE_None)
+                return false;
+        }
+
+        for (size_t i = anChunkGeomsStart[iChunk];
+             i < anChunkGeomsStart[iChunk + 1]; i++)
+        {
+            const int iShape = anChunkGeoms[i];
+            gv_rasterize_one_shape(
+                sSlot.abyChunkBuf.data(), 0, iY, nXSize, nThisYChunkSize,
+                nBandCount, eType, 0, 0, 0, bAllTouched,
+                OGRGeometry::FromHandle(pahGeometries[iShape]), eBurnValueType,
+                padfGeomBurnValues
+                    ? padfGeomBurnValues +
+                          static_cast<size_t>(iShape) * nBandCount
+                    : nullptr,
+                panGeomBurnValues ? panGeomBurnValues +
+                                        static_cast<size_t>(iShape) * nBandCount
+                                  : nullptr,
+                eBurnValueSource, eMergeAlg, pfnTransformer,
+                sSlot.pTransformArg);
+        }
+
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (poDS->RasterIO(GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                           sSlot.abyChunkBuf.data(), nXSize, nThisYChunkSize,
+                           eType, nBandCount, const_cast<int *>(panBandList), 0,
+                           0, 0, nullptr) != CE_None)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                GDALRasterizeGeometriesMultiThreaded()                */
+/*                                                                      */
+/*      Multi-threaded equivalent of the OPTIM=RASTER mode. The raster  */
+/*      is split in chunks of lines, processed concurrently. A first    */
+/*      pass computes the range of chunks touched by each geometry, so  */
+/*      that each chunk only burns the geometries touching it. As they  */
+/*      are burnt in the same order as in the single-threaded mode,     */
+/*      MERGE_ALG=ADD gives the same result.                            */
+/************************************************************************/
+
+static CPLErr GDALRasterizeGeometriesMultiThreaded(
+    GDALDataset *poDS, int nBandCount, const int *panBandList,
+    GDALDataType eType, int nGeomCount, const OGRGeometryH *pahGeometries,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg,
+    GDALDataType eBurnValueType, const double *padfGeomBurnValues,
+    const int64_t *panGeomBurnValues, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSource, GDALRasterMergeAlg eMergeAlg,
+    const char *pszYChunkSize, int nNumThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    const int nYSize = poDS->GetRasterYSize();
+
+    /* -------------------------------------------------------------------- */
+    /*      Establish a chunksize to operate on, so that the chunks of      */
+    /*      all threads fit in the cache, and that there are enough         */
+    /*      chunks to balance the load between threads.                     */
+    /* -------------------------------------------------------------------- */
+    int nYChunkSize = 0;
+    if (pszYChunkSize == nullptr || (nYChunkSize = atoi(pszYChunkSize)) == 0)
+    {
+        const GIntBig nScanlineBytes = static_cast<GIntBig>(nBandCount) *
+                                       poDS->GetRasterXSize() *
+                                       GDALGetDataTypeSizeBytes(eType);
+        const GIntBig nYChunkSize64 =
+            GDALGetCacheMax64() / nScanlineBytes / nNumThreads;
+        nYChunkSize = static_cast<int>(std::min<GIntBig>(
+            nYChunkSize64, (nYSize + 4 * nNumThreads - 1) / (4 * nNumThreads)));
+    }
+    nYChunkSize = std::max(1, std::min(nYChunkSize, nYSize));
+
+    GDALRasterizeMTContext oContext;
+    oContext.poDS = poDS;
+    oContext.nBandCount = nBandCount;
+    oContext.panBandList = panBandList;
+    oContext.eType = eType;
+    oContext.nYChunkSize = nYChunkSize;
+    oContext.nChunks = (nYSize + nYChunkSize - 1) / nYChunkSize;
+    oContext.nGeomCount = nGeomCount;
+    oContext.pahGeometries = pahGeometries;
+    oContext.eBurnValueType = eBurnValueType;
+    oContext.padfGeomBurnValues = padfGeomBurnValues;
+    oContext.panGeomBurnValues = panGeomBurnValues;
+    oContext.bAllTouched = bAllTouched;
+    oContext.eBurnValueSource = eBurnValueSource;
+    oContext.eMergeAlg = eMergeAlg;
+    oContext.pfnTransformer = pfnTransformer;
+
+    CPLDebug("GDAL",
+             "Rasterizer operating on %d swaths of %d scanlines with %d "
+             "threads.",
+             oContext.nChunks, nYChunkSize, nNumThreads);
+
+    try
+    {
+        oContext.anGeomFirstChunk.resize(nGeomCount);
+        oContext.anGeomLastChunk.resize(nGeomCount);
+        oContext.anChunkGeomsStart.resize(oContext.nChunks + 1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Each worker needs its own transformer, as they are not          */
+    /*      thread-safe.  Use less threads if they cannot be cloned.        */
+    /* -------------------------------------------------------------------- */
+    oContext.asSlots.resize(nNumThreads);
+    oContext.asSlots[0].pTransformArg = pTransformArg;
+    oContext.anFreeSlots.push_back(0);
+    for (int i = 1; i < nNumThreads; i++)
+    {
+        void *pClonedTransformArg;
+        {
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            pClonedTransformArg = GDALCloneTransformer(pTransformArg);
+        }
+        if (pClonedTransformArg == nullptr)
+        {
+            CPLDebug("GDAL",
+                     "Cannot clone transformer. Using %d thread(s) instead "
+                     "of %d.",
+                     i, nNumThreads);
+            break;
+        }
+        oContext.asSlots[i].pTransformArg = pClonedTransformArg;
+        oContext.asSlots[i].bOwnTransformArg = true;
+        oContext.anFreeSlots.push_back(i);
+    }
+    const auto DestroyTransformers = [&oContext]()
+    {
+        for (auto &sSlot : oContext.asSlots)
+        {
+            if (sSlot.bOwnTransformArg)
+                GDALDestroyTransformer(sSlot.pTransformArg);
+        }
+    };
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    const auto RunJobs =
+        [&](std::vector<GDALRasterizeMTJob> &asJobs, double dfProgressStart,
+            double dfProgressEnd)
+    {
+        const int nJobs = static_cast<int>(asJobs.size());
+        for (auto &sJob : asJobs)
+        {
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALRasterizeMTJob::Process, &sJob);
+            else
+                GDALRasterizeMTJob::Process(&sJob);
+        }
+        bool bInterrupted = false;
+        for (int nRemaining = nJobs - 1; nRemaining >= 0; nRemaining--)
+        {
+            if (poJobQueue)
+                poJobQueue->WaitCompletion(nRemaining);
+            if (!bInterrupted &&
+                !pfnProgress(dfProgressStart +
+                                 (dfProgressEnd - dfProgressStart) *
+                                     (nJobs - nRemaining) / nJobs,
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bInterrupted = true;
+                std::lock_guard<std::mutex> oLock(oContext.oMutex);
+                oContext.eErr = CE_Failure;
+            }
+        }
+        return oContext.eErr;
+    };
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the index of the geometries touching each chunk.          */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALRasterizeMTJob> asJobs;
+    const int nGeomsPerJob = std::max(
+        1, (nGeomCount + 4 * nNumThreads - 1) / (4 * nNumThreads));
+    for (int iFirst = 0; iFirst < nGeomCount; iFirst += nGeomsPerJob)
+    {
+        GDALRasterizeMTJob sJob;
+        sJob.poContext = &oContext;
+        sJob.iFirst = iFirst;
+        sJob.iLast = std::min(nGeomCount, iFirst + nGeomsPerJob) - 1;
+        sJob.pfnProcess = &GDALRasterizeMTContext::ComputeGeometryChunks;
+        asJobs.push_back(sJob);
+    }
+    if (RunJobs(asJobs, 0.0, 0.1) != CE_None)
+    {
+        DestroyTransformers();
+        return CE_Failure;
+    }
+
+    auto &anChunkGeomsStart = oContext.anChunkGeomsStart;
+    for (int iShape = 0; iShape < nGeomCount; iShape++)
+    {
+        for (int iChunk = oContext.anGeomFirstChunk[iShape];
+             iChunk >= 0 && iChunk <= oContext.anGeomLastChunk[iShape];
+             iChunk++)
+        {
+            anChunkGeomsStart[iChunk + 1]++;
+        }
+    }
+    for (int iChunk = 0; iChunk < oContext.nChunks; iChunk++)
+        anChunkGeomsStart[iChunk + 1] += anChunkGeomsStart[iChunk];
+    try
+    {
+        oContext.anChunkGeoms.resize(anChunkGeomsStart[oContext.nChunks]);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        DestroyTransformers();
+        return CE_Failure;
+    }
+    {
+        std::vector<size_t> anChunkGeomsCur(anChunkGeomsStart.begin(),
+                                            anChunkGeomsStart.end() - 1);
+        for (int iShape = 0; iShape < nGeomCount; iShape++)
+        {
+            for (int iChunk = oContext.anGeomFirstChunk[iShape];
+                 iChunk >= 0 && iChunk <= oContext.anGeomLastChunk[iShape];
+                 iChunk++)
+            {
+                oContext.anChunkGeoms[anChunkGeomsCur[iChunk]++] = iShape;
+            }
+        }
+    }
+    oContext.anGeomFirstChunk = std::vector<int>();
+    oContext.anGeomLastChunk = std::vector<int>();
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the geometries, one job per chunk.                         */
+    /* -------------------------------------------------------------------- */
+    asJobs.clear();
+    for (int iChunk = 0; iChunk < oContext.nChunks; iChunk++)
+    {
+        GDALRasterizeMTJob sJob;
+        sJob.poContext = &oContext;
+        sJob.iFirst = iChunk;
+        sJob.iLast = iChunk;
+        sJob.pfnProcess = &GDALRasterizeMTContext::ProcessChunk;
+        asJobs.push_back(sJob);
+    }
+    const CPLErr eErr = RunJobs(asJobs, 0.1, 1.0);
+
+    DestroyTransformers();
+    return eErr;
+}
+
+/************************************************************************/
+/*                GDALCreateRasterizeLayerTransformer()                 */
+/*                                                                      */
+/*      Create a transformer from the coordinate system of a layer to   */
+/*      the pixel/line coordinates of the raster.                       */
+/************************************************************************/
+
+static void *GDALCreateRasterizeLayerTransformer(GDALDataset *poDS,
+                                                 OGRLayer *poLayer)
+{
+    char *pszProjection = nullptr;
+
+    OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
+    if (!poSRS)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Failed to fetch spatial reference on layer %s "
+                 "to build transformer, assuming matching coordinate "
+                 "systems.",
+                 poLayer->GetLayerDefn()->GetName());
+    }
+    else
+    {
+        poSRS->exportToWkt(&pszProjection);
+    }
+
+    char **papszTransformerOptions = nullptr;
+    if (pszProjection != nullptr)
+        papszTransformerOptions = CSLSetNameValue(papszTransformerOptions,
+                                                  "SRC_SRS", pszProjection);
+    double adfGeoTransform[6] = {};
+    if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
+        poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
+    {
+        papszTransformerOptions = CSLSetNameValue(
+            papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
+    }
+
+    void *pTransformArg = GDALCreateGenImgProjTransformer2(
+        nullptr, GDALDataset::ToHandle(poDS), papszTransformerOptions);
+
+    CPLFree(pszProjection);
+    CSLDestroy(papszTransformerOptions);
+    return pTransformArg;
+}
+
+/************************************************************************/
+/*                 GDALRasterizeLayersMultiThreaded()                   */
+/*                                                                      */
+/*      Read the geometries of each layer by batches whose memory is    */
+/*      bounded, and burn each batch with                               */
+/*      GDALRasterizeGeometriesMultiThreaded().                         */
+/************************************************************************/
+
+static CPLErr GDALRasterizeLayersMultiThreaded(
+    GDALDataset *poDS, int nBandCount, const int *panBandList,
+    GDALDataType eType, int nLayerCount, OGRLayerH *pahLayers,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg,
+    const double *padfLayerBurnValues, const char *pszBurnAttribute,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, const char *pszYChunkSize, int nNumThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    // Maximum memory used by the geometries of a batch. Each batch requires
+    // a pass over the raster, so a layer that does not fit in it is burnt
+    // in several passes, instead of being fully loaded in memory.
+    GIntBig nMaxBatchMemory = std::max<GIntBig>(
+        10 * 1024 * 1024, GDALGetCacheMax64() / 4);
+    // The test chunk size is a number of bytes here.
+    nMaxBatchMemory = GDALGetTestChunkSize(
+        nMaxBatchMemory, std::numeric_limits<GIntBig>::max());
+
+    CPLErr eErr = CE_None;
+    for (int iLayer = 0; iLayer < nLayerCount && eErr == CE_None; iLayer++)
+    {
+        OGRLayer *poLayer = reinterpret_cast<OGRLayer *>(pahLayers[iLayer]);
+
+        if (!poLayer)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Layer element number %d is NULL, skipping.", iLayer);
+            continue;
+        }
+
+        const GIntBig nFeatureCount = poLayer->GetFeatureCount(FALSE);
+        if (nFeatureCount == 0)
+            continue;
+
+        int iBurnField = -1;
+        if (pszBurnAttribute)
+        {
+            iBurnField =
+                poLayer->GetLayerDefn()->GetFieldIndex(pszBurnAttribute);
+            if (iBurnField == -1)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Failed to find field %s on layer %s, skipping.",
+                         pszBurnAttribute, poLayer->GetLayerDefn()->GetName());
+                continue;
+            }
+        }
+
+        bool bNeedToFreeTransformer = false;
+        GDALTransformerFunc pfnLayerTransformer = pfnTransformer;
+        void *pLayerTransformArg = pTransformArg;
+        if (pfnLayerTransformer == nullptr)
+        {
+            bNeedToFreeTransformer = true;
+            pLayerTransformArg =
+                GDALCreateRasterizeLayerTransformer(poDS, poLayer);
+            pfnLayerTransformer = GDALGenImgProjTransform;
+            if (pLayerTransformArg == nullptr)
+                return CE_Failure;
+        }
+
+        const double dfLayerProgressStart =
+            static_cast<double>(iLayer) / nLayerCount;
+        const double dfLayerProgressEnd =
+            static_cast<double>(iLayer + 1) / nLayerCount;
+        const auto GetLayerProgress = [&](GIntBig nFeaturesRead, bool bEOF)
+        {
+            if (bEOF)
+                return dfLayerProgressEnd;
+            if (nFeatureCount < 0)
+                return dfLayerProgressStart;
+            return dfLayerProgressStart +
+                   (dfLayerProgressEnd - dfLayerProgressStart) *
+                       std::min(1.0, static_cast<double>(nFeaturesRead) /
+                                         static_cast<double>(nFeatureCount));
+        };
+
+        std::vector<std::unique_ptr<OGRGeometry>> apoGeometries;
+        std::vector<OGRGeometryH> ahGeometries;
+        std::vector<double> adfGeomBurnValues;
+        GIntBig nFeaturesRead = 0;
+        bool bEOF = false;
+        poLayer->ResetReading();
+        while (!bEOF && eErr == CE_None)
+        {
+            /* ------------------------------------------------------------ */
+            /*      Read a batch of geometries and their burn values.       */
+            /* ------------------------------------------------------------ */
+            const double dfBatchProgressStart =
+                GetLayerProgress(nFeaturesRead, false);
+            apoGeometries.clear();
+            ahGeometries.clear();
+            adfGeomBurnValues.clear();
+            GIntBig nBatchMemory = 0;
+            try
+            {
+                while (nBatchMemory < nMaxBatchMemory)
+                {
+                    auto poFeat = std::unique_ptr<OGRFeature>(
+                        poLayer->GetNextFeature());
+                    if (!poFeat)
+                    {
+                        bEOF = true;
+                        break;
+                    }
+                    ++nFeaturesRead;
+                    std::unique_ptr<OGRGeometry> poGeom(
+                        poFeat->StealGeometry());
+                    if (!poGeom)
+                        continue;
+                    nBatchMemory += poGeom->WkbSize();
+                    apoGeometries.push_back(std::move(poGeom));
+                    ahGeometries.push_back(
+                        OGRGeometry::ToHandle(apoGeometries.back().get()));
+                    for (int iBand = 0; iBand < nBandCount; iBand++)
+                    {
+                        adfGeomBurnValues.push_back(
+                            pszBurnAttribute
+                                ? poFeat->GetFieldAsDouble(iBurnField)
+                                : padfLayerBurnValues[iLayer * nBandCount +
+                                                      iBand]);
+                    }
+                }
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALRasterizeLayers()");
+                eErr = CE_Failure;
+                break;
+            }
+            if (ahGeometries.empty())
+                continue;
+
+            /* ------------------------------------------------------------ */
+            /*      Burn it.                                                */
+            /* ------------------------------------------------------------ */
+            void *pScaledProgressArg = GDALCreateScaledProgress(
+                dfBatchProgressStart, GetLayerProgress(nFeaturesRead, bEOF),
+                pfnProgress, pProgressArg);
+            eErr = GDALRasterizeGeometriesMultiThreaded(
+                poDS, nBandCount, panBandList, eType,
+                static_cast<int>(ahGeometries.size()), ahGeometries.data(),
+                pfnLayerTransformer, pLayerTransformArg, GDT_Float64,
+                adfGeomBurnValues.data(), nullptr, bAllTouched,
+                eBurnValueSource, eMergeAlg, pszYChunkSize, nNumThreads,
+                GDALScaledProgress, pScaledProgressArg);
+            GDALDestroyScaledProgress(pScaledProgressArg);
+        }
+        poLayer->ResetReading();
+
+        if (bNeedToFreeTransformer)
+            GDALDestroyTransformer(pLayerTransformArg);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
@@ -890,6 +1582,12 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"NUM_THREADS" (GDAL >= 3.10): Number of worker threads (integer or
+ * ALL_CPUS). When greater than 1, chunks of lines are processed
+ * concurrently, each one burning only the geometries touching it, in the
+ * same order as with a single thread. Not used in OPTIM=VECTOR mode.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option,
+ * or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1070,6 +1768,27 @@ static CPLErr GDALRasterizeGeometriesInternal(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Multi-threaded processing, in raster optimization mode.  In     */
+    /*      auto mode, it is also preferred over the vector optimization,   */
+    /*      as each chunk only processes the geometries touching it.        */
+    /* -------------------------------------------------------------------- */
+    const int nNumThreads = GDALRasterizeGetNumThreads(papszOptions);
+    if (nNumThreads > 1 && eOptim != GRO_Vector)
+    {
+        const CPLErr eErr = GDALRasterizeGeometriesMultiThreaded(
+            poDS, nBandCount, panBandList,
+            GDALGetNonComplexDataType(poBand->GetRasterDataType()), nGeomCount,
+            pahGeometries, pfnTransformer, pTransformArg, eBurnValueType,
+            padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+            eBurnValueSource, eMergeAlg,
+            CSLFetchNameValue(papszOptions, "CHUNKYSIZE"), nNumThreads,
+            pfnProgress, pProgressArg);
+        if (bNeedToFreeTransformer)
+            GDALDestroyTransformer(pTransformArg);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Choice of optimisation in auto mode. Use vector optim :         */
     /*      1) if output is tiled                                           */
@@ -1444,6 +2163,12 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS" (GDAL >= 3.10): Number of worker threads (integer or
+ * ALL_CPUS). When greater than 1, the geometries of each layer are read by
+ * batches, whose memory is limited to a quarter of GDAL_CACHEMAX (at least
+ * 10 MB), and the chunks of lines touched by each batch are processed
+ * concurrently. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1490,15 +2215,25 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
         return CE_Failure;
     }
 
+    const char *pszYChunkSize = CSLFetchNameValue(papszOptions, "CHUNKYSIZE");
+    const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
+    const GDALDataType eType = poBand->GetRasterDataType();
+
+    const int nNumThreads = GDALRasterizeGetNumThreads(papszOptions);
+    if (nNumThreads > 1)
+    {
+        return GDALRasterizeLayersMultiThreaded(
+            poDS, nBandCount, panBandList, eType, nLayerCount, pahLayers,
+            pfnTransformer, pTransformArg, padfLayerBurnValues,
+            pszBurnAttribute, bAllTouched, eBurnValueSource, eMergeAlg,
+            pszYChunkSize, nNumThreads, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Establish a chunksize to operate on.  The larger the chunk      */
     /*      size the less times we need to make a pass through all the      */
     /*      shapes.                                                         */
     /* -------------------------------------------------------------------- */
-    const char *pszYChunkSize = CSLFetchNameValue(papszOptions, "CHUNKYSIZE");
-
-    const GDALDataType eType = poBand->GetRasterDataType();
-
     const int nScanlineBytes =
         nBandCount * poDS->GetRasterXSize() * GDALGetDataTypeSizeBytes(eType);
 
@@ -1549,7 +2284,6 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
     /*      geometries.                                                     */
     /* ==================================================================== */
     CPLErr eErr = CE_None;
-    const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
 
     pfnProgress(0.0, nullptr, pProgressArg);
 
@@ -1605,41 +2339,9 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
 
         if (pfnTransformer == nullptr)
         {
-            char *pszProjection = nullptr;
             bNeedToFreeTransformer = true;
-
-            OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
-            if (!poSRS)
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Failed to fetch spatial reference on layer %s "
-                         "to build transformer, assuming matching coordinate "
-                         "systems.",
-                         poLayer->GetLayerDefn()->GetName());
-            }
-            else
-            {
-                poSRS->exportToWkt(&pszProjection);
-            }
-
-            char **papszTransformerOptions = nullptr;
-            if (pszProjection != nullptr)
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "SRC_SRS", pszProjection);
-            double adfGeoTransform[6] = {};
-            if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
-                poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
-            {
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
-            }
-
-            pTransformArg = GDALCreateGenImgProjTransformer2(
-                nullptr, hDS, papszTransformerOptions);
+            pTransformArg = GDALCreateRasterizeLayerTransformer(poDS, poLayer);
             pfnTransformer = GDALGenImgProjTransform;
-
-            CPLFree(pszProjection);
-            CSLDestroy(papszTransformerOptions);
             if (pTransformArg == nullptr)
             {
                 CPLFree(pabyChunkBuf);
@@ -34,6 +34,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <utility>
@@ -41,9 +45,12 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -142,6 +149,803 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                       GPResolveBigNeighbours()                       */
+/*                                                                      */
+/*      If our biggest neighbour is still smaller than the              */
+/*      threshold, then try tracking to that polygons biggest           */
+/*      neighbour, and so forth.                                        */
+/************************************************************************/
+
+static void GPResolveBigNeighbours(int nPolys, const GInt32 *panPolyIdMap,
+                                   const std::int64_t *panPolyValue,
+                                   const std::vector<int> &anPolySizes,
+                                   int nSizeThreshold,
+                                   std::vector<int> &anBigNeighbour)
+{
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (int iPoly = 0; iPoly < nPolys; iPoly++)
+    {
+        if (panPolyIdMap[iPoly] != iPoly)
+            continue;
+
+        // Ignore nodata polygons.
+        if (panPolyValue[iPoly] == GP_NODATA_MARKER)
+            continue;
+
+        // Don't try to merge polygons larger than the threshold.
+        if (anPolySizes[iPoly] >= nSizeThreshold)
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if (anBigNeighbour[iPoly] == -1)
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        // Walk through our neighbours until we find a polygon large enough.
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while (true)
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if (iFinalId < 0)
+            {
+                break;
+            }
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if (!bFoundBigEnoughPoly)
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        // Map the whole intermediate chain to it.
+        int iPolyCur = iPoly;
+        while (anBigNeighbour[iPolyCur] != iFinalId)
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+}
+
+namespace
+{
+// Largest neighbour of a polygon, and position in the raster scan at which
+// it was first found, to select the first one found among neighbours of the
+// same size, as the single-threaded implementation does.
+struct GDALSieveNeighbour
+{
+    int iPoly = -1;
+    GIntBig nScanPos = 0;
+};
+
+struct GDALSieveStripe
+{
+    int nYOff = 0;
+    int nYSize = 0;
+
+    // Index of the first polygon of the stripe in the global tables, and
+    // number of polygons of the stripe.
+    int nFirstPoly = 0;
+    int nPolys = 0;
+
+    // Maps polygon ids assigned by the enumerator to polygon indices in
+    // the stripe. Fragments of a polygon share the same index.
+    std::vector<int> anIdToPoly{};
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anPolyValues{};
+
+    // Polygon indices (in the stripe) and values of the first and last
+    // lines, to resolve polygons connected across stripes.
+    std::vector<int> anFirstLinePoly{};
+    std::vector<int> anLastLinePoly{};
+    std::vector<std::int64_t> anFirstLineVal{};
+    std::vector<std::int64_t> anLastLineVal{};
+
+    // Largest neighbours found by the second pass, for the polygons of
+    // the stripe, and for the polygons of each pixel of the last line of
+    // the previous stripe.
+    std::vector<GDALSieveNeighbour> asBigNeighbours{};
+    std::vector<GDALSieveNeighbour> asAboveBigNeighbours{};
+};
+
+struct GDALSieveMTContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hDstBand = nullptr;
+    int nXSize = 0;
+    int nConnectedness = 4;
+
+    std::vector<GDALSieveStripe> asStripes{};
+
+    // Global tables, indexed by polygon index.
+    std::vector<GInt32> anMergedPoly{};
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anPolyValues{};
+    std::vector<int> anBigNeighbour{};
+    std::vector<GIntBig> anBigNeighbourScanPos{};
+
+    // Protects band accesses and eErr.
+    std::mutex oMutex{};
+    CPLErr eErr = CE_None;
+
+    template <class F>
+    bool EnumerateStripe(const GDALSieveStripe &sStripe,
+                         GDALRasterPolygonEnumerator &oEnum, bool bKeepValues,
+                         F fnProcessLine);
+
+    bool FirstPass(GDALSieveStripe &sStripe);
+    bool SecondPass(GDALSieveStripe &sStripe);
+    bool ThirdPass(GDALSieveStripe &sStripe);
+
+    void UpdateBigNeighbour(GDALSieveNeighbour &sNeighbour, int iPoly,
+                            GIntBig nScanPos) const
+    {
+        if (sNeighbour.iPoly == -1 ||
+            anPolySizes[sNeighbour.iPoly] < anPolySizes[iPoly])
+        {
+            sNeighbour.iPoly = iPoly;
+            sNeighbour.nScanPos = nScanPos;
+        }
+    }
+};
+
+struct GDALSieveMTJob
+{
+    GDALSieveMTContext *poContext = nullptr;
+    GDALSieveStripe *psStripe = nullptr;
+    bool (GDALSieveMTContext::*pfnPass)(GDALSieveStripe &) = nullptr;
+
+    static void Process(void *pData)
+    {
+        auto psJob = static_cast<GDALSieveMTJob *>(pData);
+        auto poContext = psJob->poContext;
+        {
+            std::lock_guard<std::mutex> oLock(poContext->oMutex);
+            if (poContext->eErr != CE_None)
+                return;
+        }
+        if (!(poContext->*(psJob->pfnPass))(*(psJob->psStripe)))
+        {
+            std::lock_guard<std::mutex> oLock(poContext->oMutex);
+            poContext->eErr = CE_Failure;
+        }
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                          EnumerateStripe()                           */
+/*                                                                      */
+/*      Enumerate the polygons of a stripe, and call fnProcessLine(iY,  */
+/*      panThisLineVal, panThisLineWriteVal, panThisLineId,             */
+/*      panLastLineId) for each line. panLastLineId is NULL for the     */
+/*      first line of the stripe, and panThisLineWriteVal, holding the  */
+/*      unmasked values, is NULL if bKeepValues is false.               */
+/************************************************************************/
+
+template <class F>
+bool GDALSieveMTContext::EnumerateStripe(const GDALSieveStripe &sStripe,
+                                         GDALRasterPolygonEnumerator &oEnum,
+                                         bool bKeepValues, F fnProcessLine)
+{
+    std::vector<std::int64_t> anLastLineVal, anThisLineVal, anThisLineWriteVal;
+    std::vector<GInt32> anLastLineId, anThisLineId;
+    std::vector<GByte> abyMaskLine;
+    try
+    {
+        anLastLineVal.resize(nXSize);
+        anThisLineVal.resize(nXSize);
+        anLastLineId.resize(nXSize);
+        anThisLineId.resize(nXSize);
+        if (bKeepValues)
+            anThisLineWriteVal.resize(nXSize);
+        if (hMaskBand)
+            abyMaskLine.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return false;
+    }
+
+    for (int iY = sStripe.nYOff; iY < sStripe.nYOff + sStripe.nYSize; iY++)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            CPLErr eErrRead =
+                GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
+                             anThisLineVal.data(), nXSize, 1, GDT_Int64, 0, 0);
+            if (eErrRead == CE_None && bKeepValues)
+                anThisLineWriteVal = anThisLineVal;
+            if (eErrRead == CE_None && hMaskBand != nullptr)
+                eErrRead = GPMaskImageData(hMaskBand, abyMaskLine.data(), iY,
+                                           nXSize, anThisLineVal.data());
+            if (eErrRead != CE_None)
+                return false;
+        }
+
+        const bool bFirstLine = iY == sStripe.nYOff;
+        if (!oEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                               anThisLineVal.data(),
+                               bFirstLine ? nullptr : anLastLineId.data(),
+                               anThisLineId.data(), nXSize))
+            return false;
+
+        if (!fnProcessLine(iY, anThisLineVal.data(),
+                           bKeepValues ? anThisLineWriteVal.data() : nullptr,
+                           anThisLineId.data(),
+                           bFirstLine ? nullptr : anLastLineId.data()))
+            return false;
+
+        std::swap(anLastLineVal, anThisLineVal);
+        std::swap(anLastLineId, anThisLineId);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                             FirstPass()                              */
+/*                                                                      */
+/*      Enumerate the polygons of the stripe, compute their sizes and   */
+/*      keep the first and last lines.                                  */
+/************************************************************************/
+
+bool GDALSieveMTContext::FirstPass(GDALSieveStripe &sStripe)
+{
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    std::vector<int> anIdSizes;
+    const int nLastLine = sStripe.nYOff + sStripe.nYSize - 1;
+    try
+    {
+        sStripe.anFirstLinePoly.resize(nXSize);
+        sStripe.anLastLinePoly.resize(nXSize);
+        sStripe.anFirstLineVal.resize(nXSize);
+        sStripe.anLastLineVal.resize(nXSize);
+
+        if (!EnumerateStripe(
+                sStripe, oEnum, false,
+                [this, &sStripe, &oEnum, &anIdSizes,
+                 nLastLine](int iY, const std::int64_t *panThisLineVal,
+                            const std::int64_t *, const GInt32 *panThisLineId,
+                            const GInt32 *)
+                {
+                    if (iY == sStripe.nYOff)
+                    {
+                        std::copy(panThisLineVal, panThisLineVal + nXSize,
+                                  sStripe.anFirstLineVal.begin());
+                        std::copy(panThisLineId, panThisLineId + nXSize,
+                                  sStripe.anFirstLinePoly.begin());
+                    }
+                    if (iY == nLastLine)
+                    {
+                        std::copy(panThisLineVal, panThisLineVal + nXSize,
+                                  sStripe.anLastLineVal.begin());
+                        std::copy(panThisLineId, panThisLineId + nXSize,
+                                  sStripe.anLastLinePoly.begin());
+                    }
+
+                    // Accumulate polygon sizes.
+                    if (oEnum.nNextPolygonId >
+                        static_cast<int>(anIdSizes.size()))
+                        anIdSizes.resize(oEnum.nNextPolygonId);
+                    for (int iX = 0; iX < nXSize; iX++)
+                    {
+                        const int iId = panThisLineId[iX];
+                        if (iId >= 0 && anIdSizes[iId] < MY_MAX_INT)
+                            anIdSizes[iId] += 1;
+                    }
+                    return true;
+                }))
+        {
+            return false;
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Assign consecutive indices to the polygons of the stripe,   */
+        /*      and push the sizes of merged polygon fragments into them.   */
+        /* ---------------------------------------------------------------- */
+        oEnum.CompleteMerges();
+        sStripe.anIdToPoly.resize(oEnum.nNextPolygonId);
+        for (int iId = 0; iId < oEnum.nNextPolygonId; iId++)
+        {
+            if (oEnum.panPolyIdMap[iId] == iId)
+            {
+                sStripe.anIdToPoly[iId] =
+                    static_cast<int>(sStripe.anPolyValues.size());
+                sStripe.anPolyValues.push_back(oEnum.panPolyValue[iId]);
+                sStripe.anPolySizes.push_back(0);
+            }
+        }
+        for (int iId = 0; iId < oEnum.nNextPolygonId; iId++)
+        {
+            const int iPoly = sStripe.anIdToPoly[oEnum.panPolyIdMap[iId]];
+            sStripe.anIdToPoly[iId] = iPoly;
+            sStripe.anPolySizes[iPoly] = static_cast<int>(std::min<GIntBig>(
+                MY_MAX_INT,
+                static_cast<GIntBig>(sStripe.anPolySizes[iPoly]) +
+                    anIdSizes[iId]));
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return false;
+    }
+
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        if (sStripe.anFirstLinePoly[iX] >= 0)
+            sStripe.anFirstLinePoly[iX] =
+                sStripe.anIdToPoly[sStripe.anFirstLinePoly[iX]];
+        if (sStripe.anLastLinePoly[iX] >= 0)
+            sStripe.anLastLinePoly[iX] =
+                sStripe.anIdToPoly[sStripe.anLastLinePoly[iX]];
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                             SecondPass()                             */
+/*                                                                      */
+/*      Identify the largest neighbour of each polygon of the stripe,   */
+/*      as CompareNeighbour() does in the single-threaded               */
+/*      implementation.                                                 */
+/************************************************************************/
+
+bool GDALSieveMTContext::SecondPass(GDALSieveStripe &sStripe)
+{
+    // Polygon indices (in the stripe) and merged polygons of the last and
+    // current lines. For the first line, the last line is the last line of
+    // the previous stripe.
+    std::vector<int> anLastLinePoly, anThisLinePoly;
+    std::vector<int> anLastLineMerged, anThisLineMerged;
+    try
+    {
+        anLastLinePoly.resize(nXSize, -1);
+        anThisLinePoly.resize(nXSize);
+        anLastLineMerged.resize(nXSize, -1);
+        anThisLineMerged.resize(nXSize);
+        sStripe.asBigNeighbours.resize(sStripe.nPolys);
+        if (sStripe.nYOff > 0)
+        {
+            const auto &sAbove = *(&sStripe - 1);
+            sStripe.asAboveBigNeighbours.resize(nXSize);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iPoly = sAbove.anLastLinePoly[iX];
+                if (iPoly >= 0)
+                    anLastLineMerged[iX] =
+                        anMergedPoly[sAbove.nFirstPoly + iPoly];
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return false;
+    }
+
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    return EnumerateStripe(
+        sStripe, oEnum, false,
+        [this, &sStripe, &anLastLinePoly, &anThisLinePoly, &anLastLineMerged,
+         &anThisLineMerged](int iY, const std::int64_t *, const std::int64_t *,
+                            const GInt32 *panThisLineId, const GInt32 *)
+        {
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iId = panThisLineId[iX];
+                anThisLinePoly[iX] = iId < 0 ? -1 : sStripe.anIdToPoly[iId];
+                anThisLineMerged[iX] =
+                    iId < 0 ? -1
+                            : anMergedPoly[sStripe.nFirstPoly +
+                                           anThisLinePoly[iX]];
+            }
+
+            // Same as CompareNeighbour(), on the largest neighbours of the
+            // stripe.
+            const bool bFirstLine = iY == sStripe.nYOff;
+            const auto Compare = [this, &sStripe, &anLastLinePoly,
+                                  &anThisLinePoly, &anLastLineMerged,
+                                  &anThisLineMerged,
+                                  bFirstLine](int iX, int iOtherX,
+                                              bool bOtherAbove,
+                                              GIntBig nScanPos)
+            {
+                const int iMerged1 = anThisLineMerged[iX];
+                const int iMerged2 = bOtherAbove ? anLastLineMerged[iOtherX]
+                                                 : anThisLineMerged[iOtherX];
+                if (iMerged1 < 0 || iMerged2 < 0 || iMerged1 == iMerged2)
+                    return;
+
+                UpdateBigNeighbour(
+                    sStripe.asBigNeighbours[anThisLinePoly[iX]], iMerged2,
+                    nScanPos);
+                if (!bOtherAbove)
+                    UpdateBigNeighbour(
+                        sStripe.asBigNeighbours[anThisLinePoly[iOtherX]],
+                        iMerged1, nScanPos);
+                else if (bFirstLine)
+                    UpdateBigNeighbour(sStripe.asAboveBigNeighbours[iOtherX],
+                                       iMerged1, nScanPos);
+                else
+                    UpdateBigNeighbour(
+                        sStripe.asBigNeighbours[anLastLinePoly[iOtherX]],
+                        iMerged1, nScanPos);
+            };
+
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GIntBig nScanPos =
+                    (static_cast<GIntBig>(iY) * nXSize + iX) * 4;
+                if (iY > 0)
+                {
+                    Compare(iX, iX, true, nScanPos);
+
+                    if (iX > 0 && nConnectedness == 8)
+                        Compare(iX, iX - 1, true, nScanPos + 1);
+
+                    if (iX < nXSize - 1 && nConnectedness == 8)
+                        Compare(iX, iX + 1, true, nScanPos + 2);
+                }
+
+                if (iX > 0)
+                    Compare(iX, iX - 1, false, nScanPos + 3);
+            }
+
+            std::swap(anLastLinePoly, anThisLinePoly);
+            std::swap(anLastLineMerged, anThisLineMerged);
+            return true;
+        });
+}
+
+/************************************************************************/
+/*                             ThirdPass()                              */
+/*                                                                      */
+/*      Apply the merges to the lines of the stripe.                    */
+/************************************************************************/
+
+bool GDALSieveMTContext::ThirdPass(GDALSieveStripe &sStripe)
+{
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    return EnumerateStripe(
+        sStripe, oEnum, true,
+        [this, &sStripe](int iY, const std::int64_t *,
+                         std::int64_t *panThisLineWriteVal,
+                         const GInt32 *panThisLineId, const GInt32 *)
+        {
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iId = panThisLineId[iX];
+                if (iId >= 0)
+                {
+                    const int iMerged =
+                        anMergedPoly[sStripe.nFirstPoly +
+                                     sStripe.anIdToPoly[iId]];
+                    if (anBigNeighbour[iMerged] != -1)
+                        panThisLineWriteVal[iX] =
+                            anPolyValues[anBigNeighbour[iMerged]];
+                }
+            }
+
+            std::lock_guard<std::mutex> oLock(oMutex);
+            return GDALRasterIO(hDstBand, GF_Write, 0, iY, nXSize, 1,
+                                panThisLineWriteVal, nXSize, 1, GDT_Int64, 0,
+                                0) == CE_None;
+        });
+}
+
+/************************************************************************/
+/*                      GDALSieveFilterMultiThreaded()                  */
+/*                                                                      */
+/*      Multi-threaded implementation of GDALSieveFilter(). The raster   */
+/*      is split in stripes of lines, whose polygons are enumerated     */
+/*      independently by worker threads. Polygons of a stripe get       */
+/*      consecutive indices in compact global tables, and those         */
+/*      touching at the border between stripes are merged with an      */
+/*      union-find. The same three passes as the single-threaded        */
+/*      implementation are then made, each stripe re-enumerating its    */
+/*      polygons to map them to the global tables. As the largest       */
+/*      neighbours found by each stripe are merged in stripe order,     */
+/*      the result is the same.                                         */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    int nNumThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    int nLinesPerStripe =
+        std::max(1, (nYSize + 4 * nNumThreads - 1) / (4 * nNumThreads));
+    nLinesPerStripe =
+        static_cast<int>(GDALGetTestChunkSize(nLinesPerStripe, nYSize));
+
+    GDALSieveMTContext oContext;
+    oContext.hSrcBand = hSrcBand;
+    oContext.hMaskBand = hMaskBand;
+    oContext.hDstBand = hDstBand;
+    oContext.nXSize = nXSize;
+    oContext.nConnectedness = nConnectedness;
+    for (int nYOff = 0; nYOff < nYSize; nYOff += nLinesPerStripe)
+    {
+        GDALSieveStripe sStripe;
+        sStripe.nYOff = nYOff;
+        sStripe.nYSize = std::min(nLinesPerStripe, nYSize - nYOff);
+        oContext.asStripes.emplace_back(std::move(sStripe));
+    }
+    const int nStripes = static_cast<int>(oContext.asStripes.size());
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    std::vector<GDALSieveMTJob> asJobs(nStripes);
+    const auto RunPass =
+        [&](bool (GDALSieveMTContext::*pfnPass)(GDALSieveStripe &),
+            double dfProgressStart, double dfProgressEnd)
+    {
+        for (int i = 0; i < nStripes; i++)
+        {
+            asJobs[i].poContext = &oContext;
+            asJobs[i].psStripe = &oContext.asStripes[i];
+            asJobs[i].pfnPass = pfnPass;
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALSieveMTJob::Process, &asJobs[i]);
+            else
+                GDALSieveMTJob::Process(&asJobs[i]);
+        }
+        bool bInterrupted = false;
+        for (int nRemaining = nStripes - 1; nRemaining >= 0; nRemaining--)
+        {
+            if (poJobQueue)
+                poJobQueue->WaitCompletion(nRemaining);
+            if (!bInterrupted &&
+                !pfnProgress(dfProgressStart +
+                                 (dfProgressEnd - dfProgressStart) *
+                                     (nStripes - nRemaining) / nStripes,
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bInterrupted = true;
+                std::lock_guard<std::mutex> oLock(oContext.oMutex);
+                oContext.eErr = CE_Failure;
+            }
+        }
+        return oContext.eErr;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: enumerate the polygons of each stripe.              */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = RunPass(&GDALSieveMTContext::FirstPass, 0.0, 0.2);
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the global tables, merging polygons touching at the       */
+    /*      borders between stripes.                                        */
+    /* -------------------------------------------------------------------- */
+    GIntBig nPolys = 0;
+    for (auto &sStripe : oContext.asStripes)
+    {
+        sStripe.nFirstPoly = static_cast<int>(nPolys);
+        sStripe.nPolys = static_cast<int>(sStripe.anPolyValues.size());
+        nPolys += sStripe.nPolys;
+        if (nPolys > std::numeric_limits<int>::max())
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "GDALSieveFilter(): too many polygons");
+            return CE_Failure;
+        }
+    }
+
+    auto &anMergedPoly = oContext.anMergedPoly;
+    auto &anPolySizes = oContext.anPolySizes;
+    auto &anPolyValues = oContext.anPolyValues;
+    auto &anBigNeighbour = oContext.anBigNeighbour;
+    try
+    {
+        anMergedPoly.resize(static_cast<size_t>(nPolys));
+        anPolySizes.resize(static_cast<size_t>(nPolys));
+        anPolyValues.resize(static_cast<size_t>(nPolys));
+        anBigNeighbour.resize(static_cast<size_t>(nPolys), -1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+
+    const auto Find = [&anMergedPoly](int iPoly)
+    {
+        while (anMergedPoly[iPoly] != iPoly)
+        {
+            anMergedPoly[iPoly] = anMergedPoly[anMergedPoly[iPoly]];
+            iPoly = anMergedPoly[iPoly];
+        }
+        return iPoly;
+    };
+    const auto Union = [&Find, &anMergedPoly](int iPoly1, int iPoly2)
+    {
+        iPoly1 = Find(iPoly1);
+        iPoly2 = Find(iPoly2);
+        if (iPoly1 < iPoly2)
+            anMergedPoly[iPoly2] = iPoly1;
+        else if (iPoly2 < iPoly1)
+            anMergedPoly[iPoly1] = iPoly2;
+    };
+
+    for (int iPoly = 0; iPoly < static_cast<int>(nPolys); iPoly++)
+        anMergedPoly[iPoly] = iPoly;
+
+    for (int iStripe = 0; iStripe < nStripes; iStripe++)
+    {
+        auto &sStripe = oContext.asStripes[iStripe];
+        std::copy(sStripe.anPolyValues.begin(), sStripe.anPolyValues.end(),
+                  anPolyValues.begin() + sStripe.nFirstPoly);
+        sStripe.anPolyValues = std::vector<std::int64_t>();
+
+        if (iStripe == 0)
+            continue;
+        const auto &sAbove = oContext.asStripes[iStripe - 1];
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (sStripe.anFirstLinePoly[iX] < 0)
+                continue;
+            const int iPoly = sStripe.nFirstPoly + sStripe.anFirstLinePoly[iX];
+            const std::int64_t nVal = sStripe.anFirstLineVal[iX];
+            for (int iAboveX = std::max(0, iX - 1);
+                 iAboveX <= std::min(nXSize - 1, iX + 1); iAboveX++)
+            {
+                if ((iAboveX == iX || nConnectedness == 8) &&
+                    sAbove.anLastLinePoly[iAboveX] >= 0 &&
+                    sAbove.anLastLineVal[iAboveX] == nVal)
+                {
+                    Union(iPoly,
+                          sAbove.nFirstPoly + sAbove.anLastLinePoly[iAboveX]);
+                }
+            }
+        }
+    }
+
+    for (auto &sStripe : oContext.asStripes)
+    {
+        sStripe.anFirstLinePoly = std::vector<int>();
+        sStripe.anFirstLineVal = std::vector<std::int64_t>();
+        sStripe.anLastLineVal = std::vector<std::int64_t>();
+    }
+
+    for (int iPoly = 0; iPoly < static_cast<int>(nPolys); iPoly++)
+        anMergedPoly[iPoly] = Find(iPoly);
+
+    for (auto &sStripe : oContext.asStripes)
+    {
+        for (int i = 0; i < static_cast<int>(sStripe.anPolySizes.size()); i++)
+        {
+            int &nSize = anPolySizes[anMergedPoly[sStripe.nFirstPoly + i]];
+            nSize = static_cast<int>(
+                std::min<GIntBig>(MY_MAX_INT, static_cast<GIntBig>(nSize) +
+                                                  sStripe.anPolySizes[i]));
+        }
+        sStripe.anPolySizes = std::vector<int>();
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: identify the largest neighbour of each polygon.    */
+    /*      Merging the results in stripe order gives the same result as    */
+    /*      a single scan of the raster.                                    */
+    /* -------------------------------------------------------------------- */
+    eErr = RunPass(&GDALSieveMTContext::SecondPass, 0.2, 0.4);
+    if (eErr != CE_None)
+        return eErr;
+
+    auto &anBigNeighbourScanPos = oContext.anBigNeighbourScanPos;
+    try
+    {
+        anBigNeighbourScanPos.resize(static_cast<size_t>(nPolys));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+    const auto MergeBigNeighbour =
+        [&](int iMerged, const GDALSieveNeighbour &sNeighbour)
+    {
+        if (sNeighbour.iPoly < 0)
+            return;
+        int &iBigNeighbour = anBigNeighbour[iMerged];
+        if (iBigNeighbour == -1 ||
+            anPolySizes[iBigNeighbour] < anPolySizes[sNeighbour.iPoly] ||
+            (anPolySizes[iBigNeighbour] == anPolySizes[sNeighbour.iPoly] &&
+             sNeighbour.nScanPos < anBigNeighbourScanPos[iMerged]))
+        {
+            iBigNeighbour = sNeighbour.iPoly;
+            anBigNeighbourScanPos[iMerged] = sNeighbour.nScanPos;
+        }
+    };
+    for (int iStripe = 0; iStripe < nStripes; iStripe++)
+    {
+        auto &sStripe = oContext.asStripes[iStripe];
+        for (int i = 0; i < static_cast<int>(sStripe.asBigNeighbours.size());
+             i++)
+        {
+            MergeBigNeighbour(anMergedPoly[sStripe.nFirstPoly + i],
+                              sStripe.asBigNeighbours[i]);
+        }
+        for (int iX = 0;
+             iX < static_cast<int>(sStripe.asAboveBigNeighbours.size()); iX++)
+        {
+            const auto &sAbove = oContext.asStripes[iStripe - 1];
+            const int iPoly = sAbove.anLastLinePoly[iX];
+            if (iPoly >= 0)
+                MergeBigNeighbour(anMergedPoly[sAbove.nFirstPoly + iPoly],
+                                  sStripe.asAboveBigNeighbours[iX]);
+        }
+    }
+    for (auto &sStripe : oContext.asStripes)
+    {
+        sStripe.asBigNeighbours = std::vector<GDALSieveNeighbour>();
+        sStripe.asAboveBigNeighbours = std::vector<GDALSieveNeighbour>();
+        sStripe.anLastLinePoly = std::vector<int>();
+    }
+    anBigNeighbourScanPos = std::vector<GIntBig>();
+
+    GPResolveBigNeighbours(static_cast<int>(nPolys), anMergedPoly.data(),
+                           anPolyValues.data(), anPolySizes, nSizeThreshold,
+                           anBigNeighbour);
+
+    /* -------------------------------------------------------------------- */
+    /*      Third pass: apply the merges.                                   */
+    /* -------------------------------------------------------------------- */
+    return RunPass(&GDALSieveMTContext::ThirdPass, 0.4, 1.0);
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -183,8 +987,15 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.  The
+ * following options are supported:
+ * <ul>
+ * <li>NUM_THREADS=n/ALL_CPUS (GDAL >= 3.10): number of worker threads.
+ * When greater than 1, the raster is split in stripes of lines processed
+ * in parallel, and whose polygons are merged at the borders between
+ * stripes. The result is the same as with a single thread. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -196,7 +1007,7 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
                                    int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -206,6 +1017,20 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    int nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    nNumThreads = std::max(1, std::min(128, nNumThreads));
+    if (nNumThreads > 1)
+    {
+        return GDALSieveFilterMultiThreaded(hSrcBand, hMaskBand, hDstBand,
+                                            nSizeThreshold, nConnectedness,
+                                            nNumThreads, pfnProgress,
+                                            pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -453,85 +1278,11 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      If our biggest neighbour is still smaller than the              */
-    /*      threshold, then try tracking to that polygons biggest           */
-    /*      neighbour, and so forth.                                        */
+    /*      Find the polygon each small polygon should be merged into.      */
     /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
-    }
-
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
+    GPResolveBigNeighbours(static_cast<int>(anPolySizes.size()),
+                           oFirstEnum.panPolyIdMap, oFirstEnum.panPolyValue,
+                           anPolySizes, nSizeThreshold, anBigNeighbour);
 
     /* ==================================================================== */
     /*      Make a third pass over the image, actually applying the         */
@@ -70,6 +70,20 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start the generation at line lineIdx, previousLine being the content of
+    // line lineIdx - 1 (or nullptr if unknown). This allows processing
+    // horizontal stripes of a raster independently, with the same
+    // coordinates as when feeding all its lines.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine != nullptr)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
   private:
     size_t width_;
     size_t height_;
@@ -35,9 +35,12 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -50,6 +53,8 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -81,6 +86,806 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                     GDALPolygonizeMultiThreadedT()                   */
+/************************************************************************/
+
+namespace
+{
+
+// Solid vertical arm of the line at the border between two stripes, with
+// the arcs created on it for the polygons on its right (inner) and left
+// (outer) sides.
+struct GDALPolygonizeBorderArm
+{
+    std::int64_t nInnerId = -1;
+    std::size_t iInnerArc = 0;
+    std::int64_t nOuterId = -1;
+    std::size_t iOuterArc = 0;
+};
+
+// Part, within a stripe, of a polygon that crosses stripe borders.
+template <class DataType> struct GDALPolygonizeFragment
+{
+    std::int64_t nId = 0;
+    DataType nValue{};
+    std::unique_ptr<RPolygon> poPolygon{};
+};
+
+template <class DataType> struct GDALPolygonizeStripe
+{
+    int nYOff = 0;
+    int nYSize = 0;
+
+    // First pass: polygon ids, in the numbering of the stripe, of the line
+    // above the stripe and of its last line.
+    std::vector<GInt32> anTopLineId{};
+    std::vector<GInt32> anBottomLineId{};
+
+    // Global ids of the polygons of the stripe that touch its borders.
+    std::map<GInt32, std::int64_t> oMapBorderIdToGlobalId{};
+
+    // Second pass results.
+    std::vector<std::pair<OGRGeometryH, DataType>> aoCompletedPolygons{};
+    std::vector<GDALPolygonizeFragment<DataType>> aoFragments{};
+    std::vector<GDALPolygonizeBorderArm> aoTopArms{};
+    std::vector<GDALPolygonizeBorderArm> aoBottomArms{};
+
+    CPLErr eErr = CE_None;
+    bool bFirstPassDone = false;
+    bool bSecondPassDone = false;
+
+    GDALPolygonizeStripe() = default;
+    GDALPolygonizeStripe(GDALPolygonizeStripe &&) = default;
+
+    ~GDALPolygonizeStripe()
+    {
+        for (auto &oPair : aoCompletedPolygons)
+            OGR_G_DestroyGeometry(oPair.first);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALPolygonizeStripe)
+};
+
+/**
+ * Receives the polygons traced in a stripe: the ones entirely within the
+ * stripe are converted to OGR geometries, the other ones are kept as
+ * fragments to be stitched with the fragments of the other stripes.
+ */
+template <class DataType>
+class GDALPolygonizeStripeReceiver final : public PolygonReceiver<DataType>
+{
+    GDALPolygonizeStripe<DataType> &sStripe_;
+    const std::map<std::int64_t, int> &oMapStitchedIdToLastStripe_;
+    const double *padfGeoTransform_;
+
+  public:
+    // Global polygon ids of the line before the one being processed, in
+    // which the bottom-right cell of the received polygons is.
+    const std::int64_t *panLastLineId = nullptr;
+
+    GDALPolygonizeStripeReceiver(
+        GDALPolygonizeStripe<DataType> &sStripe,
+        const std::map<std::int64_t, int> &oMapStitchedIdToLastStripe,
+        const double *padfGeoTransform)
+        : sStripe_(sStripe),
+          oMapStitchedIdToLastStripe_(oMapStitchedIdToLastStripe),
+          padfGeoTransform_(padfGeoTransform)
+    {
+    }
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override
+    {
+        const std::int64_t nId = panLastLineId[poPolygon->iBottomRightCol];
+        if (oMapStitchedIdToLastStripe_.find(nId) ==
+            oMapStitchedIdToLastStripe_.end())
+        {
+            sStripe_.aoCompletedPolygons.emplace_back(
+                CreateOGRPolygon(poPolygon, padfGeoTransform_),
+                nPolygonCellValue);
+            return;
+        }
+
+        // Take ownership of the arcs, as poPolygon is destroyed after that.
+        GDALPolygonizeFragment<DataType> oFragment;
+        oFragment.nId = nId;
+        oFragment.nValue = nPolygonCellValue;
+        oFragment.poPolygon.reset(new RPolygon());
+        oFragment.poPolygon->oArcs.swap(poPolygon->oArcs);
+        oFragment.poPolygon->oArcRighthandFollow.swap(
+            poPolygon->oArcRighthandFollow);
+        oFragment.poPolygon->oArcConnections.swap(poPolygon->oArcConnections);
+        sStripe_.aoFragments.push_back(std::move(oFragment));
+    }
+};
+
+/**
+ * Polygon crossing stripe borders, whose fragments are being stitched.
+ */
+template <class DataType> struct GDALPolygonizeStitchedPolygon
+{
+    RPolygon oPolygon{};
+    // Arc each arc was appended to, or itself.
+    std::vector<std::size_t> anArcRep{};
+    DataType nValue{};
+
+    std::size_t FindArc(std::size_t iArc)
+    {
+        while (anArcRep[iArc] != iArc)
+        {
+            anArcRep[iArc] = anArcRep[anArcRep[iArc]];
+            iArc = anArcRep[iArc];
+        }
+        return iArc;
+    }
+
+    void AddFragment(RPolygon &oFragment, DataType nFragmentValue)
+    {
+        const std::size_t nOffset = oPolygon.oArcs.size();
+        for (std::size_t i = 0; i < oFragment.oArcs.size(); ++i)
+        {
+            oPolygon.oArcs.push_back(oFragment.oArcs[i]);
+            oPolygon.oArcRighthandFollow.push_back(
+                oFragment.oArcRighthandFollow[i]);
+            oPolygon.oArcConnections.push_back(nOffset +
+                                               oFragment.oArcConnections[i]);
+            anArcRep.push_back(nOffset + i);
+        }
+        oFragment.oArcs.clear();
+        // Fragments are added in stripe order, so this ends up being the
+        // value of the bottom-right cell, as in the single-threaded case.
+        nValue = nFragmentValue;
+    }
+
+    // Append the arc iNextArc, that starts on the stripe border, to the arc
+    // iArc that ends on the same arm of the border. Points of both arcs are
+    // in top to bottom order. Inner arcs (following the right-hand rule) are
+    // connected to their next arc in the lower stripe, outer arcs in the
+    // upper stripe.
+    void JoinArcs(std::size_t iArc, std::size_t iNextArc, bool bInner)
+    {
+        iArc = FindArc(iArc);
+        iNextArc = FindArc(iNextArc);
+        Arc *poArc = oPolygon.oArcs[iArc];
+        Arc *poNextArc = oPolygon.oArcs[iNextArc];
+        poArc->insert(poArc->end(), poNextArc->begin(), poNextArc->end());
+        Arc().swap(*poNextArc);
+        if (bInner)
+            oPolygon.oArcConnections[iArc] =
+                oPolygon.oArcConnections[iNextArc];
+        anArcRep[iNextArc] = iArc;
+    }
+
+    OGRGeometryH CreateGeometry(const double *padfGeoTransform)
+    {
+        RPolygon oFinal;
+        const std::size_t nArcs = oPolygon.oArcs.size();
+        std::vector<std::size_t> anNewIndex(nArcs);
+        for (std::size_t i = 0; i < nArcs; ++i)
+        {
+            if (anArcRep[i] == i)
+            {
+                anNewIndex[i] = oFinal.oArcs.size();
+                oFinal.oArcs.push_back(oPolygon.oArcs[i]);
+                oFinal.oArcRighthandFollow.push_back(
+                    oPolygon.oArcRighthandFollow[i]);
+            }
+            else
+            {
+                delete oPolygon.oArcs[i];
+            }
+        }
+        oPolygon.oArcs.clear();
+        for (std::size_t i = 0; i < nArcs; ++i)
+        {
+            if (anArcRep[i] == i)
+                oFinal.oArcConnections.push_back(
+                    anNewIndex[FindArc(oPolygon.oArcConnections[i])]);
+        }
+        return CreateOGRPolygon(&oFinal, padfGeoTransform);
+    }
+};
+
+template <class DataType, class EqualityTest> class GDALPolygonizeMTContext
+{
+    GDALRasterBandH hSrcBand_;
+    GDALRasterBandH hMaskBand_;
+    GDALDataType eDT_;
+    int nConnectedness_;
+    const double *padfGeoTransform_;
+
+  public:
+    const int nXSize;
+    const int nYSize;
+
+    std::vector<GDALPolygonizeStripe<DataType>> asStripes{};
+
+    // Ids of the polygons crossing stripe borders, with the index of the
+    // last stripe they are in.
+    std::map<std::int64_t, int> oMapStitchedIdToLastStripe{};
+
+    // Protects datasets and layer accesses, and the done flags of stripes.
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    std::atomic<bool> bStop{false};
+
+    GDALPolygonizeMTContext(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                            GDALDataType eDT, int nConnectedness,
+                            const double *padfGeoTransform)
+        : hSrcBand_(hSrcBand), hMaskBand_(hMaskBand), eDT_(eDT),
+          nConnectedness_(nConnectedness), padfGeoTransform_(padfGeoTransform),
+          nXSize(GDALGetRasterBandXSize(hSrcBand)),
+          nYSize(GDALGetRasterBandYSize(hSrcBand))
+    {
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALPolygonizeMTContext)
+
+    /**
+     * Enumerate the polygons of the lines of a stripe, and of the line
+     * above it, calling fnLineProcessed(iY, panThisLineVal, panThisLineId,
+     * panLastLineVal) after each line.
+     */
+    template <class F>
+    bool
+    EnumerateStripe(const GDALPolygonizeStripe<DataType> &sStripe,
+                    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> &oEnum,
+                    F &&fnLineProcessed)
+    {
+        std::vector<DataType> anLastLineVal(nXSize);
+        std::vector<DataType> anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize);
+        std::vector<GInt32> anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(hMaskBand_ ? nXSize : 0);
+
+        const int nFirstLine = std::max(0, sStripe.nYOff - 1);
+        for (int iY = nFirstLine; iY < sStripe.nYOff + sStripe.nYSize; ++iY)
+        {
+            if (bStop)
+                return false;
+
+            {
+                std::lock_guard<std::mutex> oLock(oMutex);
+                CPLErr eErr =
+                    GDALRasterIO(hSrcBand_, GF_Read, 0, iY, nXSize, 1,
+                                 anThisLineVal.data(), nXSize, 1, eDT_, 0, 0);
+                if (eErr == CE_None && hMaskBand_ != nullptr)
+                    eErr = GPMaskImageData(hMaskBand_, abyMaskLine.data(), iY,
+                                           nXSize, anThisLineVal.data());
+                if (eErr != CE_None)
+                    return false;
+            }
+
+            if (!oEnum.ProcessLine(
+                    iY == nFirstLine ? nullptr : anLastLineVal.data(),
+                    anThisLineVal.data(),
+                    iY == nFirstLine ? nullptr : anLastLineId.data(),
+                    anThisLineId.data(), nXSize))
+                return false;
+
+            if (!fnLineProcessed(iY, anThisLineVal.data(), anThisLineId.data(),
+                                 anLastLineVal.data()))
+                return false;
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+        return true;
+    }
+
+    /**
+     * First pass: label the polygons of the stripe and record the labels of
+     * its border lines, to find which polygons cross stripe borders.
+     */
+    bool FirstPass(GDALPolygonizeStripe<DataType> &sStripe)
+    {
+        const bool bLastStripe = sStripe.nYOff + sStripe.nYSize == nYSize;
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+            nConnectedness_);
+        if (!EnumerateStripe(
+                sStripe, oEnum,
+                [&sStripe, bLastStripe, this](int iY, const DataType *,
+                                              const GInt32 *panThisLineId,
+                                              const DataType *)
+                {
+                    if (iY < sStripe.nYOff)
+                        sStripe.anTopLineId.assign(panThisLineId,
+                                                   panThisLineId + nXSize);
+                    else if (!bLastStripe &&
+                             iY == sStripe.nYOff + sStripe.nYSize - 1)
+                        sStripe.anBottomLineId.assign(panThisLineId,
+                                                      panThisLineId + nXSize);
+                    return true;
+                }))
+            return false;
+
+        oEnum.CompleteMerges();
+        for (auto *panLineId : {&sStripe.anTopLineId, &sStripe.anBottomLineId})
+        {
+            for (auto &nId : *panLineId)
+            {
+                if (nId >= 0)
+                    nId = oEnum.panPolyIdMap[nId];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Second pass: trace the polygons of the stripe.
+     */
+    bool SecondPass(GDALPolygonizeStripe<DataType> &sStripe, int iStripe)
+    {
+        // Redo the first pass rather than keeping its polygon id map from
+        // the first pass, to bound memory use.
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oFirstEnum(
+            nConnectedness_);
+        if (!EnumerateStripe(sStripe, oFirstEnum,
+                             [](int, const DataType *, const GInt32 *,
+                                const DataType *) { return true; }))
+            return false;
+        oFirstEnum.CompleteMerges();
+
+        // Map the polygon ids of the stripe to global ids.
+        std::vector<std::int64_t> anGlobalId(oFirstEnum.nNextPolygonId);
+        for (GInt32 i = 0; i < oFirstEnum.nNextPolygonId; ++i)
+            anGlobalId[i] = (static_cast<std::int64_t>(iStripe) << 32) | i;
+        for (const auto &oPair : sStripe.oMapBorderIdToGlobalId)
+            anGlobalId[oPair.first] = oPair.second;
+        sStripe.oMapBorderIdToGlobalId.clear();
+
+        using PolygonizerType = Polygonizer<std::int64_t, DataType>;
+        GDALPolygonizeStripeReceiver<DataType> oReceiver(
+            sStripe, oMapStitchedIdToLastStripe, padfGeoTransform_);
+        PolygonizerType oPolygonizer{-1, &oReceiver};
+
+        std::vector<TwoArm> aoLastLineArm(nXSize + 2);
+        std::vector<TwoArm> aoThisLineArm(nXSize + 2);
+        for (auto &oArm : aoLastLineArm)
+            oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+        std::vector<std::int64_t> anLastLineId(nXSize);
+        std::vector<std::int64_t> anThisLineId(nXSize);
+        std::vector<DataType> anLastLineVal(nXSize);
+
+        const auto RecordBorderArms =
+            [this](const std::vector<TwoArm> &aoArm,
+                   const std::vector<std::int64_t> &anLineId,
+                   std::vector<GDALPolygonizeBorderArm> &aoBorderArms)
+        {
+            for (int iCol = 0; iCol <= nXSize; ++iCol)
+            {
+                const TwoArm &oArm = aoArm[iCol + 1];
+                if (!oArm.bSolidVertical)
+                    continue;
+                GDALPolygonizeBorderArm oBorderArm;
+                oBorderArm.nInnerId =
+                    iCol < nXSize ? anLineId[iCol]
+                                  : PolygonizerType::THE_OUTER_POLYGON_ID;
+                oBorderArm.iInnerArc = oArm.oArcVerInner.iIndex;
+                oBorderArm.nOuterId =
+                    iCol > 0 ? anLineId[iCol - 1]
+                             : PolygonizerType::THE_OUTER_POLYGON_ID;
+                oBorderArm.iOuterArc = oArm.oArcVerOuter.iIndex;
+                aoBorderArms.push_back(oBorderArm);
+            }
+        };
+
+        GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
+            nConnectedness_);
+        if (!EnumerateStripe(
+                sStripe, oSecondEnum,
+                [&](int iY, const DataType *panThisLineVal,
+                    const GInt32 *panThisLineId, const DataType *panLastLineVal)
+                {
+                    const GInt32 *panPolyIdMap = oFirstEnum.panPolyIdMap;
+                    for (int iX = 0; iX < nXSize; iX++)
+                    {
+                        anThisLineId[iX] =
+                            panThisLineId[iX] == -1
+                                ? -1
+                                : anGlobalId[panPolyIdMap[panThisLineId[iX]]];
+                    }
+
+                    if (iY < sStripe.nYOff)
+                    {
+                        oPolygonizer.processStripeTopLine(
+                            anThisLineId.data(), aoLastLineArm.data(), iY,
+                            nXSize);
+                        RecordBorderArms(aoLastLineArm, anThisLineId,
+                                         sStripe.aoTopArms);
+                    }
+                    else
+                    {
+                        oReceiver.panLastLineId = anLastLineId.data();
+                        oPolygonizer.processLine(
+                            anThisLineId.data(), panLastLineVal,
+                            aoThisLineArm.data(), aoLastLineArm.data(), iY,
+                            nXSize);
+                        std::swap(aoThisLineArm, aoLastLineArm);
+                    }
+
+                    std::swap(anLastLineId, anThisLineId);
+                    std::copy(panThisLineVal, panThisLineVal + nXSize,
+                              anLastLineVal.begin());
+                    return true;
+                }))
+            return false;
+
+        oReceiver.panLastLineId = anLastLineId.data();
+        if (sStripe.nYOff + sStripe.nYSize == nYSize)
+        {
+            std::fill(anThisLineId.begin(), anThisLineId.end(),
+                      PolygonizerType::THE_OUTER_POLYGON_ID);
+            oPolygonizer.processLine(anThisLineId.data(), anLastLineVal.data(),
+                                     aoThisLineArm.data(), aoLastLineArm.data(),
+                                     nYSize, nXSize);
+        }
+        else
+        {
+            RecordBorderArms(aoLastLineArm, anLastLineId, sStripe.aoBottomArms);
+            oPolygonizer.releaseOpenPolygons(anLastLineVal.data());
+        }
+        return true;
+    }
+
+    /**
+     * Find the polygons crossing stripe borders from the border lines
+     * labelled by the first pass, and assign them global ids.
+     */
+    void MergeBorderPolygons()
+    {
+        const int nStripes = static_cast<int>(asStripes.size());
+
+        // Union-find of the (stripe, polygon id) pairs of the border lines.
+        std::vector<std::map<GInt32, std::size_t>> aoMapIdToNode(nStripes);
+        std::vector<std::size_t> anParent;
+        std::vector<std::int64_t> anNodeKey;
+        const auto GetNode = [&](int iStripe, GInt32 nId)
+        {
+            auto oIter = aoMapIdToNode[iStripe].find(nId);
+            if (oIter != aoMapIdToNode[iStripe].end())
+                return oIter->second;
+            const std::size_t iNode = anParent.size();
+            anParent.push_back(iNode);
+            anNodeKey.push_back((static_cast<std::int64_t>(iStripe) << 32) |
+                                nId);
+            aoMapIdToNode[iStripe][nId] = iNode;
+            return iNode;
+        };
+        const auto FindRoot = [&anParent](std::size_t iNode)
+        {
+            while (anParent[iNode] != iNode)
+            {
+                anParent[iNode] = anParent[anParent[iNode]];
+                iNode = anParent[iNode];
+            }
+            return iNode;
+        };
+
+        for (int iStripe = 1; iStripe < nStripes; ++iStripe)
+        {
+            const auto &anUpper = asStripes[iStripe - 1].anBottomLineId;
+            const auto &anLower = asStripes[iStripe].anTopLineId;
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                // Both stripes agree on nodata pixels.
+                if (anUpper[iX] < 0 ||
+                    (iX > 0 && anUpper[iX] == anUpper[iX - 1] &&
+                     anLower[iX] == anLower[iX - 1]))
+                    continue;
+                const std::size_t iRoot1 =
+                    FindRoot(GetNode(iStripe - 1, anUpper[iX]));
+                const std::size_t iRoot2 =
+                    FindRoot(GetNode(iStripe, anLower[iX]));
+                // Keep the lowest node as the root, so that ids are stable.
+                anParent[std::max(iRoot1, iRoot2)] = std::min(iRoot1, iRoot2);
+            }
+            asStripes[iStripe - 1].anBottomLineId.clear();
+            asStripes[iStripe - 1].anBottomLineId.shrink_to_fit();
+            asStripes[iStripe].anTopLineId.clear();
+            asStripes[iStripe].anTopLineId.shrink_to_fit();
+        }
+
+        for (int iStripe = 0; iStripe < nStripes; ++iStripe)
+        {
+            for (const auto &oPair : aoMapIdToNode[iStripe])
+            {
+                const std::int64_t nGlobalId =
+                    anNodeKey[FindRoot(oPair.second)];
+                asStripes[iStripe].oMapBorderIdToGlobalId[oPair.first] =
+                    nGlobalId;
+                int &nLastStripe = oMapStitchedIdToLastStripe[nGlobalId];
+                nLastStripe = std::max(nLastStripe, iStripe);
+            }
+        }
+    }
+};
+
+template <class DataType, class EqualityTest> struct GDALPolygonizeMTJob
+{
+    GDALPolygonizeMTContext<DataType, EqualityTest> *poContext = nullptr;
+    int iStripe = 0;
+
+    static void Process(void *pData, bool bSecondPass)
+    {
+        auto psJob = static_cast<GDALPolygonizeMTJob *>(pData);
+        auto poContext = psJob->poContext;
+        auto &sStripe = poContext->asStripes[psJob->iStripe];
+        bool bOK = false;
+        try
+        {
+            bOK = bSecondPass ? poContext->SecondPass(sStripe, psJob->iStripe)
+                              : poContext->FirstPass(sStripe);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize(): %s", e.what());
+        }
+        if (!bOK)
+            poContext->bStop = true;
+
+        std::lock_guard<std::mutex> oLock(poContext->oMutex);
+        if (!bOK)
+            sStripe.eErr = CE_Failure;
+        if (bSecondPass)
+            sStripe.bSecondPassDone = true;
+        else
+            sStripe.bFirstPassDone = true;
+        poContext->oCV.notify_all();
+    }
+
+    static void ProcessFirstPass(void *pData)
+    {
+        Process(pData, false);
+    }
+
+    static void ProcessSecondPass(void *pData)
+    {
+        Process(pData, true);
+    }
+};
+
+}  // namespace
+
+// Polygonize horizontal stripes of the raster in parallel. Polygons that
+// cross stripe borders are identified by a first pass labelling each stripe
+// and the line above it, and are assembled from the arcs traced in each
+// stripe by the second pass. Features are written in the order of the
+// stripes, and the polygons are the same as in the single-threaded case.
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeMultiThreadedT(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, int nConnectedness, double *padfGeoTransform,
+    int nLinesPerStripe, int nNumThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg, GDALDataType eDT)
+{
+    using ContextType = GDALPolygonizeMTContext<DataType, EqualityTest>;
+    using JobType = GDALPolygonizeMTJob<DataType, EqualityTest>;
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        return CE_Failure;
+
+    ContextType oContext(hSrcBand, hMaskBand, eDT, nConnectedness,
+                         padfGeoTransform);
+    const int nYSize = oContext.nYSize;
+    const int nStripes = (nYSize + nLinesPerStripe - 1) / nLinesPerStripe;
+    std::vector<JobType> asJobs(nStripes);
+    try
+    {
+        oContext.asStripes.resize(nStripes);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+    for (int iStripe = 0; iStripe < nStripes; ++iStripe)
+    {
+        auto &sStripe = oContext.asStripes[iStripe];
+        sStripe.nYOff = iStripe * nLinesPerStripe;
+        sStripe.nYSize = std::min(nLinesPerStripe, nYSize - sStripe.nYOff);
+        asJobs[iStripe].poContext = &oContext;
+        asJobs[iStripe].iStripe = iStripe;
+    }
+
+    CPLErr eErr = CE_None;
+    const auto WaitStripe = [&oContext, &eErr](int iStripe, bool bSecondPass)
+    {
+        const auto &sStripe = oContext.asStripes[iStripe];
+        std::unique_lock<std::mutex> oLock(oContext.oMutex);
+        oContext.oCV.wait(oLock,
+                          [&sStripe, bSecondPass]() {
+                              return bSecondPass ? sStripe.bSecondPassDone
+                                                 : sStripe.bFirstPassDone;
+                          });
+        if (sStripe.eErr != CE_None)
+            eErr = CE_Failure;
+    };
+    const auto ReportProgress = [&](double dfComplete)
+    {
+        if (eErr == CE_None && !pfnProgress(dfComplete, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+        if (eErr != CE_None)
+            oContext.bStop = true;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: find the polygons crossing stripe borders.          */
+    /* -------------------------------------------------------------------- */
+    for (auto &sJob : asJobs)
+        poJobQueue->SubmitJob(JobType::ProcessFirstPass, &sJob);
+    for (int iStripe = 0; iStripe < nStripes; ++iStripe)
+    {
+        WaitStripe(iStripe, false);
+        ReportProgress(0.10 * (iStripe + 1) / nStripes);
+    }
+    poJobQueue->WaitCompletion();
+    if (eErr != CE_None)
+        return eErr;
+
+    try
+    {
+        oContext.MergeBorderPolygons();
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+
+    /* ==================================================================== */
+    /*      Second pass: trace the polygons of each stripe, and write them  */
+    /*      in stripe order, once their last stripe has been traced.        */
+    /*      Only a limited number of stripes are processed ahead of the     */
+    /*      one being written, to bound memory use.                         */
+    /* ==================================================================== */
+    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                              padfGeoTransform};
+    std::map<std::int64_t,
+             std::unique_ptr<GDALPolygonizeStitchedPolygon<DataType>>>
+        oMapStitchedPolygons;
+    std::vector<GDALPolygonizeBorderArm> aoLastBottomArms;
+    const int nMaxStripesAhead = 2 * nNumThreads;
+    int iNextStripeToSubmit = 0;
+
+    for (int iStripe = 0; eErr == CE_None && iStripe < nStripes; ++iStripe)
+    {
+        for (; iNextStripeToSubmit < nStripes &&
+               iNextStripeToSubmit < iStripe + nMaxStripesAhead;
+             ++iNextStripeToSubmit)
+        {
+            poJobQueue->SubmitJob(JobType::ProcessSecondPass,
+                                  &asJobs[iNextStripeToSubmit]);
+        }
+
+        WaitStripe(iStripe, true);
+        if (eErr != CE_None)
+            break;
+
+        auto &sStripe = oContext.asStripes[iStripe];
+        try
+        {
+            // Append the fragments of the stripe to the stitched polygons.
+            std::map<std::int64_t, std::size_t> oMapIdToArcOffset;
+            for (auto &oFragment : sStripe.aoFragments)
+            {
+                auto &poStitched = oMapStitchedPolygons[oFragment.nId];
+                if (!poStitched)
+                    poStitched.reset(
+                        new GDALPolygonizeStitchedPolygon<DataType>());
+                oMapIdToArcOffset[oFragment.nId] =
+                    poStitched->oPolygon.oArcs.size();
+                poStitched->AddFragment(*(oFragment.poPolygon),
+                                        oFragment.nValue);
+            }
+            sStripe.aoFragments.clear();
+
+            const auto IsPolygonId = [](std::int64_t nId) {
+                return nId >= 0 &&
+                       nId != Polygonizer<std::int64_t,
+                                          DataType>::THE_OUTER_POLYGON_ID;
+            };
+
+            // Join the arcs crossing the border with the previous stripe.
+            if (sStripe.aoTopArms.size() != aoLastBottomArms.size())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALPolygonize(): inconsistent stripe borders");
+                eErr = CE_Failure;
+                break;
+            }
+            const auto JoinArcs = [&](std::int64_t nId, std::size_t iArc,
+                                      std::size_t iNextArc, bool bInner)
+            {
+                if (!IsPolygonId(nId))
+                    return true;
+                const auto oIterOffset = oMapIdToArcOffset.find(nId);
+                if (oIterOffset == oMapIdToArcOffset.end())
+                    return false;
+                oMapStitchedPolygons[nId]->JoinArcs(
+                    iArc, oIterOffset->second + iNextArc, bInner);
+                return true;
+            };
+            for (std::size_t i = 0;
+                 eErr == CE_None && i < sStripe.aoTopArms.size(); ++i)
+            {
+                const auto &oTop = sStripe.aoTopArms[i];
+                const auto &oBottom = aoLastBottomArms[i];
+                if (oTop.nInnerId != oBottom.nInnerId ||
+                    oTop.nOuterId != oBottom.nOuterId ||
+                    !JoinArcs(oTop.nInnerId, oBottom.iInnerArc, oTop.iInnerArc,
+                              true) ||
+                    !JoinArcs(oTop.nOuterId, oBottom.iOuterArc, oTop.iOuterArc,
+                              false))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "GDALPolygonize(): inconsistent stripe borders");
+                    eErr = CE_Failure;
+                }
+            }
+            if (eErr != CE_None)
+                break;
+
+            // Remember the arcs crossing the border with the next stripe,
+            // as indices in the stitched polygons.
+            aoLastBottomArms = std::move(sStripe.aoBottomArms);
+            for (auto &oBottom : aoLastBottomArms)
+            {
+                if (IsPolygonId(oBottom.nInnerId))
+                    oBottom.iInnerArc += oMapIdToArcOffset[oBottom.nInnerId];
+                if (IsPolygonId(oBottom.nOuterId))
+                    oBottom.iOuterArc += oMapIdToArcOffset[oBottom.nOuterId];
+            }
+
+            // Assemble the polygons whose last stripe is this one.
+            for (const auto &oPair : oMapIdToArcOffset)
+            {
+                if (oContext.oMapStitchedIdToLastStripe.find(oPair.first)
+                        ->second != iStripe)
+                    continue;
+                auto oIter = oMapStitchedPolygons.find(oPair.first);
+                sStripe.aoCompletedPolygons.emplace_back(
+                    oIter->second->CreateGeometry(padfGeoTransform),
+                    oIter->second->nValue);
+                oMapStitchedPolygons.erase(oIter);
+            }
+
+            std::lock_guard<std::mutex> oLock(oContext.oMutex);
+            for (auto &oPair : sStripe.aoCompletedPolygons)
+            {
+                oPolygonWriter.write(oPair.first, oPair.second);
+                oPair.first = nullptr;
+            }
+            sStripe.aoCompletedPolygons.clear();
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            eErr = CE_Failure;
+            break;
+        }
+        if (eErr == CE_None)
+            eErr = oPolygonWriter.getErr();
+
+        ReportProgress(0.10 + 0.90 * (iStripe + 1) / nStripes);
+    }
+
+    oContext.bStop = true;
+    poJobQueue->WaitCompletion();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -124,29 +929,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -182,6 +964,75 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the multi-threaded implementation if requested.             */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nNumThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+    if (nNumThreads > 1)
+    {
+        const GIntBig nMaxMemoryMB = std::max<GIntBig>(
+            1, CPLAtoGIntBig(
+                   CSLFetchNameValueDef(papszOptions, "MAX_MEMORY", "1024")));
+        const size_t nMaxMemory = static_cast<size_t>(
+            std::min<GIntBig>(nMaxMemoryMB,
+                              std::numeric_limits<size_t>::max() >> 20)
+            << 20);
+
+        // Stripes of at least 64 lines, to limit the number of polygons
+        // crossing stripe borders, with about 4 stripes per thread, unless
+        // the memory limit requires smaller stripes.
+        const size_t nBytesPerLine =
+            static_cast<size_t>(nXSize) * (sizeof(DataType) + sizeof(GInt32));
+        size_t nLinesPerStripe = std::min(
+            static_cast<size_t>(nYSize + 4 * nNumThreads - 1) /
+                (4 * nNumThreads),
+            nMaxMemory /
+                (2 * static_cast<size_t>(nNumThreads) * nBytesPerLine));
+        nLinesPerStripe = std::max<size_t>(64, nLinesPerStripe);
+        nLinesPerStripe = static_cast<size_t>(
+            GDALGetTestChunkSize(nLinesPerStripe, nYSize));
+
+        if (nLinesPerStripe < static_cast<size_t>(nYSize))
+        {
+            return GDALPolygonizeMultiThreadedT<DataType, EqualityTest>(
+                hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+                adfGeoTransform, static_cast<int>(nLinesPerStripe),
+                nNumThreads, pfnProgress, pProgressArg, eDT);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -491,6 +1342,17 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: (GDAL >= 3.10) Number of threads
+ * used to polygonize horizontal stripes of the raster in parallel. Polygons
+ * crossing stripe borders are stitched, so the polygons are the same as with
+ * a single thread, but features may be written in a different order.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * </li>
+ * <li>MAX_MEMORY=value_in_MB: (GDAL >= 3.10) Only used with NUM_THREADS > 1.
+ * Maximum memory, in megabytes, that the threads may use to label the
+ * polygons of their stripe, assuming the worst case of a new polygon for each
+ * pixel. Lowering it reduces the height of stripes, and thus the peak memory
+ * for highly fragmented rasters. Defaults to 1024.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -565,6 +1427,17 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: (GDAL >= 3.10) Number of threads
+ * used to polygonize horizontal stripes of the raster in parallel. Polygons
+ * crossing stripe borders are stitched, so the polygons are the same as with
+ * a single thread, but features may be written in a different order.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * </li>
+ * <li>MAX_MEMORY=value_in_MB: (GDAL >= 3.10) Only used with NUM_THREADS > 1.
+ * Maximum memory, in megabytes, that the threads may use to label the
+ * polygons of their stripe, assuming the worst case of a new polygon for each
+ * pixel. Lowering it reduces the height of stripes, and thus the peak memory
+ * for highly fragmented rasters. Defaults to 1024.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -455,21 +455,63 @@ void Polygonizer<PolyIdType, DataType>::processLine(
     }
 }
 
-template <typename DataType>
-OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
-                                             int iPixValField,
-                                             double *padfGeoTransform)
-    : PolygonReceiver<DataType>(), hOutLayer_(hOutLayer),
-      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform)
+template <typename PolyIdType, typename DataType>
+void Polygonizer<PolyIdType, DataType>::processStripeTopLine(
+    const PolyIdType *panAboveLineId, TwoArm *poAboveLineArm,
+    const IndexType nAboveRow, const IndexType nCols)
 {
+    RPolygon *poPolyLeft = poTheOuterPolygon_;
+    for (IndexType col = 0; col <= nCols; ++col)
+    {
+        TwoArm *poArm = poAboveLineArm + col + 1;
+        poArm->iRow = nAboveRow;
+        poArm->iCol = col;
+        poArm->poPolyInside = col < nCols ? getPolygon(panAboveLineId[col])
+                                          : poTheOuterPolygon_;
+        poArm->poPolyInside->updateBottomRightPos(nAboveRow, col);
+        poArm->poPolyLeft = poPolyLeft;
+        poArm->bSolidVertical = poArm->poPolyInside != poPolyLeft;
+        if (poArm->bSolidVertical)
+        {
+            // same right-hand rule as arcs passed to vertical arms by
+            // ProcessArmConnections()
+            poArm->oArcVerInner = poArm->poPolyInside->newArc(true);
+            poArm->oArcVerOuter = poPolyLeft->newArc(false);
+        }
+        poPolyLeft = poArm->poPolyInside;
+    }
 }
 
-template <typename DataType>
-void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
-                                         DataType nPolygonCellValue)
+template <typename PolyIdType, typename DataType>
+void Polygonizer<PolyIdType, DataType>::releaseOpenPolygons(
+    const DataType *panLastLineVal)
+{
+    std::vector<PolygonMapEntry> oOpenPolygons;
+    for (auto &entry : oPolygonMap_)
+    {
+        if (entry.first != THE_OUTER_POLYGON_ID)
+            oOpenPolygons.push_back(entry);
+    }
+    // cppcheck-suppress constVariableReference
+    for (auto &entry : oOpenPolygons)
+    {
+        PolyIdType nPolyId = entry.first;
+        RPolygon *poPolygon = entry.second;
+
+        if (nPolyId != nInvalidPolyId_)
+        {
+            poPolygonReceiver_->receive(
+                poPolygon, panLastLineVal[poPolygon->iBottomRightCol]);
+        }
+
+        destroyPolygon(nPolyId);
+    }
+}
+
+OGRGeometryH CreateOGRPolygon(const RPolygon *poPolygon,
+                              const double *padfGeoTransform)
 {
     std::vector<bool> oAccessedArc(poPolygon->oArcConnections.size(), false);
-    double *padfGeoTransform = padfGeoTransform_;
 
     OGRGeometryH hPolygon = OGR_G_CreateGeometry(wkbPolygon);
 
@@ -527,6 +569,29 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         AddRingToPolygon(ite - oAccessedArc.begin());
     }
 
+    return hPolygon;
+}
+
+template <typename DataType>
+OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
+                                             int iPixValField,
+                                             double *padfGeoTransform)
+    : PolygonReceiver<DataType>(), hOutLayer_(hOutLayer),
+      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform)
+{
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
+                                         DataType nPolygonCellValue)
+{
+    write(CreateOGRPolygon(poPolygon, padfGeoTransform_), nPolygonCellValue);
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::write(OGRGeometryH hPolygon,
+                                       DataType nPolygonCellValue)
+{
     // Create the feature object
     OGRFeatureH hFeat = OGR_F_Create(OGR_L_GetLayerDefn(hOutLayer_));
 
@@ -179,8 +179,30 @@ template <typename PolyIdType, typename DataType> class Polygonizer
                      const DataType *panLastLineVal, TwoArm *poThisLineArm,
                      TwoArm *poLastLineArm, IndexType nCurrentRow,
                      IndexType nCols);
+
+    /**
+     * Initialize the arms of the line above the first line of a stripe that
+     * is processed independently of the previous lines (multi-threaded
+     * mode). Each solid vertical arm gets a new empty inner and outer arc,
+     * that continue the arcs of the same arm in the previous stripe.
+     */
+    void processStripeTopLine(const PolyIdType *panAboveLineId,
+                              TwoArm *poAboveLineArm, IndexType nAboveRow,
+                              IndexType nCols);
+
+    /**
+     * Pass the polygons that are not completed yet to the receiver, and
+     * destroy them (multi-threaded mode, after the last line of a stripe).
+     */
+    void releaseOpenPolygons(const DataType *panLastLineVal);
 };
 
+/**
+ * Create an OGR polygon from the arcs of a raster polygon.
+ */
+OGRGeometryH CreateOGRPolygon(const RPolygon *poPolygon,
+                              const double *padfGeoTransform);
+
 /**
  * Write raster polygon object to OGR layer.
  */
@@ -206,6 +228,11 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
 
     void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
 
+    /**
+     * Write a polygon geometry, whose ownership is taken, to the layer.
+     */
+    void write(OGRGeometryH hPolygon, DataType nPolygonCellValue);
+
     inline CPLErr getErr()
     {
         return eErr_;
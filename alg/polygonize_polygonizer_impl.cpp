@@ -9,6 +9,10 @@ template class Polygonizer<GInt32, std::int64_t>;
 
 template class Polygonizer<GInt32, float>;
 
+template class Polygonizer<std::int64_t, std::int64_t>;
+
+template class Polygonizer<std::int64_t, float>;
+
 template class OGRPolygonWriter<std::int64_t>;
 
 template class OGRPolygonWriter<float>;
@@ -35,16 +35,22 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -360,6 +366,568 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                     GDALFillNodataInterpolator                       */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataInterpolator
+{
+    double dfMaxSearchDist = 0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bNearest = false;
+    bool bHasNoData = false;
+    float fNoData = 0.0f;
+
+    bool Interpolate(int iX, int iY, int nXSize, const GUInt32 *panTopDownY,
+                     const float *pafTopDownValue, const GUInt32 *panBottomUpY,
+                     const float *pafBottomUpValue, float &fValue,
+                     bool &bFilled) const;
+};
+}  // namespace
+
+/************************************************************************/
+/*                           Interpolate()                              */
+/*                                                                      */
+/*      Interpolate the value of the nodata pixel at column iX of line  */
+/*      iY, from the last valid pixel found above (top-down) and        */
+/*      below (bottom-up) in each column of the line. Returns false if  */
+/*      there is no source value in the search distance. Otherwise      */
+/*      fValue is set to the interpolated value, or fNoData if all      */
+/*      source values are nodata, in which case bFilled is false.       */
+/************************************************************************/
+
+bool GDALFillNodataInterpolator::Interpolate(
+    int iX, int iY, int nXSize, const GUInt32 *panTopDownY,
+    const float *pafTopDownValue, const GUInt32 *panBottomUpY,
+    const float *pafBottomUpValue, float &fValue, bool &bFilled) const
+{
+    int nThisMaxSearchDist = nMaxSearchDist;
+
+    enum Quadrants
+    {
+        QUAD_TOP_LEFT = 0,
+        QUAD_BOTTOM_LEFT = 1,
+        QUAD_TOP_RIGHT = 2,
+        QUAD_BOTTOM_RIGHT = 3,
+    };
+
+    constexpr int QUAD_COUNT = 4;
+    double adfQuadDist[QUAD_COUNT] = {};
+    float afQuadValue[QUAD_COUNT] = {};
+
+    for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+    {
+        adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+        afQuadValue[iQuad] = 0.0;
+    }
+
+    // Step left and right by one pixel searching for the closest
+    // target value for each quadrant.
+    for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+    {
+        const int iLeftX = std::max(0, iX - iStep);
+        const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+        // Top left includes current line.
+        QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT], afQuadValue[QUAD_TOP_LEFT],
+                   iLeftX, panTopDownY[iLeftX], iX, iY,
+                   pafTopDownValue[iLeftX], nNoDataVal);
+
+        // Bottom left.
+        QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
+                   afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
+                   panBottomUpY[iLeftX], iX, iY, pafBottomUpValue[iLeftX],
+                   nNoDataVal);
+
+        // Top right and bottom right do no include center pixel.
+        if (iStep == 0)
+            continue;
+
+        // Top right includes current line.
+        QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT], afQuadValue[QUAD_TOP_RIGHT],
+                   iRightX, panTopDownY[iRightX], iX, iY,
+                   pafTopDownValue[iRightX], nNoDataVal);
+
+        // Bottom right.
+        QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
+                   afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
+                   panBottomUpY[iRightX], iX, iY, pafBottomUpValue[iRightX],
+                   nNoDataVal);
+
+        // Every four steps, recompute maximum distance.
+        if ((iStep & 0x3) == 0)
+            nThisMaxSearchDist = static_cast<int>(
+                floor(std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                               std::max(adfQuadDist[2], adfQuadDist[3]))));
+    }
+
+    bool bHasSrcValues = false;
+    bFilled = false;
+    if (bNearest)
+    {
+        double dfNearestDist = dfMaxSearchDist + 1;
+        float fNearestValue = 0.0f;
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            if (adfQuadDist[iQuad] < dfNearestDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                {
+                    fNearestValue = afQuadValue[iQuad];
+                    dfNearestDist = adfQuadDist[iQuad];
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            bFilled = dfNearestDist <= dfMaxSearchDist;
+            fValue = bFilled ? fNearestValue : fNoData;
+        }
+    }
+    else
+    {
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += afQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            bFilled = dfWeightSum > 0.0;
+            fValue = bFilled ? static_cast<float>(dfValueSum / dfWeightSum)
+                             : fNoData;
+        }
+    }
+
+    return bHasSrcValues;
+}
+
+/************************************************************************/
+/*                        GDALFillNodataTiled()                         */
+/*                                                                      */
+/*      Tiled implementation of GDALFillNodata(). Each tile is read     */
+/*      with a halo large enough for the quadrant search and the        */
+/*      smoothing iterations, so that it can be interpolated and        */
+/*      smoothed independently of the other tiles, and gives the same   */
+/*      result as the line-based implementation. Tiles are processed    */
+/*      by the worker threads of the global thread pool, and written    */
+/*      to a work file copied to the target band at the end, as the     */
+/*      halo of a tile may overlap already filled tiles.                */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataTiledContext
+{
+    GDALRasterBandH hTargetBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hOutBand = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nTileSize = 0;
+    int nSmoothingIterations = 0;
+    GDALFillNodataInterpolator oInterpolator{};
+
+    // Protects band accesses and eErr.
+    std::mutex oMutex{};
+    CPLErr eErr = CE_None;
+    std::atomic<int> nTilesDone{0};
+
+    bool ProcessTile(int nTileXOff, int nTileYOff);
+};
+
+struct GDALFillNodataTileJob
+{
+    GDALFillNodataTiledContext *poContext = nullptr;
+    int nTileXOff = 0;
+    int nTileYOff = 0;
+
+    static void Process(void *pData)
+    {
+        auto psJob = static_cast<GDALFillNodataTileJob *>(pData);
+        auto poContext = psJob->poContext;
+        {
+            std::lock_guard<std::mutex> oLock(poContext->oMutex);
+            if (poContext->eErr != CE_None)
+                return;
+        }
+        if (!poContext->ProcessTile(psJob->nTileXOff, psJob->nTileYOff))
+        {
+            std::lock_guard<std::mutex> oLock(poContext->oMutex);
+            poContext->eErr = CE_Failure;
+        }
+        poContext->nTilesDone++;
+    }
+};
+}  // namespace
+
+bool GDALFillNodataTiledContext::ProcessTile(int nTileXOff, int nTileYOff)
+{
+    const int nTileXEnd = std::min(nXSize, nTileXOff + nTileSize);
+    const int nTileYEnd = std::min(nYSize, nTileYOff + nTileSize);
+
+    // Area whose interpolated values are needed by the smoothing filter.
+    const int nInterpXOff = std::max(0, nTileXOff - nSmoothingIterations);
+    const int nInterpYOff = std::max(0, nTileYOff - nSmoothingIterations);
+    const int nInterpXEnd = std::min(nXSize, nTileXEnd + nSmoothingIterations);
+    const int nInterpYEnd = std::min(nYSize, nTileYEnd + nSmoothingIterations);
+    const int nInterpXSize = nInterpXEnd - nInterpXOff;
+    const int nInterpYSize = nInterpYEnd - nInterpYOff;
+
+    // Area of source pixels that may be reached by the quadrant search,
+    // which may go up to one pixel beyond the maximum search distance.
+    const int nHalo = oInterpolator.nMaxSearchDist + 1;
+    const int nBufXOff = std::max(0, nInterpXOff - nHalo);
+    const int nBufYOff = std::max(0, nInterpYOff - nHalo);
+    const int nBufXSize = std::min(nXSize, nInterpXEnd + nHalo) - nBufXOff;
+    const int nBufYEnd = std::min(nYSize, nInterpYEnd + nHalo);
+    const int nBufYSize = nBufYEnd - nBufYOff;
+    const GUInt32 nNoDataVal = oInterpolator.nNoDataVal;
+
+    std::vector<GByte> abyMask;
+    std::vector<float> afValues;
+    std::vector<GUInt32> anTopDownY;
+    std::vector<float> afTopDownValue;
+    std::vector<GUInt32> anLastY, anThisY;
+    std::vector<float> afLastValue, afThisValue;
+    std::vector<float> afInterp, afSmoothed;
+    std::vector<GByte> abyTMask, abyFMask;
+    try
+    {
+        const size_t nBufSize = static_cast<size_t>(nBufXSize) * nBufYSize;
+        const size_t nInterpBufSize =
+            static_cast<size_t>(nBufXSize) * nInterpYSize;
+        const size_t nInterpSize =
+            static_cast<size_t>(nInterpXSize) * nInterpYSize;
+        abyMask.resize(nBufSize);
+        afValues.resize(nBufSize);
+        anTopDownY.resize(nInterpBufSize);
+        afTopDownValue.resize(nInterpBufSize);
+        anLastY.resize(nBufXSize, nNoDataVal);
+        anThisY.resize(nBufXSize);
+        afLastValue.resize(nBufXSize);
+        afThisValue.resize(nBufXSize);
+        afInterp.resize(nInterpSize);
+        abyTMask.resize(nInterpSize);
+        abyFMask.resize(nInterpSize);
+        if (nSmoothingIterations > 0)
+            afSmoothed.resize(nInterpSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALFillNodata()");
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (GDALRasterIO(hMaskBand, GF_Read, nBufXOff, nBufYOff, nBufXSize,
+                         nBufYSize, abyMask.data(), nBufXSize, nBufYSize,
+                         GDT_Byte, 0, 0) != CE_None ||
+            GDALRasterIO(hTargetBand, GF_Read, nBufXOff, nBufYOff, nBufXSize,
+                         nBufYSize, afValues.data(), nBufXSize, nBufYSize,
+                         GDT_Float32, 0, 0) != CE_None)
+        {
+            return false;
+        }
+    }
+
+    const double dfMaxSearchDist = oInterpolator.dfMaxSearchDist;
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the "last known value" for each column from top to      */
+    /*      bottom.                                                         */
+    /* -------------------------------------------------------------------- */
+    for (int iY = nBufYOff; iY < nInterpYEnd; iY++)
+    {
+        const size_t nOffset = static_cast<size_t>(iY - nBufYOff) * nBufXSize;
+        for (int iX = 0; iX < nBufXSize; iX++)
+        {
+            if (abyMask[nOffset + iX])
+            {
+                afThisValue[iX] = afValues[nOffset + iX];
+                anThisY[iX] = iY;
+            }
+            else if (iY <= dfMaxSearchDist + anLastY[iX])
+            {
+                afThisValue[iX] = afLastValue[iX];
+                anThisY[iX] = anLastY[iX];
+            }
+            else
+            {
+                anThisY[iX] = nNoDataVal;
+            }
+        }
+
+        if (iY >= nInterpYOff)
+        {
+            const size_t nInterpOffset =
+                static_cast<size_t>(iY - nInterpYOff) * nBufXSize;
+            std::copy(anThisY.begin(), anThisY.end(),
+                      anTopDownY.begin() + nInterpOffset);
+            std::copy(afThisValue.begin(), afThisValue.end(),
+                      afTopDownValue.begin() + nInterpOffset);
+        }
+
+        std::swap(afThisValue, afLastValue);
+        std::swap(anThisY, anLastY);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the same information from bottom to top, and            */
+    /*      interpolate.                                                    */
+    /* -------------------------------------------------------------------- */
+    std::fill(anLastY.begin(), anLastY.end(), nNoDataVal);
+    for (int iY = nBufYEnd - 1; iY >= nInterpYOff; iY--)
+    {
+        const size_t nOffset = static_cast<size_t>(iY - nBufYOff) * nBufXSize;
+        for (int iX = 0; iX < nBufXSize; iX++)
+        {
+            if (abyMask[nOffset + iX])
+            {
+                afThisValue[iX] = afValues[nOffset + iX];
+                anThisY[iX] = iY;
+            }
+            else if (anLastY[iX] - iY <= dfMaxSearchDist)
+            {
+                afThisValue[iX] = afLastValue[iX];
+                anThisY[iX] = anLastY[iX];
+            }
+            else
+            {
+                anThisY[iX] = nNoDataVal;
+            }
+        }
+
+        if (iY < nInterpYEnd)
+        {
+            const size_t nInterpOffset =
+                static_cast<size_t>(iY - nInterpYOff) * nBufXSize;
+            const size_t nOutOffset =
+                static_cast<size_t>(iY - nInterpYOff) * nInterpXSize;
+            for (int iX = 0; iX < nInterpXSize; iX++)
+            {
+                const int iBufX = nInterpXOff - nBufXOff + iX;
+                float &fOut = afInterp[nOutOffset + iX];
+                fOut = afValues[nOffset + iBufX];
+                abyTMask[nOutOffset + iX] = abyMask[nOffset + iBufX];
+                abyFMask[nOutOffset + iX] = 0;
+                if (abyMask[nOffset + iBufX])
+                    continue;
+
+                float fValue = 0.0f;
+                bool bFilled = false;
+                if (oInterpolator.Interpolate(
+                        iBufX, iY, nBufXSize, anTopDownY.data() + nInterpOffset,
+                        afTopDownValue.data() + nInterpOffset, anLastY.data(),
+                        afLastValue.data(), fValue, bFilled))
+                {
+                    abyFMask[nOutOffset + iX] = 255;
+                    if (bFilled)
+                        abyTMask[nOutOffset + iX] = 255;
+                    fOut = fValue;
+                }
+            }
+        }
+
+        std::swap(afThisValue, afLastValue);
+        std::swap(anThisY, anLastY);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Apply the smoothing iterations. Lines and columns at the edge   */
+    /*      of the interpolated area are only exact at the first            */
+    /*      iterations, but errors do not propagate to the tile.            */
+    /* -------------------------------------------------------------------- */
+    for (int iIter = 0; iIter < nSmoothingIterations; iIter++)
+    {
+        for (int iLine = 0; iLine < nInterpYSize; iLine++)
+        {
+            const size_t nOffset = static_cast<size_t>(iLine) * nInterpXSize;
+            const int iY = nInterpYOff + iLine;
+            // The first and last lines of the raster are not filtered.
+            if (iY < 1 || iY >= nYSize - 1 || iLine == 0 ||
+                iLine == nInterpYSize - 1)
+            {
+                std::copy(afInterp.begin() + nOffset,
+                          afInterp.begin() + nOffset + nInterpXSize,
+                          afSmoothed.begin() + nOffset);
+                continue;
+            }
+
+            GDALFilterLine(afInterp.data() + nOffset - nInterpXSize,
+                           afInterp.data() + nOffset,
+                           afInterp.data() + nOffset + nInterpXSize,
+                           afSmoothed.data() + nOffset,
+                           abyTMask.data() + nOffset - nInterpXSize,
+                           abyTMask.data() + nOffset,
+                           abyTMask.data() + nOffset + nInterpXSize,
+                           abyFMask.data() + nOffset, nInterpXSize);
+        }
+        std::swap(afInterp, afSmoothed);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Write the tile.                                                 */
+    /* -------------------------------------------------------------------- */
+    std::lock_guard<std::mutex> oLock(oMutex);
+    return GDALRasterIO(
+               hOutBand, GF_Write, nTileXOff, nTileYOff,
+               nTileXEnd - nTileXOff, nTileYEnd - nTileYOff,
+               afInterp.data() +
+                   static_cast<size_t>(nTileYOff - nInterpYOff) * nInterpXSize +
+                   (nTileXOff - nInterpXOff),
+               nTileXEnd - nTileXOff, nTileYEnd - nTileYOff, GDT_Float32, 0,
+               static_cast<GSpacing>(nInterpXSize) * sizeof(float)) == CE_None;
+}
+
+static CPLErr GDALFillNodataTiled(
+    GDALRasterBandH hTargetBand, GDALRasterBandH hMaskBand,
+    const GDALFillNodataInterpolator &oInterpolator, int nSmoothingIterations,
+    int nTileSize, int nNumThreads, GDALDriverH hDriver,
+    const CPLString &osTmpFile, CSLConstList papszWorkFileOptions,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    if (!pfnProgress(0.0, "Filling...", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Create a work file to hold the filled tiles.                    */
+    /* -------------------------------------------------------------------- */
+    const CPLString osOutTmpFile = osTmpFile + "fill_out_work.tif";
+
+    auto poOutDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate(hDriver, osOutTmpFile, nXSize, nYSize, 1, GDT_Float32,
+                   papszWorkFileOptions)));
+
+    if (poOutDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not create output work file. Check driver "
+                 "capabilities.");
+        return CE_Failure;
+    }
+    poOutDS->MarkSuppressOnClose();
+
+    GDALFillNodataTiledContext oContext;
+    oContext.hTargetBand = hTargetBand;
+    oContext.hMaskBand = hMaskBand;
+    oContext.hOutBand = GDALRasterBand::ToHandle(poOutDS->GetRasterBand(1));
+    oContext.nXSize = nXSize;
+    oContext.nYSize = nYSize;
+    oContext.nTileSize = nTileSize;
+    oContext.nSmoothingIterations = nSmoothingIterations;
+    oContext.oInterpolator = oInterpolator;
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the tiles, keeping at most two tiles per thread in      */
+    /*      flight to bound memory usage.                                   */
+    /* -------------------------------------------------------------------- */
+    // Reserve 10% of the progress for the final copy.
+    constexpr double dfProgressRatio = 0.9;
+    const int nTilesX = (nXSize + nTileSize - 1) / nTileSize;
+    const int nTilesY = (nYSize + nTileSize - 1) / nTileSize;
+    const double dfTileCount = static_cast<double>(nTilesX) * nTilesY;
+    std::vector<GDALFillNodataTileJob> asJobs;
+    try
+    {
+        asJobs.resize(static_cast<size_t>(nTilesX) * nTilesY);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALFillNodata()");
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+    for (int iTileY = 0; eErr == CE_None && iTileY < nTilesY; iTileY++)
+    {
+        for (int iTileX = 0; eErr == CE_None && iTileX < nTilesX; iTileX++)
+        {
+            if (poJobQueue)
+                poJobQueue->WaitCompletion(2 * nNumThreads - 1);
+
+            auto &sJob =
+                asJobs[static_cast<size_t>(iTileY) * nTilesX + iTileX];
+            sJob.poContext = &oContext;
+            sJob.nTileXOff = iTileX * nTileSize;
+            sJob.nTileYOff = iTileY * nTileSize;
+            if (poJobQueue)
+                poJobQueue->SubmitJob(GDALFillNodataTileJob::Process, &sJob);
+            else
+                GDALFillNodataTileJob::Process(&sJob);
+
+            {
+                std::lock_guard<std::mutex> oLock(oContext.oMutex);
+                eErr = oContext.eErr;
+            }
+            if (eErr == CE_None &&
+                !pfnProgress(dfProgressRatio * oContext.nTilesDone /
+                                 dfTileCount,
+                             "Filling...", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                std::lock_guard<std::mutex> oLock(oContext.oMutex);
+                oContext.eErr = CE_Failure;
+                eErr = CE_Failure;
+            }
+        }
+    }
+
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+    eErr = oContext.eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Copy the result to the target band.                             */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
+        eErr = GDALRasterBandCopyWholeRaster(oContext.hOutBand, hTargetBand,
+                                             nullptr, GDALScaledProgress,
+                                             pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -400,6 +968,20 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>INTERPOLATION=INV_DIST/NEAREST (GDAL >= 3.9). By default, pixels are
  * interpolated using an inverse distance weighting (INV_DIST). It is also
  * possible to choose a nearest neighbour (NEAREST) strategy.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS (GDAL >= 3.10). Number of
+ * worker threads used to process tiles. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1. When greater than 1, the
+ * tiled processing of TILE_SIZE is used.</li>
+ * <li>TILE_SIZE=n (GDAL >= 3.10). When set, or when NUM_THREADS is greater
+ * than 1, the raster is processed by tiles of n x n pixels (512 by default),
+ * each one read with a halo of dfMaxSearchDist + nSmoothingIterations pixels,
+ * and the smoothing iterations are applied in the same pass. Memory usage is
+ * then bounded by the size of the tiles and their halo, instead of the
+ * raster width. The result is the same as with the default line-based
+ * processing, except that the smoothing filter considers as valid the pixels
+ * that were valid or have been interpolated, instead of re-reading the mask
+ * band after interpolation. This is mostly useful when dfMaxSearchDist is
+ * small compared to the raster dimensions.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -480,6 +1062,53 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
 
     const CPLString osTmpFile = CPLGenerateTempFilename("");
 
+    const char *pszNoData = CSLFetchNameValue(papszOptions, "NODATA");
+    bool bHasNoData = false;
+    float fNoData = 0.0f;
+    if (pszNoData)
+    {
+        bHasNoData = true;
+        fNoData = static_cast<float>(CPLAtof(pszNoData));
+    }
+
+    GDALFillNodataInterpolator oInterpolator;
+    oInterpolator.dfMaxSearchDist = dfMaxSearchDist;
+    oInterpolator.nMaxSearchDist = nMaxSearchDist;
+    oInterpolator.nNoDataVal = nNoDataVal;
+    oInterpolator.bNearest = bNearest;
+    oInterpolator.bHasNoData = bHasNoData;
+    oInterpolator.fNoData = fNoData;
+
+    /* -------------------------------------------------------------------- */
+    /*      Use tiled processing if requested.                              */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    int nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    nNumThreads = std::max(1, std::min(128, nNumThreads));
+
+    const char *pszTileSize = CSLFetchNameValue(papszOptions, "TILE_SIZE");
+    if (nNumThreads > 1 || pszTileSize != nullptr)
+    {
+        const int nTileSize = pszTileSize ? atoi(pszTileSize) : 512;
+        if (nTileSize <= 0)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg, "Invalid TILE_SIZE=%s",
+                     pszTileSize);
+            return CE_Failure;
+        }
+        if (pfnProgress == nullptr)
+            pfnProgress = GDALDummyProgress;
+        return GDALFillNodataTiled(
+            hTargetBand,
+            hMaskBand ? hMaskBand : GDALGetMaskBand(hTargetBand),
+            oInterpolator, nSmoothingIterations, nTileSize, nNumThreads,
+            hDriver, osTmpFile, aosWorkFileOptions.List(), pfnProgress,
+            pProgressArg);
+    }
+
     std::unique_ptr<GDALDataset> poTmpMaskDS;
     if (hMaskBand == nullptr)
     {
@@ -516,15 +1145,6 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     // If there are smoothing iterations, reserve 10% of the progress for them.
     const double dfProgressRatio = nSmoothingIterations > 0 ? 0.9 : 1.0;
 
-    const char *pszNoData = CSLFetchNameValue(papszOptions, "NODATA");
-    bool bHasNoData = false;
-    float fNoData = 0.0f;
-    if (pszNoData)
-    {
-        bHasNoData = true;
-        fNoData = static_cast<float>(CPLAtof(pszNoData));
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -799,134 +1419,20 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         memset(pabyFiltMask, 0, nXSize);
         for (int iX = 0; iX < nXSize; iX++)
         {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
             // If this was a valid target - no change.
             if (pabyMask[iX])
                 continue;
 
-            enum Quadrants
-            {
-                QUAD_TOP_LEFT = 0,
-                QUAD_BOTTOM_LEFT = 1,
-                QUAD_TOP_RIGHT = 2,
-                QUAD_BOTTOM_RIGHT = 3,
-            };
-
-            constexpr int QUAD_COUNT = 4;
-            double adfQuadDist[QUAD_COUNT] = {};
-            float afQuadValue[QUAD_COUNT] = {};
-
-            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                afQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
-                           afQuadValue[QUAD_TOP_LEFT], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
-                           afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
-                           afQuadValue[QUAD_TOP_RIGHT], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
-                           afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            bool bHasSrcValues = false;
-            if (bNearest)
+            float fValue = 0.0f;
+            bool bFilled = false;
+            if (oInterpolator.Interpolate(iX, iY, nXSize, panTopDownY,
+                                          pafTopDownValue, panLastY,
+                                          pafLastValue, fValue, bFilled))
             {
-                double dfNearestDist = dfMaxSearchDist + 1;
-                float fNearestValue = 0.0f;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] < dfNearestDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            fNearestValue = afQuadValue[iQuad];
-                            dfNearestDist = adfQuadDist[iQuad];
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfNearestDist <= dfMaxSearchDist)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] = fNearestValue;
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-            else
-            {
-                double dfWeightSum = 0.0;
-                double dfValueSum = 0.0;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                            dfWeightSum += dfWeight;
-                            dfValueSum += afQuadValue[iQuad] * dfWeight;
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfWeightSum > 0.0)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] =
-                            static_cast<float>(dfValueSum / dfWeightSum);
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
+                pabyFiltMask[iX] = 255;
+                if (bFilled)
+                    pabyMask[iX] = 255;
+                pafScanline[iX] = fValue;
             }
         }
 
@@ -27,11 +27,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
+#include "cpl_worker_thread_pool.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 #include "viewshed.h"
 
@@ -119,7 +124,15 @@
  * and dfInvisibleVal will be ignored.
  *
  *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
+ * @param papszExtraOptions Extra options, or NULL. Currently supported:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS (GDAL >= 3.10): number of threads
+ * used for the computation. The lines above and below the observer, and on
+ * its left and right, are processed in parallel, so that at most 4 threads
+ * are used. The result is identical to a single-threaded computation.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * </li>
+ * </ul>
  *
  * @return not NULL output dataset on success (to be closed with GDALClose()) or
  * NULL if an error occurs.
@@ -134,7 +147,7 @@ GDALDatasetH GDALViewshedGenerate(
     double dfOutOfRangeVal, double dfNoDataVal, double dfCurvCoeff,
     GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
     void *pProgressArg, GDALViewshedOutputType heightMode,
-    [[maybe_unused]] CSLConstList papszExtraOptions)
+    CSLConstList papszExtraOptions)
 {
     using namespace gdal;
 
@@ -150,6 +163,12 @@ GDALDatasetH GDALViewshedGenerate(
     oOpts.maxDistance = dfMaxDistance;
     oOpts.nodataVal = dfNoDataVal;
 
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszExtraOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    oOpts.numThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+
     switch (eMode)
     {
         case GVM_Edge:
@@ -258,77 +277,47 @@ double CalcHeightEdge(int i, int j, double Za, double Zb, double Zo)
         return ((Za - Zo) * i + (Zb - Zo) * (j - i)) / (j - 1) + Zo;
 }
 
-}  // unnamed namespace
-
-void Viewshed::setVisibility(int iPixel, double dfZ, double *padfZVal,
-                             std::vector<GByte> &vResult)
-{
-    if (padfZVal[iPixel] + oOpts.targetHeight < dfZ)
-        vResult[iPixel] = oOpts.invisibleVal;
-    else
-        vResult[iPixel] = oOpts.visibleVal;
-
-    if (padfZVal[iPixel] < dfZ)
-        padfZVal[iPixel] = dfZ;
-}
-
-double Viewshed::calcHeight(double dfDiagZ, double dfEdgeZ)
-{
-    double dfHeight = dfEdgeZ;
-
-    switch (oOpts.cellMode)
-    {
-        case Viewshed::CellMode::Max:
-            dfHeight = std::max(dfDiagZ, dfEdgeZ);
-            break;
-        case Viewshed::CellMode::Min:
-            dfHeight = std::min(dfDiagZ, dfEdgeZ);
-            break;
-        case Viewshed::CellMode::Diagonal:
-            dfHeight = dfDiagZ;
-            break;
-        default:  // Edge case set in initialization.
-            break;
-    }
-    return dfHeight;
-}
-
-bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
-                   void *pProgressArg)
+bool GetGeoTransforms(GDALRasterBandH hBand,
+                      std::array<double, 6> &adfGeoTransform,
+                      double *adfInvGeoTransform)
 {
-    if (!pfnProgress)
-        pfnProgress = GDALDummyProgress;
-
-    if (!pfnProgress(0.0, "", pProgressArg))
-    {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return false;
-    }
-
-    /* set up geotransformation */
-    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    adfGeoTransform = {{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
     GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
     if (hSrcDS != nullptr)
         GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
 
-    double adfInvGeoTransform[6];
     if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
         return false;
     }
+    return true;
+}
 
+/// Area of the DEM processed for one observer.
+struct ViewshedWindow
+{
+    int nX = 0;       // Column of the observer, relative to nXStart
+    int nY = 0;       // Line of the observer
+    int nXStart = 0;  // First column of the area
+    int nYStart = 0;  // First line of the area
+    int nXSize = 0;   // Number of columns of the area
+    int nYStop = 0;   // Line after the last line of the area
+};
+
+bool ComputeWindow(const Viewshed::Options &oOpts,
+                   const Viewshed::Point &oObserver,
+                   const double *adfInvGeoTransform, int nRasterXSize,
+                   int nRasterYSize, ViewshedWindow &oWindow)
+{
     /* calculate observer position */
     double dfX, dfY;
-    GDALApplyGeoTransform(adfInvGeoTransform, oOpts.observer.x,
-                          oOpts.observer.y, &dfX, &dfY);
+    GDALApplyGeoTransform(adfInvGeoTransform, oObserver.x, oObserver.y, &dfX,
+                          &dfY);
     int nX = static_cast<int>(dfX);
     int nY = static_cast<int>(dfY);
 
-    int nXSize = GDALGetRasterBandXSize(hBand);
-    int nYSize = GDALGetRasterBandYSize(hBand);
-
-    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
+    if (nX < 0 || nX > nRasterXSize || nY < 0 || nY > nRasterYSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "The observer location falls outside of the DEM area");
@@ -340,8 +329,8 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
 
     int nXStart = 0;
     int nYStart = 0;
-    int nXStop = nXSize;
-    int nYStop = nYSize;
+    int nXStop = nRasterXSize;
+    int nYStop = nRasterYSize;
     if (oOpts.maxDistance > 0)
     {
         nXStart = static_cast<int>(std::floor(
@@ -363,128 +352,118 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
     }
     nXStart = std::max(nXStart, 0);
     nYStart = std::max(nYStart, 0);
-    nXStop = std::min(nXStop, nXSize);
-    nYStop = std::min(nYStop, nYSize);
-
-    /* normalize horizontal index (0 - nXSize) */
-    nXSize = nXStop - nXStart;
-    nX -= nXStart;
+    nXStop = std::min(nXStop, nRasterXSize);
+    nYStop = std::min(nYStop, nRasterYSize);
 
-    nYSize = nYStop - nYStart;
-
-    if (nXSize == 0 || nYSize == 0)
+    if (nXStop - nXStart == 0 || nYStop - nYStart == 0)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
         return false;
     }
 
-    std::vector<double> vFirstLineVal;
-    std::vector<double> vLastLineVal;
-    std::vector<double> vThisLineVal;
-    std::vector<GByte> vResult;
-    std::vector<double> vHeightResult;
-
-    try
-    {
-        vFirstLineVal.resize(nXSize);
-        vLastLineVal.resize(nXSize);
-        vThisLineVal.resize(nXSize);
-        vResult.resize(nXSize);
-
-        if (oOpts.outputMode != OutputMode::Normal)
-            vHeightResult.resize(nXSize);
-    }
-    catch (...)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Cannot allocate vectors for viewshed");
-        return false;
-    }
-
-    double *padfFirstLineVal = vFirstLineVal.data();
-    double *padfLastLineVal = vLastLineVal.data();
-    double *padfThisLineVal = vThisLineVal.data();
-    GByte *pabyResult = vResult.data();
-    double *dfHeightResult = vHeightResult.data();
+    /* normalize horizontal index (0 - nXSize) */
+    oWindow.nX = nX - nXStart;
+    oWindow.nY = nY;
+    oWindow.nXStart = nXStart;
+    oWindow.nYStart = nYStart;
+    oWindow.nXSize = nXStop - nXStart;
+    oWindow.nYStop = nYStop;
+    return true;
+}
 
-    GDALDriverManager *hMgr = GetGDALDriverManager();
-    GDALDriver *hDriver = hMgr->GetDriverByName(oOpts.outputFormat.c_str());
-    if (!hDriver)
+/// Computes the visibility of the pixels of a line of the area processed for
+/// an observer, from the values of the adjacent line closer to the observer.
+/// The pixels on the left and on the right of the column of the observer only
+/// depend on the pixel of that column, so that once it is processed, both
+/// sides of the line can be processed independently.
+class ViewshedLineProcessor
+{
+    using OutputMode = Viewshed::OutputMode;
+    using CellMode = Viewshed::CellMode;
+
+  public:
+    ViewshedLineProcessor(const Viewshed::Options &oOptsIn,
+                          const double *padfGeoTransformIn, int nXIn,
+                          int nXSizeIn, double dfZObserverIn,
+                          double dfSphereDiameterIn)
+        : oOpts(oOptsIn), padfGeoTransform(padfGeoTransformIn), nX(nXIn),
+          nXSize(nXSizeIn), dfZObserver(dfZObserverIn),
+          dfDistance2(oOptsIn.maxDistance * oOptsIn.maxDistance),
+          dfSphereDiameter(dfSphereDiameterIn)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
-        return false;
     }
 
-    /* create output raster */
-    poDstDS.reset(hDriver->Create(
-        oOpts.outputFilename.c_str(), nXSize, nYSize, 1,
-        oOpts.outputMode == OutputMode::Normal ? GDT_Byte : GDT_Float64,
-        const_cast<char **>(oOpts.creationOpts.List())));
-    if (!poDstDS)
+    void processFirstLine(double *padfFirstLineVal, GByte *pabyResult,
+                          double *dfHeightResult) const;
+    void processCenter(int nDY, double *padfThisLineVal,
+                       const double *padfLastLineVal, GByte *pabyResult,
+                       double *dfHeightResult) const;
+    void processLeft(int nDY, double *padfThisLineVal,
+                     const double *padfLastLineVal, GByte *pabyResult,
+                     double *dfHeightResult) const;
+    void processRight(int nDY, double *padfThisLineVal,
+                      const double *padfLastLineVal, GByte *pabyResult,
+                      double *dfHeightResult) const;
+
+  private:
+    const Viewshed::Options &oOpts;
+    const double *padfGeoTransform;
+    const int nX;
+    const int nXSize;
+    const double dfZObserver;
+    const double dfDistance2;
+    const double dfSphereDiameter;
+
+    bool adjustHeightInRange(int nDX, int nDY, double &dfHeight) const
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
-                 oOpts.outputFilename.c_str());
-        return false;
+        return AdjustHeightInRange(padfGeoTransform, nDX, nDY, dfHeight,
+                                   dfDistance2, oOpts.curveCoeff,
+                                   dfSphereDiameter);
     }
-    /* copy srs */
-    if (hSrcDS)
-        poDstDS->SetSpatialRef(
-            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
-
-    std::array<double, 6> adfDstGeoTransform;
-    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
-                            adfGeoTransform[2] * nYStart;
-    adfDstGeoTransform[1] = adfGeoTransform[1];
-    adfDstGeoTransform[2] = adfGeoTransform[2];
-    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
-                            adfGeoTransform[5] * nYStart;
-    adfDstGeoTransform[4] = adfGeoTransform[4];
-    adfDstGeoTransform[5] = adfGeoTransform[5];
-    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
 
-    auto hTargetBand = poDstDS->GetRasterBand(1);
-    if (hTargetBand == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
-                 oOpts.outputFilename.c_str());
-        return false;
-    }
+    void setVisibility(int iPixel, double dfZ, double *padfZVal,
+                       GByte *pabyResult) const;
+    double calcHeight(double dfDiagZ, double dfEdgeZ) const;
+};
 
-    if (oOpts.nodataVal >= 0)
-        GDALSetRasterNoDataValue(hTargetBand, oOpts.nodataVal);
+void ViewshedLineProcessor::setVisibility(int iPixel, double dfZ,
+                                          double *padfZVal,
+                                          GByte *pabyResult) const
+{
+    if (padfZVal[iPixel] + oOpts.targetHeight < dfZ)
+        pabyResult[iPixel] = oOpts.invisibleVal;
+    else
+        pabyResult[iPixel] = oOpts.visibleVal;
 
-    /* process first line */
-    if (GDALRasterIO(hBand, GF_Read, nXStart, nY, nXSize, 1, padfFirstLineVal,
-                     nXSize, 1, GDT_Float64, 0, 0))
-    {
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
-            nXStart, nY, nXSize, 1);
-        return false;
-    }
+    if (padfZVal[iPixel] < dfZ)
+        padfZVal[iPixel] = dfZ;
+}
 
-    const double dfZObserver = oOpts.observer.z + padfFirstLineVal[nX];
-    const double dfDistance2 = oOpts.maxDistance * oOpts.maxDistance;
+double ViewshedLineProcessor::calcHeight(double dfDiagZ, double dfEdgeZ) const
+{
+    double dfHeight = dfEdgeZ;
 
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
+    switch (oOpts.cellMode)
     {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
-
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug("GDALViewshedGenerate",
-                     "Unable to fetch SemiMajor axis from spatial reference");
+        case CellMode::Max:
+            dfHeight = std::max(dfDiagZ, dfEdgeZ);
+            break;
+        case CellMode::Min:
+            dfHeight = std::min(dfDiagZ, dfEdgeZ);
+            break;
+        case CellMode::Diagonal:
+            dfHeight = dfDiagZ;
+            break;
+        default:  // Edge case set in initialization.
+            break;
     }
+    return dfHeight;
+}
 
+void ViewshedLineProcessor::processFirstLine(double *padfFirstLineVal,
+                                             GByte *pabyResult,
+                                             double *dfHeightResult) const
+{
     /* mark the observer point as visible */
     double dfGroundLevel = 0;
     if (oOpts.outputMode == OutputMode::DEM)
@@ -501,9 +480,8 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
     {
         if (oOpts.outputMode == OutputMode::DEM)
             dfGroundLevel = padfFirstLineVal[nX - 1];
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
-            oOpts.curveCoeff, dfSphereDiameter));
+        CPL_IGNORE_RET_VAL(
+            adjustHeightInRange(1, 0, padfFirstLineVal[nX - 1]));
         pabyResult[nX - 1] = oOpts.visibleVal;
         if (oOpts.outputMode != OutputMode::Normal)
             dfHeightResult[nX - 1] = dfGroundLevel;
@@ -512,9 +490,8 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
     {
         if (oOpts.outputMode == OutputMode::DEM)
             dfGroundLevel = padfFirstLineVal[nX + 1];
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
-            oOpts.curveCoeff, dfSphereDiameter));
+        CPL_IGNORE_RET_VAL(
+            adjustHeightInRange(1, 0, padfFirstLineVal[nX + 1]));
         pabyResult[nX + 1] = oOpts.visibleVal;
         if (oOpts.outputMode != OutputMode::Normal)
             dfHeightResult[nX + 1] = dfGroundLevel;
@@ -527,9 +504,7 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
         if (oOpts.outputMode == OutputMode::DEM)
             dfGroundLevel = padfFirstLineVal[iPixel];
 
-        if (AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel, 0,
-                                padfFirstLineVal[iPixel], dfDistance2,
-                                oOpts.curveCoeff, dfSphereDiameter))
+        if (adjustHeightInRange(nX - iPixel, 0, padfFirstLineVal[iPixel]))
         {
             double dfZ = CalcHeightLine(
                 nX - iPixel, padfFirstLineVal[iPixel + 1], dfZObserver);
@@ -538,7 +513,7 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
                 dfHeightResult[iPixel] = std::max(
                     0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
 
-            setVisibility(iPixel, dfZ, padfFirstLineVal, vResult);
+            setVisibility(iPixel, dfZ, padfFirstLineVal, pabyResult);
         }
         else
         {
@@ -556,9 +531,7 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
         dfGroundLevel = 0;
         if (oOpts.outputMode == OutputMode::DEM)
             dfGroundLevel = padfFirstLineVal[iPixel];
-        if (AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX, 0,
-                                padfFirstLineVal[iPixel], dfDistance2,
-                                oOpts.curveCoeff, dfSphereDiameter))
+        if (adjustHeightInRange(iPixel - nX, 0, padfFirstLineVal[iPixel]))
         {
             double dfZ = CalcHeightLine(
                 iPixel - nX, padfFirstLineVal[iPixel - 1], dfZObserver);
@@ -567,7 +540,7 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
                 dfHeightResult[iPixel] = std::max(
                     0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
 
-            setVisibility(iPixel, dfZ, padfFirstLineVal, vResult);
+            setVisibility(iPixel, dfZ, padfFirstLineVal, pabyResult);
         }
         else
         {
@@ -579,337 +552,874 @@ bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
             }
         }
     }
-    /* write result line */
+}
 
-    void *data;
-    GDALDataType dataType;
-    if (oOpts.outputMode == OutputMode::Normal)
+// nDY is the distance in lines between this line and the observer.
+void ViewshedLineProcessor::processCenter(int nDY, double *padfThisLineVal,
+                                          const double *padfLastLineVal,
+                                          GByte *pabyResult,
+                                          double *dfHeightResult) const
+{
+    double dfGroundLevel = 0;
+    if (oOpts.outputMode == OutputMode::DEM)
+        dfGroundLevel = padfThisLineVal[nX];
+    if (adjustHeightInRange(0, nDY, padfThisLineVal[nX]))
     {
-        data = static_cast<void *>(pabyResult);
-        dataType = GDT_Byte;
+        double dfZ = CalcHeightLine(nDY, padfLastLineVal[nX], dfZObserver);
+
+        if (oOpts.outputMode != OutputMode::Normal)
+            dfHeightResult[nX] =
+                std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+
+        setVisibility(nX, dfZ, padfThisLineVal, pabyResult);
     }
     else
     {
-        data = static_cast<void *>(dfHeightResult);
-        dataType = GDT_Float64;
-    }
-    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1, data,
-                     nXSize, 1, dataType, 0, 0))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "RasterIO error when writing target raster at position "
-                 "(%d,%d), size (%d,%d)",
-                 0, nY - nYStart, nXSize, 1);
-        return false;
+        pabyResult[nX] = oOpts.outOfRangeVal;
+        if (oOpts.outputMode != OutputMode::Normal)
+            dfHeightResult[nX] = oOpts.outOfRangeVal;
     }
+}
 
-    /* scan upwards */
-    std::copy(vFirstLineVal.begin(), vFirstLineVal.end(), vLastLineVal.begin());
-    for (int iLine = nY - 1; iLine >= nYStart; iLine--)
+void ViewshedLineProcessor::processLeft(int nDY, double *padfThisLineVal,
+                                        const double *padfLastLineVal,
+                                        GByte *pabyResult,
+                                        double *dfHeightResult) const
+{
+    for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXSize, 1);
-            return false;
-        }
-
-        /* set up initial point on the scanline */
-        dfGroundLevel = 0;
+        double dfGroundLevel = 0;
         if (oOpts.outputMode == OutputMode::DEM)
-            dfGroundLevel = padfThisLineVal[nX];
-        if (AdjustHeightInRange(adfGeoTransform.data(), 0, nY - iLine,
-                                padfThisLineVal[nX], dfDistance2,
-                                oOpts.curveCoeff, dfSphereDiameter))
+            dfGroundLevel = padfThisLineVal[iPixel];
+        if (adjustHeightInRange(nX - iPixel, nDY, padfThisLineVal[iPixel]))
         {
-            double dfZ =
-                CalcHeightLine(nY - iLine, padfLastLineVal[nX], dfZObserver);
+            double dfDiagZ = 0;
+            double dfEdgeZ = 0;
+            if (oOpts.cellMode != CellMode::Edge)
+                dfDiagZ = CalcHeightDiagonal(
+                    nX - iPixel, nDY, padfThisLineVal[iPixel + 1],
+                    padfLastLineVal[iPixel], dfZObserver);
+
+            if (oOpts.cellMode != CellMode::Diagonal)
+                dfEdgeZ = nX - iPixel >= nDY
+                              ? CalcHeightEdge(nDY, nX - iPixel,
+                                               padfLastLineVal[iPixel + 1],
+                                               padfThisLineVal[iPixel + 1],
+                                               dfZObserver)
+                              : CalcHeightEdge(nX - iPixel, nDY,
+                                               padfLastLineVal[iPixel + 1],
+                                               padfLastLineVal[iPixel],
+                                               dfZObserver);
+
+            double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
 
             if (oOpts.outputMode != OutputMode::Normal)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
 
-            setVisibility(nX, dfZ, padfThisLineVal, vResult);
+            setVisibility(iPixel, dfZ, padfThisLineVal, pabyResult);
         }
         else
         {
-            pabyResult[nX] = oOpts.outOfRangeVal;
-            if (oOpts.outputMode != OutputMode::Normal)
-                dfHeightResult[nX] = oOpts.outOfRangeVal;
+            for (; iPixel >= 0; iPixel--)
+            {
+                pabyResult[iPixel] = oOpts.outOfRangeVal;
+                if (oOpts.outputMode != OutputMode::Normal)
+                    dfHeightResult[iPixel] = oOpts.outOfRangeVal;
+            }
         }
+    }
+}
+
+void ViewshedLineProcessor::processRight(int nDY, double *padfThisLineVal,
+                                         const double *padfLastLineVal,
+                                         GByte *pabyResult,
+                                         double *dfHeightResult) const
+{
+    for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
+    {
+        double dfGroundLevel = 0;
+        if (oOpts.outputMode == OutputMode::DEM)
+            dfGroundLevel = padfThisLineVal[iPixel];
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
+        if (adjustHeightInRange(iPixel - nX, nDY, padfThisLineVal[iPixel]))
         {
-            dfGroundLevel = 0;
-            if (oOpts.outputMode == OutputMode::DEM)
-                dfGroundLevel = padfThisLineVal[iPixel];
-            if (AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, oOpts.curveCoeff,
-                                    dfSphereDiameter))
-            {
-                double dfDiagZ = 0;
-                double dfEdgeZ = 0;
-                if (oOpts.cellMode != CellMode::Edge)
-                    dfDiagZ = CalcHeightDiagonal(
-                        nX - iPixel, nY - iLine, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (oOpts.cellMode != CellMode::Diagonal)
-                    dfEdgeZ = nX - iPixel >= nY - iLine
-                                  ? CalcHeightEdge(nY - iLine, nX - iPixel,
-                                                   padfLastLineVal[iPixel + 1],
-                                                   padfThisLineVal[iPixel + 1],
-                                                   dfZObserver)
-                                  : CalcHeightEdge(nX - iPixel, nY - iLine,
-                                                   padfLastLineVal[iPixel + 1],
-                                                   padfLastLineVal[iPixel],
-                                                   dfZObserver);
-
-                double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
+            double dfDiagZ = 0;
+            double dfEdgeZ = 0;
+            if (oOpts.cellMode != CellMode::Edge)
+                dfDiagZ = CalcHeightDiagonal(
+                    iPixel - nX, nDY, padfThisLineVal[iPixel - 1],
+                    padfLastLineVal[iPixel], dfZObserver);
+
+            if (oOpts.cellMode != CellMode::Diagonal)
+                dfEdgeZ = iPixel - nX >= nDY
+                              ? CalcHeightEdge(nDY, iPixel - nX,
+                                               padfLastLineVal[iPixel - 1],
+                                               padfThisLineVal[iPixel - 1],
+                                               dfZObserver)
+                              : CalcHeightEdge(iPixel - nX, nDY,
+                                               padfLastLineVal[iPixel - 1],
+                                               padfLastLineVal[iPixel],
+                                               dfZObserver);
+
+            double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
 
-                if (oOpts.outputMode != OutputMode::Normal)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+            if (oOpts.outputMode != OutputMode::Normal)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
 
-                setVisibility(iPixel, dfZ, padfThisLineVal, vResult);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = oOpts.outOfRangeVal;
-                    if (oOpts.outputMode != OutputMode::Normal)
-                        dfHeightResult[iPixel] = oOpts.outOfRangeVal;
-                }
-            }
+            setVisibility(iPixel, dfZ, padfThisLineVal, pabyResult);
         }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
+        else
         {
-            dfGroundLevel = 0;
-            if (oOpts.outputMode == OutputMode::DEM)
-                dfGroundLevel = padfThisLineVal[iPixel];
-
-            if (AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, oOpts.curveCoeff,
-                                    dfSphereDiameter))
+            for (; iPixel < nXSize; iPixel++)
             {
-                double dfDiagZ = 0;
-                double dfEdgeZ = 0;
-                if (oOpts.cellMode != CellMode::Edge)
-                    dfDiagZ = CalcHeightDiagonal(
-                        iPixel - nX, nY - iLine, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-                if (oOpts.cellMode != CellMode::Diagonal)
-                    dfEdgeZ = iPixel - nX >= nY - iLine
-                                  ? CalcHeightEdge(nY - iLine, iPixel - nX,
-                                                   padfLastLineVal[iPixel - 1],
-                                                   padfThisLineVal[iPixel - 1],
-                                                   dfZObserver)
-                                  : CalcHeightEdge(iPixel - nX, nY - iLine,
-                                                   padfLastLineVal[iPixel - 1],
-                                                   padfLastLineVal[iPixel],
-                                                   dfZObserver);
-
-                double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
-
+                pabyResult[iPixel] = oOpts.outOfRangeVal;
                 if (oOpts.outputMode != OutputMode::Normal)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                setVisibility(iPixel, dfZ, padfThisLineVal, vResult);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = oOpts.outOfRangeVal;
-                    if (oOpts.outputMode != OutputMode::Normal)
-                        dfHeightResult[iPixel] = oOpts.outOfRangeVal;
-                }
+                    dfHeightResult[iPixel] = oOpts.outOfRangeVal;
             }
         }
+    }
+}
 
-        /* write result line */
-        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                         data, nXSize, 1, dataType, 0, 0))
+/// Lines above or below the observer.
+struct ViewshedHalf
+{
+    int nDirection = 0;  // -1 for the lines above the observer, 1 below
+    int nLines = 0;
+    // For each of the 2 chunks being processed and read/written: the DEM
+    // values of the lines, preceded by the last line of the previous chunk,
+    // and the output values.
+    std::vector<double> adfLineVal[2]{};
+    std::vector<GByte> abyResult[2]{};
+    std::vector<double> adfHeightResult[2]{};
+};
+
+/// Processing of the left or right side of the lines of a chunk.
+struct ViewshedSweepJob
+{
+    const ViewshedLineProcessor *poProcessor = nullptr;
+    bool bLeft = false;
+    // Distance in lines between the first line of the chunk and the observer
+    int nFirstDY = 0;
+    int nLines = 0;
+    int nXSize = 0;
+    double *padfLineVal = nullptr;
+    GByte *pabyResult = nullptr;
+    double *padfHeightResult = nullptr;
+
+    static void Process(void *pJob)
+    {
+        const auto psJob = static_cast<const ViewshedSweepJob *>(pJob);
+        for (int i = 0; i < psJob->nLines; ++i)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return false;
+            const size_t nOffset = static_cast<size_t>(i) * psJob->nXSize;
+            double *padfThisLineVal =
+                psJob->padfLineVal + nOffset + psJob->nXSize;
+            const double *padfLastLineVal = psJob->padfLineVal + nOffset;
+            GByte *pabyResult = psJob->pabyResult + nOffset;
+            double *padfHeightResult = psJob->padfHeightResult
+                                           ? psJob->padfHeightResult + nOffset
+                                           : nullptr;
+            if (psJob->bLeft)
+                psJob->poProcessor->processLeft(
+                    psJob->nFirstDY + i, padfThisLineVal, padfLastLineVal,
+                    pabyResult, padfHeightResult);
+            else
+                psJob->poProcessor->processRight(
+                    psJob->nFirstDY + i, padfThisLineVal, padfLastLineVal,
+                    pabyResult, padfHeightResult);
         }
+    }
+};
+
+/// State shared by the jobs of a cumulative viewshed.
+struct ViewshedCumulativeContext
+{
+    const Viewshed::Options *poOpts = nullptr;
+    const double *padfGeoTransform = nullptr;
+    double dfSphereDiameter = 0;
+    // DEM values of the area covering all the observers, and number of
+    // observers from which each of its pixels is visible.
+    const double *padfDEM = nullptr;
+    std::atomic<GUInt32> *panCounts = nullptr;
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    std::atomic<bool> bStop{false};
+    std::atomic<bool> bError{false};
+};
+
+/// Processing of the viewshed of one observer of a cumulative viewshed.
+struct ViewshedObserverJob
+{
+    ViewshedCumulativeContext *psContext = nullptr;
+    const ViewshedWindow *psWindow = nullptr;
+    double dfObserverHeight = 0;
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    static void Process(void *pJob);
+};
 
-        if (!pfnProgress((nY - iLine) / static_cast<double>(nYSize), "",
-                         pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            return false;
-        }
+void ViewshedObserverJob::Process(void *pJob)
+{
+    const auto psJob = static_cast<const ViewshedObserverJob *>(pJob);
+    auto &sContext = *(psJob->psContext);
+    const auto &oWindow = *(psJob->psWindow);
+    if (sContext.bStop || sContext.bError)
+        return;
+
+    const int nX = oWindow.nX;
+    const int nY = oWindow.nY;
+    const int nXSize = oWindow.nXSize;
+    std::vector<double> vFirstLineVal;
+    std::vector<double> vLastLineVal;
+    std::vector<double> vThisLineVal;
+    std::vector<GByte> vResult;
+    try
+    {
+        vFirstLineVal.resize(nXSize);
+        vLastLineVal.resize(nXSize);
+        vThisLineVal.resize(nXSize);
+        vResult.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        sContext.bError = true;
+        return;
     }
 
-    /* scan downwards */
-    memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
-    for (int iLine = nY + 1; iLine < nYStop; iLine++)
+    const size_t nColOffset =
+        static_cast<size_t>(oWindow.nXStart - sContext.nXOff);
+    const auto GetLineOffset = [&sContext, nColOffset](int iLine)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
+        return static_cast<size_t>(iLine - sContext.nYOff) * sContext.nXSize +
+               nColOffset;
+    };
+    const auto ReadLine = [&sContext, nXSize, &GetLineOffset](int iLine,
+                                                              double *padfVal)
+    {
+        memcpy(padfVal, sContext.padfDEM + GetLineOffset(iLine),
+               nXSize * sizeof(double));
+    };
+    const auto AddLine = [&sContext, nXSize, &GetLineOffset,
+                          &vResult](int iLine)
+    {
+        std::atomic<GUInt32> *panCounts =
+            sContext.panCounts + GetLineOffset(iLine);
+        for (int i = 0; i < nXSize; ++i)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXStop - nXStart, 1);
-            return false;
+            if (vResult[i])
+                panCounts[i].fetch_add(1, std::memory_order_relaxed);
         }
+    };
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = 0;
-        if (oOpts.outputMode == OutputMode::DEM)
-            dfGroundLevel = padfThisLineVal[nX];
+    ReadLine(nY, vFirstLineVal.data());
+    const ViewshedLineProcessor oProcessor(
+        *sContext.poOpts, sContext.padfGeoTransform, nX, nXSize,
+        psJob->dfObserverHeight + vFirstLineVal[nX], sContext.dfSphereDiameter);
+    oProcessor.processFirstLine(vFirstLineVal.data(), vResult.data(), nullptr);
+    AddLine(nY);
 
-        if (AdjustHeightInRange(adfGeoTransform.data(), 0, iLine - nY,
-                                padfThisLineVal[nX], dfDistance2,
-                                oOpts.curveCoeff, dfSphereDiameter))
+    /* scan upwards, then downwards */
+    for (int nDirection : {-1, 1})
+    {
+        double *padfLastLineVal = vLastLineVal.data();
+        double *padfThisLineVal = vThisLineVal.data();
+        memcpy(padfLastLineVal, vFirstLineVal.data(), nXSize * sizeof(double));
+        for (int iLine = nY + nDirection;
+             iLine >= oWindow.nYStart && iLine < oWindow.nYStop;
+             iLine += nDirection)
         {
-            double dfZ =
-                CalcHeightLine(iLine - nY, padfLastLineVal[nX], dfZObserver);
+            const int nDY = std::abs(iLine - nY);
+            ReadLine(iLine, padfThisLineVal);
+            oProcessor.processCenter(nDY, padfThisLineVal, padfLastLineVal,
+                                     vResult.data(), nullptr);
+            oProcessor.processLeft(nDY, padfThisLineVal, padfLastLineVal,
+                                   vResult.data(), nullptr);
+            oProcessor.processRight(nDY, padfThisLineVal, padfLastLineVal,
+                                    vResult.data(), nullptr);
+            AddLine(iLine);
+            std::swap(padfLastLineVal, padfThisLineVal);
+        }
+    }
+}
 
-            if (oOpts.outputMode != OutputMode::Normal)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+int GetNumThreads(const Viewshed::Options &oOpts)
+{
+    return std::max(1, std::min(128, oOpts.numThreads));
+}
 
-            setVisibility(nX, dfZ, padfThisLineVal, vResult);
-        }
+}  // unnamed namespace
+
+bool Viewshed::createOutput(GDALRasterBandH hBand,
+                            const double *padfGeoTransform, int nXStart,
+                            int nYStart, int nXSize, int nYSize,
+                            GDALDataType eType, double &dfSphereDiameter)
+{
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver = hMgr->GetDriverByName(oOpts.outputFormat.c_str());
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return false;
+    }
+
+    /* create output raster */
+    poDstDS.reset(hDriver->Create(
+        oOpts.outputFilename.c_str(), nXSize, nYSize, 1, eType,
+        const_cast<char **>(oOpts.creationOpts.List())));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 oOpts.outputFilename.c_str());
+        return false;
+    }
+    /* copy srs */
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = padfGeoTransform[0] +
+                            padfGeoTransform[1] * nXStart +
+                            padfGeoTransform[2] * nYStart;
+    adfDstGeoTransform[1] = padfGeoTransform[1];
+    adfDstGeoTransform[2] = padfGeoTransform[2];
+    adfDstGeoTransform[3] = padfGeoTransform[3] +
+                            padfGeoTransform[4] * nXStart +
+                            padfGeoTransform[5] * nYStart;
+    adfDstGeoTransform[4] = padfGeoTransform[4];
+    adfDstGeoTransform[5] = padfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+
+    auto hTargetBand = poDstDS->GetRasterBand(1);
+    if (hTargetBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
+                 oOpts.outputFilename.c_str());
+        return false;
+    }
+
+    if (oOpts.nodataVal >= 0)
+        GDALSetRasterNoDataValue(hTargetBand, oOpts.nodataVal);
+
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+     */
+    dfSphereDiameter = std::numeric_limits<double>::infinity();
+    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
+    if (poDstSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
+
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            dfSphereDiameter = dfSemiMajor * 2.0;
         else
-        {
-            pabyResult[nX] = oOpts.outOfRangeVal;
-            if (oOpts.outputMode != OutputMode::Normal)
-                dfHeightResult[nX] = oOpts.outOfRangeVal;
-        }
+            CPLDebug("GDALViewshedGenerate",
+                     "Unable to fetch SemiMajor axis from spatial reference");
+    }
+
+    return true;
+}
+
+bool Viewshed::run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
+                   void *pProgressArg)
+{
+    if (!pfnProgress)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform;
+    double adfInvGeoTransform[6];
+    if (!GetGeoTransforms(hBand, adfGeoTransform, adfInvGeoTransform))
+        return false;
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
+    ViewshedWindow oWindow;
+    if (!ComputeWindow(oOpts, oOpts.observer, adfInvGeoTransform,
+                       GDALGetRasterBandXSize(hBand),
+                       GDALGetRasterBandYSize(hBand), oWindow))
+        return false;
+
+    const int nX = oWindow.nX;
+    const int nY = oWindow.nY;
+    const int nXStart = oWindow.nXStart;
+    const int nYStart = oWindow.nYStart;
+    const int nXSize = oWindow.nXSize;
+    const int nYStop = oWindow.nYStop;
+    const int nYSize = nYStop - nYStart;
+
+    std::vector<double> vFirstLineVal;
+    std::vector<GByte> vResult;
+    std::vector<double> vHeightResult;
+
+    try
+    {
+        vFirstLineVal.resize(nXSize);
+        vResult.resize(nXSize);
+
+        if (oOpts.outputMode != OutputMode::Normal)
+            vHeightResult.resize(nXSize);
+    }
+    catch (...)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot allocate vectors for viewshed");
+        return false;
+    }
+
+    double *padfFirstLineVal = vFirstLineVal.data();
+    GByte *pabyResult = vResult.data();
+    double *dfHeightResult = vHeightResult.data();
+
+    double dfSphereDiameter = 0;
+    if (!createOutput(hBand, adfGeoTransform.data(), nXStart, nYStart, nXSize,
+                      nYSize,
+                      oOpts.outputMode == OutputMode::Normal ? GDT_Byte
+                                                             : GDT_Float64,
+                      dfSphereDiameter))
+        return false;
+    GDALRasterBandH hTargetBand =
+        GDALRasterBand::ToHandle(poDstDS->GetRasterBand(1));
+
+    /* process first line */
+    if (GDALRasterIO(hBand, GF_Read, nXStart, nY, nXSize, 1, padfFirstLineVal,
+                     nXSize, 1, GDT_Float64, 0, 0))
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
+            nXStart, nY, nXSize, 1);
+        return false;
+    }
+
+    const ViewshedLineProcessor oProcessor(
+        oOpts, adfGeoTransform.data(), nX, nXSize,
+        oOpts.observer.z + padfFirstLineVal[nX], dfSphereDiameter);
+    oProcessor.processFirstLine(padfFirstLineVal, pabyResult, dfHeightResult);
+
+    /* write result line */
+    void *data;
+    GDALDataType dataType;
+    if (oOpts.outputMode == OutputMode::Normal)
+    {
+        data = static_cast<void *>(pabyResult);
+        dataType = GDT_Byte;
+    }
+    else
+    {
+        data = static_cast<void *>(dfHeightResult);
+        dataType = GDT_Float64;
+    }
+    if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1, data,
+                     nXSize, 1, dataType, 0, 0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when writing target raster at position "
+                 "(%d,%d), size (%d,%d)",
+                 0, nY - nYStart, nXSize, 1);
+        return false;
+    }
+
+    /* scan upwards and downwards, by chunks of lines */
+
+    // The pixels of the lines of a chunk in the column of the observer are
+    // processed first. The left and right sides of the chunk can then be
+    // processed independently, and both halves too, so up to 4 threads are
+    // used. Reading and writing is done in the calling thread, while the
+    // worker threads process the previous chunk.
+    constexpr size_t MAX_BUFFER_SIZE = 64 * 1024 * 1024;
+    const size_t nBytesPerLine =
+        static_cast<size_t>(nXSize) * 4 *
+        (sizeof(double) + (oOpts.outputMode == OutputMode::Normal
+                               ? sizeof(GByte)
+                               : sizeof(double)));
+    int nChunkLines = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(256, MAX_BUFFER_SIZE / nBytesPerLine)));
+    nChunkLines = static_cast<int>(GDALGetTestChunkSize(
+        nChunkLines, std::numeric_limits<int>::max()));
+
+    ViewshedHalf asHalves[2];
+    asHalves[0].nDirection = -1;
+    asHalves[0].nLines = nY - nYStart;
+    asHalves[1].nDirection = 1;
+    asHalves[1].nLines = nYStop - nY - 1;
+    try
+    {
+        for (auto &sHalf : asHalves)
         {
-            dfGroundLevel = 0;
-            if (oOpts.outputMode == OutputMode::DEM)
-                dfGroundLevel = padfThisLineVal[iPixel];
-
-            if (AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, oOpts.curveCoeff,
-                                    dfSphereDiameter))
+            if (sHalf.nLines == 0)
+                continue;
+            const size_t nChunkSize = static_cast<size_t>(nChunkLines) * nXSize;
+            for (int k = 0; k < 2; ++k)
             {
-                double dfDiagZ = 0;
-                double dfEdgeZ = 0;
-                if (oOpts.cellMode != CellMode::Edge)
-                    dfDiagZ = CalcHeightDiagonal(
-                        nX - iPixel, iLine - nY, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (oOpts.cellMode != CellMode::Diagonal)
-                    dfEdgeZ = nX - iPixel >= iLine - nY
-                                  ? CalcHeightEdge(iLine - nY, nX - iPixel,
-                                                   padfLastLineVal[iPixel + 1],
-                                                   padfThisLineVal[iPixel + 1],
-                                                   dfZObserver)
-                                  : CalcHeightEdge(nX - iPixel, iLine - nY,
-                                                   padfLastLineVal[iPixel + 1],
-                                                   padfLastLineVal[iPixel],
-                                                   dfZObserver);
-
-                double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
-
+                sHalf.adfLineVal[k].resize(nChunkSize + nXSize);
+                sHalf.abyResult[k].resize(nChunkSize);
                 if (oOpts.outputMode != OutputMode::Normal)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                setVisibility(iPixel, dfZ, padfThisLineVal, vResult);
+                    sHalf.adfHeightResult[k].resize(nChunkSize);
             }
-            else
+            memcpy(sHalf.adfLineVal[0].data(), padfFirstLineVal,
+                   nXSize * sizeof(double));
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        return false;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    const int nNumThreads = GetNumThreads(oOpts);
+    if (nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(std::min(nNumThreads, 4));
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+        if (!poJobQueue)
+            return false;
+    }
+
+    const auto GetChunkLines = [nChunkLines](const ViewshedHalf &sHalf,
+                                             int iChunk)
+    {
+        return std::max(
+            0, std::min(nChunkLines, sHalf.nLines - iChunk * nChunkLines));
+    };
+    const auto GetLine = [nY, nChunkLines](const ViewshedHalf &sHalf,
+                                           int iChunk, int i)
+    { return nY + sHalf.nDirection * (1 + iChunk * nChunkLines + i); };
+
+    const auto ReadChunk = [&](int iChunk)
+    {
+        const int k = iChunk % 2;
+        for (auto &sHalf : asHalves)
+        {
+            for (int i = 0; i < GetChunkLines(sHalf, iChunk); ++i)
             {
-                for (; iPixel >= 0; iPixel--)
+                const int iLine = GetLine(sHalf, iChunk, i);
+                if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
+                                 sHalf.adfLineVal[k].data() +
+                                     static_cast<size_t>(i + 1) * nXSize,
+                                 nXSize, 1, GDT_Float64, 0, 0))
                 {
-                    pabyResult[iPixel] = oOpts.outOfRangeVal;
-                    if (oOpts.outputMode != OutputMode::Normal)
-                        dfHeightResult[iPixel] = oOpts.outOfRangeVal;
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "RasterIO error when reading DEM at position "
+                             "(%d,%d), size (%d,%d)",
+                             nXStart, iLine, nXSize, 1);
+                    return false;
                 }
             }
         }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
+        return true;
+    };
+
+    int nLinesDone = 1;
+    const auto WriteChunk = [&](int iChunk)
+    {
+        const int k = iChunk % 2;
+        for (auto &sHalf : asHalves)
         {
-            dfGroundLevel = 0;
-            if (oOpts.outputMode == OutputMode::DEM)
-                dfGroundLevel = padfThisLineVal[iPixel];
-
-            if (AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, oOpts.curveCoeff,
-                                    dfSphereDiameter))
+            const int nLines = GetChunkLines(sHalf, iChunk);
+            for (int i = 0; i < nLines; ++i)
             {
-                double dfDiagZ = 0;
-                double dfEdgeZ = 0;
-                if (oOpts.cellMode != CellMode::Edge)
-                    dfDiagZ = CalcHeightDiagonal(
-                        iPixel - nX, iLine - nY, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (oOpts.cellMode != CellMode::Diagonal)
-                    dfEdgeZ = iPixel - nX >= iLine - nY
-                                  ? CalcHeightEdge(iLine - nY, iPixel - nX,
-                                                   padfLastLineVal[iPixel - 1],
-                                                   padfThisLineVal[iPixel - 1],
-                                                   dfZObserver)
-                                  : CalcHeightEdge(iPixel - nX, iLine - nY,
-                                                   padfLastLineVal[iPixel - 1],
-                                                   padfLastLineVal[iPixel],
-                                                   dfZObserver);
-
-                double dfZ = calcHeight(dfDiagZ, dfEdgeZ);
+                const int iLine = GetLine(sHalf, iChunk, i);
+                const size_t nOffset = static_cast<size_t>(i) * nXSize;
+                void *pLineData =
+                    oOpts.outputMode == OutputMode::Normal
+                        ? static_cast<void *>(sHalf.abyResult[k].data() +
+                                              nOffset)
+                        : static_cast<void *>(sHalf.adfHeightResult[k].data() +
+                                              nOffset);
+                if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart,
+                                 nXSize, 1, pLineData, nXSize, 1, dataType, 0,
+                                 0))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "RasterIO error when writing target raster at "
+                             "position (%d,%d), size (%d,%d)",
+                             0, iLine - nYStart, nXSize, 1);
+                    return false;
+                }
+            }
+            nLinesDone += nLines;
+        }
 
-                if (oOpts.outputMode != OutputMode::Normal)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+        if (!pfnProgress(nLinesDone / static_cast<double>(nYSize), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        return true;
+    };
+
+    std::array<ViewshedSweepJob, 4> asJobs;
+    const auto ProcessChunk = [&](int iChunk)
+    {
+        const int k = iChunk % 2;
+        const int nFirstDY = 1 + iChunk * nChunkLines;
+        int iJob = 0;
+        for (auto &sHalf : asHalves)
+        {
+            const int nLines = GetChunkLines(sHalf, iChunk);
+            if (nLines == 0)
+                continue;
+            double *padfLineVal = sHalf.adfLineVal[k].data();
+            GByte *pabyChunkResult = sHalf.abyResult[k].data();
+            double *padfChunkHeightResult =
+                sHalf.adfHeightResult[k].empty()
+                    ? nullptr
+                    : sHalf.adfHeightResult[k].data();
+            for (int i = 0; i < nLines; ++i)
+            {
+                const size_t nOffset = static_cast<size_t>(i) * nXSize;
+                oProcessor.processCenter(
+                    nFirstDY + i, padfLineVal + nOffset + nXSize,
+                    padfLineVal + nOffset, pabyChunkResult + nOffset,
+                    padfChunkHeightResult ? padfChunkHeightResult + nOffset
+                                          : nullptr);
+            }
 
-                setVisibility(iPixel, dfZ, padfThisLineVal, vResult);
+            for (const bool bLeft : {true, false})
+            {
+                auto &sJob = asJobs[iJob++];
+                sJob.poProcessor = &oProcessor;
+                sJob.bLeft = bLeft;
+                sJob.nFirstDY = nFirstDY;
+                sJob.nLines = nLines;
+                sJob.nXSize = nXSize;
+                sJob.padfLineVal = padfLineVal;
+                sJob.pabyResult = pabyChunkResult;
+                sJob.padfHeightResult = padfChunkHeightResult;
+                if (poJobQueue)
+                    poJobQueue->SubmitJob(ViewshedSweepJob::Process, &sJob);
+                else
+                    ViewshedSweepJob::Process(&sJob);
             }
-            else
+        }
+    };
+
+    const int nChunks = DIV_ROUND_UP(
+        std::max(asHalves[0].nLines, asHalves[1].nLines), nChunkLines);
+    bool bRet = ReadChunk(0);
+    for (int iChunk = 0; bRet && iChunk < nChunks; ++iChunk)
+    {
+        const int k = iChunk % 2;
+        ProcessChunk(iChunk);
+
+        // Meanwhile, write the output of the previous chunk, and read the
+        // input of the next one.
+        if (iChunk > 0)
+            bRet = WriteChunk(iChunk - 1);
+        if (bRet && iChunk + 1 < nChunks)
+            bRet = ReadChunk(iChunk + 1);
+
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        // The last line of this chunk is the one before the next chunk.
+        if (bRet && iChunk + 1 < nChunks)
+        {
+            for (auto &sHalf : asHalves)
             {
-                for (; iPixel < nXSize; iPixel++)
+                if (GetChunkLines(sHalf, iChunk + 1) > 0)
                 {
-                    pabyResult[iPixel] = oOpts.outOfRangeVal;
-                    if (oOpts.outputMode != OutputMode::Normal)
-                        dfHeightResult[iPixel] = oOpts.outOfRangeVal;
+                    memcpy(sHalf.adfLineVal[1 - k].data(),
+                           sHalf.adfLineVal[k].data() +
+                               static_cast<size_t>(nChunkLines) * nXSize,
+                           nXSize * sizeof(double));
                 }
             }
         }
+    }
+    if (bRet && nChunks > 0)
+        bRet = WriteChunk(nChunks - 1);
+    if (!bRet)
+        return false;
 
-        /* write result line */
-        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                         data, nXSize, 1, dataType, 0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+
+    return true;
+}
+
+bool Viewshed::runCumulative(GDALRasterBandH hBand,
+                             const std::vector<Point> &observers,
+                             GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    if (!pfnProgress)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return false;
+    }
+
+    if (observers.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No observer specified");
+        return false;
+    }
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform;
+    double adfInvGeoTransform[6];
+    if (!GetGeoTransforms(hBand, adfGeoTransform, adfInvGeoTransform))
+        return false;
+
+    /* compute the area of each observer, and their union */
+    std::vector<ViewshedWindow> aoWindows(observers.size());
+    int nXStart = std::numeric_limits<int>::max();
+    int nYStart = std::numeric_limits<int>::max();
+    int nXStop = 0;
+    int nYStop = 0;
+    for (size_t i = 0; i < observers.size(); ++i)
+    {
+        auto &oWindow = aoWindows[i];
+        if (!ComputeWindow(oOpts, observers[i], adfInvGeoTransform,
+                           GDALGetRasterBandXSize(hBand),
+                           GDALGetRasterBandYSize(hBand), oWindow))
             return false;
-        }
+        nXStart = std::min(nXStart, oWindow.nXStart);
+        nYStart = std::min(nYStart, oWindow.nYStart);
+        nXStop = std::max(nXStop, oWindow.nXStart + oWindow.nXSize);
+        nYStop = std::max(nYStop, oWindow.nYStop);
+    }
+    const int nXSize = nXStop - nXStart;
+    const int nYSize = nYStop - nYStart;
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    ViewshedCumulativeContext sContext;
+    std::vector<double> vDEM;
+    std::unique_ptr<std::atomic<GUInt32>[]> panCounts;
+    try
+    {
+        const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+        vDEM.resize(nPixels);
+        panCounts.reset(new std::atomic<GUInt32>[nPixels]());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate buffers for cumulative viewshed");
+        return false;
+    }
 
-        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
-                         pProgressArg))
+    if (!createOutput(hBand, adfGeoTransform.data(), nXStart, nYStart, nXSize,
+                      nYSize, GDT_UInt32, sContext.dfSphereDiameter))
+        return false;
+
+    /* read the DEM once for all observers */
+    if (GDALRasterIO(hBand, GF_Read, nXStart, nYStart, nXSize, nYSize,
+                     vDEM.data(), nXSize, nYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
+            nXStart, nYStart, nXSize, nYSize);
+        return false;
+    }
+
+    // Only the visibility matters, and it is counted for non-zero values.
+    Options oObserverOpts(oOpts);
+    oObserverOpts.outputMode = OutputMode::Normal;
+    oObserverOpts.visibleVal = 1;
+    oObserverOpts.invisibleVal = 0;
+    oObserverOpts.outOfRangeVal = 0;
+
+    sContext.poOpts = &oObserverOpts;
+    sContext.padfGeoTransform = adfGeoTransform.data();
+    sContext.padfDEM = vDEM.data();
+    sContext.panCounts = panCounts.get();
+    sContext.nXOff = nXStart;
+    sContext.nYOff = nYStart;
+    sContext.nXSize = nXSize;
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    const int nNumThreads = GetNumThreads(oOpts);
+    if (nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+        if (!poJobQueue)
+            return false;
+    }
+
+    const int nObservers = static_cast<int>(observers.size());
+    std::vector<ViewshedObserverJob> asJobs(nObservers);
+    for (int i = 0; i < nObservers; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.psContext = &sContext;
+        sJob.psWindow = &aoWindows[i];
+        sJob.dfObserverHeight = observers[i].z;
+        if (poJobQueue)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            poJobQueue->SubmitJob(ViewshedObserverJob::Process, &sJob);
+        }
+        else
+        {
+            ViewshedObserverJob::Process(&sJob);
+            if (sContext.bError)
+                return false;
+            if (!pfnProgress((i + 1) / static_cast<double>(nObservers), "",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
+            }
+        }
+    }
+    if (poJobQueue)
+    {
+        for (int i = 0; i < nObservers; ++i)
+        {
+            poJobQueue->WaitCompletion(nObservers - i - 1);
+            if (!pfnProgress((i + 1) / static_cast<double>(nObservers), "",
+                             pProgressArg))
+            {
+                sContext.bStop = true;
+                poJobQueue->WaitCompletion();
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
+            }
+        }
+        if (sContext.bError)
+            return false;
+    }
+
+    /* write the counts */
+    GDALRasterBandH hTargetBand =
+        GDALRasterBand::ToHandle(poDstDS->GetRasterBand(1));
+    std::vector<GUInt32> anLineCounts(nXSize);
+    for (int iLine = 0; iLine < nYSize; ++iLine)
+    {
+        const std::atomic<GUInt32> *panLineCounts =
+            panCounts.get() + static_cast<size_t>(iLine) * nXSize;
+        for (int i = 0; i < nXSize; ++i)
+            anLineCounts[i] = panLineCounts[i].load(std::memory_order_relaxed);
+        if (GDALRasterIO(hTargetBand, GF_Write, 0, iLine, nXSize, 1,
+                         anLineCounts.data(), nXSize, 1, GDT_UInt32, 0, 0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when writing target raster at position "
+                     "(%d,%d), size (%d,%d)",
+                     0, iLine, nXSize, 1);
             return false;
         }
     }
@@ -28,6 +28,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cpl_progress.h"
 #include "gdal_priv.h"
@@ -95,6 +96,7 @@ class Viewshed
         CPLStringList creationOpts{};  //!< options for output raster creation
         CellMode cellMode{
             CellMode::Edge};  //!< Mode of cell height calculation.
+        int numThreads{1};    //!< Number of threads used for the computation
     };
 
     /**
@@ -116,6 +118,26 @@ class Viewshed
     CPL_DLL bool run(GDALRasterBandH hBand, GDALProgressFunc pfnProgress,
                      void *pProgressArg = nullptr);
 
+    /**
+     * Create a cumulative viewshed for several observers.
+     *
+     * The DEM is read once, and each pixel of the output raster, of type
+     * UInt32, is set to the number of observers from which it is visible.
+     * The observer, output mode and output values of the options are ignored.
+     * When numThreads is greater than 1, several observers are processed
+     * in parallel.
+     *
+     * @param hBand  Handle to the raster band.
+     * @param observers  x, y (in SRS units) and z (height above the DEM
+     *                   surface) of the observers.
+     * @param pfnProgress  Progress reporting callback function.
+     * @param pProgressArg  Argument to pass to the progress callback.
+    */
+    CPL_DLL bool runCumulative(GDALRasterBandH hBand,
+                               const std::vector<Point> &observers,
+                               GDALProgressFunc pfnProgress,
+                               void *pProgressArg = nullptr);
+
     /**
      * Fetch a pointer to the created raster band.
      *
@@ -130,9 +152,9 @@ class Viewshed
     Options oOpts;
     std::unique_ptr<GDALDataset> poDstDS;
 
-    void setVisibility(int iPixel, double dfZ, double *padfZVal,
-                       std::vector<GByte> &vResult);
-    double calcHeight(double dfZ, double dfZ2);
+    bool createOutput(GDALRasterBandH hBand, const double *padfGeoTransform,
+                      int nXStart, int nYStart, int nXSize, int nYSize,
+                      GDALDataType eType, double &dfSphereDiameter);
 };
 
 }  // namespace gdal
@@ -26,6 +26,8 @@
  ****************************************************************************/
 
 #include <limits>
+#include <stdexcept>
+#include <vector>
 
 #include "commonutils.h"
 #include "gdal.h"
@@ -62,17 +64,25 @@ MAIN_START(argc, argv)
     Viewshed::Options opts;
 
     argParser.add_output_format_argument(opts.outputFormat);
+    std::vector<double> adfObserverX;
     argParser.add_argument("-ox")
-        .store_into(opts.observer.x)
+        .append()
         .required()
         .metavar("<value>")
-        .help(_("The X position of the observer (in SRS units)."));
+        .action([&adfObserverX](const std::string &s)
+                { adfObserverX.push_back(CPLAtofM(s.c_str())); })
+        .help(_("The X position of the observer (in SRS units). May be "
+                "repeated with -om CUMULATIVE."));
 
+    std::vector<double> adfObserverY;
     argParser.add_argument("-oy")
-        .store_into(opts.observer.y)
+        .append()
         .required()
         .metavar("<value>")
-        .help(_("The Y position of the observer (in SRS units)."));
+        .action([&adfObserverY](const std::string &s)
+                { adfObserverY.push_back(CPLAtofM(s.c_str())); })
+        .help(_("The Y position of the observer (in SRS units). May be "
+                "repeated with -om CUMULATIVE."));
 
     argParser.add_argument("-oz")
         .default_value(2)
@@ -148,22 +158,43 @@ MAIN_START(argc, argv)
         .nargs(1)
         .help(_("Select an input band band containing the DEM data."));
 
+    bool bCumulative = false;
     argParser.add_argument("-om")
-        .choices("NORMAL", "DEM", "GROUND")
-        .metavar("NORMAL|DEM|GROUND")
+        .choices("NORMAL", "DEM", "GROUND", "CUMULATIVE")
+        .metavar("NORMAL|DEM|GROUND|CUMULATIVE")
         .action(
-            [&into = opts.outputMode](const std::string &value)
+            [&into = opts.outputMode, &bCumulative](const std::string &value)
             {
+                bCumulative = false;
                 if (EQUAL(value.c_str(), "DEM"))
                     into = Viewshed::OutputMode::DEM;
                 else if (EQUAL(value.c_str(), "GROUND"))
                     into = Viewshed::OutputMode::Ground;
                 else
+                {
                     into = Viewshed::OutputMode::Normal;
+                    bCumulative = EQUAL(value.c_str(), "CUMULATIVE");
+                }
             })
         .nargs(1)
         .help(_("Sets what information the output contains."));
 
+    argParser.add_argument("-num_threads")
+        .metavar("<value|ALL_CPUS>")
+        .action(
+            [&into = opts.numThreads](const std::string &s)
+            {
+                if (EQUAL(s.c_str(), "ALL_CPUS"))
+                    into = CPLGetNumCPUs();
+                else if (CPLGetValueType(s.c_str()) == CPL_VALUE_INTEGER)
+                    into = atoi(s.c_str());
+                else
+                    throw std::invalid_argument(CPLSPrintf(
+                        "Invalid value for -num_threads: %s.", s.c_str()));
+            })
+        .help(_("Number of threads to use. Defaults to the value of the "
+                "GDAL_NUM_THREADS configuration option."));
+
     bool bQuiet = false;
     argParser.add_quiet_argument(&bQuiet);
 
@@ -186,6 +217,31 @@ MAIN_START(argc, argv)
         std::exit(1);
     }
 
+    if (adfObserverX.size() != adfObserverY.size())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "-ox and -oy must be specified the same number of times.");
+        exit(2);
+    }
+    if (adfObserverX.size() > 1 && !bCumulative)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Several observers can only be specified with -om "
+                 "CUMULATIVE.");
+        exit(2);
+    }
+    opts.observer.x = adfObserverX[0];
+    opts.observer.y = adfObserverY[0];
+
+    if (!argParser.is_used("-num_threads"))
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        opts.numThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                              ? CPLGetNumCPUs()
+                              : atoi(pszNumThreads);
+    }
+
     if (opts.maxDistance < 0)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -205,7 +261,7 @@ MAIN_START(argc, argv)
 
     // For double values that are out of range for byte raster output,
     // set to zero.  Values less than zero are sentinel as NULL nodata.
-    if (opts.outputMode == Viewshed::OutputMode::Normal &&
+    if (opts.outputMode == Viewshed::OutputMode::Normal && !bCumulative &&
         opts.nodataVal > std::numeric_limits<uint8_t>::max())
         opts.nodataVal = 0;
 
@@ -248,8 +304,23 @@ MAIN_START(argc, argv)
     /* -------------------------------------------------------------------- */
     Viewshed oViewshed(opts);
 
-    bool bSuccess =
-        oViewshed.run(hBand, bQuiet ? GDALDummyProgress : GDALTermProgress);
+    bool bSuccess;
+    if (bCumulative)
+    {
+        std::vector<Viewshed::Point> aoObservers;
+        for (size_t i = 0; i < adfObserverX.size(); ++i)
+        {
+            aoObservers.push_back(
+                {adfObserverX[i], adfObserverY[i], opts.observer.z});
+        }
+        bSuccess = oViewshed.runCumulative(
+            hBand, aoObservers, bQuiet ? GDALDummyProgress : GDALTermProgress);
+    }
+    else
+    {
+        bSuccess =
+            oViewshed.run(hBand, bQuiet ? GDALDummyProgress : GDALTermProgress);
+    }
 
     GDALDatasetH hDstDS = GDALDataset::FromHandle(oViewshed.output().release());
 
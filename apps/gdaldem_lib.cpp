@@ -99,6 +99,7 @@
 #include "gdal_utils_priv.h"
 #include "commonutils.h"
 #include "gdalargumentparser.h"
+#include "gdaldem_lib_priv.h"
 
 #include <cfloat>
 #include <cmath>
@@ -110,7 +111,10 @@
 #endif
 
 #include <algorithm>
+#include <climits>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
@@ -118,11 +122,17 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
-#define HAVE_16_SSE_REG
 #define HAVE_SSE2
+#define USE_SSE2
 #include "emmintrin.h"
+#include "gdalsse_priv.h"
+#endif
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+#include "cpl_cpu_features.h"
 #endif
 
 static const double kdfDegreesToRadians = M_PI / 180.0;
@@ -135,21 +145,6 @@ typedef enum
     COLOR_SELECTION_EXACT_ENTRY
 } ColorSelectionMode;
 
-namespace gdal::GDALDEM
-{
-enum class GradientAlg
-{
-    HORN,
-    ZEVENBERGEN_THORNE,
-};
-
-enum class TRIAlg
-{
-    WILSON,
-    RILEY,
-};
-}  // namespace gdal::GDALDEM
-
 using namespace gdal::GDALDEM;
 
 struct GDALDEMProcessingOptions
@@ -183,6 +178,7 @@ struct GDALDEMProcessingOptions
     bool bMultiDirectional = false;
     CPLStringList aosCreationOptions;
     int nBand = 1;
+    std::string osNumThreads{};
 };
 
 /************************************************************************/
@@ -198,8 +194,8 @@ template <class T> struct GDALGeneric3x3ProcessingAlg
 template <class T> struct GDALGeneric3x3ProcessingAlg_multisample
 {
     typedef int (*type)(const T *pafThreeLineWin, int nLine1Off, int nLine2Off,
-                        int nLine3Off, int nXSize, void *pData,
-                        float *pafOutputBuf);
+                        int nLine3Off, int nXSize, float fDstNoDataValue,
+                        void *pData, float *pafOutputBuf);
 };
 
 template <class T>
@@ -294,6 +290,344 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
     return nVal;
 }
 
+/************************************************************************/
+/*                     GDALGeneric3x3LineParams                         */
+/************************************************************************/
+
+// Parameters that are invariant during the processing of all lines.
+template <class T> struct GDALGeneric3x3LineParams
+{
+    int nXSize = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+};
+
+/************************************************************************/
+/*                        LineHasNoDataValue()                          */
+/************************************************************************/
+
+template <class T>
+static bool LineHasNoDataValue(const T *pafLine, int nXSize, T fSrcNoDataValue)
+{
+    int iX = 0;
+    for (; iX + 3 < nXSize; iX += 4)
+    {
+        if (pafLine[iX] == fSrcNoDataValue ||
+            pafLine[iX + 1] == fSrcNoDataValue ||
+            pafLine[iX + 2] == fSrcNoDataValue ||
+            pafLine[iX + 3] == fSrcNoDataValue)
+        {
+            return true;
+        }
+    }
+    for (; iX < nXSize; iX++)
+    {
+        if (pafLine[iX] == fSrcNoDataValue)
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                    GDALGeneric3x3ProcessLine()                       */
+/************************************************************************/
+
+// Compute an output line, that is neither the first nor the last one of
+// the raster, from its 3 source lines.
+template <class T>
+static void GDALGeneric3x3ProcessLine(const GDALGeneric3x3LineParams<T> &sParams,
+                                      const T *pafThreeLineWin, int nLine1Off,
+                                      int nLine2Off, int nLine3Off,
+                                      bool bOneOfThreeLinesHasNoData,
+                                      float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const bool bIsSrcNoDataNan = sParams.bIsSrcNoDataNan;
+    const float fDstNoDataValue = sParams.fDstNoDataValue;
+    const auto pfnAlg = sParams.pfnAlg;
+    void *pData = sParams.pData;
+    const bool bComputeAtEdges = sParams.bComputeAtEdges;
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                                     bIsSrcNoDataNan, afWin, fDstNoDataValue,
+                                     pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    int j = 1;
+    if (sParams.pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+    {
+        j = sParams.pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
+                                       nLine3Off, nXSize, fDstNoDataValue,
+                                       pData, pafOutputBuf);
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                                     bIsSrcNoDataNan, afWin, fDstNoDataValue,
+                                     pfnAlg, pData, bComputeAtEdges);
+    }
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                                     bIsSrcNoDataNan, afWin, fDstNoDataValue,
+                                     pfnAlg, pData, bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                 GDALGeneric3x3ProcessingMultiThreaded()              */
+/************************************************************************/
+
+namespace
+{
+template <class T> struct GDALGeneric3x3Job
+{
+    const GDALGeneric3x3LineParams<T> *psParams = nullptr;
+    // Source lines. The first one is the line above the first output line.
+    const T *pafSrc = nullptr;
+    // For each source line, whether it contains the nodata value.
+    const bool *pabLineHasNoDataValue = nullptr;
+    float *pafDst = nullptr;
+    int nLines = 0;
+
+    static void Process(void *pJob)
+    {
+        const auto psJob = static_cast<const GDALGeneric3x3Job *>(pJob);
+        const auto &sParams = *(psJob->psParams);
+        const int nXSize = sParams.nXSize;
+        for (int iLine = 0; iLine < psJob->nLines; ++iLine)
+        {
+            const bool bOneOfThreeLinesHasNoData =
+                sParams.bSrcHasNoData &&
+                (!std::numeric_limits<T>::is_integer ||
+                 psJob->pabLineHasNoDataValue[iLine] ||
+                 psJob->pabLineHasNoDataValue[iLine + 1] ||
+                 psJob->pabLineHasNoDataValue[iLine + 2]);
+            GDALGeneric3x3ProcessLine(
+                sParams, psJob->pafSrc, iLine * nXSize, (iLine + 1) * nXSize,
+                (iLine + 2) * nXSize, bOneOfThreeLinesHasNoData,
+                psJob->pafDst + static_cast<size_t>(iLine) * nXSize);
+        }
+    }
+};
+}  // namespace
+
+// Process the lines [1, nYSize - 2] by chunks of lines. The source lines
+// of the next chunk are read, and the output lines of the previous chunk
+// are written, while the current chunk is processed by the worker threads.
+template <class T>
+static CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand, GDALDataType eReadDT,
+    const GDALGeneric3x3LineParams<T> &sParams, int nNumThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Limit the memory of the 2 source and 2 output chunks to ~ 256 MB,
+    // but use at least one line per thread.
+    constexpr size_t MAX_BUFFER_SIZE = 256 * 1024 * 1024;
+    const size_t nBytesPerLine =
+        static_cast<size_t>(nXSize) * 2 * (sizeof(T) + sizeof(float));
+    int nChunkLines = std::min(
+        nYSize - 2, std::max(nNumThreads * 4,
+                             static_cast<int>(std::min<size_t>(
+                                 INT_MAX, MAX_BUFFER_SIZE / nBytesPerLine))));
+    nChunkLines = static_cast<int>(
+        GDALGetTestChunkSize(nChunkLines, std::max(1, nYSize - 2)));
+
+    std::vector<T> apafSrc[2];
+    std::vector<float> apafDst[2];
+    std::unique_ptr<bool[]> apabLineHasNoDataValue[2];
+    try
+    {
+        for (int k = 0; k < 2; ++k)
+        {
+            // + 1 as the multisample algorithm reads one value past the end
+            apafSrc[k].resize(static_cast<size_t>(nChunkLines + 2) * nXSize +
+                              1);
+            apafDst[k].resize(static_cast<size_t>(nChunkLines) * nXSize);
+            apabLineHasNoDataValue[k].reset(new bool[nChunkLines + 2]);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALGeneric3x3Processing()");
+        return CE_Failure;
+    }
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        return CE_Failure;
+
+    // Read the source lines of the chunk starting at output line nChunkYOff
+    const auto ReadChunk = [&](int k, int nChunkYOff, int nLines)
+    {
+        if (GDALRasterIO(hSrcBand, GF_Read, 0, nChunkYOff - 1, nXSize,
+                         nLines + 2, apafSrc[k].data(), nXSize, nLines + 2,
+                         eReadDT, 0, 0) != CE_None)
+        {
+            return CE_Failure;
+        }
+        if (std::numeric_limits<T>::is_integer && sParams.bSrcHasNoData)
+        {
+            for (int iLine = 0; iLine < nLines + 2; ++iLine)
+            {
+                apabLineHasNoDataValue[k][iLine] = LineHasNoDataValue(
+                    apafSrc[k].data() + static_cast<size_t>(iLine) * nXSize,
+                    nXSize, sParams.fSrcNoDataValue);
+            }
+        }
+        return CE_None;
+    };
+
+    // Write the output lines of a chunk and report progress
+    const auto WriteChunk = [&](int k, int nChunkYOff, int nLines)
+    {
+        if (GDALRasterIO(hDstBand, GF_Write, 0, nChunkYOff, nXSize, nLines,
+                         apafDst[k].data(), nXSize, nLines, GDT_Float32, 0,
+                         0) != CE_None)
+        {
+            return CE_Failure;
+        }
+        if (!pfnProgress(1.0 * (nChunkYOff + nLines) / nYSize, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    const int nChunks = DIV_ROUND_UP(nYSize - 2, nChunkLines);
+    const auto GetChunkYOff = [nChunkLines](int iChunk)
+    { return 1 + iChunk * nChunkLines; };
+    const auto GetChunkLines = [nChunkLines, nYSize](int iChunk)
+    { return std::min(nChunkLines, nYSize - 1 - (1 + iChunk * nChunkLines)); };
+
+    CPLErr eErr = ReadChunk(0, GetChunkYOff(0), GetChunkLines(0));
+    std::vector<GDALGeneric3x3Job<T>> asJobs(nNumThreads);
+    for (int iChunk = 0; eErr == CE_None && iChunk < nChunks; ++iChunk)
+    {
+        const int k = iChunk % 2;
+        const int nLines = GetChunkLines(iChunk);
+
+        // Dispatch the lines of the chunk over the worker threads
+        const int nLinesPerJob = DIV_ROUND_UP(nLines, nNumThreads);
+        for (int iJob = 0; iJob < nNumThreads; ++iJob)
+        {
+            const int iFirstLine = iJob * nLinesPerJob;
+            if (iFirstLine >= nLines)
+                break;
+            auto &sJob = asJobs[iJob];
+            sJob.psParams = &sParams;
+            sJob.pafSrc =
+                apafSrc[k].data() + static_cast<size_t>(iFirstLine) * nXSize;
+            sJob.pabLineHasNoDataValue =
+                apabLineHasNoDataValue[k].get() + iFirstLine;
+            sJob.pafDst =
+                apafDst[k].data() + static_cast<size_t>(iFirstLine) * nXSize;
+            sJob.nLines = std::min(nLinesPerJob, nLines - iFirstLine);
+            poJobQueue->SubmitJob(GDALGeneric3x3Job<T>::Process, &sJob);
+        }
+
+        // Meanwhile, write the output of the previous chunk, and read the
+        // input of the next one.
+        if (iChunk > 0)
+        {
+            eErr = WriteChunk(1 - k, GetChunkYOff(iChunk - 1),
+                              GetChunkLines(iChunk - 1));
+        }
+        if (eErr == CE_None && iChunk + 1 < nChunks)
+        {
+            eErr = ReadChunk(1 - k, GetChunkYOff(iChunk + 1),
+                             GetChunkLines(iChunk + 1));
+        }
+
+        poJobQueue->WaitCompletion();
+    }
+
+    if (eErr == CE_None)
+    {
+        eErr = WriteChunk((nChunks - 1) % 2, GetChunkYOff(nChunks - 1),
+                          GetChunkLines(nChunks - 1));
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALGeneric3x3Processing()                          */
 /************************************************************************/
@@ -304,8 +638,8 @@ static CPLErr GDALGeneric3x3Processing(
     typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
     typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
         pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+    void *pData, bool bComputeAtEdges, int nNumThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
 {
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
@@ -381,6 +715,17 @@ static CPLErr GDALGeneric3x3Processing(
     if (!bDstHasNoData)
         fDstNoDataValue = 0.0;
 
+    GDALGeneric3x3LineParams<T> sParams;
+    sParams.nXSize = nXSize;
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.fSrcNoDataValue = fSrcNoDataValue;
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sParams.fDstNoDataValue = fDstNoDataValue;
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.pData = pData;
+    sParams.bComputeAtEdges = bComputeAtEdges;
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2 * nXSize;
@@ -413,15 +758,8 @@ static CPLErr GDALGeneric3x3Processing(
             }
             if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
             {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
+                abLineHasNoDataValue[i] = LineHasNoDataValue(
+                    pafThreeLineWin + i * nXSize, nXSize, fSrcNoDataValue);
             }
         }
     }  // End extra scope for VC12
@@ -480,6 +818,27 @@ static CPLErr GDALGeneric3x3Processing(
     }
 
     int i = 1;  // Used after for.
+    if (nNumThreads > 1 && nYSize > 3)
+    {
+        eErr = GDALGeneric3x3ProcessingMultiThreaded(
+            hSrcBand, hDstBand, eReadDT, sParams, nNumThreads, pfnProgress,
+            pProgressData);
+        i = nYSize - 1;
+
+        // Reload the last 2 lines for the computation of the last line.
+        if (eErr == CE_None && bComputeAtEdges && nXSize >= 2)
+        {
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nYSize - 2, nXSize, 2,
+                                pafThreeLineWin, nXSize, 2, eReadDT, 0, 0);
+        }
+        if (eErr != CE_None)
+        {
+            CPLFree(pafOutputBuf);
+            CPLFree(pafThreeLineWin);
+
+            return eErr;
+        }
+    }
     for (; i < nYSize - 1; i++)
     {
         /* Read third line of the line buffer */
@@ -499,122 +858,17 @@ static CPLErr GDALGeneric3x3Processing(
         bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
         if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
         {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
-            {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if (!bLastLineHasNoDataValue)
-            {
-                for (; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
+            abLineHasNoDataValue[nLine3Off / nXSize] = LineHasNoDataValue(
+                pafThreeLineWin + nLine3Off, nXSize, fSrcNoDataValue);
 
             bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
                                         abLineHasNoDataValue[1] ||
                                         abLineHasNoDataValue[2];
         }
 
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
-        }
-
-        for (; j < nXSize - 1; j++)
-        {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        GDALGeneric3x3ProcessLine(sParams, pafThreeLineWin, nLine1Off,
+                                  nLine2Off, nLine3Off,
+                                  bOneOfThreeLinesHasNoData, pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -646,6 +900,12 @@ static CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
+    if (nNumThreads > 1 && nYSize > 3)
+    {
+        nLine1Off = 0;
+        nLine2Off = nXSize;
+    }
+
     if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
     {
         for (int j = 0; j < nXSize; j++)
@@ -731,29 +991,183 @@ template <class T> struct Gradient<T, GradientAlg::ZEVENBERGEN_THORNE>
     }
 };
 
+#ifdef USE_SSE2
+
 /************************************************************************/
-/*                         GDALHillshade()                              */
+/*                       GradientMultisample                            */
 /************************************************************************/
 
-typedef struct
+// 4 consecutive source values, on which arithmetic is done in the precision
+// of the source type, so that the gradients computed by the multisample
+// algorithms are identical to the ones of the per-pixel algorithms.
+template <class T> struct GDALDEMVec4;
+
+template <> struct GDALDEMVec4<GInt32>
+{
+    __m128i xmm;
+
+    static inline GDALDEMVec4 Load(const GInt32 *ptr)
+    {
+        GDALDEMVec4 reg;
+        reg.xmm = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        return reg;
+    }
+
+    inline GDALDEMVec4 operator+(const GDALDEMVec4 &other) const
+    {
+        GDALDEMVec4 ret;
+        ret.xmm = _mm_add_epi32(xmm, other.xmm);
+        return ret;
+    }
+
+    inline GDALDEMVec4 operator-(const GDALDEMVec4 &other) const
+    {
+        GDALDEMVec4 ret;
+        ret.xmm = _mm_sub_epi32(xmm, other.xmm);
+        return ret;
+    }
+
+    inline void ToDouble(XMMReg2Double &low, XMMReg2Double &high) const
+    {
+        low.xmm = _mm_cvtepi32_pd(xmm);
+        high.xmm = _mm_cvtepi32_pd(_mm_srli_si128(xmm, 8));
+    }
+};
+
+template <> struct GDALDEMVec4<float>
+{
+    __m128 xmm;
+
+    static inline GDALDEMVec4 Load(const float *ptr)
+    {
+        GDALDEMVec4 reg;
+        reg.xmm = _mm_loadu_ps(ptr);
+        return reg;
+    }
+
+    inline GDALDEMVec4 operator+(const GDALDEMVec4 &other) const
+    {
+        GDALDEMVec4 ret;
+        ret.xmm = _mm_add_ps(xmm, other.xmm);
+        return ret;
+    }
+
+    inline GDALDEMVec4 operator-(const GDALDEMVec4 &other) const
+    {
+        GDALDEMVec4 ret;
+        ret.xmm = _mm_sub_ps(xmm, other.xmm);
+        return ret;
+    }
+
+    inline void ToDouble(XMMReg2Double &low, XMMReg2Double &high) const
+    {
+        low.xmm = _mm_cvtps_pd(xmm);
+        high.xmm = _mm_cvtps_pd(_mm_movehl_ps(xmm, xmm));
+    }
+};
+
+// Computes the gradients of the 4 pixels starting at column j, before
+// their multiplication by the inverse of the resolution, in the order of
+// the operations of Gradient<T, alg>::calc().
+template <class T, GradientAlg alg> struct GradientMultisample
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            XMMReg2Double (&x)[2], XMMReg2Double (&y)[2]);
+};
+
+template <class T> struct GradientMultisample<T, GradientAlg::HORN>
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            XMMReg2Double (&x)[2], XMMReg2Double (&y)[2])
+    {
+        typedef GDALDEMVec4<T> V;
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+        const V w0 = V::Load(firstLine);
+        const V w1 = V::Load(firstLine + 1);
+        const V w2 = V::Load(firstLine + 2);
+        const V w3 = V::Load(secondLine);
+        const V w5 = V::Load(secondLine + 2);
+        const V w6 = V::Load(thirdLine);
+        const V w7 = V::Load(thirdLine + 1);
+        const V w8 = V::Load(thirdLine + 2);
+
+        ((w0 + w3 + w3 + w6) - (w2 + w5 + w5 + w8)).ToDouble(x[0], x[1]);
+        ((w6 + w7 + w7 + w8) - (w0 + w1 + w1 + w2)).ToDouble(y[0], y[1]);
+    }
+};
+
+template <class T>
+struct GradientMultisample<T, GradientAlg::ZEVENBERGEN_THORNE>
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            XMMReg2Double (&x)[2], XMMReg2Double (&y)[2])
+    {
+        typedef GDALDEMVec4<T> V;
+        const V w1 = V::Load(pafThreeLineWin + nLine1Off + j);
+        const V w3 = V::Load(pafThreeLineWin + nLine2Off + j - 1);
+        const V w5 = V::Load(pafThreeLineWin + nLine2Off + j + 1);
+        const V w7 = V::Load(pafThreeLineWin + nLine3Off + j);
+
+        (w3 - w5).ToDouble(x[0], x[1]);
+        (w7 - w1).ToDouble(y[0], y[1]);
+    }
+};
+
+/************************************************************************/
+/*                        GDALDEMMultisample()                          */
+/************************************************************************/
+
+// Runs oKernel(x, y, pafOutput) on all groups of 4 pixels of the line for
+// which the 3x3 window is fully inside the line, 2 pixels at a time, x and
+// y being the output of GradientMultisample<T, alg>::calc(). Returns the
+// index of the first pixel that has not been computed.
+template <class T, GradientAlg alg, class Kernel>
+static int GDALDEMMultisample(const T *pafThreeLineWin, int nLine1Off,
+                              int nLine2Off, int nLine3Off, int nXSize,
+                              const Kernel &oKernel, float *pafOutputBuf)
+{
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        XMMReg2Double x[2], y[2];
+        GradientMultisample<T, alg>::calc(pafThreeLineWin, nLine1Off,
+                                          nLine2Off, nLine3Off, j, x, y);
+        oKernel(x[0], y[0], pafOutputBuf + j);
+        oKernel(x[1], y[1], pafOutputBuf + j + 2);
+    }
+    return j;
+}
+
+static inline XMMReg2Double GDALDEMSet1(double dfVal)
 {
-    double inv_nsres;
-    double inv_ewres;
-    double sin_altRadians;
-    double cos_alt_mul_z;
-    double azRadians;
-    double cos_az_mul_cos_alt_mul_z;
-    double sin_az_mul_cos_alt_mul_z;
-    double square_z;
-    double sin_altRadians_mul_254;
-    double cos_az_mul_cos_alt_mul_z_mul_254;
-    double sin_az_mul_cos_alt_mul_z_mul_254;
-
-    double square_z_mul_square_inv_res;
-    double cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
-    double sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
-    double z_scaled;
-} GDALHillshadeAlgData;
+    return XMMReg2Double::Load1ValHighAndLow(&dfVal);
+}
+
+// Vector version of ApproxADivByInvSqrtB(a, b), returning a / sqrt(b)
+static inline XMMReg2Double ApproxADivByInvSqrtB(const XMMReg2Double &a,
+                                                 const XMMReg2Double &b)
+{
+    XMMReg2Double approx_inv_sqrt_b;
+    // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
+    approx_inv_sqrt_b.xmm = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(b.xmm)));
+    // And perform one step of Newton-Raphson approximation to improve it
+    approx_inv_sqrt_b =
+        approx_inv_sqrt_b *
+        (GDALDEMSet1(1.5) -
+         (b * GDALDEMSet1(0.5)) * (approx_inv_sqrt_b * approx_inv_sqrt_b));
+    return a * approx_inv_sqrt_b;
+}
+
+#endif  // USE_SSE2
+
+/************************************************************************/
+/*                         GDALHillshade()                              */
+/************************************************************************/
 
 /* Unoptimized formulas are :
     x = psData->z*((afWin[0] + afWin[3] + afWin[3] + afWin[6]) -
@@ -851,6 +1265,21 @@ static double DifferenceBetweenAngles(double angle1, double angle2,
     return diff;
 }
 
+static float GDALHillshadeIgorShade(double slopeDegrees, double aspect,
+                                   double azRadians)
+{
+    double slopeStrength = slopeDegrees / 90;
+
+    double aspectDiff =
+        DifferenceBetweenAngles(aspect, M_PI * 3 / 2 - azRadians, M_PI * 2);
+
+    double aspectStrength = 1 - aspectDiff / M_PI;
+
+    double shadowness = 1.0 - slopeStrength * aspectStrength;
+
+    return static_cast<float>(255.0 * shadowness);
+}
+
 template <class T, GradientAlg alg>
 static float GDALHillshadeIgorAlg(const T *afWin, float /*fDstNoDataValue*/,
                                   void *pData)
@@ -898,17 +1327,48 @@ static float GDALHillshadeIgorAlg(const T *afWin, float /*fDstNoDataValue*/,
         aspect = atan2(dy, -dx);
     }
 
-    double slopeStrength = slopeDegrees / 90;
-
-    double aspectDiff = DifferenceBetweenAngles(
-        aspect, M_PI * 3 / 2 - psData->azRadians, M_PI * 2);
-
-    double aspectStrength = 1 - aspectDiff / M_PI;
-
-    double shadowness = 1.0 - slopeStrength * aspectStrength;
+    return GDALHillshadeIgorShade(slopeDegrees, aspect, psData->azRadians);
+}
 
-    return static_cast<float>(255.0 * shadowness);
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALHillshadeIgorAlg_multisample(const T *pafThreeLineWin,
+                                            int nLine1Off, int nLine2Off,
+                                            int nLine3Off, int nXSize,
+                                            float /*fDstNoDataValue*/,
+                                            void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const XMMReg2Double inv_ewres = GDALDEMSet1(psData->inv_ewres);
+    const XMMReg2Double inv_nsres = GDALDEMSet1(psData->inv_nsres);
+    const XMMReg2Double z_scaled = GDALDEMSet1(psData->z_scaled);
+    const double azRadians = psData->azRadians;
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](const XMMReg2Double &x, const XMMReg2Double &y, float *pafOutput)
+        {
+            const XMMReg2Double dx = x * inv_ewres;
+            const XMMReg2Double dy = y * inv_nsres;
+            const XMMReg2Double key = dx * dx + dy * dy;
+            double adfTanSlope[2], adfX[2], adfY[2];
+            (XMMReg2Double::Sqrt(key) * z_scaled).Store2Val(adfTanSlope);
+            x.Store2Val(adfX);
+            y.Store2Val(adfY);
+            for (int k = 0; k < 2; ++k)
+            {
+                // atan2(y, x) is the atan2(dy2, -dx) of the per-pixel
+                // algorithm, but for the sign of zero, which only matters
+                // on flat areas, where the slope strength is zero.
+                pafOutput[k] = GDALHillshadeIgorShade(
+                    atan(adfTanSlope[k]) * kdfRadiansToDegrees,
+                    atan2(adfY[k], adfX[k]), azRadians);
+            }
+        },
+        pafOutputBuf);
 }
+#endif
 
 template <class T, GradientAlg alg>
 static float GDALHillshadeAlg(const T *afWin, float /*fDstNoDataValue*/,
@@ -934,6 +1394,51 @@ static float GDALHillshadeAlg(const T *afWin, float /*fDstNoDataValue*/,
     return static_cast<float>(cang);
 }
 
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALHillshadeAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                        int nLine2Off, int nLine3Off,
+                                        int nXSize, float /*fDstNoDataValue*/,
+                                        void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const XMMReg2Double inv_ewres = GDALDEMSet1(psData->inv_ewres);
+    const XMMReg2Double inv_nsres = GDALDEMSet1(psData->inv_nsres);
+    const XMMReg2Double sin_altRadians_mul_254 =
+        GDALDEMSet1(psData->sin_altRadians_mul_254);
+    const XMMReg2Double cos_az_mul_cos_alt_mul_z_mul_254 =
+        GDALDEMSet1(psData->cos_az_mul_cos_alt_mul_z_mul_254);
+    const XMMReg2Double sin_az_mul_cos_alt_mul_z_mul_254 =
+        GDALDEMSet1(psData->sin_az_mul_cos_alt_mul_z_mul_254);
+    const XMMReg2Double square_z = GDALDEMSet1(psData->square_z);
+    const XMMReg2Double one = GDALDEMSet1(1.0);
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](const XMMReg2Double &gradX, const XMMReg2Double &gradY,
+            float *pafOutput)
+        {
+            // First Slope ...
+            const XMMReg2Double x = gradX * inv_ewres;
+            const XMMReg2Double y = gradY * inv_nsres;
+
+            const XMMReg2Double xx_plus_yy = x * x + y * y;
+
+            // ... then the shade value
+            const XMMReg2Double cang_mul_254 = ApproxADivByInvSqrtB(
+                sin_altRadians_mul_254 -
+                    (y * cos_az_mul_cos_alt_mul_z_mul_254 -
+                     x * sin_az_mul_cos_alt_mul_z_mul_254),
+                one + square_z * xx_plus_yy);
+
+            // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+            XMMReg2Double::Max(one, one + cang_mul_254).Store2Val(pafOutput);
+        },
+        pafOutputBuf);
+}
+#endif
+
 template <class T>
 static float GDALHillshadeAlg_same_res(const T *afWin,
                                        float /*fDstNoDataValue*/, void *pData)
@@ -975,26 +1480,26 @@ static float GDALHillshadeAlg_same_res(const T *afWin,
     return static_cast<float>(cang);
 }
 
-#ifdef HAVE_16_SSE_REG
+#ifdef USE_SSE2
 template <class T>
 static int
 GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
                                       int nLine2Off, int nLine3Off, int nXSize,
-                                      void *pData, float *pafOutputBuf)
+                                      float /*fDstNoDataValue*/, void *pData,
+                                      float *pafOutputBuf)
 {
-    // Only valid for T == int
+    typedef GDALDEMVec4<T> V;
 
     GDALHillshadeAlgData *psData = static_cast<GDALHillshadeAlgData *>(pData);
-    const __m128d reg_fact_x =
-        _mm_load1_pd(&(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res));
-    const __m128d reg_fact_y =
-        _mm_load1_pd(&(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res));
-    const __m128d reg_constant_num =
-        _mm_load1_pd(&(psData->sin_altRadians_mul_254));
-    const __m128d reg_constant_denom =
-        _mm_load1_pd(&(psData->square_z_mul_square_inv_res));
-    const __m128d reg_half = _mm_set1_pd(0.5);
-    const __m128d reg_one = _mm_add_pd(reg_half, reg_half);
+    const XMMReg2Double reg_fact_x =
+        GDALDEMSet1(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const XMMReg2Double reg_fact_y =
+        GDALDEMSet1(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const XMMReg2Double reg_constant_num =
+        GDALDEMSet1(psData->sin_altRadians_mul_254);
+    const XMMReg2Double reg_constant_denom =
+        GDALDEMSet1(psData->square_z_mul_square_inv_res);
+    const XMMReg2Double reg_one = GDALDEMSet1(1.0);
     const __m128 reg_one_float = _mm_set1_ps(1);
 
     int j = 1;  // Used after for.
@@ -1004,81 +1509,58 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
         const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
         const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
 
-        __m128i firstLine0 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine));
-        __m128i firstLine1 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 1));
-        __m128i firstLine2 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(firstLine + 2));
-        __m128i thirdLine0 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine));
-        __m128i thirdLine1 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 1));
-        __m128i thirdLine2 =
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(thirdLine + 2));
-        __m128i accX = _mm_sub_epi32(firstLine0, thirdLine2);
-        const __m128i six_minus_two = _mm_sub_epi32(thirdLine0, firstLine2);
-        __m128i accY = accX;
-        const __m128i three_minus_five = _mm_sub_epi32(
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine)),
-            _mm_loadu_si128(reinterpret_cast<__m128i const *>(secondLine + 2)));
-        const __m128i one_minus_seven = _mm_sub_epi32(firstLine1, thirdLine1);
-        accX = _mm_add_epi32(accX, three_minus_five);
-        accY = _mm_add_epi32(accY, one_minus_seven);
-        accX = _mm_add_epi32(accX, three_minus_five);
-        accY = _mm_add_epi32(accY, one_minus_seven);
-        accX = _mm_add_epi32(accX, six_minus_two);
-        accY = _mm_sub_epi32(accY, six_minus_two);
-
-        __m128d reg_x0 = _mm_cvtepi32_pd(accX);
-        __m128d reg_x1 = _mm_cvtepi32_pd(_mm_srli_si128(accX, 8));
-        __m128d reg_y0 = _mm_cvtepi32_pd(accY);
-        __m128d reg_y1 = _mm_cvtepi32_pd(_mm_srli_si128(accY, 8));
-        __m128d reg_xx_plus_yy0 =
-            _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0), _mm_mul_pd(reg_y0, reg_y0));
-        __m128d reg_xx_plus_yy1 =
-            _mm_add_pd(_mm_mul_pd(reg_x1, reg_x1), _mm_mul_pd(reg_y1, reg_y1));
-
-        __m128d reg_numerator0 = _mm_add_pd(
-            reg_constant_num, _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x0),
-                                         _mm_mul_pd(reg_fact_y, reg_y0)));
-        __m128d reg_numerator1 = _mm_add_pd(
-            reg_constant_num, _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x1),
-                                         _mm_mul_pd(reg_fact_y, reg_y1)));
-        __m128d reg_denominator0 = _mm_add_pd(
-            reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy0));
-        __m128d reg_denominator1 = _mm_add_pd(
-            reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy1));
-
-        __m128d regB0 = reg_denominator0;
-        __m128d regB1 = reg_denominator1;
-        __m128d regB0_half = _mm_mul_pd(regB0, reg_half);
-        __m128d regB1_half = _mm_mul_pd(regB1, reg_half);
-        // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
-        regB0 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB0)));
-        regB1 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB1)));
-        // And perform one step of Newton-Raphson approximation to improve it
-        // approx_inv_sqrt_x = approx_inv_sqrt_x*(1.5 -
-        //                            0.5*x*approx_inv_sqrt_x*approx_inv_sqrt_x);
-        const __m128d reg_one_and_a_half = _mm_add_pd(reg_one, reg_half);
-        regB0 = _mm_mul_pd(
-            regB0,
-            _mm_sub_pd(reg_one_and_a_half,
-                       _mm_mul_pd(regB0_half, _mm_mul_pd(regB0, regB0))));
-        regB1 = _mm_mul_pd(
-            regB1,
-            _mm_sub_pd(reg_one_and_a_half,
-                       _mm_mul_pd(regB1_half, _mm_mul_pd(regB1, regB1))));
-        reg_numerator0 = _mm_mul_pd(reg_numerator0, regB0);
-        reg_numerator1 = _mm_mul_pd(reg_numerator1, regB1);
-
-        __m128 res = _mm_castsi128_ps(
-            _mm_unpacklo_epi64(_mm_castps_si128(_mm_cvtpd_ps(reg_numerator0)),
-                               _mm_castps_si128(_mm_cvtpd_ps(reg_numerator1))));
-        res = _mm_add_ps(res, reg_one_float);
-        res = _mm_max_ps(res, reg_one_float);
-
-        _mm_storeu_ps(pafOutputBuf + j, res);
+        const V firstLine0 = V::Load(firstLine);
+        const V firstLine1 = V::Load(firstLine + 1);
+        const V firstLine2 = V::Load(firstLine + 2);
+        const V thirdLine0 = V::Load(thirdLine);
+        const V thirdLine1 = V::Load(thirdLine + 1);
+        const V thirdLine2 = V::Load(thirdLine + 2);
+        V accX = firstLine0 - thirdLine2;
+        const V six_minus_two = thirdLine0 - firstLine2;
+        V accY = accX;
+        const V three_minus_five =
+            V::Load(secondLine) - V::Load(secondLine + 2);
+        const V one_minus_seven = firstLine1 - thirdLine1;
+        accX = accX + three_minus_five;
+        accY = accY + one_minus_seven;
+        accX = accX + three_minus_five;
+        accY = accY + one_minus_seven;
+        accX = accX + six_minus_two;
+        accY = accY - six_minus_two;
+
+        XMMReg2Double reg_x[2], reg_y[2], reg_cang_mul_254[2];
+        accX.ToDouble(reg_x[0], reg_x[1]);
+        accY.ToDouble(reg_y[0], reg_y[1]);
+        for (int k = 0; k < 2; ++k)
+        {
+            const XMMReg2Double reg_xx_plus_yy =
+                reg_x[k] * reg_x[k] + reg_y[k] * reg_y[k];
+            reg_cang_mul_254[k] = ApproxADivByInvSqrtB(
+                reg_constant_num +
+                    (reg_fact_x * reg_x[k] + reg_fact_y * reg_y[k]),
+                reg_one + reg_constant_denom * reg_xx_plus_yy);
+        }
+
+        if (std::numeric_limits<T>::is_integer)
+        {
+            // The final additions are done in single precision, as they
+            // have always been for integer input.
+            __m128 res = _mm_castsi128_ps(_mm_unpacklo_epi64(
+                _mm_castps_si128(_mm_cvtpd_ps(reg_cang_mul_254[0].xmm)),
+                _mm_castps_si128(_mm_cvtpd_ps(reg_cang_mul_254[1].xmm))));
+            res = _mm_add_ps(res, reg_one_float);
+            res = _mm_max_ps(res, reg_one_float);
+
+            _mm_storeu_ps(pafOutputBuf + j, res);
+        }
+        else
+        {
+            // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+            XMMReg2Double::Max(reg_one, reg_one + reg_cang_mul_254[0])
+                .Store2Val(pafOutputBuf + j);
+            XMMReg2Double::Max(reg_one, reg_one + reg_cang_mul_254[1])
+                .Store2Val(pafOutputBuf + j + 2);
+        }
     }
     return j;
 }
@@ -1086,6 +1568,19 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
 
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI * M_PI) / 4);
 
+static float GDALHillshadeCombinedShade(double cos_cang, double sqrt_slope)
+{
+    double cang = acos(cos_cang);
+
+    // combined shading
+    cang = 1 - cang * atan(sqrt_slope) * INV_SQUARE_OF_HALF_PI;
+
+    const float fcang =
+        cang <= 0.0 ? 1.0f : static_cast<float>(1.0 + (254.0 * cang));
+
+    return fcang;
+}
+
 template <class T, GradientAlg alg>
 static float GDALHillshadeCombinedAlg(const T *afWin, float /*fDstNoDataValue*/,
                                       void *pData)
@@ -1101,19 +1596,62 @@ static float GDALHillshadeCombinedAlg(const T *afWin, float /*fDstNoDataValue*/,
     const double slope = xx_plus_yy * psData->square_z;
 
     // ... then the shade value
-    double cang = acos(ApproxADivByInvSqrtB(
-        psData->sin_altRadians - (y * psData->cos_az_mul_cos_alt_mul_z -
-                                  x * psData->sin_az_mul_cos_alt_mul_z),
-        1 + slope));
-
-    // combined shading
-    cang = 1 - cang * atan(sqrt(slope)) * INV_SQUARE_OF_HALF_PI;
-
-    const float fcang =
-        cang <= 0.0 ? 1.0f : static_cast<float>(1.0 + (254.0 * cang));
+    return GDALHillshadeCombinedShade(
+        ApproxADivByInvSqrtB(
+            psData->sin_altRadians - (y * psData->cos_az_mul_cos_alt_mul_z -
+                                      x * psData->sin_az_mul_cos_alt_mul_z),
+            1 + slope),
+        sqrt(slope));
+}
 
-    return fcang;
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALHillshadeCombinedAlg_multisample(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, float /*fDstNoDataValue*/, void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const XMMReg2Double inv_ewres = GDALDEMSet1(psData->inv_ewres);
+    const XMMReg2Double inv_nsres = GDALDEMSet1(psData->inv_nsres);
+    const XMMReg2Double sin_altRadians = GDALDEMSet1(psData->sin_altRadians);
+    const XMMReg2Double cos_az_mul_cos_alt_mul_z =
+        GDALDEMSet1(psData->cos_az_mul_cos_alt_mul_z);
+    const XMMReg2Double sin_az_mul_cos_alt_mul_z =
+        GDALDEMSet1(psData->sin_az_mul_cos_alt_mul_z);
+    const XMMReg2Double square_z = GDALDEMSet1(psData->square_z);
+    const XMMReg2Double one = GDALDEMSet1(1.0);
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](const XMMReg2Double &gradX, const XMMReg2Double &gradY,
+            float *pafOutput)
+        {
+            // First Slope ...
+            const XMMReg2Double x = gradX * inv_ewres;
+            const XMMReg2Double y = gradY * inv_nsres;
+
+            const XMMReg2Double xx_plus_yy = x * x + y * y;
+
+            const XMMReg2Double slope = xx_plus_yy * square_z;
+
+            double adfCosCang[2], adfSqrtSlope[2];
+            ApproxADivByInvSqrtB(sin_altRadians -
+                                     (y * cos_az_mul_cos_alt_mul_z -
+                                      x * sin_az_mul_cos_alt_mul_z),
+                                 one + slope)
+                .Store2Val(adfCosCang);
+            XMMReg2Double::Sqrt(slope).Store2Val(adfSqrtSlope);
+
+            // ... then the shade value
+            pafOutput[0] =
+                GDALHillshadeCombinedShade(adfCosCang[0], adfSqrtSlope[0]);
+            pafOutput[1] =
+                GDALHillshadeCombinedShade(adfCosCang[1], adfSqrtSlope[1]);
+        },
+        pafOutputBuf);
 }
+#endif
 
 static void *GDALCreateHillshadeData(double *adfGeoTransform, double z,
                                      double scale, double alt, double az,
@@ -1158,19 +1696,6 @@ static void *GDALCreateHillshadeData(double *adfGeoTransform, double z,
 /*                   GDALHillshadeMultiDirectional()                    */
 /************************************************************************/
 
-typedef struct
-{
-    double inv_nsres;
-    double inv_ewres;
-    double square_z;
-    double sin_altRadians_mul_127;
-    double sin_altRadians_mul_254;
-
-    double cos_alt_mul_z_mul_127;
-    double cos225_az_mul_cos_alt_mul_z_mul_127;
-
-} GDALHillshadeMultiDirectionalAlgData;
-
 template <class T, GradientAlg alg>
 static float GDALHillshadeMultiDirectionalAlg(const T *afWin,
                                               float /*fDstNoDataValue*/,
@@ -1231,6 +1756,75 @@ static float GDALHillshadeMultiDirectionalAlg(const T *afWin,
     return static_cast<float>(cang);
 }
 
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALHillshadeMultiDirectionalAlg_multisample(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, float /*fDstNoDataValue*/, void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeMultiDirectionalAlgData *psData =
+        static_cast<const GDALHillshadeMultiDirectionalAlgData *>(pData);
+    const XMMReg2Double inv_ewres = GDALDEMSet1(psData->inv_ewres);
+    const XMMReg2Double inv_nsres = GDALDEMSet1(psData->inv_nsres);
+    const XMMReg2Double square_z = GDALDEMSet1(psData->square_z);
+    const XMMReg2Double sin_altRadians_mul_127 =
+        GDALDEMSet1(psData->sin_altRadians_mul_127);
+    const XMMReg2Double cos_alt_mul_z_mul_127 =
+        GDALDEMSet1(psData->cos_alt_mul_z_mul_127);
+    const XMMReg2Double cos225_az_mul_cos_alt_mul_z_mul_127 =
+        GDALDEMSet1(psData->cos225_az_mul_cos_alt_mul_z_mul_127);
+    const XMMReg2Double flat_value =
+        GDALDEMSet1(1.0 + psData->sin_altRadians_mul_254);
+    const XMMReg2Double zero = XMMReg2Double::Zero();
+    const XMMReg2Double half = GDALDEMSet1(0.5);
+    const XMMReg2Double one = GDALDEMSet1(1.0);
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](const XMMReg2Double &gradX, const XMMReg2Double &gradY,
+            float *pafOutput)
+        {
+            // First Slope ...
+            const XMMReg2Double x = gradX * inv_ewres;
+            const XMMReg2Double y = gradY * inv_nsres;
+
+            const XMMReg2Double xx = x * x;
+            const XMMReg2Double yy = y * y;
+            const XMMReg2Double xx_plus_yy = xx + yy;
+
+            // ... then the shade value from different azimuth.
+            // Max(zero, val) is val <= 0.0 ? 0.0 : val, but for the sign of
+            // zero, which does not change the result.
+            const XMMReg2Double val225_mul_127 = XMMReg2Double::Max(
+                zero, sin_altRadians_mul_127 +
+                          (x - y) * cos225_az_mul_cos_alt_mul_z_mul_127);
+            const XMMReg2Double val270_mul_127 = XMMReg2Double::Max(
+                zero, sin_altRadians_mul_127 - x * cos_alt_mul_z_mul_127);
+            const XMMReg2Double val315_mul_127 = XMMReg2Double::Max(
+                zero, sin_altRadians_mul_127 +
+                          (x + y) * cos225_az_mul_cos_alt_mul_z_mul_127);
+            const XMMReg2Double val360_mul_127 = XMMReg2Double::Max(
+                zero, sin_altRadians_mul_127 - y * cos_alt_mul_z_mul_127);
+
+            // ... then the weighted shading
+            const XMMReg2Double weight_225 = half * xx_plus_yy - x * y;
+            const XMMReg2Double weight_270 = xx;
+            const XMMReg2Double weight_315 = xx_plus_yy - weight_225;
+            const XMMReg2Double weight_360 = yy;
+            const XMMReg2Double cang_mul_127 = ApproxADivByInvSqrtB(
+                (weight_225 * val225_mul_127 + weight_270 * val270_mul_127 +
+                 weight_315 * val315_mul_127 + weight_360 * val360_mul_127) /
+                    xx_plus_yy,
+                one + square_z * xx_plus_yy);
+
+            XMMReg2Double::Ternary(XMMReg2Double::Equals(xx_plus_yy, zero),
+                                   flat_value, one + cang_mul_127)
+                .Store2Val(pafOutput);
+        },
+        pafOutputBuf);
+}
+#endif
+
 static void *GDALCreateHillshadeMultiDirectionalData(double *adfGeoTransform,
                                                      double z, double scale,
                                                      double alt,
@@ -1260,14 +1854,6 @@ static void *GDALCreateHillshadeMultiDirectionalData(double *adfGeoTransform,
 /*                         GDALSlope()                                  */
 /************************************************************************/
 
-typedef struct
-{
-    double nsres;
-    double ewres;
-    double scale;
-    int slopeFormat;
-} GDALSlopeAlgData;
-
 template <class T>
 static float GDALSlopeHornAlg(const T *afWin, float /*fDstNoDataValue*/,
                               void *pData)
@@ -1311,6 +1897,55 @@ static float GDALSlopeZevenbergenThorneAlg(const T *afWin,
     return static_cast<float>(100 * (sqrt(key) / (2 * psData->scale)));
 }
 
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALSlopeAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                    int nLine2Off, int nLine3Off, int nXSize,
+                                    float /*fDstNoDataValue*/, void *pData,
+                                    float *pafOutputBuf)
+{
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const XMMReg2Double ewres = GDALDEMSet1(psData->ewres);
+    const XMMReg2Double nsres = GDALDEMSet1(psData->nsres);
+    const XMMReg2Double scale = GDALDEMSet1(
+        (alg == GradientAlg::ZEVENBERGEN_THORNE ? 2 : 8) * psData->scale);
+
+    const auto ComputeTanSlope =
+        [&](const XMMReg2Double &x, const XMMReg2Double &y)
+    {
+        const XMMReg2Double dx = x / ewres;
+        const XMMReg2Double dy = y / nsres;
+        const XMMReg2Double key = dx * dx + dy * dy;
+        return XMMReg2Double::Sqrt(key) / scale;
+    };
+
+    if (psData->slopeFormat == 1)
+    {
+        return GDALDEMMultisample<T, alg>(
+            pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+            [&](const XMMReg2Double &x, const XMMReg2Double &y,
+                float *pafOutput)
+            {
+                double adfTanSlope[2];
+                ComputeTanSlope(x, y).Store2Val(adfTanSlope);
+                pafOutput[0] = static_cast<float>(atan(adfTanSlope[0]) *
+                                                  kdfRadiansToDegrees);
+                pafOutput[1] = static_cast<float>(atan(adfTanSlope[1]) *
+                                                  kdfRadiansToDegrees);
+            },
+            pafOutputBuf);
+    }
+
+    const XMMReg2Double hundred = GDALDEMSet1(100.0);
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](const XMMReg2Double &x, const XMMReg2Double &y, float *pafOutput)
+        { (hundred * ComputeTanSlope(x, y)).Store2Val(pafOutput); },
+        pafOutputBuf);
+}
+#endif
+
 static void *GDALCreateSlopeData(double *adfGeoTransform, double scale,
                                  int slopeFormat)
 {
@@ -1333,18 +1968,9 @@ typedef struct
     bool bAngleAsAzimuth;
 } GDALAspectAlgData;
 
-template <class T>
-static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
+static float GDALAspectFromGradient(double dx, double dy,
+                                    float fDstNoDataValue, bool bAngleAsAzimuth)
 {
-    const GDALAspectAlgData *psData =
-        static_cast<const GDALAspectAlgData *>(pData);
-
-    const double dx = ((afWin[2] + afWin[5] + afWin[5] + afWin[8]) -
-                       (afWin[0] + afWin[3] + afWin[3] + afWin[6]));
-
-    const double dy = ((afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
-                       (afWin[0] + afWin[1] + afWin[1] + afWin[2]));
-
     float aspect = static_cast<float>(atan2(dy, -dx) / kdfDegreesToRadians);
 
     if (dx == 0 && dy == 0)
@@ -1352,7 +1978,7 @@ static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
         /* Flat area */
         aspect = fDstNoDataValue;
     }
-    else if (psData->bAngleAsAzimuth)
+    else if (bAngleAsAzimuth)
     {
         if (aspect > 90.0f)
             aspect = 450.0f - aspect;
@@ -1371,6 +1997,22 @@ static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
     return aspect;
 }
 
+template <class T>
+static float GDALAspectAlg(const T *afWin, float fDstNoDataValue, void *pData)
+{
+    const GDALAspectAlgData *psData =
+        static_cast<const GDALAspectAlgData *>(pData);
+
+    const double dx = ((afWin[2] + afWin[5] + afWin[5] + afWin[8]) -
+                       (afWin[0] + afWin[3] + afWin[3] + afWin[6]));
+
+    const double dy = ((afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
+                       (afWin[0] + afWin[1] + afWin[1] + afWin[2]));
+
+    return GDALAspectFromGradient(dx, dy, fDstNoDataValue,
+                                  psData->bAngleAsAzimuth);
+}
+
 template <class T>
 static float GDALAspectZevenbergenThorneAlg(const T *afWin,
                                             float fDstNoDataValue, void *pData)
@@ -1380,30 +2022,40 @@ static float GDALAspectZevenbergenThorneAlg(const T *afWin,
 
     const double dx = afWin[5] - afWin[3];
     const double dy = afWin[7] - afWin[1];
-    float aspect = static_cast<float>(atan2(dy, -dx) / kdfDegreesToRadians);
-    if (dx == 0 && dy == 0)
-    {
-        /* Flat area */
-        aspect = fDstNoDataValue;
-    }
-    else if (psData->bAngleAsAzimuth)
-    {
-        if (aspect > 90.0f)
-            aspect = 450.0f - aspect;
-        else
-            aspect = 90.0f - aspect;
-    }
-    else
-    {
-        if (aspect < 0)
-            aspect += 360.0f;
-    }
 
-    if (aspect == 360.0f)
-        aspect = 0.0;
+    return GDALAspectFromGradient(dx, dy, fDstNoDataValue,
+                                  psData->bAngleAsAzimuth);
+}
 
-    return aspect;
+#ifdef USE_SSE2
+template <class T, GradientAlg alg>
+static int GDALAspectAlg_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                     int nLine2Off, int nLine3Off, int nXSize,
+                                     float fDstNoDataValue, void *pData,
+                                     float *pafOutputBuf)
+{
+    const GDALAspectAlgData *psData =
+        static_cast<const GDALAspectAlgData *>(pData);
+    const bool bAngleAsAzimuth = psData->bAngleAsAzimuth;
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [fDstNoDataValue, bAngleAsAzimuth](const XMMReg2Double &x,
+                                           const XMMReg2Double &y,
+                                           float *pafOutput)
+        {
+            double adfX[2], adfY[2];
+            x.Store2Val(adfX);
+            y.Store2Val(adfY);
+            // The dx of the per-pixel algorithms is -x.
+            pafOutput[0] = GDALAspectFromGradient(
+                -adfX[0], adfY[0], fDstNoDataValue, bAngleAsAzimuth);
+            pafOutput[1] = GDALAspectFromGradient(
+                -adfX[1], adfY[1], fDstNoDataValue, bAngleAsAzimuth);
+        },
+        pafOutputBuf);
 }
+#endif
 
 static void *GDALCreateAspectData(bool bAngleAsAzimuth)
 {
@@ -3172,6 +3824,73 @@ static Algorithm GetAlgorithm(const char *pszProcessing)
     }
 }
 
+/************************************************************************/
+/*                     GDALDEMGetMultisampleAlg()                       */
+/************************************************************************/
+
+#ifdef USE_SSE2
+// Returns the version of the algorithm that computes several pixels at
+// once, when there is one.
+template <class T, GradientAlg alg>
+static typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+GDALDEMGetMultisampleAlg(Algorithm eUtilityMode,
+                         const GDALDEMProcessingOptions *psOptions,
+                         bool bSameRes)
+{
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+    const bool bUseAVX =
+        CPLTestBool(CPLGetConfigOption("GDAL_USE_AVX", "YES")) &&
+        CPLHaveRuntimeAVX();
+#endif
+
+    if (eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional)
+    {
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+        if (bUseAVX)
+            return GDALHillshadeMultiDirectionalAlg_multisample_AVX<T, alg>;
+#endif
+        return GDALHillshadeMultiDirectionalAlg_multisample<T, alg>;
+    }
+    else if (eUtilityMode == HILL_SHADE && psOptions->bCombined)
+    {
+        return GDALHillshadeCombinedAlg_multisample<T, alg>;
+    }
+    else if (eUtilityMode == HILL_SHADE && psOptions->bIgor)
+    {
+        return GDALHillshadeIgorAlg_multisample<T, alg>;
+    }
+    else if (eUtilityMode == HILL_SHADE)
+    {
+        if (alg == GradientAlg::HORN && bSameRes)
+        {
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+            if (bUseAVX)
+                return GDALHillshadeAlg_same_res_multisample_AVX<T>;
+#endif
+            return GDALHillshadeAlg_same_res_multisample<T>;
+        }
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+        if (bUseAVX)
+            return GDALHillshadeAlg_multisample_AVX<T, alg>;
+#endif
+        return GDALHillshadeAlg_multisample<T, alg>;
+    }
+    else if (eUtilityMode == SLOPE)
+    {
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+        if (bUseAVX)
+            return GDALSlopeAlg_multisample_AVX<T, alg>;
+#endif
+        return GDALSlopeAlg_multisample<T, alg>;
+    }
+    else if (eUtilityMode == ASPECT)
+    {
+        return GDALAspectAlg_multisample<T, alg>;
+    }
+    return nullptr;
+}
+#endif
+
 /************************************************************************/
 /*                    GDALDEMAppOptionsGetParser()                      */
 /************************************************************************/
@@ -3210,6 +3929,22 @@ static std::unique_ptr<GDALArgumentParser> GDALDEMAppOptionsGetParser(
 
         subParser->add_creation_options_argument(psOptions->aosCreationOptions);
 
+        subParser->add_argument("-num_threads")
+            .metavar("<value|ALL_CPUS>")
+            .action(
+                [psOptions](const std::string &s)
+                {
+                    if (!EQUAL(s.c_str(), "ALL_CPUS") &&
+                        CPLGetValueType(s.c_str()) != CPL_VALUE_INTEGER)
+                    {
+                        throw std::invalid_argument(CPLSPrintf(
+                            "Invalid value for -num_threads: %s.", s.c_str()));
+                    }
+                    psOptions->osNumThreads = s;
+                })
+            .help(_("Number of worker threads for processing. Defaults to the "
+                    "GDAL_NUM_THREADS configuration option."));
+
         if (psOptionsForBinary)
         {
             subParser->add_quiet_argument(&psOptionsForBinary->bQuiet);
@@ -3820,6 +4555,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     void *pData = nullptr;
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type
+        pfnAlgFloat_multisample = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type
         pfnAlgInt32_multisample = nullptr;
 
@@ -3900,10 +4637,6 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                 {
                     pfnAlgFloat = GDALHillshadeAlg_same_res<float>;
                     pfnAlgInt32 = GDALHillshadeAlg_same_res<GInt32>;
-#ifdef HAVE_16_SSE_REG
-                    pfnAlgInt32_multisample =
-                        GDALHillshadeAlg_same_res_multisample<GInt32>;
-#endif
                 }
                 else
                 {
@@ -3982,6 +4715,32 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         pfnAlgInt32 = GDALRoughnessAlg<GInt32>;
     }
 
+#ifdef USE_SSE2
+    {
+        const bool bSameRes = adfGeoTransform[1] == -adfGeoTransform[5];
+        if (psOptions->eGradientAlg == GradientAlg::ZEVENBERGEN_THORNE)
+        {
+            pfnAlgFloat_multisample =
+                GDALDEMGetMultisampleAlg<float,
+                                         GradientAlg::ZEVENBERGEN_THORNE>(
+                    eUtilityMode, psOptions, bSameRes);
+            pfnAlgInt32_multisample =
+                GDALDEMGetMultisampleAlg<GInt32,
+                                         GradientAlg::ZEVENBERGEN_THORNE>(
+                    eUtilityMode, psOptions, bSameRes);
+        }
+        else
+        {
+            pfnAlgFloat_multisample =
+                GDALDEMGetMultisampleAlg<float, GradientAlg::HORN>(
+                    eUtilityMode, psOptions, bSameRes);
+            pfnAlgInt32_multisample =
+                GDALDEMGetMultisampleAlg<GInt32, GradientAlg::HORN>(
+                    eUtilityMode, psOptions, bSameRes);
+        }
+    }
+#endif
+
     const GDALDataType eDstDataType =
         (eUtilityMode == HILL_SHADE || eUtilityMode == COLOR_RELIEF)
             ? GDT_Byte
@@ -4157,17 +4916,28 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         if (bDstHasNoData)
             GDALSetRasterNoDataValue(hDstBand, dfDstNoDataValue);
 
+        const char *pszNumThreads =
+            psOptions->osNumThreads.empty()
+                ? CPLGetConfigOption("GDAL_NUM_THREADS", "1")
+                : psOptions->osNumThreads.c_str();
+        const int nNumThreads = std::max(
+            1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                                 ? CPLGetNumCPUs()
+                                 : atoi(pszNumThreads)));
+
         if (eSrcDT == GDT_Byte || eSrcDT == GDT_Int16 || eSrcDT == GDT_UInt16)
         {
             GDALGeneric3x3Processing<GInt32>(
                 hSrcBand, hDstBand, pfnAlgInt32, pfnAlgInt32_multisample, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                psOptions->bComputeAtEdges, nNumThreads, pfnProgress,
+                pProgressData);
         }
         else
         {
             GDALGeneric3x3Processing<float>(
-                hSrcBand, hDstBand, pfnAlgFloat, nullptr, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                hSrcBand, hDstBand, pfnAlgFloat, pfnAlgFloat_multisample, pData,
+                psOptions->bComputeAtEdges, nNumThreads, pfnProgress,
+                pProgressData);
         }
     }
 
@@ -0,0 +1,527 @@
+/******************************************************************************
+ *
+ * Project:  GDAL DEM Utilities
+ * Purpose:  AVX optimized versions of the gdaldem algorithms
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdaldem_lib_priv.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+
+#include <cmath>
+#include <limits>
+
+#include <immintrin.h>
+
+// gdalsse_priv.h is deliberately not used in this file: its XMMReg4Double
+// class would get a different definition than in the files compiled without
+// the AVX flags.
+
+using namespace gdal::GDALDEM;
+
+static const double kdfRadiansToDegrees = 180.0 / M_PI;
+
+namespace
+{
+
+/************************************************************************/
+/*                            GDALDEMVec8                               */
+/************************************************************************/
+
+// 8 consecutive source values, on which arithmetic is done in the precision
+// of the source type, so that the computed gradients are identical to the
+// ones of the per-pixel algorithms.
+template <class T> struct GDALDEMVec8;
+
+template <> struct GDALDEMVec8<GInt32>
+{
+    // AVX has no 256 bit integer arithmetic
+    __m128i low;
+    __m128i high;
+
+    static inline GDALDEMVec8 Load(const GInt32 *ptr)
+    {
+        GDALDEMVec8 reg;
+        reg.low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        reg.high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 4));
+        return reg;
+    }
+
+    inline GDALDEMVec8 operator+(const GDALDEMVec8 &other) const
+    {
+        GDALDEMVec8 ret;
+        ret.low = _mm_add_epi32(low, other.low);
+        ret.high = _mm_add_epi32(high, other.high);
+        return ret;
+    }
+
+    inline GDALDEMVec8 operator-(const GDALDEMVec8 &other) const
+    {
+        GDALDEMVec8 ret;
+        ret.low = _mm_sub_epi32(low, other.low);
+        ret.high = _mm_sub_epi32(high, other.high);
+        return ret;
+    }
+
+    inline void ToDouble(__m256d &dlow, __m256d &dhigh) const
+    {
+        dlow = _mm256_cvtepi32_pd(low);
+        dhigh = _mm256_cvtepi32_pd(high);
+    }
+};
+
+template <> struct GDALDEMVec8<float>
+{
+    __m256 ymm;
+
+    static inline GDALDEMVec8 Load(const float *ptr)
+    {
+        GDALDEMVec8 reg;
+        reg.ymm = _mm256_loadu_ps(ptr);
+        return reg;
+    }
+
+    inline GDALDEMVec8 operator+(const GDALDEMVec8 &other) const
+    {
+        GDALDEMVec8 ret;
+        ret.ymm = _mm256_add_ps(ymm, other.ymm);
+        return ret;
+    }
+
+    inline GDALDEMVec8 operator-(const GDALDEMVec8 &other) const
+    {
+        GDALDEMVec8 ret;
+        ret.ymm = _mm256_sub_ps(ymm, other.ymm);
+        return ret;
+    }
+
+    inline void ToDouble(__m256d &dlow, __m256d &dhigh) const
+    {
+        dlow = _mm256_cvtps_pd(_mm256_castps256_ps128(ymm));
+        dhigh = _mm256_cvtps_pd(_mm256_extractf128_ps(ymm, 1));
+    }
+};
+
+/************************************************************************/
+/*                         GradientMultisample                          */
+/************************************************************************/
+
+// Computes the gradients of the 8 pixels starting at column j, before
+// their multiplication by the inverse of the resolution, in the order of
+// the operations of Gradient<T, alg>::calc().
+template <class T, GradientAlg alg> struct GradientMultisample
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            __m256d (&x)[2], __m256d (&y)[2]);
+};
+
+template <class T> struct GradientMultisample<T, GradientAlg::HORN>
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            __m256d (&x)[2], __m256d (&y)[2])
+    {
+        typedef GDALDEMVec8<T> V;
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+        const V w0 = V::Load(firstLine);
+        const V w1 = V::Load(firstLine + 1);
+        const V w2 = V::Load(firstLine + 2);
+        const V w3 = V::Load(secondLine);
+        const V w5 = V::Load(secondLine + 2);
+        const V w6 = V::Load(thirdLine);
+        const V w7 = V::Load(thirdLine + 1);
+        const V w8 = V::Load(thirdLine + 2);
+
+        ((w0 + w3 + w3 + w6) - (w2 + w5 + w5 + w8)).ToDouble(x[0], x[1]);
+        ((w6 + w7 + w7 + w8) - (w0 + w1 + w1 + w2)).ToDouble(y[0], y[1]);
+    }
+};
+
+template <class T>
+struct GradientMultisample<T, GradientAlg::ZEVENBERGEN_THORNE>
+{
+    static inline void calc(const T *pafThreeLineWin, int nLine1Off,
+                            int nLine2Off, int nLine3Off, int j,
+                            __m256d (&x)[2], __m256d (&y)[2])
+    {
+        typedef GDALDEMVec8<T> V;
+        const V w1 = V::Load(pafThreeLineWin + nLine1Off + j);
+        const V w3 = V::Load(pafThreeLineWin + nLine2Off + j - 1);
+        const V w5 = V::Load(pafThreeLineWin + nLine2Off + j + 1);
+        const V w7 = V::Load(pafThreeLineWin + nLine3Off + j);
+
+        (w3 - w5).ToDouble(x[0], x[1]);
+        (w7 - w1).ToDouble(y[0], y[1]);
+    }
+};
+
+/************************************************************************/
+/*                         GDALDEMMultisample()                         */
+/************************************************************************/
+
+// Runs oKernel(x, y, pafOutput) on all groups of 8 pixels of the line for
+// which the 3x3 window is fully inside the line, 4 pixels at a time.
+template <class T, GradientAlg alg, class Kernel>
+inline int GDALDEMMultisample(const T *pafThreeLineWin, int nLine1Off,
+                              int nLine2Off, int nLine3Off, int nXSize,
+                              const Kernel &oKernel, float *pafOutputBuf)
+{
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 8; j += 8)
+    {
+        __m256d x[2], y[2];
+        GradientMultisample<T, alg>::calc(pafThreeLineWin, nLine1Off,
+                                          nLine2Off, nLine3Off, j, x, y);
+        oKernel(x[0], y[0], pafOutputBuf + j);
+        oKernel(x[1], y[1], pafOutputBuf + j + 4);
+    }
+    return j;
+}
+
+// Returns a / sqrt(b), with the same approximation as the SSE2 version
+inline __m256d ApproxADivByInvSqrtB(__m256d a, __m256d b)
+{
+    // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
+    __m256d approx_inv_sqrt_b =
+        _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(b)));
+    // And perform one step of Newton-Raphson approximation to improve it
+    approx_inv_sqrt_b = _mm256_mul_pd(
+        approx_inv_sqrt_b,
+        _mm256_sub_pd(
+            _mm256_set1_pd(1.5),
+            _mm256_mul_pd(_mm256_mul_pd(b, _mm256_set1_pd(0.5)),
+                          _mm256_mul_pd(approx_inv_sqrt_b,
+                                        approx_inv_sqrt_b))));
+    return _mm256_mul_pd(a, approx_inv_sqrt_b);
+}
+
+inline void Store4Val(__m256d reg, float *pafOutput)
+{
+    _mm_storeu_ps(pafOutput, _mm256_cvtpd_ps(reg));
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                  GDALHillshadeAlg_multisample_AVX()                  */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALHillshadeAlg_multisample_AVX(const T *pafThreeLineWin, int nLine1Off,
+                                     int nLine2Off, int nLine3Off, int nXSize,
+                                     float /*fDstNoDataValue*/, void *pData,
+                                     float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m256d inv_ewres = _mm256_set1_pd(psData->inv_ewres);
+    const __m256d inv_nsres = _mm256_set1_pd(psData->inv_nsres);
+    const __m256d sin_altRadians_mul_254 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_254);
+    const __m256d cos_az_mul_cos_alt_mul_z_mul_254 =
+        _mm256_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254);
+    const __m256d sin_az_mul_cos_alt_mul_z_mul_254 =
+        _mm256_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254);
+    const __m256d square_z = _mm256_set1_pd(psData->square_z);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](__m256d gradX, __m256d gradY, float *pafOutput)
+        {
+            // First Slope ...
+            const __m256d x = _mm256_mul_pd(gradX, inv_ewres);
+            const __m256d y = _mm256_mul_pd(gradY, inv_nsres);
+
+            const __m256d xx_plus_yy =
+                _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+
+            // ... then the shade value
+            const __m256d cang_mul_254 = ApproxADivByInvSqrtB(
+                _mm256_sub_pd(
+                    sin_altRadians_mul_254,
+                    _mm256_sub_pd(
+                        _mm256_mul_pd(y, cos_az_mul_cos_alt_mul_z_mul_254),
+                        _mm256_mul_pd(x, sin_az_mul_cos_alt_mul_z_mul_254))),
+                _mm256_add_pd(one, _mm256_mul_pd(square_z, xx_plus_yy)));
+
+            // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+            Store4Val(_mm256_max_pd(one, _mm256_add_pd(one, cang_mul_254)),
+                      pafOutput);
+        },
+        pafOutputBuf);
+}
+
+/************************************************************************/
+/*              GDALHillshadeAlg_same_res_multisample_AVX()             */
+/************************************************************************/
+
+template <class T>
+int GDALHillshadeAlg_same_res_multisample_AVX(const T *pafThreeLineWin,
+                                              int nLine1Off, int nLine2Off,
+                                              int nLine3Off, int nXSize,
+                                              float /*fDstNoDataValue*/,
+                                              void *pData, float *pafOutputBuf)
+{
+    typedef GDALDEMVec8<T> V;
+
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m256d reg_fact_x =
+        _mm256_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d reg_fact_y =
+        _mm256_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d reg_constant_num =
+        _mm256_set1_pd(psData->sin_altRadians_mul_254);
+    const __m256d reg_constant_denom =
+        _mm256_set1_pd(psData->square_z_mul_square_inv_res);
+    const __m256d reg_one = _mm256_set1_pd(1.0);
+    const __m128 reg_one_float = _mm_set1_ps(1);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 8; j += 8)
+    {
+        const T *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const T *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const T *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+
+        const V firstLine0 = V::Load(firstLine);
+        const V firstLine1 = V::Load(firstLine + 1);
+        const V firstLine2 = V::Load(firstLine + 2);
+        const V thirdLine0 = V::Load(thirdLine);
+        const V thirdLine1 = V::Load(thirdLine + 1);
+        const V thirdLine2 = V::Load(thirdLine + 2);
+        V accX = firstLine0 - thirdLine2;
+        const V six_minus_two = thirdLine0 - firstLine2;
+        V accY = accX;
+        const V three_minus_five =
+            V::Load(secondLine) - V::Load(secondLine + 2);
+        const V one_minus_seven = firstLine1 - thirdLine1;
+        accX = accX + three_minus_five;
+        accY = accY + one_minus_seven;
+        accX = accX + three_minus_five;
+        accY = accY + one_minus_seven;
+        accX = accX + six_minus_two;
+        accY = accY - six_minus_two;
+
+        __m256d reg_x[2], reg_y[2];
+        accX.ToDouble(reg_x[0], reg_x[1]);
+        accY.ToDouble(reg_y[0], reg_y[1]);
+        for (int k = 0; k < 2; ++k)
+        {
+            const __m256d reg_xx_plus_yy =
+                _mm256_add_pd(_mm256_mul_pd(reg_x[k], reg_x[k]),
+                              _mm256_mul_pd(reg_y[k], reg_y[k]));
+            const __m256d reg_cang_mul_254 = ApproxADivByInvSqrtB(
+                _mm256_add_pd(
+                    reg_constant_num,
+                    _mm256_add_pd(_mm256_mul_pd(reg_fact_x, reg_x[k]),
+                                  _mm256_mul_pd(reg_fact_y, reg_y[k]))),
+                _mm256_add_pd(reg_one, _mm256_mul_pd(reg_constant_denom,
+                                                     reg_xx_plus_yy)));
+
+            if (std::numeric_limits<T>::is_integer)
+            {
+                // Same as the SSE2 version
+                __m128 res = _mm256_cvtpd_ps(reg_cang_mul_254);
+                res = _mm_add_ps(res, reg_one_float);
+                res = _mm_max_ps(res, reg_one_float);
+                _mm_storeu_ps(pafOutputBuf + j + 4 * k, res);
+            }
+            else
+            {
+                // cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+                Store4Val(_mm256_max_pd(reg_one,
+                                        _mm256_add_pd(reg_one,
+                                                      reg_cang_mul_254)),
+                          pafOutputBuf + j + 4 * k);
+            }
+        }
+    }
+    return j;
+}
+
+/************************************************************************/
+/*           GDALHillshadeMultiDirectionalAlg_multisample_AVX()         */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALHillshadeMultiDirectionalAlg_multisample_AVX(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, float /*fDstNoDataValue*/, void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeMultiDirectionalAlgData *psData =
+        static_cast<const GDALHillshadeMultiDirectionalAlgData *>(pData);
+    const __m256d inv_ewres = _mm256_set1_pd(psData->inv_ewres);
+    const __m256d inv_nsres = _mm256_set1_pd(psData->inv_nsres);
+    const __m256d square_z = _mm256_set1_pd(psData->square_z);
+    const __m256d sin_altRadians_mul_127 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_127);
+    const __m256d cos_alt_mul_z_mul_127 =
+        _mm256_set1_pd(psData->cos_alt_mul_z_mul_127);
+    const __m256d cos225_az_mul_cos_alt_mul_z_mul_127 =
+        _mm256_set1_pd(psData->cos225_az_mul_cos_alt_mul_z_mul_127);
+    const __m256d flat_value =
+        _mm256_set1_pd(1.0 + psData->sin_altRadians_mul_254);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](__m256d gradX, __m256d gradY, float *pafOutput)
+        {
+            // First Slope ...
+            const __m256d x = _mm256_mul_pd(gradX, inv_ewres);
+            const __m256d y = _mm256_mul_pd(gradY, inv_nsres);
+
+            const __m256d xx = _mm256_mul_pd(x, x);
+            const __m256d yy = _mm256_mul_pd(y, y);
+            const __m256d xx_plus_yy = _mm256_add_pd(xx, yy);
+
+            // ... then the shade value from different azimuth
+            const __m256d val225_mul_127 = _mm256_max_pd(
+                zero,
+                _mm256_add_pd(
+                    sin_altRadians_mul_127,
+                    _mm256_mul_pd(_mm256_sub_pd(x, y),
+                                  cos225_az_mul_cos_alt_mul_z_mul_127)));
+            const __m256d val270_mul_127 = _mm256_max_pd(
+                zero, _mm256_sub_pd(sin_altRadians_mul_127,
+                                    _mm256_mul_pd(x, cos_alt_mul_z_mul_127)));
+            const __m256d val315_mul_127 = _mm256_max_pd(
+                zero,
+                _mm256_add_pd(
+                    sin_altRadians_mul_127,
+                    _mm256_mul_pd(_mm256_add_pd(x, y),
+                                  cos225_az_mul_cos_alt_mul_z_mul_127)));
+            const __m256d val360_mul_127 = _mm256_max_pd(
+                zero, _mm256_sub_pd(sin_altRadians_mul_127,
+                                    _mm256_mul_pd(y, cos_alt_mul_z_mul_127)));
+
+            // ... then the weighted shading
+            const __m256d weight_225 = _mm256_sub_pd(
+                _mm256_mul_pd(half, xx_plus_yy), _mm256_mul_pd(x, y));
+            const __m256d weight_270 = xx;
+            const __m256d weight_315 = _mm256_sub_pd(xx_plus_yy, weight_225);
+            const __m256d weight_360 = yy;
+            const __m256d sum = _mm256_add_pd(
+                _mm256_add_pd(
+                    _mm256_add_pd(_mm256_mul_pd(weight_225, val225_mul_127),
+                                  _mm256_mul_pd(weight_270, val270_mul_127)),
+                    _mm256_mul_pd(weight_315, val315_mul_127)),
+                _mm256_mul_pd(weight_360, val360_mul_127));
+            const __m256d cang_mul_127 = ApproxADivByInvSqrtB(
+                _mm256_div_pd(sum, xx_plus_yy),
+                _mm256_add_pd(one, _mm256_mul_pd(square_z, xx_plus_yy)));
+
+            Store4Val(_mm256_blendv_pd(_mm256_add_pd(one, cang_mul_127),
+                                       flat_value,
+                                       _mm256_cmp_pd(xx_plus_yy, zero,
+                                                     _CMP_EQ_OQ)),
+                      pafOutput);
+        },
+        pafOutputBuf);
+}
+
+/************************************************************************/
+/*                   GDALSlopeAlg_multisample_AVX()                     */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALSlopeAlg_multisample_AVX(const T *pafThreeLineWin, int nLine1Off,
+                                 int nLine2Off, int nLine3Off, int nXSize,
+                                 float /*fDstNoDataValue*/, void *pData,
+                                 float *pafOutputBuf)
+{
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const __m256d ewres = _mm256_set1_pd(psData->ewres);
+    const __m256d nsres = _mm256_set1_pd(psData->nsres);
+    const __m256d scale = _mm256_set1_pd(
+        (alg == GradientAlg::ZEVENBERGEN_THORNE ? 2 : 8) * psData->scale);
+
+    const auto ComputeTanSlope = [&](__m256d x, __m256d y)
+    {
+        const __m256d dx = _mm256_div_pd(x, ewres);
+        const __m256d dy = _mm256_div_pd(y, nsres);
+        const __m256d key =
+            _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        return _mm256_div_pd(_mm256_sqrt_pd(key), scale);
+    };
+
+    if (psData->slopeFormat == 1)
+    {
+        return GDALDEMMultisample<T, alg>(
+            pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+            [&](__m256d x, __m256d y, float *pafOutput)
+            {
+                double adfTanSlope[4];
+                _mm256_storeu_pd(adfTanSlope, ComputeTanSlope(x, y));
+                for (int k = 0; k < 4; ++k)
+                {
+                    pafOutput[k] = static_cast<float>(atan(adfTanSlope[k]) *
+                                                      kdfRadiansToDegrees);
+                }
+            },
+            pafOutputBuf);
+    }
+
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    return GDALDEMMultisample<T, alg>(
+        pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off, nXSize,
+        [&](__m256d x, __m256d y, float *pafOutput)
+        {
+            Store4Val(_mm256_mul_pd(hundred, ComputeTanSlope(x, y)),
+                      pafOutput);
+        },
+        pafOutputBuf);
+}
+
+/************************************************************************/
+/*                      Explicit instantiations                         */
+/************************************************************************/
+
+#define INSTANTIATE_ALG(T, alg)                                                \
+    template int GDALHillshadeAlg_multisample_AVX<T, alg>(                     \
+        const T *, int, int, int, int, float, void *, float *);                \
+    template int GDALHillshadeMultiDirectionalAlg_multisample_AVX<T, alg>(     \
+        const T *, int, int, int, int, float, void *, float *);                \
+    template int GDALSlopeAlg_multisample_AVX<T, alg>(                         \
+        const T *, int, int, int, int, float, void *, float *);
+
+#define INSTANTIATE(T)                                                         \
+    INSTANTIATE_ALG(T, GradientAlg::HORN)                                      \
+    INSTANTIATE_ALG(T, GradientAlg::ZEVENBERGEN_THORNE)                        \
+    template int GDALHillshadeAlg_same_res_multisample_AVX<T>(                 \
+        const T *, int, int, int, int, float, void *, float *);
+
+INSTANTIATE(GInt32)
+INSTANTIATE(float)
+
+#endif /* HAVE_AVX_AT_COMPILE_TIME */
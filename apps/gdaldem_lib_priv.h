@@ -0,0 +1,126 @@
+/******************************************************************************
+ *
+ * Project:  GDAL DEM Utilities
+ * Purpose:  Private definitions shared by the gdaldem_lib*.cpp files
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALDEM_LIB_PRIV_H
+#define GDALDEM_LIB_PRIV_H
+
+#include "cpl_port.h"
+
+//! @cond Doxygen_Suppress
+
+namespace gdal::GDALDEM
+{
+enum class GradientAlg
+{
+    HORN,
+    ZEVENBERGEN_THORNE,
+};
+
+enum class TRIAlg
+{
+    WILSON,
+    RILEY,
+};
+}  // namespace gdal::GDALDEM
+
+typedef struct
+{
+    double inv_nsres;
+    double inv_ewres;
+    double sin_altRadians;
+    double cos_alt_mul_z;
+    double azRadians;
+    double cos_az_mul_cos_alt_mul_z;
+    double sin_az_mul_cos_alt_mul_z;
+    double square_z;
+    double sin_altRadians_mul_254;
+    double cos_az_mul_cos_alt_mul_z_mul_254;
+    double sin_az_mul_cos_alt_mul_z_mul_254;
+
+    double square_z_mul_square_inv_res;
+    double cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
+    double sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
+    double z_scaled;
+} GDALHillshadeAlgData;
+
+typedef struct
+{
+    double inv_nsres;
+    double inv_ewres;
+    double square_z;
+    double sin_altRadians_mul_127;
+    double sin_altRadians_mul_254;
+
+    double cos_alt_mul_z_mul_127;
+    double cos225_az_mul_cos_alt_mul_z_mul_127;
+
+} GDALHillshadeMultiDirectionalAlgData;
+
+typedef struct
+{
+    double nsres;
+    double ewres;
+    double scale;
+    int slopeFormat;
+} GDALSlopeAlgData;
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+
+// AVX implementations of the multisample algorithms, in gdaldem_lib_avx.cpp.
+// They are instantiated for T = GInt32 and T = float, and return the index
+// of the first pixel of the line that has not been computed.
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALHillshadeAlg_multisample_AVX(const T *pafThreeLineWin, int nLine1Off,
+                                     int nLine2Off, int nLine3Off, int nXSize,
+                                     float fDstNoDataValue, void *pData,
+                                     float *pafOutputBuf);
+
+template <class T>
+int GDALHillshadeAlg_same_res_multisample_AVX(const T *pafThreeLineWin,
+                                              int nLine1Off, int nLine2Off,
+                                              int nLine3Off, int nXSize,
+                                              float fDstNoDataValue,
+                                              void *pData, float *pafOutputBuf);
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALHillshadeMultiDirectionalAlg_multisample_AVX(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, float fDstNoDataValue, void *pData, float *pafOutputBuf);
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALSlopeAlg_multisample_AVX(const T *pafThreeLineWin, int nLine1Off,
+                                 int nLine2Off, int nLine3Off, int nXSize,
+                                 float fDstNoDataValue, void *pData,
+                                 float *pafOutputBuf);
+
+#endif  // HAVE_AVX_AT_COMPILE_TIME
+
+//! @endcond
+
+#endif  // GDALDEM_LIB_PRIV_H
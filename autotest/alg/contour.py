@@ -401,3 +401,56 @@ def test_contour_raster_acquisition_error():
         gdal.ContourGenerateEx(
             ds.GetRasterBand(1), ogr_lyr, options=["LEVEL_INTERVAL=1", "ID_FIELD=0"]
         )
+
+
+###############################################################################
+# Test multi-threaded contour line generation
+
+
+@pytest.mark.parametrize("lines_per_stripe", [1, 3, 7])
+def test_contour_multi_threaded(lines_per_stripe):
+
+    ds = gdal.Open("data/contour_in.tif")
+
+    def get_lines(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        ogr_lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+        field_defn = ogr.FieldDefn("elev", ogr.OFTReal)
+        ogr_lyr.CreateField(field_defn)
+        gdal.ContourGenerateEx(
+            ds.GetRasterBand(1),
+            ogr_lyr,
+            options=[
+                "LEVEL_INTERVAL=10",
+                "ELEV_FIELD=0",
+                "NUM_THREADS=%d" % num_threads,
+            ],
+        )
+        lines = {}
+        for f in ogr_lyr:
+            lines.setdefault(f["elev"], []).append(
+                _normalize_line(f.GetGeometryRef().GetPoints())
+            )
+        return {elev: sorted(points) for elev, points in lines.items()}
+
+    ref_lines = gdaltest.check_multi_threaded_result(
+        get_lines, chunk_size=lines_per_stripe
+    )
+    assert ref_lines
+
+
+def _normalize_line(points):
+    """Returns the vertices of a line, rounded, in a canonical order, since
+    lines stitched across stripes may start at another end point, or for
+    rings at another vertex, than in the single-threaded case."""
+
+    points = [(round(x, 8), round(y, 8)) for x, y in points]
+    if len(points) > 1 and points[0] == points[-1]:
+        ring = points[:-1]
+        candidates = []
+        for r in (ring, ring[::-1]):
+            i = r.index(min(r))
+            candidates.append(r[i:] + r[:i])
+        ring = min(candidates)
+        return tuple(ring + ring[:1])
+    return tuple(min(points, points[::-1]))
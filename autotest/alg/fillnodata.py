@@ -403,3 +403,55 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Test that tiled processing gives the same result as the line-based one
+
+
+@pytest.mark.parametrize("interpolation", ["INV_DIST", "NEAREST"])
+@pytest.mark.parametrize(
+    "tile_size,num_threads", [("7", "1"), ("16", "4"), (None, "ALL_CPUS")]
+)
+def test_fillnodata_tiled(interpolation, tile_size, num_threads):
+
+    xsize = 100
+    ysize = 80
+    values = array.array(
+        "f",
+        [
+            ((x * 7 + y * 13) % 37) + 0.5 * (x % 5)
+            for y in range(ysize)
+            for x in range(xsize)
+        ],
+    )
+    mask = array.array(
+        "B",
+        [
+            0 if ((x // 9 + y // 7) % 3 == 0 or (x * y) % 11 == 0) else 255
+            for y in range(ysize)
+            for x in range(xsize)
+        ],
+    )
+
+    def run(options):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", xsize, ysize, 1, gdal.GDT_Float32
+        )
+        ds.GetRasterBand(1).WriteRaster(0, 0, xsize, ysize, values.tobytes())
+        mask_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+        mask_ds.GetRasterBand(1).WriteRaster(0, 0, xsize, ysize, mask.tobytes())
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=mask_ds.GetRasterBand(1),
+            maxSearchDist=5,
+            smoothingIterations=3,
+            options=["INTERPOLATION=" + interpolation] + options,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    expected = run([])
+    options = ["NUM_THREADS=" + num_threads]
+    if tile_size:
+        options.append("TILE_SIZE=" + tile_size)
+    assert run(options) == expected
@@ -33,6 +33,7 @@
 import struct
 from collections import defaultdict
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -448,3 +449,36 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that the multi-threaded implementation, which stitches the polygons
+# crossing stripe borders, gives the same polygons as the single-threaded one.
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("options", [[], ["8CONNECTED=8"]])
+@pytest.mark.parametrize("lines_per_stripe", ["1", "2", "7"])
+def test_polygonize_multi_threaded(is_int_polygonize, options, lines_per_stripe):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(num_threads):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("out", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        func = gdal.Polygonize if is_int_polygonize else gdal.FPolygonize
+        result = func(
+            src_band,
+            src_band.GetMaskBand(),
+            mem_layer,
+            0,
+            options + ["NUM_THREADS=%d" % num_threads],
+        )
+        assert result == 0, "Polygonize failed"
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    gdaltest.check_multi_threaded_result(polygonize, chunk_size=lines_per_stripe)
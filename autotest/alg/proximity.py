@@ -29,6 +29,9 @@
 ###############################################################################
 
 
+import math
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -126,3 +129,78 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EDT against exact distances
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("lines_per_chunk", [None, "1", "3"])
+def test_proximity_edt(num_threads, lines_per_chunk):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+    src_data = src_band.ReadRaster(buf_type=gdal.GDT_Int32)
+    src_vals = struct.unpack("i" * (xsize * ysize), src_data)
+
+    max_dist = 8.5
+    targets = [
+        (x, y)
+        for y in range(ysize)
+        for x in range(xsize)
+        if src_vals[y * xsize + x]
+    ]
+    expected = []
+    for y in range(ysize):
+        for x in range(xsize):
+            dist = min(math.hypot(x - tx, y - ty) for tx, ty in targets)
+            expected.append(dist if dist <= max_dist else -1.0)
+
+    dst_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 1, gdal.GDT_Float32
+    )
+    dst_band = dst_ds.GetRasterBand(1)
+
+    with gdal.config_option("GDAL_TEST_CHUNK_SIZE", lines_per_chunk):
+        gdal.ComputeProximity(
+            src_band,
+            dst_band,
+            options=[
+                "ALGORITHM=EDT",
+                "MAXDIST=%g" % max_dist,
+                "NODATA=-1",
+                "NUM_THREADS=" + num_threads,
+            ],
+        )
+
+    got = struct.unpack("f" * (xsize * ysize), dst_band.ReadRaster())
+    assert got == pytest.approx(expected, abs=1e-5)
+
+    gdal.ComputeProximity(
+        src_band,
+        dst_band,
+        options=[
+            "ALGORITHM=EDT",
+            "MAXDIST=%g" % max_dist,
+            "NODATA=-1",
+            "FIXED_BUF_VAL=100",
+            "NUM_THREADS=" + num_threads,
+        ],
+    )
+    got = struct.unpack("f" * (xsize * ysize), dst_band.ReadRaster())
+    assert got == pytest.approx([100.0 if v > 0 else v for v in expected], abs=1e-5)
+
+
+def test_proximity_edt_invalid_algorithm():
+
+    src_ds = gdal.Open("data/pat.tif")
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    with pytest.raises(Exception):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=INVALID"],
+        )
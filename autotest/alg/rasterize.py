@@ -30,6 +30,7 @@
 
 import struct
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -1011,3 +1012,115 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Test multi-threaded rasterization, which must give the same result as the
+# single-threaded one
+
+
+def _create_random_geometries_layer():
+
+    import random
+
+    rng = random.Random(0)
+    sr = osr.SpatialReference('LOCAL_CS["arbitrary"]')
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test", srs=sr)
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for i in range(300):
+        x = rng.uniform(-5, 100)
+        y = rng.uniform(-5, 100)
+        r = rng.uniform(0.2, 10)
+        kind = i % 3
+        if kind == 0:
+            wkt = "POLYGON((%f %f,%f %f,%f %f,%f %f))" % (
+                x,
+                y,
+                x + r,
+                y + rng.uniform(-r, r),
+                x + rng.uniform(-r, r),
+                y + r,
+                x,
+                y,
+            )
+        elif kind == 1:
+            wkt = "LINESTRING(%f %f,%f %f,%f %f)" % (
+                x,
+                y,
+                x + r,
+                y + r,
+                x + 2 * r,
+                y - r,
+            )
+        else:
+            wkt = "MULTIPOINT(%f %f,%f %f)" % (x, y, x + r, y + r)
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = i % 7 + 1
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    return ds, lyr
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["MERGE_ALG=ADD"],
+        ["ALL_TOUCHED=YES"],
+        ["MERGE_ALG=ADD", "ALL_TOUCHED=YES"],
+    ],
+)
+@pytest.mark.parametrize("chunkysize", ["0", "1", "7"])
+def test_rasterize_layer_multi_threaded(options, chunkysize):
+
+    src_ds, lyr = _create_random_geometries_layer()
+
+    def run(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 97, 93, 1, gdal.GDT_Float32)
+        ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+        ds.SetProjection(lyr.GetSpatialRef().ExportToWkt())
+        assert (
+            gdal.RasterizeLayer(
+                ds,
+                [1],
+                lyr,
+                options=options
+                + [
+                    "ATTRIBUTE=val",
+                    "CHUNKYSIZE=" + chunkysize,
+                    "NUM_THREADS=%d" % num_threads,
+                ],
+            )
+            == gdal.CE_None
+        )
+        return ds.ReadRaster()
+
+    gdaltest.check_multi_threaded_result(run)
+
+    # Read the layer by small batches of geometries (the test chunk size is
+    # the number of bytes of a batch)
+    gdaltest.check_multi_threaded_result(run, chunk_size=1000)
+
+
+@pytest.mark.parametrize("options", [[], ["-add"], ["-at"]])
+def test_rasterize_geometries_multi_threaded(options):
+
+    src_ds, lyr = _create_random_geometries_layer()
+
+    def run():
+        return gdal.Rasterize(
+            "",
+            src_ds,
+            format="MEM",
+            outputType=gdal.GDT_Float32,
+            width=97,
+            height=93,
+            outputBounds=[0, 93, 97, 0],
+            attribute="val",
+            options=options + ["-chunkysize", "5"],
+        ).ReadRaster()
+
+    expected = run()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert run() == expected
@@ -30,6 +30,7 @@
 ###############################################################################
 
 
+import gdaltest
 import pytest
 
 from osgeo import gdal
@@ -328,3 +329,49 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test multi-threaded processing, which must give the same result as the
+# single-threaded one
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+@pytest.mark.parametrize("lines_per_stripe", ["1", "3", "7"])
+def test_sieve_multi_threaded(connectedness, use_mask, lines_per_stripe):
+
+    numpy = pytest.importorskip("numpy")
+
+    rng = numpy.random.default_rng(0)
+    ar = rng.integers(0, 4, size=(50, 40), dtype=numpy.uint8)
+    # Make some polygons large enough to absorb the small ones
+    ar[5:20, 3:15] = 1
+    ar[30:45, 20:38] = 2
+
+    def run(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 40, 50)
+        band = ds.GetRasterBand(1)
+        band.WriteArray(ar)
+        if use_mask:
+            band.SetNoDataValue(3)
+            mask_band = band.GetMaskBand()
+        else:
+            mask_band = None
+        assert (
+            gdal.SieveFilter(
+                band,
+                mask_band,
+                band,
+                5,
+                connectedness,
+                ["NUM_THREADS=%d" % num_threads],
+            )
+            == gdal.CE_None
+        )
+        return band.ReadRaster()
+
+    expected = gdaltest.check_multi_threaded_result(
+        run, chunk_size=lines_per_stripe
+    )
+    assert expected != ar.tobytes()
@@ -181,3 +181,25 @@ def test_gtiff_build_overviews(tmp_vsimem, source_ds_2048x2048_filename, ovr_alg
     ds = gdal.Open(filename, gdal.GA_Update)
     ds.BuildOverviews(ovr_alg, [2, 4, 8])
     ds.Close()
+
+
+@pytest.fixture(scope="module")
+def tiled_local_filename(tmp_path_factory):
+    filename = str(tmp_path_factory.mktemp("benchmark") / "tiled.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, 4096, 4096, 3, options=["TILED=YES", "INTERLEAVE=BAND"]
+    )
+    data = bytes(range(256)) * (4096 * 4096 // 256)
+    for i in range(3):
+        ds.GetRasterBand(i + 1).WriteRaster(0, 0, 4096, 4096, data)
+    ds = None
+    return filename
+
+
+@pytest.mark.parametrize(
+    "num_threads", ["1", "ALL_CPUS"], ids=["stdio", "parallel_pread"]
+)
+def test_gtiff_read_local_file_multi_range(tiled_local_filename, num_threads):
+    with gdal.config_option("CPL_VSIL_LOCAL_READ_NUM_THREADS", num_threads):
+        ds = gdal.Open(tiled_local_filename)
+        ds.ReadRaster()
@@ -4393,6 +4393,119 @@ TEST_F(test_cpl, VSI_plugin_advise_read)
     VSIFCloseL(fp);
 }
 
+// Test ReadMultiRange() and AdviseRead() on local files, with
+// CPL_VSIL_LOCAL_READ_NUM_THREADS
+TEST_F(test_cpl, VSI_local_file_ReadMultiRange)
+{
+    const std::string osTmp =
+        std::string(CPLGenerateTempFilename(nullptr)) + ".bin";
+    constexpr size_t FILE_SIZE = 3 * 1024 * 1024 + 123;
+    std::vector<GByte> abyContent(FILE_SIZE);
+    for (size_t i = 0; i < FILE_SIZE; ++i)
+        abyContent[i] = static_cast<GByte>((i * 7) % 251);
+    VSILFILE *fp = VSIFOpenL(osTmp.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        GTEST_SKIP() << "Cannot create temporary file";
+    }
+    ASSERT_EQ(VSIFWriteL(abyContent.data(), 1, FILE_SIZE, fp), FILE_SIZE);
+    VSIFCloseL(fp);
+
+    for (const char *pszThreads : {"1", "4"})
+    {
+        CPLConfigOptionSetter oSetter("CPL_VSIL_LOCAL_READ_NUM_THREADS",
+                                      pszThreads, false);
+#ifdef __linux
+        EXPECT_EQ(VSIHasOptimizedReadMultiRange(osTmp.c_str()) != 0,
+                  strcmp(pszThreads, "1") != 0);
+#endif
+        fp = VSIFOpenL(osTmp.c_str(), "rb");
+        ASSERT_TRUE(fp != nullptr);
+
+        // Includes a range larger than the pieces read in parallel, and
+        // overlapping ranges in non-increasing order.
+        const vsi_l_offset anOffsets[] = {5, 1024 * 1024 - 3, 0, 100,
+                                          FILE_SIZE - 10};
+        const size_t anSizes[] = {10, 2 * 1024 * 1024 + 5, 1, 0, 10};
+        constexpr int nRanges = static_cast<int>(CPL_ARRAYSIZE(anOffsets));
+        std::vector<std::vector<GByte>> aabyData(nRanges);
+        void *apData[nRanges];
+        for (int i = 0; i < nRanges; ++i)
+        {
+            aabyData[i].resize(std::max<size_t>(1, anSizes[i]));
+            apData[i] = aabyData[i].data();
+        }
+
+        reinterpret_cast<VSIVirtualHandle *>(fp)->AdviseRead(
+            nRanges, anOffsets, anSizes);
+
+        ASSERT_EQ(VSIFSeekL(fp, 2, SEEK_SET), 0);
+        EXPECT_EQ(VSIFReadMultiRangeL(nRanges, apData, anOffsets, anSizes, fp),
+                  0);
+        // File position is not changed by ReadMultiRange()
+        EXPECT_EQ(VSIFTellL(fp), 2U);
+        for (int i = 0; i < nRanges; ++i)
+        {
+            EXPECT_TRUE(memcmp(aabyData[i].data(),
+                               abyContent.data() + anOffsets[i],
+                               anSizes[i]) == 0)
+                << i;
+        }
+
+        // Range beyond end of file
+        const vsi_l_offset nOffsetAfterEOF = FILE_SIZE - 1;
+        EXPECT_NE(VSIFReadMultiRangeL(1, &apData[1], &nOffsetAfterEOF,
+                                      &anSizes[1], fp),
+                  0);
+
+        VSIFCloseL(fp);
+    }
+
+    VSIUnlink(osTmp.c_str());
+}
+
+// Test VSIFMapRangeL()
+TEST_F(test_cpl, VSIFMapRangeL)
+{
+    const std::string osLocalFilename =
+        std::string(CPLGenerateTempFilename(nullptr)) + ".bin";
+    for (const std::string &osFilename :
+         {std::string("/vsimem/VSIFMapRangeL.bin"), osLocalFilename})
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+        if (fp == nullptr)
+            continue;
+        ASSERT_EQ(VSIFWriteL("0123456789", 1, 10, fp), 10U);
+        VSIFCloseL(fp);
+
+        fp = VSIFOpenL(osFilename.c_str(), "rb");
+        ASSERT_TRUE(fp != nullptr);
+        ASSERT_EQ(VSIFSeekL(fp, 1, SEEK_SET), 0);
+
+        VSIMappedRange *psRange = VSIFMapRangeL(fp, 2, 5);
+        ASSERT_TRUE(psRange != nullptr);
+        // File position is not changed
+        EXPECT_EQ(VSIFTellL(fp), 1U);
+
+        VSIMappedRange *psEmptyRange = VSIFMapRangeL(fp, 10, 0);
+        EXPECT_TRUE(psEmptyRange != nullptr);
+        VSIMappedRangeFree(psEmptyRange);
+
+        // Range beyond end of file
+        EXPECT_TRUE(VSIFMapRangeL(fp, 8, 3) == nullptr);
+        EXPECT_TRUE(VSIFMapRangeL(fp, 11, 1) == nullptr);
+
+        // The range remains valid after the file has been closed
+        VSIFCloseL(fp);
+        const char *pszData =
+            static_cast<const char *>(VSIMappedRangeGetData(psRange));
+        EXPECT_EQ(std::string(pszData, 5), "23456");
+        VSIMappedRangeFree(psRange);
+
+        VSIUnlink(osFilename.c_str());
+    }
+}
+
 // Test CPLIsASCII()
 TEST_F(test_cpl, CPLIsASCII)
 {
@@ -4685,6 +4798,127 @@ TEST_F(test_cpl, vsimem_pread)
     VSIFCloseL(fp);
 }
 
+// Test VSIMemCreateScratchFile()
+TEST_F(test_cpl, VSIMemCreateScratchFile)
+{
+    char **papszFilesBefore = VSIReadDir("/vsimem/");
+    const int nFilesBefore = CSLCount(papszFilesBefore);
+    CSLDestroy(papszFilesBefore);
+
+    VSILFILE *fp = VSIMemCreateScratchFile();
+    ASSERT_TRUE(fp != nullptr);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(VSIFWriteL("0123456789", 1, 10, fp), 10U);
+    }
+    EXPECT_EQ(VSIFTellL(fp), 10000U);
+    ASSERT_EQ(VSIFSeekL(fp, 5003, SEEK_SET), 0);
+    char szBuffer[4] = {0};
+    EXPECT_EQ(VSIFReadL(szBuffer, 1, 3, fp), 3U);
+    EXPECT_EQ(std::string(szBuffer), std::string("345"));
+
+    VSIMappedRange *psRange = VSIFMapRangeL(fp, 9998, 2);
+    ASSERT_TRUE(psRange != nullptr);
+    EXPECT_EQ(std::string(static_cast<const char *>(
+                              VSIMappedRangeGetData(psRange)),
+                          2),
+              std::string("89"));
+
+    // The buffer cannot be reallocated while a range is mapped
+    ASSERT_EQ(VSIFSeekL(fp, 0, SEEK_END), 0);
+    std::vector<GByte> abyZeroes(100000);
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(VSIFWriteL(abyZeroes.data(), 1, abyZeroes.size(), fp), 0U);
+    CPLPopErrorHandler();
+    EXPECT_EQ(std::string(static_cast<const char *>(
+                              VSIMappedRangeGetData(psRange)),
+                          2),
+              std::string("89"));
+    VSIMappedRangeFree(psRange);
+    EXPECT_EQ(VSIFWriteL(abyZeroes.data(), 1, abyZeroes.size(), fp),
+              abyZeroes.size());
+
+    // Not visible in the /vsimem/ namespace
+    char **papszFiles = VSIReadDir("/vsimem/");
+    EXPECT_EQ(CSLCount(papszFiles), nFilesBefore);
+    CSLDestroy(papszFiles);
+
+    VSIFCloseL(fp);
+}
+
+// Test /vsimem/ operations done concurrently from several threads
+TEST_F(test_cpl, vsimem_multithreaded)
+{
+    CPLWorkerThreadPool oPool;
+    ASSERT_TRUE(oPool.Setup(8, nullptr, nullptr, false));
+
+    std::vector<int> anThreadIdx(8);
+    std::vector<void *> apData;
+    for (int i = 0; i < 8; ++i)
+    {
+        anThreadIdx[i] = i;
+        apData.push_back(&anThreadIdx[i]);
+    }
+    std::atomic<int> nErrors{0};
+    static std::atomic<int> *pnErrors = nullptr;
+    pnErrors = &nErrors;
+    oPool.SubmitJobs(
+        [](void *pData)
+        {
+            const int iThread = *static_cast<int *>(pData);
+            for (int i = 0; i < 200; ++i)
+            {
+                const std::string osDir(
+                    CPLSPrintf("/vsimem/vsimem_multithreaded/%d", iThread));
+                const std::string osFilename(
+                    CPLSPrintf("%s/%d.bin", osDir.c_str(), i));
+                VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb+");
+                if (fp == nullptr)
+                {
+                    (*pnErrors)++;
+                    continue;
+                }
+                int nVal = 0;
+                if (VSIFWriteL(&i, sizeof(i), 1, fp) != 1 ||
+                    VSIFSeekL(fp, 0, SEEK_SET) != 0 ||
+                    VSIFReadL(&nVal, sizeof(nVal), 1, fp) != 1 || nVal != i)
+                {
+                    (*pnErrors)++;
+                }
+                VSIFCloseL(fp);
+
+                const std::string osNewFilename(
+                    CPLSPrintf("%s/%d_renamed.bin", osDir.c_str(), i));
+                VSIStatBufL sStat;
+                if (VSIRename(osFilename.c_str(), osNewFilename.c_str()) != 0 ||
+                    VSIStatL(osFilename.c_str(), &sStat) == 0 ||
+                    VSIStatL(osNewFilename.c_str(), &sStat) != 0 ||
+                    sStat.st_size != sizeof(i))
+                {
+                    (*pnErrors)++;
+                }
+                char **papszFiles = VSIReadDir(osDir.c_str());
+                if (CSLCount(papszFiles) != 1 ||
+                    strcmp(papszFiles[0], CPLGetFilename(
+                                              osNewFilename.c_str())) != 0)
+                {
+                    (*pnErrors)++;
+                }
+                CSLDestroy(papszFiles);
+                if (VSIUnlink(osNewFilename.c_str()) != 0)
+                    (*pnErrors)++;
+            }
+        },
+        apData);
+    oPool.WaitCompletion();
+    EXPECT_EQ(nErrors.load(), 0);
+
+    char **papszDirs = VSIReadDir("/vsimem/vsimem_multithreaded");
+    EXPECT_EQ(CSLCount(papszDirs), 8);
+    CSLDestroy(papszDirs);
+    VSIRmdirRecursive("/vsimem/vsimem_multithreaded");
+}
+
 // Test regular file system PRead() implementation
 TEST_F(test_cpl, file_system_pread)
 {
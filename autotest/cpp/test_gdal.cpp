@@ -36,8 +36,14 @@
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "test_data.h"
 
@@ -3927,4 +3933,231 @@ TEST_F(test_gdal, gdal_gcp_class)
     }
 }
 
+// Test GDALGetThreadSafeDataset() and GDAL_OF_THREAD_SAFE
+TEST_F(test_gdal, thread_safe_dataset)
+{
+    if (!GDALGetDriverByName("GTiff"))
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    auto poRefDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        GCORE_DATA_DIR "rgbsmall.tif", GDAL_OF_RASTER, nullptr, nullptr));
+    ASSERT_NE(poRefDS, nullptr);
+    EXPECT_FALSE(poRefDS->IsThreadSafe(GDAL_OF_RASTER));
+    const int nXSize = poRefDS->GetRasterXSize();
+    const int nYSize = poRefDS->GetRasterYSize();
+    const int nBands = poRefDS->GetRasterCount();
+    std::vector<GByte> abyRef(static_cast<size_t>(nXSize) * nYSize * nBands);
+    ASSERT_EQ(poRefDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize, abyRef.data(),
+                                nXSize, nYSize, GDT_Byte, nBands, nullptr, 0,
+                                0, 0, nullptr),
+              CE_None);
+
+    auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        GCORE_DATA_DIR "rgbsmall.tif", GDAL_OF_RASTER | GDAL_OF_THREAD_SAFE,
+        nullptr, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    EXPECT_TRUE(poDS->IsThreadSafe(GDAL_OF_RASTER));
+    EXPECT_TRUE(GDALDatasetIsThreadSafe(GDALDataset::ToHandle(poDS.get()),
+                                        GDAL_OF_RASTER, nullptr));
+    EXPECT_EQ(poDS->GetRasterXSize(), nXSize);
+    EXPECT_EQ(poDS->GetRasterYSize(), nYSize);
+    EXPECT_EQ(poDS->GetRasterCount(), nBands);
+    EXPECT_STREQ(poDS->GetDriver()->GetDescription(), "GTiff");
+    double adfGT[6] = {0};
+    double adfRefGT[6] = {0};
+    EXPECT_EQ(poDS->GetGeoTransform(adfGT), CE_None);
+    EXPECT_EQ(poRefDS->GetGeoTransform(adfRefGT), CE_None);
+    for (int i = 0; i < 6; ++i)
+        EXPECT_EQ(adfGT[i], adfRefGT[i]);
+    EXPECT_EQ(poDS->GetRasterBand(1)->GetColorInterpretation(),
+              poRefDS->GetRasterBand(1)->GetColorInterpretation());
+
+    const auto ReadAndCompare = [&poDS, &abyRef, nXSize, nYSize, nBands]()
+    {
+        std::vector<GByte> abyBuffer(abyRef.size());
+        bool bOK = true;
+        for (int iIter = 0; bOK && iIter < 10; ++iIter)
+        {
+            bOK = poDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize,
+                                 abyBuffer.data(), nXSize, nYSize, GDT_Byte,
+                                 nBands, nullptr, 0, 0, 0,
+                                 nullptr) == CE_None &&
+                  abyBuffer == abyRef;
+            poDS->FlushCache(false);
+        }
+        return bOK;
+    };
+
+    // The thread that opened the dataset reads from the initial dataset,
+    // simultaneously with the other threads, that read from their clone.
+    constexpr int N_THREADS = 4;
+    std::vector<std::thread> aoThreads;
+    std::vector<int> anOK(N_THREADS);
+    for (int iThread = 0; iThread < N_THREADS; ++iThread)
+    {
+        aoThreads.emplace_back([&ReadAndCompare, &anOK, iThread]()
+                               { anOK[iThread] = ReadAndCompare(); });
+    }
+    EXPECT_TRUE(ReadAndCompare());
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    for (int iThread = 0; iThread < N_THREADS; ++iThread)
+        EXPECT_TRUE(anOK[iThread]) << iThread;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(poDS->GetRasterBand(1)->Fill(0), CE_Failure);
+    EXPECT_EQ(poDS->SetMetadataItem("FOO", "BAR", nullptr), CE_Failure);
+    EXPECT_EQ(GDALDataset::Open(GCORE_DATA_DIR "rgbsmall.tif",
+                                GDAL_OF_RASTER | GDAL_OF_UPDATE |
+                                    GDAL_OF_THREAD_SAFE,
+                                nullptr, nullptr),
+              nullptr);
+    EXPECT_EQ(GDALDataset::Open(GCORE_DATA_DIR "rgbsmall.tif",
+                                GDAL_OF_THREAD_SAFE, nullptr, nullptr),
+              nullptr);
+    EXPECT_EQ(GDALGetThreadSafeDataset(poRefDS.get(), GDAL_OF_VECTOR),
+              nullptr);
+    CPLPopErrorHandler();
+
+    // A thread-safe dataset is returned as is
+    GDALDataset *poSameDS = GDALGetThreadSafeDataset(poDS.get(),
+                                                     GDAL_OF_RASTER);
+    EXPECT_EQ(poSameDS, poDS.get());
+    poSameDS->ReleaseRef();
+
+    // Datasets that cannot be reopened are not supported
+    GDALDatasetUniquePtr poMEMDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", 1, 1, 1, GDT_Byte, nullptr));
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(GDALGetThreadSafeDataset(poMEMDS.get(), GDAL_OF_RASTER),
+              nullptr);
+    CPLPopErrorHandler();
+}
+
+// Test multi-threaded reading of blocks for drivers that set
+// m_bCanReadBlocksConcurrently
+TEST_F(test_gdal, multi_threaded_block_rasterio)
+{
+    static std::mutex oMutex;
+    static std::condition_variable oCond;
+    static std::set<std::thread::id> oSetThreadIds;
+    static int nFailingXBlock = -1;
+
+    class TestRasterBand : public GDALRasterBand
+    {
+      protected:
+        CPLErr IReadBlock(int nXBlock, int nYBlock, void *pImage) override
+        {
+            {
+                // Wait for another thread to read a block, so that the
+                // concurrent reading is checked whatever the scheduling of
+                // the pool threads. The timeout avoids hanging if the reads
+                // happen to be serialized.
+                std::unique_lock<std::mutex> oLock(oMutex);
+                oSetThreadIds.insert(std::this_thread::get_id());
+                oCond.notify_all();
+                oCond.wait_for(oLock, std::chrono::seconds(10),
+                               [] { return oSetThreadIds.size() >= 2; });
+            }
+            if (nXBlock == nFailingXBlock)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "failing block");
+                return CE_Failure;
+            }
+            for (int iY = 0; iY < nBlockYSize; ++iY)
+            {
+                for (int iX = 0; iX < nBlockXSize; ++iX)
+                {
+                    static_cast<GUInt16 *>(pImage)[iY * nBlockXSize + iX] =
+                        static_cast<GUInt16>(
+                            (nYBlock * nBlockYSize + iY) * 7 +
+                            nXBlock * nBlockXSize + iX + nBand * 1000);
+                }
+            }
+            return CE_None;
+        }
+
+      public:
+        TestRasterBand(GDALDataset *poDSIn, int nBandIn)
+        {
+            poDS = poDSIn;
+            nBand = nBandIn;
+            nRasterXSize = poDSIn->GetRasterXSize();
+            nRasterYSize = poDSIn->GetRasterYSize();
+            nBlockXSize = 16;
+            nBlockYSize = 8;
+            eDataType = GDT_UInt16;
+        }
+    };
+
+    class TestDataset : public GDALDataset
+    {
+      public:
+        explicit TestDataset(bool bPixelInterleaved)
+        {
+            nRasterXSize = 100;
+            nRasterYSize = 50;
+            m_bCanReadBlocksConcurrently = true;
+            for (int i = 1; i <= 3; ++i)
+                SetBand(i, new TestRasterBand(this, i));
+            if (bPixelInterleaved)
+                SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
+        }
+    };
+
+    CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+    for (bool bPixelInterleaved : {false, true})
+    {
+        TestDataset oDS(bPixelInterleaved);
+        const int nXOff = 3;
+        const int nYOff = 5;
+        const int nXSize = 90;
+        const int nYSize = 40;
+        std::vector<GUInt32> anBuffer(static_cast<size_t>(nXSize) * nYSize *
+                                      3);
+        nFailingXBlock = -1;
+        oSetThreadIds.clear();
+        ASSERT_EQ(oDS.RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
+                               anBuffer.data(), nXSize, nYSize, GDT_UInt32, 3,
+                               nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+        // Blocks are read by several threads of the pool, and not by the
+        // calling thread.
+        EXPECT_GE(oSetThreadIds.size(), 2U);
+        EXPECT_EQ(oSetThreadIds.count(std::this_thread::get_id()), 0U);
+        bool bOK = true;
+        for (int iBand = 0; iBand < 3; ++iBand)
+        {
+            for (int iY = 0; iY < nYSize; ++iY)
+            {
+                for (int iX = 0; iX < nXSize; ++iX)
+                {
+                    bOK &= anBuffer[(static_cast<size_t>(iBand) * nYSize +
+                                     iY) *
+                                        nXSize +
+                                    iX] ==
+                           static_cast<GUInt16>((nYOff + iY) * 7 + nXOff +
+                                                iX + (iBand + 1) * 1000);
+                }
+            }
+        }
+        EXPECT_TRUE(bOK) << bPixelInterleaved;
+
+        // Blocks that could not be read must not remain in the block cache
+        TestDataset oDS2(bPixelInterleaved);
+        nFailingXBlock = 2;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(oDS2.GetRasterBand(1)->RasterIO(
+                      GF_Read, nXOff, nYOff, nXSize, nYSize, anBuffer.data(),
+                      nXSize, nYSize, GDT_UInt32, 0, 0, nullptr),
+                  CE_Failure);
+        CPLPopErrorHandler();
+        EXPECT_STREQ(CPLGetLastErrorMsg(), "failing block");
+        EXPECT_EQ(oDS2.GetRasterBand(1)->TryGetLockedBlockRef(2, 1), nullptr);
+    }
+}
+
 }  // namespace
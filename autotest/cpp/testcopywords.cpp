@@ -30,8 +30,11 @@
 #include "cpl_conv.h"
 #include "gdal.h"
 
+#include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -957,6 +960,63 @@ TEST_F(TestCopyWords, ByteToByte)
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 }
 
+// Check that conversions of packed buffers, which may use SIMD kernels,
+// give the same result as conversions done one word at a time.
+TEST_F(TestCopyWords, PackedSameAsWordByWord)
+{
+    const double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    const double dfInf = std::numeric_limits<double>::infinity();
+    const double adfSpecialValues[] = {
+        0,       0.49,    0.5,       0.51,     -0.49,    -0.5,    -0.51,
+        1.5,     -1.5,    254.5,     255,      255.5,    256,     32766.5,
+        32767.5, -32768,  -32768.5,  65534.5,  65535.5,  70000,   -70000,
+        1e10,    -1e10,   3.5e38,    -3.5e38,  dfNaN,    dfInf,   -dfInf};
+    constexpr int N = 100;
+    std::vector<double> adfSrc;
+    for (int i = 0; i < N; i++)
+    {
+        if ((i % 3) == 0)
+            adfSrc.push_back(adfSpecialValues[(i / 3) %
+                                              CPL_ARRAYSIZE(adfSpecialValues)]);
+        else
+            adfSrc.push_back((i - N / 2) * 1234.5 + 0.25);
+    }
+
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+
+        for (int nInType = GDT_Byte; nInType <= GDT_Float64; nInType++)
+        {
+            const GDALDataType eIn = static_cast<GDALDataType>(nInType);
+            const int nInSize = GDALGetDataTypeSizeBytes(eIn);
+            std::vector<GByte> abyIn(N * nInSize);
+            GDALCopyWords(adfSrc.data(), GDT_Float64, sizeof(double),
+                          abyIn.data(), eIn, nInSize, N);
+            for (int nOutType = GDT_Byte; nOutType <= GDT_Float64; nOutType++)
+            {
+                const GDALDataType eOut = static_cast<GDALDataType>(nOutType);
+                const int nOutSize = GDALGetDataTypeSizeBytes(eOut);
+                std::vector<GByte> abyOutPacked(N * nOutSize);
+                std::vector<GByte> abyOutWordByWord(N * nOutSize);
+                GDALCopyWords(abyIn.data(), eIn, nInSize, abyOutPacked.data(),
+                              eOut, nOutSize, N);
+                for (int i = 0; i < N; i++)
+                {
+                    GDALCopyWords(abyIn.data() + i * nInSize, eIn, nInSize,
+                                  abyOutWordByWord.data() + i * nOutSize, eOut,
+                                  nOutSize, 1);
+                }
+                EXPECT_EQ(abyOutPacked, abyOutWordByWord)
+                    << GDALGetDataTypeName(eIn) << " -> "
+                    << GDALGetDataTypeName(eOut);
+            }
+        }
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+}
+
 TEST_F(TestCopyWords, Int16ToInt16)
 {
     memset(pIn, 0xff, 256);
@@ -72,6 +72,28 @@ int main()
         MY_ASSERT(res[3] == input[3]);
     }
 
+    {
+        int input[] = {1, 2147483647, 3, -2147483647 - 1};
+        XMMReg4Double reg = XMMReg4Double::Load4Val(input);
+        double res[4];
+        reg.Store4Val(res);
+        MY_ASSERT(res[0] == input[0]);
+        MY_ASSERT(res[1] == input[1]);
+        MY_ASSERT(res[2] == input[2]);
+        MY_ASSERT(res[3] == input[3]);
+    }
+
+    {
+        unsigned int input[] = {1, 4294967295U, 2147483648U, 0};
+        XMMReg4Double reg = XMMReg4Double::Load4Val(input);
+        double res[4];
+        reg.Store4Val(res);
+        MY_ASSERT(res[0] == input[0]);
+        MY_ASSERT(res[1] == input[1]);
+        MY_ASSERT(res[2] == input[2]);
+        MY_ASSERT(res[3] == input[3]);
+    }
+
     {
         float input[] = {1.0f, 2.0f, 3.0f, 4.0f};
         XMMReg4Double reg = XMMReg4Double::Load4Val(input);
@@ -202,6 +224,28 @@ int main()
         MY_ASSERT(res[2] == input[2] + diff[2]);
         MY_ASSERT(res[3] == input[3]);
 
+        XMMReg4Double::Max(reg, reg + XMMReg4Double::Load4Val(diff))
+            .Store4Val(res);
+        MY_ASSERT(res[0] == input[0] + diff[0]);
+        MY_ASSERT(res[1] == input[1]);
+        MY_ASSERT(res[2] == input[2]);
+        MY_ASSERT(res[3] == input[3] + diff[3]);
+
+        XMMReg4Double::Or(
+            XMMReg4Double::Greater(reg, reg2),
+            XMMReg4Double::Greater(reg + XMMReg4Double::Load4Val(diff), reg))
+            .StoreMask(mask);
+        MY_ASSERT(mask[0] == 0xFF);
+        MY_ASSERT(mask[8] == 0);
+        MY_ASSERT(mask[16] == 0);
+        MY_ASSERT(mask[24] == 0xFF);
+
+        XMMReg4Double::Sqrt(reg * reg).Store4Val(res);
+        MY_ASSERT(res[0] == input[0]);
+        MY_ASSERT(res[1] == input[1]);
+        MY_ASSERT(res[2] == input[2]);
+        MY_ASSERT(res[3] == input[3]);
+
         reg = XMMReg4Double::Load4Val(input);
         XMMReg4Double reg_diff = XMMReg4Double::Load4Val(diff);
         XMMReg4Double::Ternary(XMMReg4Double::Greater(reg, reg + reg_diff), reg,
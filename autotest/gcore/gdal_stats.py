@@ -905,3 +905,135 @@ def test_stats_mask_band():
     assert src_ds.GetRasterBand(1).ComputeRasterMinMax(False) == (2, 3)
     assert src_ds.GetRasterBand(1).ComputeStatistics(False) == [2, 3, 2.5, 0.5]
     assert src_ds.GetRasterBand(1).GetHistogram(False) == [0, 0, 1, 1] + ([0] * 252)
+
+
+###############################################################################
+# Test that multi-threaded computation of statistics, min/max and histogram
+# gives the same results as the single-threaded one
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt",
+    [
+        (gdal.GDT_Byte, "B"),
+        (gdal.GDT_UInt16, "H"),
+        (gdal.GDT_Int16, "h"),
+        (gdal.GDT_Float32, "f"),
+    ],
+)
+@pytest.mark.parametrize("nodata", [None, 0])
+@pytest.mark.parametrize("with_mask", [False, True])
+def test_stats_multithreaded(datatype, struct_frmt, nodata, with_mask):
+
+    if with_mask and nodata is not None:
+        pytest.skip("mask band ignored when there is a nodata value")
+
+    width = 1000
+    height = 700
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    values = [(i * 7919 + (i // width) * 13) % 251 for i in range(width * height)]
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack(struct_frmt * len(values), *values)
+    )
+    if nodata is not None:
+        ds.GetRasterBand(1).SetNoDataValue(nodata)
+    if with_mask:
+        ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0,
+            0,
+            width,
+            height,
+            bytes([255 if i % 3 else 0 for i in range(width * height)]),
+        )
+
+    def compute():
+        band = ds.GetRasterBand(1)
+        minmax = band.ComputeRasterMinMax(False)
+        stats = band.ComputeStatistics(False)
+        hist = band.GetHistogram(-0.5, 255.5, 256, False, False)
+        return minmax, stats, hist
+
+    ref_minmax, ref_stats, ref_hist = compute()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        minmax, stats, hist = compute()
+
+    assert minmax == ref_minmax
+    assert stats == ref_stats
+    assert hist == ref_hist
+
+
+###############################################################################
+# Test the vectorized computation of statistics, min/max and histogram on
+# lines whose width is not a multiple of 4, with nodata and mask, against
+# hand-computed values
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt,offset,scale",
+    [
+        (gdal.GDT_UInt32, "I", 4000000000, 10000),
+        (gdal.GDT_Int32, "i", -2000000000, 10000),
+        (gdal.GDT_Float64, "d", 0.25, 0.5),
+    ],
+)
+@pytest.mark.parametrize("variant", ["all_valid", "nodata", "mask"])
+def test_stats_simd_kernels(datatype, struct_frmt, offset, scale, variant):
+
+    # Lines of 5 pixels: 4 pixels processed in vector registers, and 1
+    # remaining one. The value 9 is both in the vector part and in the
+    # remaining part, and is invalid for the nodata and mask variants. The
+    # scale keeps 8 out of the ARE_REAL_EQUAL() tolerance around the nodata
+    # value.
+    width = 5
+    height = 2
+    values = [1, 2, 9, 3, 4, 5, 6, 7, 8, 9]
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    band = ds.GetRasterBand(1)
+    band.WriteRaster(
+        0,
+        0,
+        width,
+        height,
+        struct.pack(struct_frmt * len(values), *[offset + v * scale for v in values]),
+    )
+    if variant == "nodata":
+        band.SetNoDataValue(offset + 9 * scale)
+    elif variant == "mask":
+        ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        band.GetMaskBand().WriteRaster(
+            0, 0, width, height, bytes([0 if v == 9 else 255 for v in values])
+        )
+
+    if variant == "all_valid":
+        # Mean of 54 / 10, and variance of 366 / 10 - 5.4 * 5.4
+        expected_stats = [1, 9, 5.4, math.sqrt(7.44)]
+        expected_hist = [1, 1, 1, 1, 1, 1, 1, 1, 2]
+        expected_hist_out_of_range = [2, 1, 1, 1, 1, 1, 3]
+    else:
+        # Mean of 1..8, and variance of (8 * 8 - 1) / 12
+        expected_stats = [1, 8, 4.5, math.sqrt(5.25)]
+        expected_hist = [1, 1, 1, 1, 1, 1, 1, 1, 0]
+        expected_hist_out_of_range = [2, 1, 1, 1, 1, 1, 1]
+    expected_stats = [
+        offset + expected_stats[0] * scale,
+        offset + expected_stats[1] * scale,
+        offset + expected_stats[2] * scale,
+        expected_stats[3] * scale,
+    ]
+
+    assert band.ComputeRasterMinMax(False) == tuple(expected_stats[0:2])
+
+    stats = band.ComputeStatistics(False)
+    assert stats[0:2] == expected_stats[0:2]
+    assert stats[2:4] == pytest.approx(expected_stats[2:4], rel=1e-12)
+
+    # One bucket per value from 1 to 9
+    hist = band.GetHistogram(
+        offset + 0.5 * scale, offset + 9.5 * scale, 9, False, False
+    )
+    assert hist == expected_hist
+
+    # One bucket per value from 2 to 8, with out of range values
+    hist = band.GetHistogram(offset + 1.5 * scale, offset + 8.5 * scale, 7, True, False)
+    assert hist == expected_hist_out_of_range
@@ -1201,6 +1201,104 @@ def test_tiff_read_vsicurl_multirange():
         gdal.VSICurlClearCache()
 
 
+###############################################################################
+# Test that CPL_VSIL_CURL_DISK_CACHE_DIR is used by ReadMultiRange(), and by
+# AdviseRead() and PRead() in multi-threaded decoding
+
+
+@pytest.mark.parametrize("multi_threaded", [False, True])
+@pytest.mark.require_curl()
+@pytest.mark.skipif(
+    not check_libtiff_internal_or_at_least(4, 0, 11),
+    reason="libtiff >= 4.0.11 required",
+)
+def test_tiff_read_vsicurl_disk_cache(tmp_path, multi_threaded):
+
+    ref_filename = "../gdrivers/data/utm.tif"
+    with open(ref_filename, "rb") as f:
+        ref_data = f.read()
+
+    class Handler:
+        def __init__(self):
+            self.get_count = 0
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            if request.headers.get("If-None-Match") == '"etag"':
+                request.send_response(304)
+                request.end_headers()
+                return
+            request.send_response(200)
+            request.send_header("Content-Length", len(ref_data))
+            request.send_header("ETag", '"etag"')
+            request.end_headers()
+
+        def do_GET(self, request):
+            self.get_count += 1
+            rng = request.headers["Range"][len("bytes=") :]
+            start = int(rng.split("-")[0])
+            end = min(int(rng.split("-")[1]), len(ref_data) - 1)
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(206)
+            request.send_header("Content-type", "application/octet-stream")
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, len(ref_data))
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.send_header("ETag", '"etag"')
+            request.send_header("Connection", "close")
+            request.end_headers()
+            request.wfile.write(ref_data[start : end + 1])
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    options = {
+        "CPL_VSIL_CURL_DISK_CACHE_DIR": str(tmp_path),
+        "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
+        "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+    }
+    if multi_threaded:
+        options["GDAL_NUM_THREADS"] = "2"
+    else:
+        options["GTIFF_DIRECT_IO"] = "YES"
+
+    def read():
+        ds = gdal.Open("/vsicurl/http://127.0.0.1:%d/utm.tif" % webserver_port)
+        assert ds is not None, "could not open dataset"
+        return ds.ReadRaster(0, 0, 512, 32, 128, 4)
+
+    try:
+        with gdaltest.config_options(options):
+            handler = Handler()
+            with webserver.install_http_handler(handler):
+                data = read()
+            assert handler.get_count > 0
+
+            # Everything is served from the disk cache
+            gdal.VSICurlClearCache()
+            handler = Handler()
+            with webserver.install_http_handler(handler):
+                assert read() == data
+            assert handler.get_count == 0
+
+        ds = gdal.GetDriverByName("MEM").Create("", 128, 4)
+        ds.WriteRaster(0, 0, 128, 4, data)
+        assert ds.GetRasterBand(1).Checksum() == 6429
+
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
 ###############################################################################
 # Test reading a TIFF made of a single-strip that is more than 2GB (#5403)
 
@@ -831,6 +831,73 @@ def test_vsiaz_write_appendblob_retry():
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test write of a block blob with blocks uploaded in parallel
+
+
+def test_vsiaz_write_blockblob_parallel():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {
+            "VSIAZURE_CHUNK_SIZE_BYTES": "3",
+            "VSIAZURE_NUM_UPLOAD_THREADS": "3",
+            "GDAL_HTTP_MAX_RETRY": "0",
+        },
+        thread_local=False,
+    ):
+        # Use a non sequential HTTP handler as the PUT could be emitted in
+        # any order
+        handler = webserver.NonSequentialMockedHttpHandler()
+        for i, data in enumerate([b"foo", b"bar", b"baz", b"!"]):
+            handler.add(
+                "PUT",
+                "/azure/blob/myaccount/test_copy/file.bin?blockid=%012d&comp=block"
+                % (i + 1),
+                201,
+                expected_body=data,
+            )
+        handler.add(
+            "PUT",
+            "/azure/blob/myaccount/test_copy/file.bin?comp=blocklist",
+            201,
+            expected_headers={
+                "x-ms-blob-content-type": "foo/Bar",
+                "x-ms-blob-cache-control": "no-cache",
+                "x-ms-meta-foo": "bar",
+            },
+            unexpected_headers=["Content-Type", "Cache-Control"],
+            expected_body=b"""<?xml version="1.0" encoding="utf-8"?>
+<BlockList>
+<Latest>000000000001</Latest>
+<Latest>000000000002</Latest>
+<Latest>000000000003</Latest>
+<Latest>000000000004</Latest>
+</BlockList>
+""",
+        )
+
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenExL(
+                "/vsiaz/test_copy/file.bin",
+                "wb",
+                0,
+                [
+                    "Content-Type=foo/Bar",
+                    "Cache-Control=no-cache",
+                    "x-ms-meta-foo=bar",
+                ],
+            )
+            assert f
+            for data in [b"foo", b"bar", b"baz", b"!"]:
+                assert gdal.VSIFWriteL(data, 1, len(data), f) == len(data)
+            assert gdal.VSIFCloseL(f) == 0
+
+
 ###############################################################################
 # Test Unlink()
 
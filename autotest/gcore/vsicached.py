@@ -29,7 +29,9 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import os
+import sys
 
 import pytest
 
@@ -134,3 +136,145 @@ def test_vsicached_readdir_error():
 
     with gdal.quiet_errors():
         assert gdal.ReadDir("/vsicached?") is None
+
+
+def test_vsicached_shared():
+
+    chunk_size = 16384
+    data = bytes(i % 251 for i in range(100000))
+    tmpfilename = "/vsimem/test_vsicached_shared.bin"
+    gdal.FileFromMemBuffer(tmpfilename, data)
+    filename = "/vsicached?shared=yes&chunk_size=16KB&file=" + tmpfilename
+    nchunks = (len(data) + chunk_size - 1) // chunk_size
+    try:
+        gdal.CachedFileClearSharedCache()
+        gdal.CachedFileStatsReset()
+
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            assert gdal.VSIFReadL(1, len(data), f) == data
+        finally:
+            gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.CachedFileStatsGetAsSerializedJSON())
+        assert j["miss_count"] == nchunks
+        assert j["hit_count"] == 0
+        assert j["chunk_count"] == nchunks
+        assert j["size"] == len(data)
+
+        # Another handle on the same file reuses the cached chunks
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            gdal.VSIFSeekL(f, chunk_size + 10, 0)
+            assert (
+                gdal.VSIFReadL(1, 2 * chunk_size, f)
+                == data[chunk_size + 10 : 3 * chunk_size + 10]
+            )
+        finally:
+            gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.CachedFileStatsGetAsSerializedJSON())
+        assert j["miss_count"] == nchunks
+        assert j["hit_count"] == 3
+
+        # Private cache
+        f = gdal.VSIFOpenL(filename.replace("shared=yes", "shared=no"), "rb")
+        assert f
+        try:
+            assert gdal.VSIFReadL(1, len(data), f) == data
+        finally:
+            gdal.VSIFCloseL(f)
+
+        assert json.loads(gdal.CachedFileStatsGetAsSerializedJSON()) == j
+
+        # A modified file is not confused with its previous version
+        gdal.FileFromMemBuffer(tmpfilename, data[0:-1])
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            assert gdal.VSIFReadL(1, len(data), f) == data[0:-1]
+        finally:
+            gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(tmpfilename)
+        gdal.CachedFileClearSharedCache()
+        gdal.CachedFileStatsReset()
+
+
+@pytest.mark.skipif(
+    sys.platform not in ("linux", "darwin"),
+    reason="sub-second modification time not used in the cache key",
+)
+def test_vsicached_shared_local_file_rewritten(tmp_path):
+
+    tmpfilename = str(tmp_path / "test.bin")
+    filename = "/vsicached?shared=yes&file=" + tmpfilename
+
+    def read_first_byte():
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, 1, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    try:
+        gdal.CachedFileClearSharedCache()
+        with open(tmpfilename, "wb") as f:
+            f.write(b"a" * 1000)
+        assert read_first_byte() == b"a"
+
+        # Rewritten in place with the same size, likely within the same
+        # second
+        with open(tmpfilename, "wb") as f:
+            f.write(b"b" * 1000)
+        assert read_first_byte() == b"b"
+
+        # Replaced by another file
+        with open(tmpfilename + ".new", "wb") as f:
+            f.write(b"c" * 1000)
+        os.replace(tmpfilename + ".new", tmpfilename)
+        assert read_first_byte() == b"c"
+
+    finally:
+        gdal.CachedFileClearSharedCache()
+
+
+def test_vsicached_shared_eviction():
+
+    chunk_size = 16384
+    data = bytes(i % 253 for i in range(64 * chunk_size))
+    tmpfilename = "/vsimem/test_vsicached_shared_eviction.bin"
+    gdal.FileFromMemBuffer(tmpfilename, data)
+    max_size = 16 * chunk_size
+    try:
+        gdal.CachedFileClearSharedCache()
+        gdal.CachedFileStatsReset()
+
+        with gdal.config_option("VSI_CACHE_SHARED_SIZE", str(max_size)):
+            f = gdal.VSIFOpenL(
+                "/vsicached?shared=yes&chunk_size=16KB&file=" + tmpfilename, "rb"
+            )
+        assert f
+        try:
+            for i in range(64):
+                assert (
+                    gdal.VSIFReadL(1, chunk_size, f)
+                    == data[i * chunk_size : (i + 1) * chunk_size]
+                )
+        finally:
+            gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.CachedFileStatsGetAsSerializedJSON())
+        assert j["max_size"] == max_size
+        assert j["size"] <= max_size
+        assert j["eviction_count"] == 64 - j["chunk_count"]
+        assert j["evicted_bytes"] == j["eviction_count"] * chunk_size
+
+    finally:
+        gdal.Unlink(tmpfilename)
+        gdal.CachedFileClearSharedCache()
+        gdal.CachedFileStatsReset()
@@ -28,7 +28,10 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import hashlib
+import json
 import sys
+import threading
 import time
 
 import gdaltest
@@ -1170,3 +1173,346 @@ def test_vsicurl_404_repeated_same_resource(server):
 
     with pytest.raises(Exception, match="404"):
         gdal.Open("/vsicurl/http://localhost:%d/does/not/exist.bin" % server.port)
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR
+
+
+def test_vsicurl_disk_cache(server, tmp_path):
+
+    gdal.VSICurlClearCache()
+
+    path = "/test_vsicurl_disk_cache.bin"
+    filename = "/vsicurl/http://localhost:%d%s" % (server.port, path)
+
+    def read():
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        data = gdal.VSIFReadL(1, 3, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": str(tmp_path),
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+    ):
+        handler = webserver.SequentialHandler()
+        handler.add("HEAD", path, 200, {"Content-Length": "3", "ETag": '"etag1"'})
+        handler.add("GET", path, 200, {"ETag": '"etag1"'}, b"foo")
+        with webserver.install_http_handler(handler):
+            assert read() == b"foo"
+
+        # Data is served from the disk cache after revalidation of the file
+        # properties
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            path,
+            304,
+            {},
+            expected_headers={"If-None-Match": '"etag1"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert read() == b"foo"
+
+        # File properties recently validated: no request at all
+        gdal.VSICurlClearCache()
+        with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_MAX_AGE", "3600"):
+            with webserver.install_http_handler(webserver.SequentialHandler()):
+                assert read() == b"foo"
+
+        # Remote file has changed: cached data must not be used
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            path,
+            200,
+            {"Content-Length": "3", "ETag": '"etag2"'},
+            expected_headers={"If-None-Match": '"etag1"'},
+        )
+        handler.add("GET", path, 200, {"ETag": '"etag2"'}, b"bar")
+        with webserver.install_http_handler(handler):
+            assert read() == b"bar"
+
+        # Corrupted entries are discarded
+        gdal.VSICurlClearCache()
+        for entry in tmp_path.glob("*/*.chunk"):
+            with open(entry, "r+b") as f:
+                f.seek(-1, 2)
+                f.write(b"X")
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            path,
+            304,
+            {},
+            expected_headers={"If-None-Match": '"etag2"'},
+        )
+        handler.add("GET", path, 200, {"ETag": '"etag2"'}, b"bar")
+        with webserver.install_http_handler(handler):
+            assert read() == b"bar"
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_READ_AHEAD
+
+
+def test_vsicurl_read_ahead(server):
+
+    gdal.VSICurlClearCache()
+
+    path = "/test_vsicurl_read_ahead.bin"
+    filename = "/vsicurl/http://localhost:%d%s" % (server.port, path)
+    chunk_size = 16384
+    data = bytes(i % 251 for i in range(8 * chunk_size))
+
+    def add_get(handler, start, end):
+        handler.add(
+            "GET",
+            path,
+            206,
+            {
+                "Content-Range": "bytes %d-%d/%d" % (start, end, len(data)),
+                "Content-Length": "%d" % (end - start + 1),
+            },
+            data[start : end + 1],
+            expected_headers={"Range": "bytes=%d-%d" % (start, end)},
+        )
+
+    handler = webserver.SequentialHandler()
+    handler.add("HEAD", path, 200, {"Content-Length": "%d" % len(data)})
+    add_get(handler, 0, chunk_size - 1)
+    add_get(handler, chunk_size, 3 * chunk_size - 1)
+    # Sequential access confirmed by the third read: the next window is
+    # prefetched, and then doubled once the reader has caught up with it
+    add_get(handler, 3 * chunk_size, 5 * chunk_size - 1)
+    add_get(handler, 5 * chunk_size, 8 * chunk_size - 1)
+
+    gdal.NetworkStatsReset()
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_READ_AHEAD": "YES",
+            "CPL_VSIL_NETWORK_STATS_ENABLED": "YES",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        },
+        thread_local=False,
+    ):
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(filename, "rb")
+            assert f
+            for i in range(8):
+                assert (
+                    gdal.VSIFReadL(1, chunk_size, f)
+                    == data[i * chunk_size : (i + 1) * chunk_size]
+                )
+            gdal.VSIFCloseL(f)
+
+    j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+    gdal.NetworkStatsReset()
+    assert j["methods"]["GET"]["count"] == 4
+    assert j["read_ahead"] == {"hit_count": 5}
+    stats_file = j["handlers"]["vsicurl"]["files"][filename]
+    assert stats_file["actions"]["ReadAhead"]["methods"]["GET"]["count"] == 2
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that VSI_CACHE_SHARED=YES shares chunks between different URLs of an
+# object whose ETag is a hash of its content
+
+
+@gdaltest.enable_exceptions()
+def test_vsicurl_vsi_cache_shared_content_etag(server):
+
+    gdal.VSICurlClearCache()
+    gdal.CachedFileClearSharedCache()
+    gdal.CachedFileStatsReset()
+
+    data = bytes(i % 251 for i in range(10000))
+    headers = {
+        "Content-Length": "%d" % len(data),
+        "ETag": '"%s"' % hashlib.md5(data).hexdigest(),
+    }
+
+    handler = webserver.SequentialHandler()
+    handler.add("HEAD", "/test_vsi_cache_shared/a.bin", 200, headers)
+    handler.add(
+        "GET",
+        "/test_vsi_cache_shared/a.bin",
+        206,
+        {
+            "Content-Range": "bytes 0-%d/%d" % (len(data) - 1, len(data)),
+            "Content-Length": "%d" % len(data),
+        },
+        data,
+    )
+    # No GET request on the second URL
+    handler.add("HEAD", "/test_vsi_cache_shared/b.bin", 200, headers)
+
+    try:
+        with gdal.config_options(
+            {
+                "VSI_CACHE": "YES",
+                "VSI_CACHE_SHARED": "YES",
+                "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            },
+            thread_local=False,
+        ):
+            with webserver.install_http_handler(handler):
+                for name in ("a.bin", "b.bin"):
+                    f = gdal.VSIFOpenL(
+                        "/vsicurl/http://localhost:%d/test_vsi_cache_shared/%s"
+                        % (server.port, name),
+                        "rb",
+                    )
+                    assert f
+                    try:
+                        assert gdal.VSIFReadL(1, len(data), f) == data
+                    finally:
+                        gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.CachedFileStatsGetAsSerializedJSON())
+        assert j["miss_count"] == 1
+        assert j["hit_count"] == 1
+    finally:
+        gdal.VSICurlClearCache()
+        gdal.CachedFileClearSharedCache()
+        gdal.CachedFileStatsReset()
+
+
+###############################################################################
+# Test GDAL_HTTP_CONNECTION_POOL
+
+
+def test_vsicurl_connection_pool(server):
+
+    gdal.VSICurlClearCache()
+
+    path = "/test_vsicurl_connection_pool.bin"
+    filename = "/vsicurl/http://localhost:%d%s" % (server.port, path)
+    chunk_size = 16384
+    data = bytes(i % 251 for i in range(4 * chunk_size))
+
+    handler = webserver.SequentialHandler()
+    handler.add("HEAD", path, 200, {"Content-Length": "%d" % len(data)})
+    handler.add(
+        "GET",
+        path,
+        206,
+        {
+            "Content-Range": "bytes 0-%d/%d" % (chunk_size - 1, len(data)),
+            "Content-Length": "%d" % chunk_size,
+        },
+        data[0:chunk_size],
+        expected_headers={"Range": "bytes=0-%d" % (chunk_size - 1)},
+    )
+    # Server ignoring the Range header
+    handler.add("GET", path, 200, {"Content-Length": "%d" % len(data)}, data)
+
+    try:
+        with gdal.config_options(
+            {"GDAL_HTTP_CONNECTION_POOL": "YES"}, thread_local=False
+        ):
+            with webserver.install_http_handler(handler):
+                f = gdal.VSIFOpenL(filename, "rb")
+                assert f
+                try:
+                    assert gdal.VSIFReadL(1, 10, f) == data[0:10]
+
+                    # The error detected in the thread of the connection pool
+                    # must be reported in the calling thread
+                    gdal.VSIFSeekL(f, 2 * chunk_size, 0)
+                    gdal.ErrorReset()
+                    with gdal.quiet_errors():
+                        assert gdal.VSIFReadL(1, 10, f) == b""
+                    assert (
+                        "Range downloading not supported"
+                        in gdal.GetLastErrorMsg()
+                    )
+                finally:
+                    gdal.VSIFCloseL(f)
+    finally:
+        gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that GDAL_HTTP_CONNECTION_POOL caps the number of connections to a host
+# when requests are issued from several threads
+
+
+@pytest.mark.skipif(
+    not sys.platform.startswith("linux"), reason="requires /proc/net/tcp"
+)
+@pytest.mark.parametrize("max_host_connections", [1, 2])
+def test_vsicurl_connection_pool_max_host_connections(server, max_host_connections):
+
+    gdal.VSICurlClearCache()
+
+    def count_connections():
+        # Client side sockets connected to the server, including the ones
+        # not accepted yet by the server, which serves one at a time.
+        count = 0
+        with open("/proc/net/tcp") as f:
+            for line in f.readlines()[1:]:
+                fields = line.split()
+                remote_port = int(fields[2].split(":")[1], 16)
+                if fields[3] == "01" and remote_port == server.port:
+                    count += 1
+        return count
+
+    max_connections = [0]
+
+    def method(request):
+        # Give time to the other requests to be emitted
+        time.sleep(0.2)
+        max_connections[0] = max(max_connections[0], count_connections())
+        request.send_response(200)
+        request.send_header("Content-Length", 3)
+        request.end_headers()
+
+    nthreads = 8
+    handler = webserver.NonSequentialMockedHttpHandler()
+    for i in range(nthreads):
+        handler.add(
+            "HEAD", "/test_vsicurl_connection_pool_%d.bin" % i, custom_method=method
+        )
+
+    sizes = [None] * nthreads
+
+    def stat(i):
+        stat_res = gdal.VSIStatL(
+            "/vsicurl/http://127.0.0.1:%d/test_vsicurl_connection_pool_%d.bin"
+            % (server.port, i)
+        )
+        if stat_res:
+            sizes[i] = stat_res.size
+
+    try:
+        with gdal.config_options(
+            {
+                "GDAL_HTTP_CONNECTION_POOL": "YES",
+                "GDAL_HTTP_MAX_HOST_CONNECTIONS": str(max_host_connections),
+            },
+            thread_local=False,
+        ):
+            with webserver.install_http_handler(handler):
+                threads = [
+                    threading.Thread(target=stat, args=(i,)) for i in range(nthreads)
+                ]
+                for t in threads:
+                    t.start()
+                for t in threads:
+                    t.join()
+    finally:
+        gdal.VSICurlClearCache()
+
+    assert sizes == [3] * nthreads
+    assert max_connections[0] == max_host_connections
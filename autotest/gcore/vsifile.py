@@ -29,9 +29,13 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import gzip
 import os
+import random
+import struct
 import sys
 import time
+import zlib
 
 import gdaltest
 import pytest
@@ -837,6 +841,82 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test multithreaded decompression of files made of independent blocks
+
+
+def _vsigzip_test_data():
+    r = random.Random(0)
+    data = bytearray()
+    for i in range(9000):
+        if i % 3 == 0:
+            data += r.getrandbits(8000).to_bytes(1000, "little")
+        else:
+            data += ("line %d,%f,hello world\n" % (i, r.random())).encode() * 40
+    return bytes(data)
+
+
+@pytest.mark.parametrize("layout", ["full_flush_markers", "bgzf", "plain"])
+def test_vsigzip_multi_thread_read(tmp_vsimem, layout):
+
+    filename = str(tmp_vsimem / "test.gz")
+    data = _vsigzip_test_data()
+    if layout == "full_flush_markers":
+        with gdaltest.config_options(
+            {"GDAL_NUM_THREADS": "4", "CPL_VSIL_DEFLATE_CHUNK_SIZE": "64K"}
+        ):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+            gdal.VSIFWriteL(data, 1, len(data), f)
+            gdal.VSIFCloseL(f)
+    elif layout == "bgzf":
+        content = bytearray()
+        for i in range(0, len(data), 60000):
+            piece = data[i : i + 60000]
+            c = zlib.compressobj(6, zlib.DEFLATED, -15)
+            compressed = c.compress(piece) + c.flush()
+            content += b"\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff"
+            content += struct.pack("<H2sHH", 6, b"BC", 2, len(compressed) + 25)
+            content += compressed
+            content += struct.pack("<II", zlib.crc32(piece), len(piece))
+        gdal.FileFromMemBuffer(filename, bytes(content))
+    else:
+        # Mostly stored deflate blocks, with a full flush marker appearing
+        # by chance in them, that must not be taken as a block boundary.
+        r = random.Random(0)
+        data = bytearray(r.getrandbits(24000000).to_bytes(3000000, "little"))
+        data[1500000:1500009] = b"\x00\x00\xff\xff\x00\x00\x00\xff\xff"
+        data = bytes(data)
+        gdal.FileFromMemBuffer(filename, gzip.compress(data))
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        for i in range(2):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+            assert gdal.VSIFReadL(1, len(data) + 1, f) == data
+            assert gdal.VSIFEofL(f)
+
+            for offset, size in [(5000000, 100), (10, 3000000), (2999990, 20)]:
+                assert gdal.VSIFSeekL(f, offset, 0) == 0
+                assert gdal.VSIFReadL(1, size, f) == data[offset : offset + size]
+                assert gdal.VSIFTellL(f) == min(offset + size, len(data))
+
+            assert gdal.VSIFSeekL(f, 0, 2) == 0
+            assert gdal.VSIFTellL(f) == len(data)
+            gdal.VSIFCloseL(f)
+
+            # The side-car index is written once the whole file has been read
+            assert (gdal.VSIStatL(filename + ".idx") is not None) == (
+                layout != "plain"
+            )
+
+    # Check that an outdated index is ignored
+    if layout == "full_flush_markers":
+        gdal.FileFromMemBuffer(filename, gzip.compress(data[0:1000]))
+        with gdal.config_option("GDAL_NUM_THREADS", "4"):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+            assert gdal.VSIFReadL(1, 1001, f) == data[0:1000]
+            gdal.VSIFCloseL(f)
+
+
 ###############################################################################
 # Test vsisync()
 
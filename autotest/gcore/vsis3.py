@@ -2958,6 +2958,142 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded in parallel
+
+
+@pytest.mark.parametrize("fail_part", [False, True])
+def test_vsis3_write_multipart_parallel(aws_test_config, webserver_port, fail_part):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {
+            "VSIS3_CHUNK_SIZE_BYTES": "3",
+            "VSIS3_NUM_UPLOAD_THREADS": "3",
+            "GDAL_HTTP_MAX_RETRY": "0",
+        },
+        thread_local=False,
+    ):
+        # Use a non sequential HTTP handler as the PUT could be emitted in
+        # any order
+        handler = webserver.NonSequentialMockedHttpHandler()
+        handler.add(
+            "POST",
+            "/test_bucket/foo?uploads",
+            200,
+            {"Content-type": "application:/xml"},
+            b"""<?xml version="1.0" encoding="UTF-8"?>
+            <InitiateMultipartUploadResult>
+            <UploadId>my_id</UploadId>
+            </InitiateMultipartUploadResult>""",
+        )
+        for i, data in enumerate([b"foo", b"bar", b"baz", b"!"]):
+            if fail_part and i == 1:
+                handler.add("PUT", "/test_bucket/foo?partNumber=2&uploadId=my_id", 403)
+                continue
+            handler.add(
+                "PUT",
+                "/test_bucket/foo?partNumber=%d&uploadId=my_id" % (i + 1),
+                200,
+                {"ETag": '"etag%d"' % (i + 1)},
+                expected_body=data,
+            )
+        if fail_part:
+            handler.add("DELETE", "/test_bucket/foo?uploadId=my_id", 204)
+        else:
+            handler.add(
+                "POST",
+                "/test_bucket/foo?uploadId=my_id",
+                200,
+                expected_body=b"""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag3"</ETag></Part>
+<Part>
+<PartNumber>4</PartNumber><ETag>"etag4"</ETag></Part>
+</CompleteMultipartUpload>
+""",
+            )
+
+        with webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL("/vsis3/test_bucket/foo", "wb")
+            assert f
+            with gdal.quiet_errors():
+                for data in [b"foo", b"bar", b"baz", b"!"]:
+                    if gdal.VSIFWriteL(data, 1, len(data), f) != len(data):
+                        break
+                gdal.VSIFCloseL(f)
+
+            if fail_part:
+                # The upload must have been aborted, but parts submitted
+                # after the failed one are not necessarily uploaded.
+                assert ("DELETE", "/test_bucket/foo?uploadId=my_id") not in (
+                    handler.req_resp_map
+                )
+                handler.req_resp_map.clear()
+
+
+###############################################################################
+# Test that a multipart upload invalidates the cached properties of the file
+
+
+def test_vsis3_write_multipart_invalidate_cache(aws_test_config, webserver_port):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_option("VSIS3_CHUNK_SIZE_BYTES", "3", thread_local=False):
+        f = gdal.VSIFOpenL("/vsis3/test_bucket/foo", "wb")
+        assert f
+
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "POST",
+            "/test_bucket/foo?uploads",
+            200,
+            {"Content-type": "application:/xml"},
+            b"""<?xml version="1.0" encoding="UTF-8"?>
+            <InitiateMultipartUploadResult>
+            <UploadId>my_id</UploadId>
+            </InitiateMultipartUploadResult>""",
+        )
+        handler.add(
+            "PUT",
+            "/test_bucket/foo?partNumber=1&uploadId=my_id",
+            200,
+            {"ETag": '"etag1"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert gdal.VSIFWriteL("foob", 1, 4, f) == 4
+
+        # Cache the properties of the file while it is being uploaded
+        handler = webserver.SequentialHandler()
+        handler.add("GET", "/test_bucket/foo", 200, {"Connection": "close"}, "foo")
+        with webserver.install_http_handler(handler):
+            assert gdal.VSIStatL("/vsis3/test_bucket/foo").size == 3
+
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "PUT",
+            "/test_bucket/foo?partNumber=2&uploadId=my_id",
+            200,
+            {"ETag": '"etag2"'},
+        )
+        handler.add("POST", "/test_bucket/foo?uploadId=my_id", 200)
+        with webserver.install_http_handler(handler):
+            assert gdal.VSIFWriteL("ar", 1, 2, f) == 2
+            assert gdal.VSIFCloseL(f) == 0
+
+    # Completing the upload must have invalidated the cached size
+    handler = webserver.SequentialHandler()
+    handler.add("GET", "/test_bucket/foo", 200, {"Connection": "close"}, "foobar")
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIStatL("/vsis3/test_bucket/foo").size == 6
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
@@ -648,6 +648,77 @@ def test_vsizip_multi_thread_below_threshold():
     assert data == "hello"
 
 
+###############################################################################
+# Test the cache of decompressed entries, and parallel decompression of
+# sibling entries
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_vsizip_entry_cache(tmp_vsimem, num_threads):
+
+    zip_name = str(tmp_vsimem / "test.zip")
+    contents = {}
+    fmain = gdal.VSIFOpenL("/vsizip/" + zip_name, "wb")
+    for ext in ("shp", "shx", "dbf", "prj"):
+        contents["sub/foo." + ext] = (ext * 1000 + str(random.random())).encode()
+    contents["sub/bar.txt"] = b"bar"
+    contents["big.bin"] = b"x" * (2 * 1024 * 1024)
+    for name, data in contents.items():
+        f = gdal.VSIFOpenL("/vsizip/" + zip_name + "/" + name, "wb")
+        gdal.VSIFWriteL(data, 1, len(data), f)
+        gdal.VSIFCloseL(f)
+    gdal.VSIFCloseL(fmain)
+
+    debug_msgs = []
+
+    def handler(err_class, err_no, msg):
+        if err_class == gdal.CE_Debug and "served from the entry cache" in msg:
+            debug_msgs.append(msg)
+
+    with gdaltest.config_options(
+        {"GDAL_NUM_THREADS": num_threads, "CPL_DEBUG": "VSIZIP"}
+    ):
+        for i in range(2):
+            gdal.PushErrorHandler(handler)
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            try:
+                for name, data in contents.items():
+                    f = gdal.VSIFOpenL("/vsizip/" + zip_name + "/" + name, "rb")
+                    assert f
+                    assert gdal.VSIFReadL(1, len(data) + 1, f) == data
+                    assert gdal.VSIFEofL(f)
+                    gdal.VSIFSeekL(f, 3, 0)
+                    assert gdal.VSIFReadL(1, 3, f) == data[3:6]
+                    gdal.VSIFCloseL(f)
+            finally:
+                gdal.PopErrorHandler()
+
+            # Small entries are decompressed on the first pass. With several
+            # threads, the siblings of foo.shp are decompressed along with it.
+            # On the second pass, they are all served from the cache.
+            small_entries = [name for name in contents if name != "big.bin"]
+            if i == 0:
+                expected = 3 if num_threads == "4" else 0
+            else:
+                expected = len(small_entries)
+            assert len(debug_msgs) == expected, debug_msgs
+            debug_msgs.clear()
+
+    # Rewrite the archive with entries of the same size and check that
+    # the new content is returned
+    fmain = gdal.VSIFOpenL("/vsizip/" + zip_name, "wb")
+    f = gdal.VSIFOpenL("/vsizip/" + zip_name + "/sub/bar.txt", "wb")
+    gdal.VSIFWriteL(b"BAR", 1, 3, f)
+    gdal.VSIFCloseL(f)
+    gdal.VSIFCloseL(fmain)
+
+    f = gdal.VSIFOpenL("/vsizip/" + zip_name + "/sub/bar.txt", "rb")
+    assert gdal.VSIFReadL(1, 4, f) == b"BAR"
+    gdal.VSIFCloseL(f)
+
+    assert gdal.VSIFOpenL("/vsizip/" + zip_name + "/sub/foo.shp", "rb") is None
+
+
 ###############################################################################
 # Test creating ZIP64 file: uncompressed larger than 4GB, but compressed
 # data stream < 4 GB
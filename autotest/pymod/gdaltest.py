@@ -1275,6 +1275,27 @@ def compare_ds(ds1, ds2, xoff=0, yoff=0, width=0, height=0, verbose=1):
     return maxdiff
 
 
+###############################################################################
+# Check that a multi-threaded algorithm gives the same result as the
+# single-threaded one. run(num_threads) must run the algorithm with the
+# specified number of threads, and return a result comparable with ==.
+# When chunk_size is set, the GDAL_TEST_CHUNK_SIZE configuration option is
+# set to it, to force the processing by small chunks, in single-threaded and
+# multi-threaded modes. Returns the single-threaded result.
+
+
+def check_multi_threaded_result(run, chunk_size=None, num_threads=4):
+
+    expected = run(1)
+    with gdal.config_option(
+        "GDAL_TEST_CHUNK_SIZE", None if chunk_size is None else str(chunk_size)
+    ):
+        if chunk_size is not None:
+            assert run(1) == expected
+        assert run(num_threads) == expected
+    return expected
+
+
 ###############################################################################
 # Deregister all JPEG2000 drivers, except the one passed as an argument
 
@@ -189,6 +189,111 @@ def test_gdal_viewshed_api(viewshed_input):
     assert ds.GetRasterBand(1).Checksum() == 8381
 
 
+###############################################################################
+# Test that multi-threaded computation gives the same result as single-threaded
+
+
+@pytest.mark.parametrize(
+    "heightMode", [gdal.GVOT_NORMAL, gdal.GVOT_MIN_TARGET_HEIGHT_FROM_GROUND]
+)
+@pytest.mark.parametrize("maxDistance", [0, 5000])
+def test_gdal_viewshed_api_num_threads(viewshed_input, heightMode, maxDistance):
+    src_ds = gdal.Open(viewshed_input)
+
+    def generate(num_threads):
+        ds = gdal.ViewshedGenerate(
+            src_ds.GetRasterBand(1),
+            "MEM",
+            "unused_target_raster_name",
+            [],
+            ox[0],
+            oy[0],
+            oz[0],
+            0,  # targetHeight
+            255,  # visibleVal
+            0,  # invisibleVal
+            0,  # outOfRangeVal
+            -1.0,  # noDataVal,
+            0.85714,  # dfCurvCoeff
+            gdal.GVM_Edge,
+            maxDistance,
+            heightMode=heightMode,
+            options=["NUM_THREADS=%s" % num_threads],
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    gdaltest.check_multi_threaded_result(generate)
+    # Force several chunks of lines
+    gdaltest.check_multi_threaded_result(
+        generate, chunk_size=7, num_threads="ALL_CPUS"
+    )
+
+
+###############################################################################
+# Test cumulative viewshed of several observers
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_gdal_viewshed_cumulative(
+    gdal_viewshed_path, tmp_path, viewshed_input, num_threads
+):
+
+    observers = [(621528, 4817617), (618000, 4820000), (625000, 4815000)]
+
+    expected = None
+    for x, y in observers:
+        viewshed_out = str(tmp_path / "test_gdal_viewshed_out.tif")
+        _, err = gdaltest.runexternal_out_and_err(
+            f"{gdal_viewshed_path} -vv 1 -oz 10 -ox {x} -oy {y} {viewshed_input} {viewshed_out}"
+        )
+        assert err is None or err == ""
+        ds = gdal.Open(viewshed_out)
+        data = struct.unpack(
+            "I" * (ds.RasterXSize * ds.RasterYSize),
+            ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_UInt32),
+        )
+        ds = None
+        if expected is None:
+            expected = list(data)
+        else:
+            expected = [a + b for a, b in zip(expected, data)]
+
+    viewshed_out = str(tmp_path / "test_gdal_viewshed_cumulative_out.tif")
+    observer_args = " ".join(f"-ox {x} -oy {y}" for x, y in observers)
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdal_viewshed_path} -om CUMULATIVE -oz 10 {observer_args} -num_threads {num_threads} {viewshed_input} {viewshed_out}"
+    )
+    assert err is None or err == ""
+    ds = gdal.Open(viewshed_out)
+    assert ds.GetRasterBand(1).DataType == gdal.GDT_UInt32
+    data = struct.unpack(
+        "I" * (ds.RasterXSize * ds.RasterYSize), ds.GetRasterBand(1).ReadRaster()
+    )
+    assert list(data) == expected
+
+
+###############################################################################
+
+
+def test_gdal_viewshed_several_observers_not_cumulative(gdal_viewshed_path, tmp_path):
+
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdal_viewshed_path} -ox -79.5 -oy 43.5 -ox -79.6 -oy 43.6 ../gdrivers/data/n43.tif {tmp_path}/tmp.tif"
+    )
+    assert "Several observers can only be specified with -om CUMULATIVE" in err
+
+
+###############################################################################
+
+
+def test_gdal_viewshed_invalid_num_threads(gdal_viewshed_path, tmp_path):
+
+    _, err = gdaltest.runexternal_out_and_err(
+        f"{gdal_viewshed_path} -ox -79.5 -oy 43.5 -num_threads foo ../gdrivers/data/n43.tif {tmp_path}/tmp.tif"
+    )
+    assert "Invalid value for -num_threads" in err
+
+
 ###############################################################################
 
 
@@ -699,6 +699,149 @@ def test_gdaldem_lib_nodata():
         pytest.fail("Bad checksum")
 
 
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("hillshade", {"computeEdges": True}),
+        ("hillshade", {"combined": True}),
+        ("hillshade", {"multiDirectional": True}),
+        ("hillshade", {"igor": True, "alg": "ZevenbergenThorne"}),
+        ("slope", {}),
+        ("slope", {"computeEdges": True, "alg": "ZevenbergenThorne"}),
+        ("aspect", {}),
+        ("TRI", {}),
+        ("TPI", {"computeEdges": True}),
+        ("roughness", {}),
+    ],
+)
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize("with_nodata", [False, True])
+def test_gdaldem_lib_num_threads(processing, options, datatype, with_nodata):
+
+    src_ds = gdal.Translate(
+        "",
+        gdal.Open("../gdrivers/data/n43.tif"),
+        format="MEM",
+        outputType=datatype,
+    )
+    if with_nodata:
+        src_ds.GetRasterBand(1).SetNoDataValue(0)
+        src_ds.GetRasterBand(1).WriteRaster(
+            50, 60, 2, 1, b"\0" * 2, buf_type=gdal.GDT_Byte
+        )
+
+    def run(num_threads):
+        ds = gdal.DEMProcessing(
+            "", src_ds, processing, format="MEM", numThreads=num_threads, **options
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    ref = gdaltest.check_multi_threaded_result(run)
+
+    # Force several chunks of lines
+    gdaltest.check_multi_threaded_result(run, chunk_size=7, num_threads=3)
+
+    with gdal.config_option("GDAL_NUM_THREADS", "ALL_CPUS"):
+        ds = gdal.DEMProcessing("", src_ds, processing, format="MEM", **options)
+    assert ds.GetRasterBand(1).ReadRaster() == ref
+
+
+###############################################################################
+# Test that the SSE2/AVX batched kernels give the same result as the
+# per-pixel ones (the latter are used when writing a compressed tiled GeoTIFF)
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("hillshade", {"combined": True}),
+        ("hillshade", {"igor": True}),
+        ("hillshade", {"multiDirectional": True}),
+        ("slope", {}),
+        ("slope", {"slopeFormat": "percent"}),
+        ("aspect", {}),
+        ("aspect", {"trigonometric": True}),
+    ],
+)
+@pytest.mark.parametrize("alg", ["Horn", "ZevenbergenThorne"])
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize("same_res", [True, False])
+@pytest.mark.require_driver("GTiff")
+def test_gdaldem_lib_multisample(
+    tmp_vsimem, processing, options, alg, datatype, same_res
+):
+
+    src_ds = gdal.Translate(
+        "",
+        gdal.Open("../gdrivers/data/n43.tif"),
+        format="MEM",
+        outputType=datatype,
+    )
+    if not same_res:
+        gt = list(src_ds.GetGeoTransform())
+        gt[5] *= 0.75
+        src_ds.SetGeoTransform(gt)
+
+    ref_ds = gdal.DEMProcessing(
+        tmp_vsimem / "ref.tif",
+        src_ds,
+        processing,
+        alg=alg,
+        creationOptions=["COMPRESS=DEFLATE", "TILED=YES"],
+        **options,
+    )
+    ref = struct.unpack(
+        "f" * (121 * 121),
+        ref_ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float32),
+    )
+
+    def check(ds):
+        got = struct.unpack(
+            "f" * (121 * 121),
+            ds.GetRasterBand(1).ReadRaster(buf_type=gdal.GDT_Float32),
+        )
+        if (
+            processing == "hillshade"
+            and not options
+            and alg == "Horn"
+            and datatype == gdal.GDT_Int16
+            and same_res
+        ):
+            # The SSE2 kernel for that case computes the final steps with
+            # float instead of double
+            assert max(abs(a - b) for a, b in zip(got, ref)) <= 1
+        else:
+            assert got == ref
+
+    check(
+        gdal.DEMProcessing("", src_ds, processing, format="MEM", alg=alg, **options)
+    )
+
+    with gdal.config_option("GDAL_USE_AVX", "NO"):
+        check(
+            gdal.DEMProcessing(
+                "", src_ds, processing, format="MEM", alg=alg, **options
+            )
+        )
+
+
+###############################################################################
+# Test invalid value for -num_threads
+
+
+def test_gdaldem_lib_num_threads_invalid():
+
+    src_ds = gdal.Open("../gdrivers/data/n43.tif")
+    with pytest.raises(Exception, match="Invalid value for -num_threads"):
+        gdal.DEMProcessing("", src_ds, "hillshade", format="MEM", numThreads="foo")
+
+
 ###############################################################################
 # Test option argument handling
 
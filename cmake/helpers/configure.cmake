@@ -289,6 +289,8 @@ else ()
       HAVE_PREAD_BSD)
   endif()
 
+  check_symbol_exists(posix_fadvise "fcntl.h" HAVE_POSIX_FADVISE)
+
   set(UNIX_STDIO_64 TRUE)
 
   set(INCLUDE_XLOCALE_H)
@@ -1030,6 +1030,16 @@ GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenShared(const char *, GDALAccess)
 #define GDAL_OF_FROM_GDALOPEN 0x400
 #endif
 
+/** Open in read-only mode and return a dataset that can be used concurrently
+ * from several threads. Must be combined with GDAL_OF_RASTER, and cannot be
+ * used with GDAL_OF_UPDATE.
+ *
+ * Used by GDALOpenEx().
+ * @since GDAL 3.10
+ * @see GDALGetThreadSafeDataset()
+ */
+#define GDAL_OF_THREAD_SAFE 0x800
+
 GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenEx(
     const char *pszFilename, unsigned int nOpenFlags,
     const char *const *papszAllowedDrivers, const char *const *papszOpenOptions,
@@ -1200,6 +1210,11 @@ int CPL_DLL CPL_STDCALL GDALReferenceDataset(GDALDatasetH);
 int CPL_DLL CPL_STDCALL GDALDereferenceDataset(GDALDatasetH);
 int CPL_DLL CPL_STDCALL GDALReleaseDataset(GDALDatasetH);
 
+bool CPL_DLL GDALDatasetIsThreadSafe(GDALDatasetH, int nScopeFlags,
+                                     CSLConstList papszOptions);
+GDALDatasetH CPL_DLL GDALGetThreadSafeDataset(GDALDatasetH, int nScopeFlags,
+                                              CSLConstList papszOptions);
+
 CPLErr CPL_DLL CPL_STDCALL GDALBuildOverviews(GDALDatasetH, const char *, int,
                                               const int *, int, const int *,
                                               GDALProgressFunc,
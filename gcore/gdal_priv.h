@@ -70,6 +70,7 @@ class GDALRelationship;
 
 #include <stdarg.h>
 
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <iterator>
@@ -528,6 +529,15 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     bool bShared = false;
     bool bIsInternal = true;
     bool bSuppressOnClose = false;
+    // Set by GDALOpenEx() when the dataset can be opened again from its
+    // description, driver and open options.
+    bool m_bCanBeReopened = false;
+    // Set by drivers whose IReadBlock() can be called concurrently from
+    // several threads on different blocks, of the same band or of different
+    // bands. Enables TryMultiThreadedBlockRasterIO().
+    bool m_bCanReadBlocksConcurrently = false;
+    // Set while TryMultiThreadedBlockRasterIO() reads the strips of a request
+    bool m_bInMultiThreadedBlockRasterIO = false;
 
     mutable std::map<std::string, std::unique_ptr<OGRFieldDomain>>
         m_oMapFieldDomains{};
@@ -593,6 +603,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                                GSpacing nLineSpace, GSpacing nBandSpace,
                                GDALRasterIOExtraArg *psExtraArg, int *pbTried);
 
+    CPLErr TryMultiThreadedBlockRasterIO(
+        GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+        void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+        int nBandCount, int *panBandMap, GSpacing nPixelSpace,
+        GSpacing nLineSpace, GSpacing nBandSpace,
+        GDALRasterIOExtraArg *psExtraArg, bool bBlockBased, int *pbTried);
+
     void ShareLockWithParentDataset(GDALDataset *poParentDataset);
 
     //! @endcond
@@ -819,6 +836,10 @@ class CPL_DLL GDALDataset : public GDALMajorObject
         return papszOpenOptions;
     }
 
+    virtual bool IsThreadSafe(int nScopeFlags) const;
+    virtual bool CanBeCloned(int nScopeFlags) const;
+    virtual std::unique_ptr<GDALDataset> Clone(int nScopeFlags) const;
+
     static GDALDataset **GetOpenDatasets(int *pnDatasetCount);
 
 #ifndef DOXYGEN_SKIP
@@ -1197,6 +1218,13 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Index of the partition of the global block cache the block belongs to
+    int nCachePartition;
+    // Value of the promotion counter of the partition when the block was
+    // last moved to the head of its LRU list. Modified under the lock of the
+    // partition, but read without it by Touch().
+    std::atomic<GUIntBig> nLastPromotion;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
 
@@ -4293,6 +4321,9 @@ void GDALRasterIOExtraArgSetResampleAlg(GDALRasterIOExtraArg *psExtraArg,
 GDALDataset *GDALCreateOverviewDataset(GDALDataset *poDS, int nOvrLevel,
                                        bool bThisLevelOnly);
 
+GDALDataset CPL_DLL *GDALGetThreadSafeDataset(GDALDataset *poDS,
+                                              int nScopeFlags);
+
 // Should cover particular cases of #3573, #4183, #4506, #6578
 // Behavior is undefined if fVal1 or fVal2 are NaN (should be tested before
 // calling this function)
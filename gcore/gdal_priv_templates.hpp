@@ -565,6 +565,9 @@ inline void GDALCopy4Words(const float *pValueIn, GInt16 *const pValueOut)
 {
     __m128 xmm = _mm_loadu_ps(pValueIn);
 
+    // Set NaN to 0, as GDALCopyWord() does
+    xmm = _mm_and_ps(xmm, _mm_cmpord_ps(xmm, xmm));
+
     const __m128 xmm_min = _mm_set1_ps(-32768);
     const __m128 xmm_max = _mm_set1_ps(32767);
     xmm = _mm_min_ps(_mm_max_ps(xmm, xmm_min), xmm_max);
@@ -28,6 +28,9 @@
 
 #include "gdal_thread_pool.h"
 
+#include "cpl_conv.h"
+
+#include <algorithm>
 #include <mutex>
 
 // For unclear reasons, attempts at making this a std::unique_ptr<>, even
@@ -68,3 +71,22 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                        GDALGetTestChunkSize()                        */
+/************************************************************************/
+
+// Returns the size of the chunks (generally a number of lines) in which a
+// multi-threaded algorithm splits its processing, that is nDefaultSize,
+// unless the GDAL_TEST_CHUNK_SIZE configuration option is set. That option
+// is only meant for the test suite, to exercise the processing of many small
+// chunks on small rasters. Its value is clamped to [1, nMaxSize].
+GIntBig GDALGetTestChunkSize(GIntBig nDefaultSize, GIntBig nMaxSize)
+{
+    const char *pszChunkSize =
+        CPLGetConfigOption("GDAL_TEST_CHUNK_SIZE", nullptr);
+    if (pszChunkSize == nullptr)
+        return nDefaultSize;
+    return std::max<GIntBig>(
+        1, std::min<GIntBig>(nMaxSize, CPLAtoGIntBig(pszChunkSize)));
+}
@@ -35,4 +35,6 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+GIntBig CPL_DLL GDALGetTestChunkSize(GIntBig nDefaultSize, GIntBig nMaxSize);
+
 #endif  // GDAL_THREAD_POOL_H
@@ -1735,6 +1735,83 @@ void GDALDataset::UnMarkSuppressOnClose()
     bSuppressOnClose = false;
 }
 
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+/** Return whether this dataset, and its related objects (typically raster
+ * bands), can be called for the intended scope from several threads
+ * simultaneously.
+ *
+ * The default implementation returns false. The datasets returned by
+ * GDALGetThreadSafeDataset() return true.
+ *
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Currently only GDAL_OF_RASTER is supported.
+ * @since GDAL 3.10
+ */
+bool GDALDataset::IsThreadSafe(int nScopeFlags) const
+{
+    CPL_IGNORE_RET_VAL(nScopeFlags);
+    return false;
+}
+
+/************************************************************************/
+/*                            CanBeCloned()                             */
+/************************************************************************/
+
+/** Return whether Clone() can be called on this dataset for the intended
+ * scope.
+ *
+ * The default implementation returns true for read-only raster datasets
+ * opened with GDALOpenEx() (and not through the generic OVERVIEW_LEVEL open
+ * option), that can be opened again from their description, driver and open
+ * options.
+ *
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Currently only GDAL_OF_RASTER is supported.
+ * @since GDAL 3.10
+ */
+bool GDALDataset::CanBeCloned(int nScopeFlags) const
+{
+    return m_bCanBeReopened && nScopeFlags == GDAL_OF_RASTER &&
+           eAccess == GA_ReadOnly && poDriver != nullptr;
+}
+
+/************************************************************************/
+/*                               Clone()                                */
+/************************************************************************/
+
+/** Return a new instance of this dataset, independent from this one, that
+ * exposes the same content for the intended scope.
+ *
+ * This is used by GDALGetThreadSafeDataset() to give each thread its own
+ * instance of the dataset. The default implementation opens again the
+ * dataset with GDALOpenEx(), restricted to its driver and with its open
+ * options. Drivers may override it, together with CanBeCloned(), to share
+ * some state between instances.
+ *
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Currently only GDAL_OF_RASTER is supported.
+ * @return a new dataset, or nullptr in case of error.
+ * @since GDAL 3.10
+ */
+std::unique_ptr<GDALDataset> GDALDataset::Clone(int nScopeFlags) const
+{
+    if (!CanBeCloned(nScopeFlags))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "%s: dataset cannot be cloned", GetDescription());
+        return nullptr;
+    }
+    const char *const apszAllowedDrivers[] = {poDriver->GetDescription(),
+                                              nullptr};
+    return std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        GetDescription(),
+        nScopeFlags | GDAL_OF_INTERNAL | GDAL_OF_VERBOSE_ERROR,
+        apszAllowedDrivers, papszOpenOptions));
+}
+
 /************************************************************************/
 /*                        CleanupPostFileClosing()                      */
 /************************************************************************/
@@ -2450,6 +2527,18 @@ CPLErr GDALDataset::BandBasedRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     int iBandIndex;
     CPLErr eErr = CE_None;
 
+    // Read the blocks concurrently if the driver allows it.
+    if (m_bCanReadBlocksConcurrently)
+    {
+        int bTried = FALSE;
+        eErr = TryMultiThreadedBlockRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace,
+            nBandSpace, psExtraArg, /* bBlockBased = */ false, &bTried);
+        if (bTried)
+            return eErr;
+    }
+
     GDALProgressFunc pfnProgressGlobal = psExtraArg->pfnProgress;
     void *pProgressDataGlobal = psExtraArg->pProgressData;
 
@@ -3544,6 +3633,10 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * from the same thread.</li> <li>Verbose error: GDAL_OF_VERBOSE_ERROR. If set,
  * a failed attempt to open the file will lead to an error message to be
  * reported.</li>
+ * <li>Thread safe: GDAL_OF_THREAD_SAFE (since GDAL 3.10). If set, the
+ * returned dataset can be used concurrently from several threads. It must be
+ * combined with GDAL_OF_RASTER, and is incompatible with GDAL_OF_UPDATE and
+ * GDAL_OF_SHARED. See GDALGetThreadSafeDataset().</li>
  * </ul>
  *
  * @param papszAllowedDrivers NULL to consider all candidate drivers, or a NULL
@@ -3582,6 +3675,28 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
 {
     VALIDATE_POINTER1(pszFilename, "GDALOpen", nullptr);
 
+    if (nOpenFlags & GDAL_OF_THREAD_SAFE)
+    {
+        if ((nOpenFlags & GDAL_OF_KIND_MASK) != GDAL_OF_RASTER ||
+            (nOpenFlags & (GDAL_OF_UPDATE | GDAL_OF_SHARED)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE must be combined with "
+                     "GDAL_OF_RASTER, and cannot be combined with "
+                     "GDAL_OF_UPDATE or GDAL_OF_SHARED");
+            return nullptr;
+        }
+        GDALDataset *poDS = GDALDataset::FromHandle(GDALOpenEx(
+            pszFilename, nOpenFlags & ~GDAL_OF_THREAD_SAFE,
+            papszAllowedDrivers, papszOpenOptions, papszSiblingFiles));
+        if (poDS == nullptr)
+            return nullptr;
+        GDALDataset *poThreadSafeDS =
+            GDALGetThreadSafeDataset(poDS, GDAL_OF_RASTER);
+        poDS->ReleaseRef();
+        return poThreadSafeDS;
+    }
+
     // If no driver kind is specified, assume all are to be probed.
     if ((nOpenFlags & GDAL_OF_KIND_MASK) == 0)
         nOpenFlags |= GDAL_OF_KIND_MASK & ~GDAL_OF_MULTIDIM_RASTER;
@@ -3825,6 +3940,7 @@ retry:
                 poDS->papszOpenOptions = papszOpenOptionsCleaned;
                 papszOpenOptionsCleaned = nullptr;
             }
+            poDS->m_bCanBeReopened = true;
 
             // Deal with generic OVERVIEW_LEVEL open option, unless it is
             // driver specific.
@@ -39,6 +39,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <new>
@@ -53,6 +54,12 @@
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
+
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2_OPTIM
+#include "gdalsse_priv.h"
+#endif
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -3380,208 +3387,1236 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
 }
 
 /************************************************************************/
-/*                            GetHistogram()                            */
+/*                      GDALGetStatisticsNumThreads()                   */
 /************************************************************************/
 
-/**
- * \brief Compute raster histogram.
- *
- * Note that the bucket size is (dfMax-dfMin) / nBuckets.
- *
- * For example to compute a simple 256 entry histogram of eight bit data,
- * the following would be suitable.  The unusual bounds are to ensure that
- * bucket boundaries don't fall right on integer values causing possible errors
- * due to rounding after scaling.
-\code{.cpp}
-    GUIntBig anHistogram[256];
+// Number of threads to use to compute statistics, min/max and histograms
+// from GDAL_NUM_THREADS.
+static int GDALGetStatisticsNumThreads()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
 
-    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
-                          GDALDummyProgress, nullptr );
-\endcode
- *
- * Note that setting bApproxOK will generally result in a subsampling of the
- * file, and will utilize overviews if available.  It should generally
- * produce a representative histogram for the data that is suitable for use
- * in generating histogram based luts for instance.  Generally bApproxOK is
- * much faster than an exactly computed histogram.
- *
- * This method is the same as the C functions GDALGetRasterHistogram() and
- * GDALGetRasterHistogramEx().
- *
- * @param dfMin the lower bound of the histogram.
- * @param dfMax the upper bound of the histogram.
- * @param nBuckets the number of buckets in panHistogram.
- * @param panHistogram array into which the histogram totals are placed.
- * @param bIncludeOutOfRange if TRUE values below the histogram range will
- * mapped into panHistogram[0], and values above will be mapped into
- * panHistogram[nBuckets-1] otherwise out of range values are discarded.
- * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
- * @param pfnProgress function to report progress to completion.
- * @param pProgressData application data to pass to pfnProgress.
- *
- * @return CE_None on success, or CE_Failure if something goes wrong.
- */
+/************************************************************************/
+/*                    GDALRasterBandScanMultiThreaded()                 */
+/************************************************************************/
 
-CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
-                                    GUIntBig *panHistogram,
-                                    int bIncludeOutOfRange, int bApproxOK,
-                                    GDALProgressFunc pfnProgress,
-                                    void *pProgressData)
+namespace
+{
+// Maximum number of pixels of a chunk read at once
+constexpr int SCAN_CHUNK_PIXELS = 2 * 1024 * 1024;
+// Approximate number of pixels of a slice processed by a job
+constexpr int SCAN_SLICE_PIXELS = 64 * 1024;
 
+// Decomposition of a band in chunks and slices
+struct GDALScanLayout
 {
-    CPLAssert(nullptr != panHistogram);
+    int nChunkXSize = 0;
+    int nChunkYSize = 0;
+    int nSliceYSize = 0;
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    explicit GDALScanLayout(GDALRasterBand *poBand);
 
-    /* -------------------------------------------------------------------- */
-    /*      If we have overviews, use them for the histogram.               */
-    /* -------------------------------------------------------------------- */
-    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    int GetMaxSlicesPerChunk() const
     {
-        // FIXME: should we use the most reduced overview here or use some
-        // minimum number of samples like GDALRasterBand::ComputeStatistics()
-        // does?
-        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
+        return DIV_ROUND_UP(nChunkYSize, nSliceYSize);
+    }
+};
 
-        if (poBestOverview != this)
+GDALScanLayout::GDALScanLayout(GDALRasterBand *poBand)
+{
+    const int nXSize = poBand->GetXSize();
+    const int nYSize = poBand->GetYSize();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockXSize = std::min(std::max(1, nBlockXSize), nXSize);
+    nBlockYSize = std::min(std::max(1, nBlockYSize), nYSize);
+
+    // Whole lines of blocks when possible, otherwise a part of a line of
+    // blocks.
+    nChunkXSize = nXSize;
+    if (static_cast<GIntBig>(nXSize) * nBlockYSize > SCAN_CHUNK_PIXELS)
+    {
+        nChunkXSize = std::max(
+            nBlockXSize,
+            SCAN_CHUNK_PIXELS / nBlockYSize / nBlockXSize * nBlockXSize);
+        nChunkXSize = std::min(nChunkXSize, nXSize);
+    }
+    nChunkYSize = std::max(1, SCAN_CHUNK_PIXELS / nChunkXSize);
+    if (nChunkYSize >= nBlockYSize)
+        nChunkYSize = nChunkYSize / nBlockYSize * nBlockYSize;
+    nChunkYSize = std::min(nChunkYSize, nYSize);
+
+    // Lines of the chunk buffer are nChunkXSize pixels apart, and slices
+    // must start on a 32-byte boundary, as the SIMD kernels of
+    // ComputeStatisticsInternal expect aligned data.
+    const GIntBig nLineBytes = static_cast<GIntBig>(nChunkXSize) *
+                               GDALGetDataTypeSizeBytes(
+                                   poBand->GetRasterDataType());
+    int nSliceYAlign = 1;
+    while ((nLineBytes * nSliceYAlign) % 32 != 0)
+        nSliceYAlign *= 2;
+    nSliceYSize = std::max(1, SCAN_SLICE_PIXELS / nChunkXSize);
+    nSliceYSize = DIV_ROUND_UP(nSliceYSize, nSliceYAlign) * nSliceYAlign;
+}
+
+// Function processing a slice of nXSize * nYSize pixels, whose lines are
+// nLineStride pixels apart. pData is aligned on 32 bytes. pabyMask has the
+// same layout as pData, and is null when there is no mask band. iSlice is
+// the index of the slice in its chunk: jobs with the same index never run
+// concurrently.
+using GDALScanSliceFunc =
+    std::function<void(int iSlice, const void *pData, const GByte *pabyMask,
+                       int nXSize, int nYSize, int nLineStride)>;
+
+// Function called from the calling thread once all the nSlices slices of a
+// chunk have been processed.
+using GDALScanEndOfChunkFunc = std::function<void(int nSlices)>;
+
+struct GDALScanFreeAligned
+{
+    void operator()(void *p) const
+    {
+        VSIFreeAligned(p);
+    }
+};
+
+struct GDALScanSliceJob
+{
+    const GDALScanSliceFunc *pfnProcessSlice = nullptr;
+    int iSlice = 0;
+    const void *pData = nullptr;
+    const GByte *pabyMask = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nLineStride = 0;
+
+    static void Process(void *pData)
+    {
+        const auto psJob = static_cast<const GDALScanSliceJob *>(pData);
+        (*psJob->pfnProcessSlice)(psJob->iSlice, psJob->pData, psJob->pabyMask,
+                                  psJob->nXSize, psJob->nYSize,
+                                  psJob->nLineStride);
+    }
+};
+}  // namespace
+
+// Reads the whole band at full resolution, and its mask band if not null,
+// by chunks aligned on blocks, from the calling thread, so that the driver is
+// never entered from several threads at once. Each chunk is split in slices
+// of consecutive lines that are processed by jobs of the global thread pool,
+// while the next chunk is read. The decomposition in chunks and slices only
+// depends on the raster and block dimensions, so that results merged in slice
+// order do not depend on the number of threads.
+static bool GDALRasterBandScanMultiThreaded(
+    GDALRasterBand *poBand, GDALRasterBand *poMaskBand, int nThreads,
+    const GDALScanLayout &oLayout, const GDALScanSliceFunc &pfnProcessSlice,
+    const GDALScanEndOfChunkFunc &pfnEndOfChunk, GDALProgressFunc pfnProgress,
+    void *pProgressData, const char *pszProgressMsg)
+{
+    const int nXSize = poBand->GetXSize();
+    const int nYSize = poBand->GetYSize();
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nChunkXSize = oLayout.nChunkXSize;
+    const int nChunkYSize = oLayout.nChunkYSize;
+    const int nSliceYSize = oLayout.nSliceYSize;
+
+    // With a single thread, or if the thread pool cannot be created, slices
+    // are processed by the calling thread.
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        if (auto poThreadPool = GDALGetGlobalThreadPool(nThreads))
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    const size_t nChunkPixels = static_cast<size_t>(nChunkXSize) * nChunkYSize;
+    std::unique_ptr<GByte, GDALScanFreeAligned> apabyData[2];
+    std::vector<GByte> abyMask[2];
+    try
+    {
+        for (int i = 0; i < 2; ++i)
         {
-            return poBestOverview->GetHistogram(
-                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
-                bApproxOK, pfnProgress, pProgressData);
+            apabyData[i].reset(static_cast<GByte *>(
+                VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nChunkPixels * nDTSize)));
+            if (!apabyData[i])
+                return false;
+            if (poMaskBand)
+                abyMask[i].resize(nChunkPixels);
         }
     }
+    catch (const std::exception &)
+    {
+        poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in GDALRasterBandScanMultiThreaded");
+        return false;
+    }
 
-    /* -------------------------------------------------------------------- */
-    /*      Read actual data and build histogram.                           */
-    /* -------------------------------------------------------------------- */
-    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
+    std::vector<GDALScanSliceJob> asJobs;
+    int nPendingSlices = 0;
+    const auto WaitPendingSlices = [&poJobQueue, &pfnEndOfChunk, &asJobs,
+                                    &nPendingSlices]()
     {
-        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+        if (nPendingSlices > 0 && pfnEndOfChunk)
+            pfnEndOfChunk(nPendingSlices);
+        nPendingSlices = 0;
+        asJobs.clear();
+    };
+
+    const double dfTotalPixels = static_cast<double>(nXSize) * nYSize;
+    double dfPixelsDone = 0;
+    int iBuffer = 0;
+    for (int nChunkYOff = 0; nChunkYOff < nYSize; nChunkYOff += nChunkYSize)
+    {
+        const int nReqYSize = std::min(nChunkYSize, nYSize - nChunkYOff);
+        for (int nChunkXOff = 0; nChunkXOff < nXSize;
+             nChunkXOff += nChunkXSize)
+        {
+            const int nReqXSize = std::min(nChunkXSize, nXSize - nChunkXOff);
+            GByte *pabyData = apabyData[iBuffer].get();
+            GByte *pabyMask = poMaskBand ? abyMask[iBuffer].data() : nullptr;
+            if (poBand->RasterIO(GF_Read, nChunkXOff, nChunkYOff, nReqXSize,
+                                 nReqYSize, pabyData, nReqXSize, nReqYSize,
+                                 eDT, 0,
+                                 static_cast<GSpacing>(nChunkXSize) * nDTSize,
+                                 nullptr) != CE_None ||
+                (pabyMask &&
+                 poMaskBand->RasterIO(GF_Read, nChunkXOff, nChunkYOff,
+                                      nReqXSize, nReqYSize, pabyMask,
+                                      nReqXSize, nReqYSize, GDT_Byte, 0,
+                                      nChunkXSize, nullptr) != CE_None))
+            {
+                WaitPendingSlices();
+                return false;
+            }
+
+            // Finish the processing of the previous chunk before submitting
+            // this one, so that the slice index can be used by the callers
+            // to index per-slice results.
+            WaitPendingSlices();
+
+            for (int nSliceYOff = 0; nSliceYOff < nReqYSize;
+                 nSliceYOff += nSliceYSize)
+            {
+                GDALScanSliceJob sJob;
+                sJob.pfnProcessSlice = &pfnProcessSlice;
+                sJob.iSlice = nPendingSlices++;
+                const size_t nOffset =
+                    static_cast<size_t>(nSliceYOff) * nChunkXSize;
+                sJob.pData = pabyData + nOffset * nDTSize;
+                sJob.pabyMask = pabyMask ? pabyMask + nOffset : nullptr;
+                sJob.nXSize = nReqXSize;
+                sJob.nYSize = std::min(nSliceYSize, nReqYSize - nSliceYOff);
+                sJob.nLineStride = nChunkXSize;
+                asJobs.push_back(sJob);
+            }
+            CPLAssert(nPendingSlices <= oLayout.GetMaxSlicesPerChunk());
+            for (auto &sJob : asJobs)
+            {
+                if (!poJobQueue ||
+                    !poJobQueue->SubmitJob(GDALScanSliceJob::Process, &sJob))
+                {
+                    GDALScanSliceJob::Process(&sJob);
+                }
+            }
+            iBuffer = 1 - iBuffer;
+
+            dfPixelsDone += static_cast<double>(nReqXSize) * nReqYSize;
+            if (!pfnProgress(dfPixelsDone / dfTotalPixels, pszProgressMsg,
+                             pProgressData))
+            {
+                WaitPendingSlices();
+                poBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                return false;
+            }
+        }
     }
+    WaitPendingSlices();
+    return true;
+}
 
-    // Written this way to deal with NaN
-    if (!(dfMax > dfMin))
+#ifdef USE_SSE2_OPTIM
+
+/************************************************************************/
+/*                         GetNoDataInterval()                          */
+/************************************************************************/
+
+namespace
+{
+// Interval [dfLow, dfHigh] of the values that ARE_REAL_EQUAL() considers
+// equal to the nodata value. Empty when there is no nodata value.
+struct GDALNoDataInterval
+{
+    double dfLow = std::numeric_limits<double>::infinity();
+    double dfHigh = -std::numeric_limits<double>::infinity();
+
+    bool IsEmpty() const
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMax should be strictly greater than dfMin");
-        return CE_Failure;
+        return dfLow > dfHigh;
     }
+};
+}  // namespace
 
-    GDALRasterIOExtraArg sExtraArg;
-    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+// Maps floating-point values to integers with the same ordering, so that
+// consecutive representable values map to consecutive integers.
+template <class T, class I> static I GDALFloatToOrdered(T tVal)
+{
+    I nVal;
+    memcpy(&nVal, &tVal, sizeof(nVal));
+    return nVal < 0 ? std::numeric_limits<I>::min() - nVal : nVal;
+}
 
-    const double dfScale = nBuckets / (dfMax - dfMin);
-    if (dfScale == 0 || !std::isfinite(dfScale))
+template <class T, class I> static T GDALOrderedToFloat(I nVal)
+{
+    if (nVal < 0)
+        nVal = std::numeric_limits<I>::min() - nVal;
+    T tVal;
+    memcpy(&tVal, &nVal, sizeof(nVal));
+    return tVal;
+}
+
+// Returns the bound, in the direction nDir (-1 or 1), of the interval of
+// values that ARE_REAL_EQUAL() considers equal to tNoData. The difference
+// between |tVal - tNoData| and the tolerance of ARE_REAL_EQUAL() strictly
+// increases with the distance to tNoData, so the bound is found by an
+// exponential search followed by a bisection on the number of representable
+// values from tNoData.
+template <class T, class I>
+static double GetAreRealEqualBound(T tNoData, I nDir)
+{
+    if (std::isinf(tNoData))
+        return tNoData;
+    const I nNoData = GDALFloatToOrdered<T, I>(tNoData);
+    const auto IsEqual = [tNoData, nNoData, nDir](I nSteps)
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMin and dfMax should be finite values such that "
-                    "nBuckets / (dfMax - dfMin) is non-zero");
-        return CE_Failure;
+        return ARE_REAL_EQUAL(
+            GDALOrderedToFloat<T, I>(nNoData + nDir * nSteps), tNoData);
+    };
+    I nGood = 0;
+    I nBad = 1;
+    while (IsEqual(nBad))
+    {
+        nGood = nBad;
+        nBad *= 2;
     }
-    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
+    while (nBad - nGood > 1)
+    {
+        const I nMid = nGood + (nBad - nGood) / 2;
+        if (IsEqual(nMid))
+            nGood = nMid;
+        else
+            nBad = nMid;
+    }
+    return GDALOrderedToFloat<T, I>(nNoData + nDir * nGood);
+}
 
-    int bGotNoDataValue = FALSE;
-    const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
-    bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
-    bool bGotFloatNoDataValue = false;
-    float fNoDataValue = 0.0f;
-    ComputeFloatNoDataValue(eDataType, dfNoDataValue, bGotNoDataValue,
-                            fNoDataValue, bGotFloatNoDataValue);
-    GDALRasterBand *poMaskBand = nullptr;
-    if (!bGotNoDataValue)
+static GDALNoDataInterval GetNoDataInterval(GDALDataType eDataType,
+                                            bool bGotNoDataValue,
+                                            double dfNoDataValue,
+                                            bool bGotFloatNoDataValue,
+                                            float fNoDataValue)
+{
+    GDALNoDataInterval sInterval;
+    if (eDataType == GDT_Float32)
     {
-        const int l_nMaskFlags = GetMaskFlags();
-        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
-            GetColorInterpretation() != GCI_AlphaBand)
+        if (bGotFloatNoDataValue)
         {
-            poMaskBand = GetMaskBand();
+            sInterval.dfLow =
+                GetAreRealEqualBound<float, int32_t>(fNoDataValue, -1);
+            sInterval.dfHigh =
+                GetAreRealEqualBound<float, int32_t>(fNoDataValue, 1);
         }
     }
-
-    bool bSignedByte = false;
-    if (eDataType == GDT_Byte)
+    else if (bGotNoDataValue)
     {
-        EnablePixelTypeSignedByteWarning(false);
-        const char *pszPixelType =
-            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
-        EnablePixelTypeSignedByteWarning(true);
-        bSignedByte =
-            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        sInterval.dfLow =
+            GetAreRealEqualBound<double, int64_t>(dfNoDataValue, -1);
+        sInterval.dfHigh =
+            GetAreRealEqualBound<double, int64_t>(dfNoDataValue, 1);
     }
+    return sInterval;
+}
 
-    if (bApproxOK && HasArbitraryOverviews())
+/************************************************************************/
+/*                         GDALSIMDValueLoader                          */
+/************************************************************************/
+
+namespace
+{
+// Loads pixel values as doubles, with the validity of each of them: values
+// that are NaN, in the nodata interval or masked out are invalid.
+template <class T, bool HAS_NODATA, bool HAS_MASK> struct GDALSIMDValueLoader
+{
+    // Whether all values are valid, in which case validity masks are not
+    // computed.
+    static constexpr bool ALL_VALID =
+        !HAS_NODATA && !HAS_MASK && !std::is_floating_point<T>::value;
+
+    const double dfNoDataLow;
+    const double dfNoDataHigh;
+    XMMReg4Double oNoDataLow{};
+    XMMReg4Double oNoDataHigh{};
+    XMMReg4Double oZero{};
+
+    explicit GDALSIMDValueLoader(const GDALNoDataInterval &sNoData)
+        : dfNoDataLow(sNoData.dfLow), dfNoDataHigh(sNoData.dfHigh)
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out how much the image should be reduced to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
-        const double dfReduction =
-            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
-                 GDALSTAT_APPROX_NUMSAMPLES);
+        oNoDataLow = XMMReg4Double::Load1ValHighAndLow(&dfNoDataLow);
+        oNoDataHigh = XMMReg4Double::Load1ValHighAndLow(&dfNoDataHigh);
+        oZero = XMMReg4Double::Zero();
+    }
 
-        int nXReduced = nRasterXSize;
-        int nYReduced = nRasterYSize;
-        if (dfReduction > 1.0)
+    // Loads 4 values. oValid is not set if ALL_VALID.
+    inline XMMReg4Double Load4(const T *pData, const GByte *pabyMask,
+                               XMMReg4Double &oValid) const
+    {
+        const XMMReg4Double oVal = XMMReg4Double::Load4Val(pData);
+        if constexpr (HAS_NODATA)
         {
-            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
-            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
-
-            // Catch the case of huge resizing ratios here
-            if (nXReduced == 0)
-                nXReduced = 1;
-            if (nYReduced == 0)
-                nYReduced = 1;
+            // Comparisons are false for NaN, which is thus invalid too.
+            oValid =
+                XMMReg4Double::Or(XMMReg4Double::Greater(oNoDataLow, oVal),
+                                  XMMReg4Double::Greater(oVal, oNoDataHigh));
         }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            oValid = XMMReg4Double::Equals(oVal, oVal);
+        }
+        if constexpr (HAS_MASK)
+        {
+            const XMMReg4Double oMask = XMMReg4Double::NotEquals(
+                XMMReg4Double::Load4Val(pabyMask), oZero);
+            if constexpr (HAS_NODATA || std::is_floating_point<T>::value)
+                oValid = XMMReg4Double::And(oValid, oMask);
+            else
+                oValid = oMask;
+        }
+        return oVal;
+    }
 
-        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
-                                          nXReduced, nYReduced);
-        if (!pData)
-            return CE_Failure;
-
-        const CPLErr eErr =
-            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
-                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
-        if (eErr != CE_None)
+    // Loads a single value, and returns whether it is valid.
+    inline bool Load1(const T *pData, const GByte *pabyMask,
+                      double &dfVal) const
+    {
+        dfVal = static_cast<double>(*pData);
+        if constexpr (HAS_MASK)
         {
-            CPLFree(pData);
-            return eErr;
+            if (*pabyMask == 0)
+                return false;
         }
+        if constexpr (HAS_NODATA)
+            return dfVal < dfNoDataLow || dfVal > dfNoDataHigh;
+        else if constexpr (std::is_floating_point<T>::value)
+            return !std::isnan(dfVal);
+        else
+            return true;
+    }
+};
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+/************************************************************************/
+/*                         ComputeMinMaxSIMD                            */
+/************************************************************************/
+
+template <class T, bool HAS_NODATA, bool HAS_MASK> struct ComputeMinMaxSIMD
+{
+    static void f(const T *pData, int nXCheck, int nYCheck, int nLineStride,
+                  const GByte *pabyMask, const GDALNoDataInterval &sNoData,
+                  double &dfMin, double &dfMax)
+    {
+        using Loader = GDALSIMDValueLoader<T, HAS_NODATA, HAS_MASK>;
+        const Loader oLoader(sNoData);
+        constexpr double dfMaxDouble = std::numeric_limits<double>::max();
+        constexpr double dfMinusMaxDouble = -dfMaxDouble;
+        const auto oMaxDouble = XMMReg4Double::Load1ValHighAndLow(&dfMaxDouble);
+        const auto oMinusMaxDouble =
+            XMMReg4Double::Load1ValHighAndLow(&dfMinusMaxDouble);
+        auto oMin = XMMReg4Double::Load1ValHighAndLow(&dfMin);
+        auto oMax = XMMReg4Double::Load1ValHighAndLow(&dfMax);
+
+        for (int iY = 0; iY < nYCheck; iY++)
         {
-            pabyMaskData =
-                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
-            if (!pabyMaskData)
+            const GPtrDiff_t nLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nLineStride;
+            const T *pLine = pData + nLineOffset;
+            const GByte *pabyMaskLine =
+                HAS_MASK ? pabyMask + nLineOffset : nullptr;
+            int iX = 0;
+            for (; iX + 4 <= nXCheck; iX += 4)
             {
-                CPLFree(pData);
-                return CE_Failure;
+                XMMReg4Double oValid;
+                const auto oVal = oLoader.Load4(
+                    pLine + iX, HAS_MASK ? pabyMaskLine + iX : nullptr, oValid);
+                if constexpr (Loader::ALL_VALID)
+                {
+                    oMin = XMMReg4Double::Min(oMin, oVal);
+                    oMax = XMMReg4Double::Max(oMax, oVal);
+                }
+                else
+                {
+                    oMin = XMMReg4Double::Min(
+                        oMin, XMMReg4Double::Ternary(oValid, oVal, oMaxDouble));
+                    oMax = XMMReg4Double::Max(
+                        oMax,
+                        XMMReg4Double::Ternary(oValid, oVal, oMinusMaxDouble));
+                }
             }
-
-            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
-                                     pabyMaskData, nXReduced, nYReduced,
-                                     GDT_Byte, 0, 0, nullptr) != CE_None)
+            for (; iX < nXCheck; iX++)
             {
-                CPLFree(pData);
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                double dfVal;
+                if (oLoader.Load1(pLine + iX,
+                                  HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                  dfVal))
+                {
+                    dfMin = std::min(dfMin, dfVal);
+                    dfMax = std::max(dfMax, dfVal);
+                }
             }
         }
 
-        // This isn't the fastest way to do this, but is easier for now.
-        for (int iY = 0; iY < nYReduced; iY++)
+        double adfMin[4];
+        double adfMax[4];
+        oMin.Store4Val(adfMin);
+        oMax.Store4Val(adfMax);
+        for (int i = 0; i < 4; i++)
         {
-            for (int iX = 0; iX < nXReduced; iX++)
-            {
-                const int iOffset = iX + iY * nXReduced;
-                double dfValue = 0.0;
+            dfMin = std::min(dfMin, adfMin[i]);
+            dfMax = std::max(dfMax, adfMax[i]);
+        }
+    }
+};
 
-                if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                    continue;
+/************************************************************************/
+/*                       ComputeStatisticsSIMD                          */
+/************************************************************************/
+
+// Computes the count, mean and sum of squares of differences to the mean of
+// the valid values of a buffer with the corrected two-pass algorithm, and
+// merges them into the running ones with the parallel variant of the Welford
+// algorithm (Chan et al.).
+template <class T, bool HAS_NODATA, bool HAS_MASK> struct ComputeStatisticsSIMD
+{
+    static void f(const T *pData, int nXCheck, int nYCheck, int nLineStride,
+                  const GByte *pabyMask, const GDALNoDataInterval &sNoData,
+                  double &dfMin, double &dfMax, double &dfMean, double &dfM2,
+                  GUIntBig &nValidCount)
+    {
+        using Loader = GDALSIMDValueLoader<T, HAS_NODATA, HAS_MASK>;
+        const Loader oLoader(sNoData);
+        constexpr double dfOne = 1.0;
+        constexpr double dfMaxDouble = std::numeric_limits<double>::max();
+        constexpr double dfMinusMaxDouble = -dfMaxDouble;
+        const auto oOne = XMMReg4Double::Load1ValHighAndLow(&dfOne);
+        const auto oMaxDouble = XMMReg4Double::Load1ValHighAndLow(&dfMaxDouble);
+        const auto oMinusMaxDouble =
+            XMMReg4Double::Load1ValHighAndLow(&dfMinusMaxDouble);
+
+        // First pass: count, sum, min and max.
+        auto oCount = XMMReg4Double::Zero();
+        auto oSum = XMMReg4Double::Zero();
+        auto oMin = XMMReg4Double::Load1ValHighAndLow(&dfMin);
+        auto oMax = XMMReg4Double::Load1ValHighAndLow(&dfMax);
+        double dfCount = 0;
+        double dfSum = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t nLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nLineStride;
+            const T *pLine = pData + nLineOffset;
+            const GByte *pabyMaskLine =
+                HAS_MASK ? pabyMask + nLineOffset : nullptr;
+            int iX = 0;
+            for (; iX + 4 <= nXCheck; iX += 4)
+            {
+                XMMReg4Double oValid;
+                const auto oVal = oLoader.Load4(
+                    pLine + iX, HAS_MASK ? pabyMaskLine + iX : nullptr, oValid);
+                if constexpr (Loader::ALL_VALID)
+                {
+                    oSum += oVal;
+                    oMin = XMMReg4Double::Min(oMin, oVal);
+                    oMax = XMMReg4Double::Max(oMax, oVal);
+                }
+                else
+                {
+                    oCount += XMMReg4Double::And(oValid, oOne);
+                    oSum += XMMReg4Double::And(oValid, oVal);
+                    oMin = XMMReg4Double::Min(
+                        oMin, XMMReg4Double::Ternary(oValid, oVal, oMaxDouble));
+                    oMax = XMMReg4Double::Max(
+                        oMax,
+                        XMMReg4Double::Ternary(oValid, oVal, oMinusMaxDouble));
+                }
+            }
+            if constexpr (Loader::ALL_VALID)
+                dfCount += iX;
+            for (; iX < nXCheck; iX++)
+            {
+                double dfVal;
+                if (oLoader.Load1(pLine + iX,
+                                  HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                  dfVal))
+                {
+                    dfCount += 1;
+                    dfSum += dfVal;
+                    dfMin = std::min(dfMin, dfVal);
+                    dfMax = std::max(dfMax, dfVal);
+                }
+            }
+        }
+
+        double adfMin[4];
+        double adfMax[4];
+        oMin.Store4Val(adfMin);
+        oMax.Store4Val(adfMax);
+        for (int i = 0; i < 4; i++)
+        {
+            dfMin = std::min(dfMin, adfMin[i]);
+            dfMax = std::max(dfMax, adfMax[i]);
+        }
+
+        dfCount += oCount.GetHorizSum();
+        if (dfCount == 0)
+            return;
+        const double dfBlockMean = (dfSum + oSum.GetHorizSum()) / dfCount;
+
+        // Second pass: sums of differences, and of their squares, to the
+        // mean. The former corrects the rounding error of the mean.
+        const auto oBlockMean = XMMReg4Double::Load1ValHighAndLow(&dfBlockMean);
+        auto oSumDelta = XMMReg4Double::Zero();
+        auto oSumDelta2 = XMMReg4Double::Zero();
+        double dfSumDelta = 0;
+        double dfSumDelta2 = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t nLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nLineStride;
+            const T *pLine = pData + nLineOffset;
+            const GByte *pabyMaskLine =
+                HAS_MASK ? pabyMask + nLineOffset : nullptr;
+            int iX = 0;
+            for (; iX + 4 <= nXCheck; iX += 4)
+            {
+                XMMReg4Double oValid;
+                auto oDelta = oLoader.Load4(
+                                  pLine + iX,
+                                  HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                  oValid) -
+                              oBlockMean;
+                if constexpr (!Loader::ALL_VALID)
+                    oDelta = XMMReg4Double::And(oValid, oDelta);
+                oSumDelta += oDelta;
+                oSumDelta2 += oDelta * oDelta;
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                double dfVal;
+                if (oLoader.Load1(pLine + iX,
+                                  HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                  dfVal))
+                {
+                    const double dfDelta = dfVal - dfBlockMean;
+                    dfSumDelta += dfDelta;
+                    dfSumDelta2 += dfDelta * dfDelta;
+                }
+            }
+        }
+        dfSumDelta += oSumDelta.GetHorizSum();
+        dfSumDelta2 += oSumDelta2.GetHorizSum();
+        const double dfCorrectedBlockMean =
+            dfBlockMean + dfSumDelta / dfCount;
+        const double dfBlockM2 =
+            std::max(0.0, dfSumDelta2 - dfSumDelta * dfSumDelta / dfCount);
+
+        const GUIntBig nBlockCount = static_cast<GUIntBig>(dfCount);
+        const GUIntBig nNewValidCount = nValidCount + nBlockCount;
+        const double dfDelta = dfCorrectedBlockMean - dfMean;
+        const double dfBlockWeight = dfCount / nNewValidCount;
+        dfMean += dfDelta * dfBlockWeight;
+        dfM2 += dfBlockM2 + dfDelta * dfDelta *
+                                static_cast<double>(nValidCount) *
+                                dfBlockWeight;
+        nValidCount = nNewValidCount;
+    }
+};
+
+/************************************************************************/
+/*                        ComputeHistogramSIMD                          */
+/************************************************************************/
+
+template <class T, bool HAS_NODATA, bool HAS_MASK> struct ComputeHistogramSIMD
+{
+    static void f(const T *pData, int nXCheck, int nYCheck, int nLineStride,
+                  const GByte *pabyMask, const GDALNoDataInterval &sNoData,
+                  double dfMin, double dfScale, int nBuckets,
+                  bool bIncludeOutOfRange, GUIntBig *panHistogram)
+    {
+        using Loader = GDALSIMDValueLoader<T, HAS_NODATA, HAS_MASK>;
+        const Loader oLoader(sNoData);
+
+        // Bucket indices are computed as (value - dfMin) * dfScale, clamped
+        // to [-1, nBuckets] so that out of range values are recognized after
+        // flooring. Invalid values get index -2.
+        constexpr double dfMinusOne = -1.0;
+        constexpr double dfMinusTwo = -2.0;
+        const double dfBuckets = nBuckets;
+        const auto oMin = XMMReg4Double::Load1ValHighAndLow(&dfMin);
+        const auto oScale = XMMReg4Double::Load1ValHighAndLow(&dfScale);
+        const auto oMinusOne = XMMReg4Double::Load1ValHighAndLow(&dfMinusOne);
+        const auto oMinusTwo = XMMReg4Double::Load1ValHighAndLow(&dfMinusTwo);
+        const auto oBuckets = XMMReg4Double::Load1ValHighAndLow(&dfBuckets);
+
+        const auto AddToHistogram =
+            [nBuckets, bIncludeOutOfRange, panHistogram](double dfIndex)
+        {
+            // floor() of a value in [-2, nBuckets]
+            int nIndex = static_cast<int>(dfIndex);
+            if (nIndex > dfIndex)
+                nIndex--;
+            if (nIndex >= 0 && nIndex < nBuckets)
+                panHistogram[nIndex]++;
+            else if (bIncludeOutOfRange && nIndex == -1)
+                panHistogram[0]++;
+            else if (bIncludeOutOfRange && nIndex == nBuckets)
+                panHistogram[nBuckets - 1]++;
+        };
+
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t nLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nLineStride;
+            const T *pLine = pData + nLineOffset;
+            const GByte *pabyMaskLine =
+                HAS_MASK ? pabyMask + nLineOffset : nullptr;
+            int iX = 0;
+            for (; iX + 4 <= nXCheck; iX += 4)
+            {
+                XMMReg4Double oValid;
+                auto oIndex = (oLoader.Load4(
+                                   pLine + iX,
+                                   HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                   oValid) -
+                               oMin) *
+                              oScale;
+                oIndex = XMMReg4Double::Min(
+                    XMMReg4Double::Max(oIndex, oMinusOne), oBuckets);
+                if constexpr (!Loader::ALL_VALID)
+                    oIndex = XMMReg4Double::Ternary(oValid, oIndex, oMinusTwo);
+                double adfIndex[4];
+                oIndex.Store4Val(adfIndex);
+                AddToHistogram(adfIndex[0]);
+                AddToHistogram(adfIndex[1]);
+                AddToHistogram(adfIndex[2]);
+                AddToHistogram(adfIndex[3]);
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                double dfVal;
+                if (oLoader.Load1(pLine + iX,
+                                  HAS_MASK ? pabyMaskLine + iX : nullptr,
+                                  dfVal))
+                {
+                    AddToHistogram(std::min(
+                        std::max((dfVal - dfMin) * dfScale, dfMinusOne),
+                        dfBuckets));
+                }
+            }
+        }
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                       GDALDispatchSIMDKernel()                       */
+/************************************************************************/
+
+template <class T, template <class, bool, bool> class KERNEL, class... Args>
+static void GDALDispatchSIMDKernelForType(const void *pData, int nXCheck,
+                                          int nYCheck, int nLineStride,
+                                          const GByte *pabyMask,
+                                          const GDALNoDataInterval &sNoData,
+                                          Args &&...args)
+{
+    const T *pTData = static_cast<const T *>(pData);
+    if (sNoData.IsEmpty())
+    {
+        if (pabyMask)
+            KERNEL<T, false, true>::f(pTData, nXCheck, nYCheck, nLineStride,
+                                      pabyMask, sNoData,
+                                      std::forward<Args>(args)...);
+        else
+            KERNEL<T, false, false>::f(pTData, nXCheck, nYCheck, nLineStride,
+                                       pabyMask, sNoData,
+                                       std::forward<Args>(args)...);
+    }
+    else
+    {
+        if (pabyMask)
+            KERNEL<T, true, true>::f(pTData, nXCheck, nYCheck, nLineStride,
+                                     pabyMask, sNoData,
+                                     std::forward<Args>(args)...);
+        else
+            KERNEL<T, true, false>::f(pTData, nXCheck, nYCheck, nLineStride,
+                                      pabyMask, sNoData,
+                                      std::forward<Args>(args)...);
+    }
+}
+
+// Runs KERNEL on a nXCheck * nYCheck buffer, whose lines are nLineStride
+// pixels apart, and returns true, if there is a SIMD kernel for its data type.
+template <template <class, bool, bool> class KERNEL, class... Args>
+static bool GDALDispatchSIMDKernel(GDALDataType eDataType, bool bSignedByte,
+                                   const void *pData, int nXCheck,
+                                   int nYCheck, int nLineStride,
+                                   const GByte *pabyMask, bool bGotNoDataValue,
+                                   double dfNoDataValue,
+                                   bool bGotFloatNoDataValue,
+                                   float fNoDataValue, Args &&...args)
+{
+    if (eDataType != GDT_Byte && eDataType != GDT_UInt16 &&
+        eDataType != GDT_Int16 && eDataType != GDT_UInt32 &&
+        eDataType != GDT_Int32 && eDataType != GDT_Float32 &&
+        eDataType != GDT_Float64)
+    {
+        return false;
+    }
+    if (eDataType == GDT_Byte && bSignedByte)
+        return false;
+
+    const GDALNoDataInterval sNoData =
+        GetNoDataInterval(eDataType, bGotNoDataValue, dfNoDataValue,
+                          bGotFloatNoDataValue, fNoDataValue);
+#define DISPATCH_FOR_TYPE(T)                                                   \
+    GDALDispatchSIMDKernelForType<T, KERNEL>(pData, nXCheck, nYCheck,          \
+                                             nLineStride, pabyMask, sNoData,   \
+                                             std::forward<Args>(args)...)
+    switch (eDataType)
+    {
+        case GDT_Byte:
+            DISPATCH_FOR_TYPE(GByte);
+            break;
+        case GDT_UInt16:
+            DISPATCH_FOR_TYPE(GUInt16);
+            break;
+        case GDT_Int16:
+            DISPATCH_FOR_TYPE(GInt16);
+            break;
+        case GDT_UInt32:
+            DISPATCH_FOR_TYPE(GUInt32);
+            break;
+        case GDT_Int32:
+            DISPATCH_FOR_TYPE(GInt32);
+            break;
+        case GDT_Float32:
+            DISPATCH_FOR_TYPE(float);
+            break;
+        default:
+            DISPATCH_FOR_TYPE(double);
+            break;
+    }
+#undef DISPATCH_FOR_TYPE
+    return true;
+}
+
+#endif  // USE_SSE2_OPTIM
+
+/************************************************************************/
+/*                       ComputeHistogramForBlock()                     */
+/************************************************************************/
+
+// Adds the valid pixels of a nXCheck * nYCheck buffer, whose lines are
+// nLineStride pixels apart, to panHistogram.
+static void ComputeHistogramForBlock(
+    const void *pData, GDALDataType eDataType, bool bSignedByte, int nXCheck,
+    int nYCheck, int nLineStride, const GByte *pabyMask, bool bGotNoDataValue,
+    double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
+    double dfMin, double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *panHistogram)
+{
+    // this is a special case for a common situation.
+    if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
+        (dfMin >= -0.5 && dfMin <= 0.5) && nXCheck == nLineStride &&
+        nBuckets == 256)
+    {
+        const GPtrDiff_t nPixels = static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+
+        for (GPtrDiff_t i = 0; i < nPixels; i++)
+        {
+            if (pabyMask && pabyMask[i] == 0)
+                continue;
+            if (!(bGotNoDataValue &&
+                  (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
+            {
+                panHistogram[pabyData[i]]++;
+            }
+        }
+
+        return;
+    }
+
+#ifdef USE_SSE2_OPTIM
+    if (GDALDispatchSIMDKernel<ComputeHistogramSIMD>(
+            eDataType, bSignedByte, pData, nXCheck, nYCheck, nLineStride,
+            pabyMask, bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+            fNoDataValue, dfMin, dfScale, nBuckets, bIncludeOutOfRange,
+            panHistogram))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+
+            if (pabyMask && pabyMask[iOffset] == 0)
+                continue;
+
+            double dfValue = 0.0;
+
+            switch (eDataType)
+            {
+                case GDT_Byte:
+                {
+                    if (bSignedByte)
+                        dfValue =
+                            static_cast<const signed char *>(pData)[iOffset];
+                    else
+                        dfValue = static_cast<const GByte *>(pData)[iOffset];
+                    break;
+                }
+                case GDT_Int8:
+                    dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt16:
+                    dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_Int16:
+                    dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt32:
+                    dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_Int32:
+                    dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GUInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Int64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Float32:
+                {
+                    const float fValue =
+                        static_cast<const float *>(pData)[iOffset];
+                    if (CPLIsNan(fValue) ||
+                        (bGotFloatNoDataValue &&
+                         ARE_REAL_EQUAL(fValue, fNoDataValue)))
+                        continue;
+                    dfValue = fValue;
+                    break;
+                }
+                case GDT_Float64:
+                    dfValue = static_cast<const double *>(pData)[iOffset];
+                    if (CPLIsNan(dfValue))
+                        continue;
+                    break;
+                case GDT_CInt16:
+                {
+                    double dfReal =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                }
+                break;
+                case GDT_CInt32:
+                {
+                    double dfReal =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                }
+                break;
+                case GDT_CFloat32:
+                {
+                    double dfReal =
+                        static_cast<const float *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const float *>(pData)[iOffset * 2 + 1];
+                    if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                }
+                break;
+                case GDT_CFloat64:
+                {
+                    double dfReal =
+                        static_cast<const double *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const double *>(pData)[iOffset * 2 + 1];
+                    if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                }
+                break;
+                case GDT_Unknown:
+                case GDT_TypeCount:
+                    CPLAssert(false);
+                    return;
+            }
+
+            if (eDataType != GDT_Float32 && bGotNoDataValue &&
+                ARE_REAL_EQUAL(dfValue, dfNoDataValue))
+                continue;
+
+            // Given that dfValue and dfMin are not NaN, and dfScale > 0
+            // and finite, the result of the multiplication cannot be
+            // NaN
+            const double dfIndex = floor((dfValue - dfMin) * dfScale);
+
+            if (dfIndex < 0)
+            {
+                if (bIncludeOutOfRange)
+                    panHistogram[0]++;
+            }
+            else if (dfIndex >= nBuckets)
+            {
+                if (bIncludeOutOfRange)
+                    ++panHistogram[nBuckets - 1];
+            }
+            else
+            {
+                ++panHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                            GetHistogram()                            */
+/************************************************************************/
+
+/**
+ * \brief Compute raster histogram.
+ *
+ * Note that the bucket size is (dfMax-dfMin) / nBuckets.
+ *
+ * For example to compute a simple 256 entry histogram of eight bit data,
+ * the following would be suitable.  The unusual bounds are to ensure that
+ * bucket boundaries don't fall right on integer values causing possible errors
+ * due to rounding after scaling.
+\code{.cpp}
+    GUIntBig anHistogram[256];
+
+    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
+                          GDALDummyProgress, nullptr );
+\endcode
+ *
+ * Note that setting bApproxOK will generally result in a subsampling of the
+ * file, and will utilize overviews if available.  It should generally
+ * produce a representative histogram for the data that is suitable for use
+ * in generating histogram based luts for instance.  Generally bApproxOK is
+ * much faster than an exactly computed histogram.
+ *
+ * Starting with GDAL 3.10, when the histogram is computed from all blocks at
+ * full resolution, the GDAL_NUM_THREADS configuration option can be set to
+ * the number of worker threads (or ALL_CPUS) to use to compute it. Blocks
+ * are still read from the calling thread.
+ *
+ * This method is the same as the C functions GDALGetRasterHistogram() and
+ * GDALGetRasterHistogramEx().
+ *
+ * @param dfMin the lower bound of the histogram.
+ * @param dfMax the upper bound of the histogram.
+ * @param nBuckets the number of buckets in panHistogram.
+ * @param panHistogram array into which the histogram totals are placed.
+ * @param bIncludeOutOfRange if TRUE values below the histogram range will
+ * mapped into panHistogram[0], and values above will be mapped into
+ * panHistogram[nBuckets-1] otherwise out of range values are discarded.
+ * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
+ * @param pfnProgress function to report progress to completion.
+ * @param pProgressData application data to pass to pfnProgress.
+ *
+ * @return CE_None on success, or CE_Failure if something goes wrong.
+ */
+
+CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
+                                    GUIntBig *panHistogram,
+                                    int bIncludeOutOfRange, int bApproxOK,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+
+{
+    CPLAssert(nullptr != panHistogram);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    /* -------------------------------------------------------------------- */
+    /*      If we have overviews, use them for the histogram.               */
+    /* -------------------------------------------------------------------- */
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        // FIXME: should we use the most reduced overview here or use some
+        // minimum number of samples like GDALRasterBand::ComputeStatistics()
+        // does?
+        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
+
+        if (poBestOverview != this)
+        {
+            return poBestOverview->GetHistogram(
+                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
+                bApproxOK, pfnProgress, pProgressData);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read actual data and build histogram.                           */
+    /* -------------------------------------------------------------------- */
+    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    // Written this way to deal with NaN
+    if (!(dfMax > dfMin))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMax should be strictly greater than dfMin");
+        return CE_Failure;
+    }
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+
+    const double dfScale = nBuckets / (dfMax - dfMin);
+    if (dfScale == 0 || !std::isfinite(dfScale))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMin and dfMax should be finite values such that "
+                    "nBuckets / (dfMax - dfMin) is non-zero");
+        return CE_Failure;
+    }
+    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
+
+    int bGotNoDataValue = FALSE;
+    const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
+    bool bGotFloatNoDataValue = false;
+    float fNoDataValue = 0.0f;
+    ComputeFloatNoDataValue(eDataType, dfNoDataValue, bGotNoDataValue,
+                            fNoDataValue, bGotFloatNoDataValue);
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!bGotNoDataValue)
+    {
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
+    }
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    if (bApproxOK && HasArbitraryOverviews())
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out how much the image should be reduced to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        const double dfReduction =
+            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
+                 GDALSTAT_APPROX_NUMSAMPLES);
+
+        int nXReduced = nRasterXSize;
+        int nYReduced = nRasterYSize;
+        if (dfReduction > 1.0)
+        {
+            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
+            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
+
+            // Catch the case of huge resizing ratios here
+            if (nXReduced == 0)
+                nXReduced = 1;
+            if (nYReduced == 0)
+                nYReduced = 1;
+        }
+
+        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
+                                          nXReduced, nYReduced);
+        if (!pData)
+            return CE_Failure;
+
+        const CPLErr eErr =
+            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
+                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
+        if (eErr != CE_None)
+        {
+            CPLFree(pData);
+            return eErr;
+        }
+
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
+            if (!pabyMaskData)
+            {
+                CPLFree(pData);
+                return CE_Failure;
+            }
+
+            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
+                                     pabyMaskData, nXReduced, nYReduced,
+                                     GDT_Byte, 0, 0, nullptr) != CE_None)
+            {
+                CPLFree(pData);
+                CPLFree(pabyMaskData);
+                return CE_Failure;
+            }
+        }
+
+        // This isn't the fastest way to do this, but is easier for now.
+        for (int iY = 0; iY < nYReduced; iY++)
+        {
+            for (int iX = 0; iX < nXReduced; iX++)
+            {
+                const int iOffset = iX + iY * nXReduced;
+                double dfValue = 0.0;
+
+                if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                    continue;
 
                 switch (eDataType)
                 {
@@ -3735,6 +4770,63 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
+        // Multi-threaded computation when all blocks are read. Each slice
+        // index has its own histogram, summed at the end. Not done for a huge
+        // number of buckets, to limit memory usage.
+        const int nThreads =
+            nSampleRate == 1 && nBuckets <= 65536 &&
+                    static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn > 1
+                ? GDALGetStatisticsNumThreads()
+                : 1;
+        if (nThreads > 1)
+        {
+            const GDALScanLayout oLayout(this);
+            std::vector<std::vector<GUIntBig>> aanSliceHistograms;
+            try
+            {
+                aanSliceHistograms.resize(oLayout.GetMaxSlicesPerChunk());
+                for (auto &anSliceHistogram : aanSliceHistograms)
+                    anSliceHistogram.resize(nBuckets);
+            }
+            catch (const std::exception &)
+            {
+                ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in GetHistogram()");
+                return CE_Failure;
+            }
+
+            const auto ProcessSlice =
+                [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+                 bGotFloatNoDataValue, fNoDataValue, dfMin, dfScale, nBuckets,
+                 bIncludeOutOfRange,
+                 &aanSliceHistograms](int iSlice, const void *pData,
+                                      const GByte *pabyMask, int nXCheck,
+                                      int nYCheck, int nLineStride)
+            {
+                ComputeHistogramForBlock(
+                    pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                    nLineStride, pabyMask, CPL_TO_BOOL(bGotNoDataValue),
+                    dfNoDataValue, bGotFloatNoDataValue, fNoDataValue, dfMin,
+                    dfScale, nBuckets, CPL_TO_BOOL(bIncludeOutOfRange),
+                    aanSliceHistograms[iSlice].data());
+            };
+            if (!GDALRasterBandScanMultiThreaded(
+                    this, poMaskBand, nThreads, oLayout, ProcessSlice, nullptr,
+                    pfnProgress, pProgressData, "Compute Histogram"))
+            {
+                return CE_Failure;
+            }
+
+            for (const auto &anSliceHistogram : aanSliceHistograms)
+            {
+                for (int i = 0; i < nBuckets; ++i)
+                    panHistogram[i] += anSliceHistogram[i];
+            }
+
+            pfnProgress(1.0, "Compute Histogram", pProgressData);
+            return CE_None;
+        }
+
         GByte *pabyMaskData = nullptr;
         if (poMaskBand)
         {
@@ -3790,165 +4882,11 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 return CE_Failure;
             }
 
-            // this is a special case for a common situation.
-            if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
-                (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
-                nXCheck == nBlockXSize && nBuckets == 256)
-            {
-                const GPtrDiff_t nPixels =
-                    static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
-
-                for (GPtrDiff_t i = 0; i < nPixels; i++)
-                {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
-                        continue;
-                    if (!(bGotNoDataValue &&
-                          (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
-                }
-
-                poBlock->DropLock();
-                continue;  // To next sample block.
-            }
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    double dfValue = 0.0;
-
-                    switch (eDataType)
-                    {
-                        case GDT_Byte:
-                        {
-                            if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
-                            else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
-                            break;
-                        }
-                        case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt64:
-                            dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Int64:
-                            dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Float32:
-                        {
-                            const float fValue =
-                                static_cast<float *>(pData)[iOffset];
-                            if (CPLIsNan(fValue) ||
-                                (bGotFloatNoDataValue &&
-                                 ARE_REAL_EQUAL(fValue, fNoDataValue)))
-                                continue;
-                            dfValue = fValue;
-                            break;
-                        }
-                        case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
-                            if (CPLIsNan(dfValue))
-                                continue;
-                            break;
-                        case GDT_CInt16:
-                        {
-                            double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        }
-                        break;
-                        case GDT_CInt32:
-                        {
-                            double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        }
-                        break;
-                        case GDT_CFloat32:
-                        {
-                            double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
-                            if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        }
-                        break;
-                        case GDT_CFloat64:
-                        {
-                            double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
-                            if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        }
-                        break;
-                        case GDT_Unknown:
-                        case GDT_TypeCount:
-                            CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
-                    }
-
-                    if (eDataType != GDT_Float32 && bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, dfNoDataValue))
-                        continue;
-
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0
-                    // and finite, the result of the multiplication cannot be
-                    // NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
-
-                    if (dfIndex < 0)
-                    {
-                        if (bIncludeOutOfRange)
-                            panHistogram[0]++;
-                    }
-                    else if (dfIndex >= nBuckets)
-                    {
-                        if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
-                }
-            }
+            ComputeHistogramForBlock(
+                pData, eDataType, bSignedByte, nXCheck, nYCheck, nBlockXSize,
+                pabyMaskData, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                bGotFloatNoDataValue, fNoDataValue, dfMin, dfScale, nBuckets,
+                CPL_TO_BOOL(bIncludeOutOfRange), panHistogram);
 
             poBlock->DropLock();
         }
@@ -5610,6 +6548,59 @@ static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
     return dfValue;
 }
 
+/************************************************************************/
+/*                     ComputeStatisticsForBlock()                      */
+/************************************************************************/
+
+// Updates the running minimum, maximum, mean and sum of squares of
+// differences to the mean (Welford algorithm) with the valid pixels of a
+// nXCheck * nYCheck buffer, whose lines are nLineStride pixels apart.
+static void ComputeStatisticsForBlock(
+    const void *pData, GDALDataType eDataType, bool bSignedByte, int nXCheck,
+    int nYCheck, int nLineStride, const GByte *pabyMask, bool bGotNoDataValue,
+    double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
+    double &dfMin, double &dfMax, double &dfMean, double &dfM2,
+    GUIntBig &nValidCount)
+{
+#ifdef USE_SSE2_OPTIM
+    if (GDALDispatchSIMDKernel<ComputeStatisticsSIMD>(
+            eDataType, bSignedByte, pData, nXCheck, nYCheck, nLineStride,
+            pabyMask, bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+            fNoDataValue, dfMin, dfMax, dfMean, dfM2, nValidCount))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+            if (pabyMask && pabyMask[iOffset] == 0)
+                continue;
+
+            bool bValid = true;
+            double dfValue = GetPixelValue(
+                eDataType, bSignedByte, pData, iOffset, bGotNoDataValue,
+                dfNoDataValue, bGotFloatNoDataValue, fNoDataValue, bValid);
+
+            if (!bValid)
+                continue;
+
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+
+            nValidCount++;
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / nValidCount;
+            dfM2 += dfDelta * (dfValue - dfMean);
+        }
+    }
+}
+
 /************************************************************************/
 /*                         SetValidPercent()                            */
 /************************************************************************/
@@ -5677,6 +6668,11 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.10, when all pixels are read, the GDAL_NUM_THREADS
+ * configuration option can be set to the number of worker threads (or
+ * ALL_CPUS) to use to compute the statistics. Blocks are still read from the
+ * calling thread. The result does not depend on the number of threads.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5950,52 +6946,133 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            // Multi-threaded computation when all blocks are read. Integer
+            // accumulators of each slice index are summed at the end.
+            const int nThreads =
+                nSampleRate == 1 &&
+                        static_cast<GIntBig>(nBlocksPerRow) *
+                                nBlocksPerColumn >
+                            1
+                    ? GDALGetStatisticsNumThreads()
+                    : 1;
+            if (nThreads > 1)
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
+                struct SliceStats
+                {
+                    GUInt32 nMin = 0;
+                    GUInt32 nMax = 0;
+                    GUIntBig nSum = 0;
+                    GUIntBig nSumSquare = 0;
+                    GUIntBig nSampleCount = 0;
+                    GUIntBig nValidCount = 0;
+                };
+
+                const GDALScanLayout oLayout(this);
+                std::vector<SliceStats> asSliceStats(
+                    oLayout.GetMaxSlicesPerChunk());
+                for (auto &sStats : asSliceStats)
+                    sStats.nMin = nMaxValueType;
+
+                const auto ProcessSlice =
+                    [this, nNoDataValue, nMaxValueType,
+                     &asSliceStats](int iSlice, const void *pData,
+                                    const GByte *, int nXCheck, int nYCheck,
+                                    int nLineStride)
+                {
+                    SliceStats &s = asSliceStats[iSlice];
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nLineStride, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              s.nMin, s.nMax, s.nSum, s.nSumSquare,
+                              s.nSampleCount, s.nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nLineStride, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              s.nMin, s.nMax, s.nSum, s.nSumSquare,
+                              s.nSampleCount, s.nValidCount);
+                    }
+                };
+                if (!GDALRasterBandScanMultiThreaded(
+                        this, nullptr, nThreads, oLayout, ProcessSlice,
+                        nullptr, pfnProgress, pProgressData,
+                        "Compute Statistics"))
+                {
                     return CE_Failure;
+                }
 
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                if (eDataType == GDT_Byte)
+                for (const auto &s : asSliceStats)
                 {
-                    ComputeStatisticsInternal<
-                        GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                    if (s.nValidCount)
+                    {
+                        nMin = std::min(nMin, s.nMin);
+                        nMax = std::max(nMax, s.nMax);
+                    }
+                    nSum += s.nSum;
+                    nSumSquare += s.nSumSquare;
+                    nSampleCount += s.nSampleCount;
+                    nValidCount += s.nValidCount;
                 }
-                else
+            }
+            else
+            {
+                for (int iSampleBlock = 0;
+                     iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
+                     iSampleBlock += nSampleRate)
                 {
-                    ComputeStatisticsInternal<
-                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
+                    const int iYBlock = iSampleBlock / nBlocksPerRow;
+                    const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
-                poBlock->DropLock();
+                    GDALRasterBlock *const poBlock =
+                        GetLockedBlockRef(iXBlock, iYBlock);
+                    if (poBlock == nullptr)
+                        return CE_Failure;
 
-                if (!pfnProgress(iSampleBlock /
-                                     static_cast<double>(nBlocksPerRow *
-                                                         nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
+                    void *const pData = poBlock->GetDataRef();
+
+                    int nXCheck = 0, nYCheck = 0;
+                    GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
+
+                    poBlock->DropLock();
+
+                    if (!pfnProgress(iSampleBlock /
+                                         static_cast<double>(nBlocksPerRow *
+                                                             nBlocksPerColumn),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
                 }
             }
 
@@ -6065,93 +7142,142 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         }
 #endif
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        // When all blocks are read, the partial statistics of the slices are
+        // merged in a deterministic order with the parallel variant of the
+        // Welford algorithm (Chan et al.). This is also done with a single
+        // thread, so that results do not depend on the number of threads.
+        if (nSampleRate == 1 &&
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn > 1)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            const int nThreads = GDALGetStatisticsNumThreads();
+            struct SliceStats
+            {
+                double dfMin = std::numeric_limits<double>::max();
+                double dfMax = -std::numeric_limits<double>::max();
+                double dfMean = 0.0;
+                double dfM2 = 0.0;
+                GUIntBig nValidCount = 0;
+            };
+
+            const GDALScanLayout oLayout(this);
+            std::vector<SliceStats> asSliceStats(
+                oLayout.GetMaxSlicesPerChunk());
+
+            const auto ProcessSlice =
+                [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+                 bGotFloatNoDataValue, fNoDataValue,
+                 &asSliceStats](int iSlice, const void *pData,
+                                const GByte *pabyMask, int nXCheck,
+                                int nYCheck, int nLineStride)
+            {
+                SliceStats &s = asSliceStats[iSlice];
+                s = SliceStats();
+                ComputeStatisticsForBlock(
+                    pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                    nLineStride, pabyMask, CPL_TO_BOOL(bGotNoDataValue),
+                    dfNoDataValue, bGotFloatNoDataValue, fNoDataValue, s.dfMin,
+                    s.dfMax, s.dfMean, s.dfM2, s.nValidCount);
+            };
+            const auto EndOfChunk =
+                [&asSliceStats, &dfMin, &dfMax, &dfMean, &dfM2,
+                 &nValidCount](int nSlices)
+            {
+                for (int i = 0; i < nSlices; ++i)
+                {
+                    const SliceStats &s = asSliceStats[i];
+                    if (s.nValidCount == 0)
+                        continue;
+                    dfMin = std::min(dfMin, s.dfMin);
+                    dfMax = std::max(dfMax, s.dfMax);
+                    const GUIntBig nNewValidCount = nValidCount + s.nValidCount;
+                    const double dfDelta = s.dfMean - dfMean;
+                    const double dfOtherWeight =
+                        static_cast<double>(s.nValidCount) / nNewValidCount;
+                    dfMean += dfDelta * dfOtherWeight;
+                    dfM2 += s.dfM2 + dfDelta * dfDelta *
+                                         static_cast<double>(nValidCount) *
+                                         dfOtherWeight;
+                    nValidCount = nNewValidCount;
+                }
+            };
+            if (!GDALRasterBandScanMultiThreaded(
+                    this, poMaskBand, nThreads, oLayout, ProcessSlice,
+                    EndOfChunk, pfnProgress, pProgressData,
+                    "Compute Statistics"))
             {
                 return CE_Failure;
             }
-        }
 
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+            nSampleCount = static_cast<GUIntBig>(nRasterXSize) * nRasterYSize;
+        }
+        else
         {
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
             }
 
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            for (int iSampleBlock = 0;
+                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
+                 iSampleBlock += nSampleRate)
             {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+                const int iYBlock = iSampleBlock / nBlocksPerRow;
+                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
                 {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    bool bValid = true;
-                    double dfValue = GetPixelValue(
-                        eDataType, bSignedByte, pData, iOffset,
-                        CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                        bGotFloatNoDataValue, fNoDataValue, bValid);
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    if (!bValid)
-                        continue;
+                void *const pData = poBlock->GetDataRef();
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(
+                        GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                        nXCheck, nYCheck, pabyMaskData, nXCheck, nYCheck,
+                        GDT_Byte, 0, nBlockXSize, nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    poBlock->DropLock();
+                    return CE_Failure;
                 }
-            }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                ComputeStatisticsForBlock(
+                    pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                    nBlockXSize, pabyMaskData, CPL_TO_BOOL(bGotNoDataValue),
+                    dfNoDataValue, bGotFloatNoDataValue, fNoDataValue, dfMin,
+                    dfMax, dfMean, dfM2, nValidCount);
 
-            poBlock->DropLock();
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
 
-            if (!pfnProgress(
-                    iSampleBlock /
-                        static_cast<double>(nBlocksPerRow * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                poBlock->DropLock();
+
+                if (!pfnProgress(iSampleBlock /
+                                     static_cast<double>(nBlocksPerRow *
+                                                         nBlocksPerColumn),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
             }
-        }
 
-        CPLFree(pabyMaskData);
+            CPLFree(pabyMaskData);
+        }
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6387,6 +7513,16 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
                                  const GByte *pabyMaskData, double &dfMin,
                                  double &dfMax)
 {
+#ifdef USE_SSE2_OPTIM
+    if (GDALDispatchSIMDKernel<ComputeMinMaxSIMD>(
+            eDataType, bSignedByte, pData, nXCheck, nYCheck, nBlockXSize,
+            pabyMaskData, bGotNoDataValue, dfNoDataValue, bGotFloatNoDataValue,
+            fNoDataValue, dfMin, dfMax))
+    {
+        return;
+    }
+#endif
+
     switch (eDataType)
     {
         case GDT_Unknown:
@@ -6550,6 +7686,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.10, when all pixels are read, the GDAL_NUM_THREADS
+ * configuration option can be set to the number of worker threads (or
+ * ALL_CPUS) to use to compute the min/max.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -6647,9 +7787,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](const void *pData, int nXCheck, int nBufferWidth,
+                        int nYCheck, GUInt32 &nBlockMin, GUInt32 &nBlockMax,
+                        GInt16 &nBlockMinInt16, GInt16 &nBlockMaxInt16)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -6663,7 +7804,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nBlockMin, nBlockMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -6677,7 +7819,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nBlockMin, nBlockMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -6693,7 +7836,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nBlockMinInt16,
+                        &nBlockMaxInt16);
                 }
             }
             else
@@ -6703,7 +7847,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nBlockMinInt16, &nBlockMaxInt16);
                 }
             }
         }
@@ -6769,7 +7913,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced, nMin,
+                                  nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -6808,7 +7953,72 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        // Multi-threaded computation when all blocks are read. Each slice
+        // index has its own accumulators, merged at the end.
+        const int nThreads =
+            nSampleRate == 1 &&
+                    static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn > 1
+                ? GDALGetStatisticsNumThreads()
+                : 1;
+        if (nThreads > 1)
+        {
+            struct SliceMinMax
+            {
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GInt16 nMinInt16;
+                GInt16 nMaxInt16;
+                double dfMin;
+                double dfMax;
+            };
+
+            const GDALScanLayout oLayout(this);
+            std::vector<SliceMinMax> asSliceMinMax(
+                oLayout.GetMaxSlicesPerChunk(),
+                SliceMinMax{nMin, nMax, nMinInt16, nMaxInt16, dfMin, dfMax});
+
+            const auto ProcessSlice =
+                [this, bUseOptimizedPath, bSignedByte, bGotNoDataValue,
+                 dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+                 &ComputeMinMaxForBlock,
+                 &asSliceMinMax](int iSlice, const void *pData,
+                                 const GByte *pabyMask, int nXCheck,
+                                 int nYCheck, int nLineStride)
+            {
+                SliceMinMax &s = asSliceMinMax[iSlice];
+                if (bUseOptimizedPath)
+                {
+                    ComputeMinMaxForBlock(pData, nXCheck, nLineStride, nYCheck,
+                                          s.nMin, s.nMax, s.nMinInt16,
+                                          s.nMaxInt16);
+                }
+                else
+                {
+                    ComputeMinMaxGeneric(
+                        pData, eDataType, bSignedByte, nXCheck, nYCheck,
+                        nLineStride, CPL_TO_BOOL(bGotNoDataValue),
+                        dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+                        pabyMask, s.dfMin, s.dfMax);
+                }
+            };
+            if (!GDALRasterBandScanMultiThreaded(
+                    this, poMaskBand, nThreads, oLayout, ProcessSlice, nullptr,
+                    GDALDummyProgress, nullptr, nullptr))
+            {
+                return CE_Failure;
+            }
+
+            for (const auto &s : asSliceMinMax)
+            {
+                nMin = std::min(nMin, s.nMin);
+                nMax = std::max(nMax, s.nMax);
+                nMinInt16 = std::min(nMinInt16, s.nMinInt16);
+                nMaxInt16 = std::max(nMaxInt16, s.nMaxInt16);
+                dfMin = std::min(dfMin, s.dfMin);
+                dfMax = std::max(dfMax, s.dfMax);
+            }
+        }
+        else if (bUseOptimizedPath)
         {
             for (int iSampleBlock = 0;
                  iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
@@ -6826,7 +8036,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      nMin, nMax, nMinInt16, nMaxInt16);
 
                 poBlock->DropLock();
 
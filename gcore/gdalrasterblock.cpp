@@ -33,7 +33,9 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
 #include <mutex>
 
@@ -46,21 +48,18 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
 #if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+typedef CPLMutex GDALRBLockType;
+#define INITIALIZE_LOCK(hLock) CPLMutexHolderD(&(hLock))
+#define TAKE_LOCK(hLock) CPLMutexHolderOptionalLockD(hLock)
+#define DESTROY_LOCK(hLock) CPLDestroyMutex(hLock)
 #else
 
-static CPLLock *hRBLock = nullptr;
+typedef CPLLock GDALRBLockType;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -91,14 +90,91 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(hLock)                                                 \
+    CPLLockHolderD(&(hLock), GetLockType());                                   \
+    CPLLockSetDebugPerf(hLock, bDebugContention)
+#define TAKE_LOCK(hLock) CPLLockHolderOptionalLockD(hLock)
+#define DESTROY_LOCK(hLock) CPLDestroyLock(hLock)
 
 #endif
 
+/************************************************************************/
+/*                        GDALRBCachePartition                          */
+/************************************************************************/
+
+// The global block cache is split into GDAL_RB_CACHE_PARTITIONS LRU lists,
+// each one protected by its own lock. A block is assigned to a partition
+// from a hash of its band and block coordinates. The memory budget
+// (nCacheMax / nCacheUsed) remains global.
+namespace
+{
+struct GDALRBCachePartition
+{
+    GDALRBLockType *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    // Number of times a block has been moved to the head of the list.
+    // Only modified under hLock, but read without it by Touch().
+    std::atomic<GUIntBig> nPromotions{0};
+    // Number of blocks in the list. Same as above.
+    std::atomic<int> nBlocks{0};
+};
+}  // namespace
+
+constexpr int MAX_CACHE_PARTITIONS = 64;
+static GDALRBCachePartition asCachePartitions[MAX_CACHE_PARTITIONS];
+
+/************************************************************************/
+/*                       GetCachePartitionCount()                       */
+/************************************************************************/
+
+static int GetCachePartitionCount()
+{
+    static const int nPartitions = []()
+    {
+        const char *pszVal =
+            CPLGetConfigOption("GDAL_RB_CACHE_PARTITIONS", "1");
+        int nVal;
+        if (EQUAL(pszVal, "ALL_CPUS"))
+            nVal = CPLGetNumCPUs();
+        else
+            nVal = atoi(pszVal);
+        if (nVal < 1 || nVal > MAX_CACHE_PARTITIONS)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_RB_CACHE_PARTITIONS=%s not supported. "
+                     "Value should be in [1,%d] range, or ALL_CPUS. "
+                     "Clamping to that range",
+                     pszVal, MAX_CACHE_PARTITIONS);
+            nVal = std::max(1, std::min(nVal, MAX_CACHE_PARTITIONS));
+        }
+        return nVal;
+    }();
+    return nPartitions;
+}
+
+/************************************************************************/
+/*                         GetCachePartition()                          */
+/************************************************************************/
+
+static int GetCachePartition(const GDALRasterBand *poBand, int nXOff,
+                             int nYOff)
+{
+    const int nPartitions = GetCachePartitionCount();
+    if (nPartitions == 1)
+        return 0;
+    uint64_t nHash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(poBand));
+    nHash ^= (static_cast<uint64_t>(static_cast<uint32_t>(nXOff)) << 32) |
+             static_cast<uint32_t>(nYOff);
+    // splitmix64 finalizer, to spread neighbouring blocks over partitions
+    nHash ^= nHash >> 30;
+    nHash *= 0xbf58476d1ce4e5b9ULL;
+    nHash ^= nHash >> 27;
+    nHash *= 0x94d049bb133111ebULL;
+    nHash ^= nHash >> 31;
+    return static_cast<int>(nHash % static_cast<unsigned>(nPartitions));
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -241,8 +317,9 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
+            for (int i = 0; i < GetCachePartitionCount(); ++i)
             {
-                INITIALIZE_LOCK;
+                INITIALIZE_LOCK(asCachePartitions[i].hLock);
             }
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
@@ -434,11 +511,20 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
-
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Start from a different partition at each call, so that successive
+    // calls evict blocks evenly from all partitions.
+    static std::atomic<unsigned> nFlushCounter{0};
+    const int nPartitions = GetCachePartitionCount();
+    const int nFirstPartition =
+        static_cast<int>(nFlushCounter++ % static_cast<unsigned>(nPartitions));
+    for (int iPart = 0; iPart < nPartitions && poTarget == nullptr; ++iPart)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        auto &oPartition =
+            asCachePartitions[(nFirstPartition + iPart) % nPartitions];
+        INITIALIZE_LOCK(oPartition.hLock);
+        poTarget = oPartition.poOldest;
 
         while (poTarget != nullptr)
         {
@@ -452,7 +538,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -466,6 +552,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -585,7 +674,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nCachePartition(0), nLastPromotion(0)
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
@@ -612,7 +702,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false),
+      nCachePartition(0), nLastPromotion(0)
 {
 }
 
@@ -701,19 +792,24 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(asCachePartitions[nCachePartition].hLock);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    auto &oPartition = asCachePartitions[nCachePartition];
+
+    if (poPrevious != nullptr || oPartition.poNewest == this)
+        oPartition.nBlocks.fetch_sub(1, std::memory_order_relaxed);
+
+    if (oPartition.poOldest == this)
+        oPartition.poOldest = poPrevious;
 
-    if (poNewest == this)
+    if (oPartition.poNewest == this)
     {
-        poNewest = poNext;
+        oPartition.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -747,26 +843,34 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (const auto &oPartition : asCachePartitions)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        TAKE_LOCK(oPartition.hLock);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        const GDALRasterBlock *poNewest = oPartition.poNewest;
+        const GDALRasterBlock *poOldest = oPartition.poOldest;
+        CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
+                  (poNewest != nullptr && poOldest != nullptr));
+
+        if (poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(poNewest->poPrevious == nullptr);
+            CPLAssert(poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            int nBlocks = 0;
+            const GDALRasterBlock *poLast = nullptr;
+            for (const GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+
+                poLast = poBlock;
+                ++nBlocks;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(poOldest == poLast);
+            CPLAssert(oPartition.nBlocks.load() == nBlocks);
+        }
     }
 }
 
@@ -779,24 +883,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int iPart = 0; iPart < GetCachePartitionCount(); ++iPart)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(asCachePartitions[iPart].hLock);
+        for (GDALRasterBlock *poBlock = asCachePartitions[iPart].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -853,32 +960,55 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    auto &oPartition = asCachePartitions[nCachePartition];
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oPartition.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    // When the cache is partitioned, do not bother taking the lock to move
+    // a block that is already among the most recent quarter of its
+    // partition: the number of promotions done since its own one is an upper
+    // bound of its distance to the head of the list. This makes the LRU
+    // ordering approximate, but avoids lock contention on hot blocks.
+    if (GetCachePartitionCount() > 1 &&
+        oPartition.nPromotions.load(std::memory_order_relaxed) -
+                nLastPromotion.load(std::memory_order_relaxed) <
+            static_cast<GUIntBig>(
+                oPartition.nBlocks.load(std::memory_order_relaxed) / 4))
+        return;
+
+    TAKE_LOCK(oPartition.hLock);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    auto &oPartition = asCachePartitions[nCachePartition];
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oPartition.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    // A block that is in the list, but not at its head, has a previous one.
+    if (poPrevious == nullptr)
+        oPartition.nBlocks.fetch_add(1, std::memory_order_relaxed);
+    nLastPromotion.store(
+        oPartition.nPromotions.fetch_add(1, std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+
+    if (oPartition.poOldest == this)
+        oPartition.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -887,19 +1017,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oPartition.poNewest;
 
-    if (poNewest != nullptr)
+    if (oPartition.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oPartition.poNewest->poPrevious == nullptr);
+        oPartition.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oPartition.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oPartition.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oPartition.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -928,10 +1058,17 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
-    // only be called if we have go through there.
+    // This call will initialize the cache partition locks. Other call places
+    // can only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
+    // Blocks are evicted from the partition of this block first, and
+    // then from the other ones if that was not sufficient.
+    const int nPartitions = GetCachePartitionCount();
+    nCachePartition = GetCachePartition(poBand, nXOff, nYOff);
+    int iPartitionShift = 0;
+    bool bAddedToList = false;
+
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
 
@@ -947,11 +1084,14 @@ CPLErr GDALRasterBlock::Internalize()
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            auto &oPartition =
+                asCachePartitions[(nCachePartition + iPartitionShift) %
+                                  nPartitions];
+            TAKE_LOCK(oPartition.hLock);
 
             if (bFirstIter)
                 nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
+            GDALRasterBlock *poTarget = oPartition.poOldest;
             while (nCacheUsed > nCurCacheMax)
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
@@ -998,7 +1138,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oPartition.poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1053,13 +1193,22 @@ CPLErr GDALRasterBlock::Internalize()
                 }
             }
 
-            /* ------------------------------------------------------------------
-             */
-            /*      Add this block to the list. */
-            /* ------------------------------------------------------------------
-             */
-            if (!bLoopAgain)
+            if (!bLoopAgain && nCacheUsed > nCurCacheMax &&
+                iPartitionShift + 1 < nPartitions)
+            {
+                // Go on evicting from the next partition
+                ++iPartitionShift;
+                bLoopAgain = true;
+            }
+
+            /* ------------------------------------------------------------ */
+            /*      Add this block to the list.                             */
+            /* ------------------------------------------------------------ */
+            if (!bLoopAgain && iPartitionShift == 0)
+            {
                 Touch_unlocked();
+                bAddedToList = true;
+            }
         }
 
         bFirstIter = false;
@@ -1106,6 +1255,12 @@ CPLErr GDALRasterBlock::Internalize()
         }
     } while (bLoopAgain);
 
+    if (!bAddedToList)
+    {
+        TAKE_LOCK(asCachePartitions[nCachePartition].hLock);
+        Touch_unlocked();
+    }
+
     if (pNewData == nullptr)
     {
         pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
@@ -1167,9 +1322,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &oPartition : asCachePartitions)
+    {
+        if (oPartition.hLock != nullptr)
+            DESTROY_LOCK(oPartition.hLock);
+        oPartition.hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1248,7 +1406,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(asCachePartitions[nCachePartition].hLock);
 
     return FALSE;
 }
@@ -1257,14 +1415,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( const auto &oPartition : asCachePartitions )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = oPartition.poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d\n", iBlock);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
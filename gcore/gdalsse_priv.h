@@ -191,6 +191,14 @@ class XMMReg2Double
         return reg;
     }
 
+    static inline XMMReg2Double Or(const XMMReg2Double &expr1,
+                                   const XMMReg2Double &expr2)
+    {
+        XMMReg2Double reg;
+        reg.xmm = _mm_or_pd(expr1.xmm, expr2.xmm);
+        return reg;
+    }
+
     static inline XMMReg2Double Ternary(const XMMReg2Double &cond,
                                         const XMMReg2Double &true_expr,
                                         const XMMReg2Double &false_expr)
@@ -209,6 +217,21 @@ class XMMReg2Double
         return reg;
     }
 
+    static inline XMMReg2Double Max(const XMMReg2Double &expr1,
+                                    const XMMReg2Double &expr2)
+    {
+        XMMReg2Double reg;
+        reg.xmm = _mm_max_pd(expr1.xmm, expr2.xmm);
+        return reg;
+    }
+
+    static inline XMMReg2Double Sqrt(const XMMReg2Double &expr)
+    {
+        XMMReg2Double reg;
+        reg.xmm = _mm_sqrt_pd(expr.xmm);
+        return reg;
+    }
+
     inline void nsLoad1ValHighAndLow(const double *ptr)
     {
         xmm = _mm_load1_pd(ptr);
@@ -268,6 +291,20 @@ class XMMReg2Double
         xmm = _mm_cvtepi32_pd(xmm_i);
     }
 
+    inline void nsLoad2Val(const int *ptr)
+    {
+        xmm = _mm_cvtepi32_pd(GDALCopyInt64ToXMM(ptr));
+    }
+
+    inline void nsLoad2Val(const unsigned int *ptr)
+    {
+        // Shift the unsigned range to the signed one before the conversion,
+        // and shift it back as double.
+        const __m128i xmm_i = _mm_xor_si128(GDALCopyInt64ToXMM(ptr),
+                                            _mm_set1_epi32(INT_MIN));
+        xmm = _mm_add_pd(_mm_cvtepi32_pd(xmm_i), _mm_set1_pd(2147483648.0));
+    }
+
     static inline void Load4Val(const unsigned char *ptr, XMMReg2Double &low,
                                 XMMReg2Double &high)
     {
@@ -313,6 +350,29 @@ class XMMReg2Double
         high.xmm = _mm_cvtps_pd(temp2);
     }
 
+    static inline void Load4Val(const int *ptr, XMMReg2Double &low,
+                                XMMReg2Double &high)
+    {
+        const __m128i xmm_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        low.xmm = _mm_cvtepi32_pd(xmm_i);
+        high.xmm =
+            _mm_cvtepi32_pd(_mm_shuffle_epi32(xmm_i, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+
+    static inline void Load4Val(const unsigned int *ptr, XMMReg2Double &low,
+                                XMMReg2Double &high)
+    {
+        const __m128i xmm_i = _mm_xor_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)),
+            _mm_set1_epi32(INT_MIN));
+        const __m128d xmm_shift = _mm_set1_pd(2147483648.0);
+        low.xmm = _mm_add_pd(_mm_cvtepi32_pd(xmm_i), xmm_shift);
+        high.xmm = _mm_add_pd(
+            _mm_cvtepi32_pd(_mm_shuffle_epi32(xmm_i, _MM_SHUFFLE(3, 2, 3, 2))),
+            xmm_shift);
+    }
+
     inline void Zeroize()
     {
         xmm = _mm_setzero_pd();
@@ -534,6 +594,25 @@ class XMMReg2Double
         return reg;
     }
 
+    static inline XMMReg2Double Or(const XMMReg2Double &expr1,
+                                   const XMMReg2Double &expr2)
+    {
+        XMMReg2Double reg;
+        int low1[2], high1[2];
+        int low2[2], high2[2];
+        memcpy(low1, &expr1.low, sizeof(double));
+        memcpy(high1, &expr1.high, sizeof(double));
+        memcpy(low2, &expr2.low, sizeof(double));
+        memcpy(high2, &expr2.high, sizeof(double));
+        low1[0] |= low2[0];
+        low1[1] |= low2[1];
+        high1[0] |= high2[0];
+        high1[1] |= high2[1];
+        memcpy(&reg.low, low1, sizeof(double));
+        memcpy(&reg.high, high1, sizeof(double));
+        return reg;
+    }
+
     static inline XMMReg2Double Ternary(const XMMReg2Double &cond,
                                         const XMMReg2Double &true_expr,
                                         const XMMReg2Double &false_expr)
@@ -559,6 +638,23 @@ class XMMReg2Double
         return reg;
     }
 
+    static inline XMMReg2Double Max(const XMMReg2Double &expr1,
+                                    const XMMReg2Double &expr2)
+    {
+        XMMReg2Double reg;
+        reg.low = (expr1.low > expr2.low) ? expr1.low : expr2.low;
+        reg.high = (expr1.high > expr2.high) ? expr1.high : expr2.high;
+        return reg;
+    }
+
+    static inline XMMReg2Double Sqrt(const XMMReg2Double &expr)
+    {
+        XMMReg2Double reg;
+        reg.low = sqrt(expr.low);
+        reg.high = sqrt(expr.high);
+        return reg;
+    }
+
     static inline XMMReg2Double Load2Val(const double *ptr)
     {
         XMMReg2Double reg;
@@ -643,6 +739,18 @@ class XMMReg2Double
         high = ptr[1];
     }
 
+    inline void nsLoad2Val(const int *ptr)
+    {
+        low = ptr[0];
+        high = ptr[1];
+    }
+
+    inline void nsLoad2Val(const unsigned int *ptr)
+    {
+        low = ptr[0];
+        high = ptr[1];
+    }
+
     static inline void Load4Val(const unsigned char *ptr, XMMReg2Double &low,
                                 XMMReg2Double &high)
     {
@@ -680,6 +788,20 @@ class XMMReg2Double
         high.nsLoad2Val(ptr + 2);
     }
 
+    static inline void Load4Val(const int *ptr, XMMReg2Double &low,
+                                XMMReg2Double &high)
+    {
+        low.nsLoad2Val(ptr);
+        high.nsLoad2Val(ptr + 2);
+    }
+
+    static inline void Load4Val(const unsigned int *ptr, XMMReg2Double &low,
+                                XMMReg2Double &high)
+    {
+        low.nsLoad2Val(ptr);
+        high.nsLoad2Val(ptr + 2);
+    }
+
     inline void Zeroize()
     {
         low = 0.0;
@@ -909,6 +1031,37 @@ class XMMReg4Double
         ymm = _mm256_cvtps_pd(_mm_loadu_ps(ptr));
     }
 
+    static inline XMMReg4Double Load4Val(const int *ptr)
+    {
+        XMMReg4Double reg;
+        reg.nsLoad4Val(ptr);
+        return reg;
+    }
+
+    inline void nsLoad4Val(const int *ptr)
+    {
+        ymm = _mm256_cvtepi32_pd(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+    }
+
+    static inline XMMReg4Double Load4Val(const unsigned int *ptr)
+    {
+        XMMReg4Double reg;
+        reg.nsLoad4Val(ptr);
+        return reg;
+    }
+
+    inline void nsLoad4Val(const unsigned int *ptr)
+    {
+        // Shift the unsigned range to the signed one before the conversion,
+        // and shift it back as double.
+        const __m128i xmm_i = _mm_xor_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)),
+            _mm_set1_epi32(INT_MIN));
+        ymm = _mm256_add_pd(_mm256_cvtepi32_pd(xmm_i),
+                            _mm256_set1_pd(2147483648.0));
+    }
+
     static inline XMMReg4Double Equals(const XMMReg4Double &expr1,
                                        const XMMReg4Double &expr2)
     {
@@ -941,6 +1094,14 @@ class XMMReg4Double
         return reg;
     }
 
+    static inline XMMReg4Double Or(const XMMReg4Double &expr1,
+                                   const XMMReg4Double &expr2)
+    {
+        XMMReg4Double reg;
+        reg.ymm = _mm256_or_pd(expr1.ymm, expr2.ymm);
+        return reg;
+    }
+
     static inline XMMReg4Double Ternary(const XMMReg4Double &cond,
                                         const XMMReg4Double &true_expr,
                                         const XMMReg4Double &false_expr)
@@ -959,6 +1120,21 @@ class XMMReg4Double
         return reg;
     }
 
+    static inline XMMReg4Double Max(const XMMReg4Double &expr1,
+                                    const XMMReg4Double &expr2)
+    {
+        XMMReg4Double reg;
+        reg.ymm = _mm256_max_pd(expr1.ymm, expr2.ymm);
+        return reg;
+    }
+
+    static inline XMMReg4Double Sqrt(const XMMReg4Double &expr)
+    {
+        XMMReg4Double reg;
+        reg.ymm = _mm256_sqrt_pd(expr.ymm);
+        return reg;
+    }
+
     inline XMMReg4Double &operator=(const XMMReg4Double &other)
     {
         ymm = other.ymm;
@@ -1141,6 +1317,20 @@ class XMMReg4Double
         return reg;
     }
 
+    static inline XMMReg4Double Load4Val(const int *ptr)
+    {
+        XMMReg4Double reg;
+        XMMReg2Double::Load4Val(ptr, reg.low, reg.high);
+        return reg;
+    }
+
+    static inline XMMReg4Double Load4Val(const unsigned int *ptr)
+    {
+        XMMReg4Double reg;
+        XMMReg2Double::Load4Val(ptr, reg.low, reg.high);
+        return reg;
+    }
+
     static inline XMMReg4Double Equals(const XMMReg4Double &expr1,
                                        const XMMReg4Double &expr2)
     {
@@ -1177,6 +1367,15 @@ class XMMReg4Double
         return reg;
     }
 
+    static inline XMMReg4Double Or(const XMMReg4Double &expr1,
+                                   const XMMReg4Double &expr2)
+    {
+        XMMReg4Double reg;
+        reg.low = XMMReg2Double::Or(expr1.low, expr2.low);
+        reg.high = XMMReg2Double::Or(expr1.high, expr2.high);
+        return reg;
+    }
+
     static inline XMMReg4Double Ternary(const XMMReg4Double &cond,
                                         const XMMReg4Double &true_expr,
                                         const XMMReg4Double &false_expr)
@@ -1198,6 +1397,23 @@ class XMMReg4Double
         return reg;
     }
 
+    static inline XMMReg4Double Max(const XMMReg4Double &expr1,
+                                    const XMMReg4Double &expr2)
+    {
+        XMMReg4Double reg;
+        reg.low = XMMReg2Double::Max(expr1.low, expr2.low);
+        reg.high = XMMReg2Double::Max(expr1.high, expr2.high);
+        return reg;
+    }
+
+    static inline XMMReg4Double Sqrt(const XMMReg4Double &expr)
+    {
+        XMMReg4Double reg;
+        reg.low = XMMReg2Double::Sqrt(expr.low);
+        reg.high = XMMReg2Double::Sqrt(expr.high);
+        return reg;
+    }
+
     inline XMMReg4Double &operator=(const XMMReg4Double &other)
     {
         low = other.low;
@@ -0,0 +1,934 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Read-only dataset that can be used from several threads
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_proxy.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+// c++17 or VS2017
+#if defined(HAVE_SHARED_MUTEX) || _MSC_VER >= 1910
+#include <shared_mutex>
+#define CPL_SHARED_MUTEX_TYPE std::shared_mutex
+#define CPL_SHARED_LOCK std::shared_lock<std::shared_mutex>
+#define CPL_EXCLUSIVE_LOCK std::unique_lock<std::shared_mutex>
+#else
+// Poor-man implementation of std::shared_mutex with an exclusive mutex
+#define CPL_SHARED_MUTEX_TYPE std::mutex
+#define CPL_SHARED_LOCK std::lock_guard<std::mutex>
+#define CPL_EXCLUSIVE_LOCK std::lock_guard<std::mutex>
+#endif
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cpl_error.h"
+#include "gdal.h"
+#include "gdal_priv.h"
+
+//! @cond Doxygen_Suppress
+
+/* ******************************************************************** */
+/*                        GDALThreadSafeDataset                         */
+/* ******************************************************************** */
+
+// Read-only dataset that can be used from several threads simultaneously.
+//
+// It wraps a "prototype" dataset, which is used to read pixels by the thread
+// that created this dataset. Each other thread that reads pixels gets its
+// own clone of the prototype (see GDALDataset::Clone()), opened lazily on
+// its first access. The blocks read are stored in the block cache of the
+// bands of this dataset, which is thus shared by all threads, and the
+// metadata is served by the prototype dataset, under a mutex.
+
+class GDALThreadSafeRasterBand;
+
+class GDALThreadSafeDataset final : public GDALProxyDataset
+{
+  public:
+    GDALThreadSafeDataset(GDALDataset *poPrototypeDS, int nScopeFlags);
+    ~GDALThreadSafeDataset() override;
+
+    bool IsThreadSafe(int nScopeFlags) const override;
+
+    char **GetMetadataDomainList() override;
+    char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
+
+    CPLErr FlushCache(bool bAtClosing) override;
+
+    const OGRSpatialReference *GetSpatialRef() const override;
+    CPLErr SetSpatialRef(const OGRSpatialReference *poSRS) override;
+
+    CPLErr GetGeoTransform(double *) override;
+    CPLErr SetGeoTransform(double *) override;
+
+    void *GetInternalHandle(const char *) override;
+    GDALDriver *GetDriver() override;
+    char **GetFileList() override;
+
+    int GetGCPCount() override;
+    const OGRSpatialReference *GetGCPSpatialRef() const override;
+    const GDAL_GCP *GetGCPs() override;
+    CPLErr SetGCPs(int nGCPCount, const GDAL_GCP *pasGCPList,
+                   const OGRSpatialReference *poGCP_SRS) override;
+
+    CPLErr CreateMaskBand(int nFlags) override;
+
+    GDALDataset *RefUnderlyingDataset() const override;
+    void UnrefUnderlyingDataset(GDALDataset *poUnderlyingDS) const override;
+
+  protected:
+    CPLErr IBuildOverviews(const char *, int, const int *, int, const int *,
+                           GDALProgressFunc, void *,
+                           CSLConstList papszOptions) override;
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, int, int *, GSpacing, GSpacing, GSpacing,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
+  private:
+    friend class GDALThreadSafeRasterBand;
+
+    const int m_nScopeFlags;
+
+    // Dataset wrapped, on which we hold a reference.
+    GDALDataset *const m_poPrototypeDS;
+
+    // Thread that reads pixels from m_poPrototypeDS instead of from a clone.
+    const std::thread::id m_nPrototypeThreadId;
+
+    // Serializes the accesses to m_poPrototypeDS and its bands. Recursive,
+    // as the thread of the prototype holds it during its reads of pixels,
+    // during which a progress callback may access the metadata.
+    mutable std::recursive_mutex m_oPrototypeMutex{};
+
+    // Per-thread clones of m_poPrototypeDS, for the threads other than
+    // m_nPrototypeThreadId. An entry of a thread that has terminated may be
+    // reused by a later thread that gets the same id.
+    mutable std::mutex m_oClonesMutex{};
+    mutable std::map<std::thread::id, std::unique_ptr<GDALDataset>>
+        m_oMapThreadIdToClone{};
+
+    CPLErr ReportReadOnly(const char *pszMethod);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeDataset)
+};
+
+/* ******************************************************************** */
+/*                      GDALThreadSafeRasterBand                        */
+/* ******************************************************************** */
+
+class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
+{
+  public:
+    GDALThreadSafeRasterBand(GDALThreadSafeDataset *poTSDS,
+                             GDALRasterBand *poPrototypeBand, int nBandIdx,
+                             int nOvrIdx, bool bIsMask);
+
+    char **GetMetadataDomainList() override;
+    char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
+    CPLErr FlushCache(bool bAtClosing) override;
+    char **GetCategoryNames() override;
+    double GetNoDataValue(int *pbSuccess = nullptr) override;
+    int64_t GetNoDataValueAsInt64(int *pbSuccess = nullptr) override;
+    uint64_t GetNoDataValueAsUInt64(int *pbSuccess = nullptr) override;
+    double GetMinimum(int *pbSuccess = nullptr) override;
+    double GetMaximum(int *pbSuccess = nullptr) override;
+    double GetOffset(int *pbSuccess = nullptr) override;
+    double GetScale(int *pbSuccess = nullptr) override;
+    const char *GetUnitType() override;
+    GDALColorInterp GetColorInterpretation() override;
+    GDALColorTable *GetColorTable() override;
+    CPLErr Fill(double dfRealValue, double dfImaginaryValue = 0) override;
+
+    CPLErr SetCategoryNames(char **) override;
+    CPLErr SetNoDataValue(double) override;
+    CPLErr DeleteNoDataValue() override;
+    CPLErr SetColorTable(GDALColorTable *) override;
+    CPLErr SetColorInterpretation(GDALColorInterp) override;
+    CPLErr SetOffset(double) override;
+    CPLErr SetScale(double) override;
+    CPLErr SetUnitType(const char *) override;
+
+    CPLErr SetStatistics(double dfMin, double dfMax, double dfMean,
+                         double dfStdDev) override;
+
+    int HasArbitraryOverviews() override;
+    int GetOverviewCount() override;
+    GDALRasterBand *GetOverview(int) override;
+    GDALRasterBand *GetRasterSampleOverview(GUIntBig) override;
+    CPLErr BuildOverviews(const char *, int, const int *, GDALProgressFunc,
+                          void *, CSLConstList papszOptions) override;
+
+    CPLErr SetDefaultHistogram(double dfMin, double dfMax, int nBuckets,
+                               GUIntBig *panHistogram) override;
+
+    GDALRasterAttributeTable *GetDefaultRAT() override;
+    CPLErr SetDefaultRAT(const GDALRasterAttributeTable *) override;
+
+    GDALRasterBand *GetMaskBand() override;
+    int GetMaskFlags() override;
+    CPLErr CreateMaskBand(int nFlags) override;
+    bool IsMaskBand() const override;
+    GDALMaskValueRange GetMaskValueRange() const override;
+
+  protected:
+    GDALRasterBand *
+    RefUnderlyingRasterBand(bool bForceOpen = true) const override;
+    void
+    UnrefUnderlyingRasterBand(GDALRasterBand *poUnderlyingBand) const override;
+
+    CPLErr IReadBlock(int, int, void *) override;
+    CPLErr IWriteBlock(int, int, void *) override;
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, GSpacing, GSpacing,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
+  private:
+    GDALThreadSafeDataset *const m_poTSDS;
+    GDALRasterBand *const m_poPrototypeBand;
+
+    // Location of the band in the clones of the prototype dataset: band
+    // number, index of the overview (or -1) and whether this is the mask
+    // band of that band or overview.
+    const int m_nBandIdx;
+    const int m_nOvrIdx;
+    const bool m_bIsMask;
+
+    std::vector<std::unique_ptr<GDALThreadSafeRasterBand>> m_apoOverviews{};
+    std::unique_ptr<GDALRasterBand> m_poMaskBand{};
+
+    // Blocks being read by a thread, that other threads must wait for
+    // instead of reading them again.
+    std::mutex m_oBlockMutex{};
+    std::condition_variable m_oBlockCond{};
+    std::set<std::pair<int, int>> m_oSetBlocksBeingRead{};
+
+    // Held in shared mode by IRasterIO() while it reads or uses blocks, and
+    // in exclusive mode by FlushCache(), so that the block cache of the band
+    // is not freed while blocks are being acquired, read or copied by other
+    // threads.
+    CPL_SHARED_MUTEX_TYPE m_oFlushMutex{};
+
+    GDALRasterBlock *GetSharedLockedBlockRef(int nXBlockOff, int nYBlockOff);
+    CPLErr ReportReadOnly(const char *pszMethod);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeRasterBand)
+};
+
+/************************************************************************/
+/*                       GDALThreadSafeDataset()                        */
+/************************************************************************/
+
+GDALThreadSafeDataset::GDALThreadSafeDataset(GDALDataset *poPrototypeDS,
+                                             int nScopeFlags)
+    : m_nScopeFlags(nScopeFlags), m_poPrototypeDS(poPrototypeDS),
+      m_nPrototypeThreadId(std::this_thread::get_id())
+{
+    m_poPrototypeDS->Reference();
+
+    SetDescription(m_poPrototypeDS->GetDescription());
+    nRasterXSize = m_poPrototypeDS->GetRasterXSize();
+    nRasterYSize = m_poPrototypeDS->GetRasterYSize();
+    eAccess = GA_ReadOnly;
+    for (int i = 1; i <= m_poPrototypeDS->GetRasterCount(); ++i)
+    {
+        SetBand(i, std::make_unique<GDALThreadSafeRasterBand>(
+                       this, m_poPrototypeDS->GetRasterBand(i), i, -1, false));
+    }
+}
+
+/************************************************************************/
+/*                      ~GDALThreadSafeDataset()                        */
+/************************************************************************/
+
+GDALThreadSafeDataset::~GDALThreadSafeDataset()
+{
+    GDALThreadSafeDataset::FlushCache(true);
+    m_oMapThreadIdToClone.clear();
+    m_poPrototypeDS->ReleaseRef();
+}
+
+/************************************************************************/
+/*                        RefUnderlyingDataset()                        */
+/************************************************************************/
+
+// Returns the dataset from which the current thread reads pixels: the
+// prototype dataset, locked until UnrefUnderlyingDataset(), for the thread
+// that created this dataset, and its own clone of it for other threads.
+GDALDataset *GDALThreadSafeDataset::RefUnderlyingDataset() const
+{
+    const auto nThreadId = std::this_thread::get_id();
+    if (nThreadId == m_nPrototypeThreadId)
+    {
+        m_oPrototypeMutex.lock();
+        return m_poPrototypeDS;
+    }
+    {
+        std::lock_guard<std::mutex> oLock(m_oClonesMutex);
+        const auto oIter = m_oMapThreadIdToClone.find(nThreadId);
+        if (oIter != m_oMapThreadIdToClone.end())
+            return oIter->second.get();
+    }
+
+    // Open the clone without holding the lock, so that other threads are
+    // not blocked during the parsing of the headers.
+    auto poClone = m_poPrototypeDS->Clone(m_nScopeFlags);
+    if (!poClone)
+        return nullptr;
+    if (poClone->GetRasterXSize() != nRasterXSize ||
+        poClone->GetRasterYSize() != nRasterYSize ||
+        poClone->GetRasterCount() != nBands)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s: clone of the dataset has not the same dimensions as "
+                 "the dataset",
+                 GetDescription());
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oClonesMutex);
+    auto &poSlot = m_oMapThreadIdToClone[nThreadId];
+    poSlot = std::move(poClone);
+    return poSlot.get();
+}
+
+/************************************************************************/
+/*                       UnrefUnderlyingDataset()                       */
+/************************************************************************/
+
+void GDALThreadSafeDataset::UnrefUnderlyingDataset(
+    GDALDataset *poUnderlyingDS) const
+{
+    if (poUnderlyingDS == m_poPrototypeDS)
+        m_oPrototypeMutex.unlock();
+}
+
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+bool GDALThreadSafeDataset::IsThreadSafe(int nScopeFlags) const
+{
+    return nScopeFlags == m_nScopeFlags;
+}
+
+/************************************************************************/
+/*                           ReportReadOnly()                           */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::ReportReadOnly(const char *pszMethod)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "%s() not supported on a thread-safe dataset", pszMethod);
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                     Methods served by the prototype                  */
+/************************************************************************/
+
+#define TSD_PROTOTYPE_METHOD(retType, methodName, argList, argParams)         \
+    retType GDALThreadSafeDataset::methodName argList                          \
+    {                                                                          \
+        std::lock_guard<std::recursive_mutex> oLock(m_oPrototypeMutex);        \
+        return m_poPrototypeDS->methodName argParams;                          \
+    }
+
+TSD_PROTOTYPE_METHOD(char **, GetMetadataDomainList, (), ())
+TSD_PROTOTYPE_METHOD(char **, GetMetadata, (const char *pszDomain),
+                     (pszDomain))
+TSD_PROTOTYPE_METHOD(const char *, GetMetadataItem,
+                     (const char *pszName, const char *pszDomain),
+                     (pszName, pszDomain))
+TSD_PROTOTYPE_METHOD(const OGRSpatialReference *, GetSpatialRef, () const,
+                     ())
+TSD_PROTOTYPE_METHOD(CPLErr, GetGeoTransform, (double *padfGeoTransform),
+                     (padfGeoTransform))
+TSD_PROTOTYPE_METHOD(GDALDriver *, GetDriver, (), ())
+TSD_PROTOTYPE_METHOD(char **, GetFileList, (), ())
+TSD_PROTOTYPE_METHOD(int, GetGCPCount, (), ())
+TSD_PROTOTYPE_METHOD(const OGRSpatialReference *, GetGCPSpatialRef, () const,
+                     ())
+TSD_PROTOTYPE_METHOD(const GDAL_GCP *, GetGCPs, (), ())
+
+#undef TSD_PROTOTYPE_METHOD
+
+/************************************************************************/
+/*                         Unsupported methods                          */
+/************************************************************************/
+
+#define TSD_READ_ONLY_METHOD(methodName, argList)                              \
+    CPLErr GDALThreadSafeDataset::methodName argList                           \
+    {                                                                          \
+        return ReportReadOnly(#methodName);                                    \
+    }
+
+TSD_READ_ONLY_METHOD(SetMetadata, (char **, const char *))
+TSD_READ_ONLY_METHOD(SetMetadataItem, (const char *, const char *,
+                                       const char *))
+TSD_READ_ONLY_METHOD(SetSpatialRef, (const OGRSpatialReference *))
+TSD_READ_ONLY_METHOD(SetGeoTransform, (double *))
+TSD_READ_ONLY_METHOD(SetGCPs, (int, const GDAL_GCP *,
+                               const OGRSpatialReference *))
+TSD_READ_ONLY_METHOD(CreateMaskBand, (int))
+TSD_READ_ONLY_METHOD(IBuildOverviews,
+                     (const char *, int, const int *, int, const int *,
+                      GDALProgressFunc, void *, CSLConstList))
+
+#undef TSD_READ_ONLY_METHOD
+
+/************************************************************************/
+/*                          GetInternalHandle()                         */
+/************************************************************************/
+
+void *GDALThreadSafeDataset::GetInternalHandle(const char *)
+{
+    // The handles of the underlying datasets are bound to a thread.
+    return nullptr;
+}
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::FlushCache(bool bAtClosing)
+{
+    // Only the blocks of our bands need to be flushed: the clones are
+    // read-only.
+    return GDALDataset::FlushCache(bAtClosing);
+}
+
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, int *panBandMap, GSpacing nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+        return ReportReadOnly("IRasterIO");
+
+    // Go through the bands, so that their shared block cache is used.
+    return BandBasedRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                             nBufXSize, nBufYSize, eBufType, nBandCount,
+                             panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+                             psExtraArg);
+}
+
+/************************************************************************/
+/*                      GDALThreadSafeRasterBand()                      */
+/************************************************************************/
+
+GDALThreadSafeRasterBand::GDALThreadSafeRasterBand(
+    GDALThreadSafeDataset *poTSDS, GDALRasterBand *poPrototypeBand,
+    int nBandIdx, int nOvrIdx, bool bIsMask)
+    : m_poTSDS(poTSDS), m_poPrototypeBand(poPrototypeBand),
+      m_nBandIdx(nBandIdx), m_nOvrIdx(nOvrIdx), m_bIsMask(bIsMask)
+{
+    // Overviews and mask bands are not attached to the dataset, as for
+    // the bands of most drivers.
+    if (nOvrIdx < 0 && !bIsMask)
+    {
+        poDS = poTSDS;
+        nBand = nBandIdx;
+    }
+    SetDescription(poPrototypeBand->GetDescription());
+    nRasterXSize = poPrototypeBand->GetXSize();
+    nRasterYSize = poPrototypeBand->GetYSize();
+    eDataType = poPrototypeBand->GetRasterDataType();
+    eAccess = GA_ReadOnly;
+    poPrototypeBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+
+    if (bIsMask)
+    {
+        m_poMaskBand = std::make_unique<GDALAllValidMaskBand>(this);
+        return;
+    }
+
+    if (nOvrIdx < 0)
+    {
+        const int nOvrCount = poPrototypeBand->GetOverviewCount();
+        for (int i = 0; i < nOvrCount; ++i)
+        {
+            GDALRasterBand *poOvrBand = poPrototypeBand->GetOverview(i);
+            if (poOvrBand == nullptr)
+                break;
+            m_apoOverviews.push_back(std::make_unique<GDALThreadSafeRasterBand>(
+                poTSDS, poOvrBand, nBandIdx, i, false));
+        }
+    }
+
+    GDALRasterBand *poMaskBand = poPrototypeBand->GetMaskBand();
+    if (poMaskBand)
+    {
+        m_poMaskBand = std::make_unique<GDALThreadSafeRasterBand>(
+            poTSDS, poMaskBand, nBandIdx, nOvrIdx, true);
+    }
+}
+
+/************************************************************************/
+/*                      RefUnderlyingRasterBand()                       */
+/************************************************************************/
+
+// Returns the band that corresponds to this band in the dataset from which
+// the current thread reads pixels (see
+// GDALThreadSafeDataset::RefUnderlyingDataset()).
+GDALRasterBand *
+GDALThreadSafeRasterBand::RefUnderlyingRasterBand(bool /*bForceOpen*/) const
+{
+    GDALDataset *poUnderlyingDS = m_poTSDS->RefUnderlyingDataset();
+    if (poUnderlyingDS == nullptr)
+        return nullptr;
+    if (poUnderlyingDS == m_poTSDS->m_poPrototypeDS)
+        return m_poPrototypeBand;
+    GDALRasterBand *poBand = poUnderlyingDS->GetRasterBand(m_nBandIdx);
+    if (poBand && m_nOvrIdx >= 0)
+        poBand = poBand->GetOverview(m_nOvrIdx);
+    if (poBand && m_bIsMask)
+        poBand = poBand->GetMaskBand();
+    if (poBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot find band in clone of %s", m_poTSDS->GetDescription());
+    }
+    return poBand;
+}
+
+/************************************************************************/
+/*                     UnrefUnderlyingRasterBand()                      */
+/************************************************************************/
+
+void GDALThreadSafeRasterBand::UnrefUnderlyingRasterBand(
+    GDALRasterBand *poUnderlyingBand) const
+{
+    if (poUnderlyingBand == m_poPrototypeBand)
+        m_poTSDS->UnrefUnderlyingDataset(m_poTSDS->m_poPrototypeDS);
+}
+
+/************************************************************************/
+/*                           ReportReadOnly()                           */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::ReportReadOnly(const char *pszMethod)
+{
+    ReportError(CE_Failure, CPLE_NotSupported,
+                "%s() not supported on a thread-safe dataset", pszMethod);
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                     Methods served by the prototype                  */
+/************************************************************************/
+
+#define TSRB_PROTOTYPE_METHOD(retType, methodName, argList, argParams)        \
+    retType GDALThreadSafeRasterBand::methodName argList                       \
+    {                                                                          \
+        std::lock_guard<std::recursive_mutex> oLock(                           \
+            m_poTSDS->m_oPrototypeMutex);                                      \
+        return m_poPrototypeBand->methodName argParams;                        \
+    }
+
+TSRB_PROTOTYPE_METHOD(char **, GetMetadataDomainList, (), ())
+TSRB_PROTOTYPE_METHOD(char **, GetMetadata, (const char *pszDomain),
+                      (pszDomain))
+TSRB_PROTOTYPE_METHOD(const char *, GetMetadataItem,
+                      (const char *pszName, const char *pszDomain),
+                      (pszName, pszDomain))
+TSRB_PROTOTYPE_METHOD(char **, GetCategoryNames, (), ())
+TSRB_PROTOTYPE_METHOD(double, GetNoDataValue, (int *pbSuccess), (pbSuccess))
+TSRB_PROTOTYPE_METHOD(int64_t, GetNoDataValueAsInt64, (int *pbSuccess),
+                      (pbSuccess))
+TSRB_PROTOTYPE_METHOD(uint64_t, GetNoDataValueAsUInt64, (int *pbSuccess),
+                      (pbSuccess))
+TSRB_PROTOTYPE_METHOD(double, GetMinimum, (int *pbSuccess), (pbSuccess))
+TSRB_PROTOTYPE_METHOD(double, GetMaximum, (int *pbSuccess), (pbSuccess))
+TSRB_PROTOTYPE_METHOD(double, GetOffset, (int *pbSuccess), (pbSuccess))
+TSRB_PROTOTYPE_METHOD(double, GetScale, (int *pbSuccess), (pbSuccess))
+TSRB_PROTOTYPE_METHOD(const char *, GetUnitType, (), ())
+TSRB_PROTOTYPE_METHOD(GDALColorInterp, GetColorInterpretation, (), ())
+TSRB_PROTOTYPE_METHOD(GDALColorTable *, GetColorTable, (), ())
+TSRB_PROTOTYPE_METHOD(int, HasArbitraryOverviews, (), ())
+TSRB_PROTOTYPE_METHOD(GDALRasterAttributeTable *, GetDefaultRAT, (), ())
+TSRB_PROTOTYPE_METHOD(bool, IsMaskBand, () const, ())
+TSRB_PROTOTYPE_METHOD(GDALMaskValueRange, GetMaskValueRange, () const, ())
+
+#undef TSRB_PROTOTYPE_METHOD
+
+/************************************************************************/
+/*                         Unsupported methods                          */
+/************************************************************************/
+
+#define TSRB_READ_ONLY_METHOD(methodName, argList)                             \
+    CPLErr GDALThreadSafeRasterBand::methodName argList                        \
+    {                                                                          \
+        return ReportReadOnly(#methodName);                                    \
+    }
+
+TSRB_READ_ONLY_METHOD(SetMetadata, (char **, const char *))
+TSRB_READ_ONLY_METHOD(SetMetadataItem, (const char *, const char *,
+                                        const char *))
+TSRB_READ_ONLY_METHOD(Fill, (double, double))
+TSRB_READ_ONLY_METHOD(SetCategoryNames, (char **))
+TSRB_READ_ONLY_METHOD(SetNoDataValue, (double))
+TSRB_READ_ONLY_METHOD(DeleteNoDataValue, ())
+TSRB_READ_ONLY_METHOD(SetColorTable, (GDALColorTable *))
+TSRB_READ_ONLY_METHOD(SetColorInterpretation, (GDALColorInterp))
+TSRB_READ_ONLY_METHOD(SetOffset, (double))
+TSRB_READ_ONLY_METHOD(SetScale, (double))
+TSRB_READ_ONLY_METHOD(SetUnitType, (const char *))
+TSRB_READ_ONLY_METHOD(SetStatistics, (double, double, double, double))
+TSRB_READ_ONLY_METHOD(BuildOverviews, (const char *, int, const int *,
+                                       GDALProgressFunc, void *,
+                                       CSLConstList))
+TSRB_READ_ONLY_METHOD(SetDefaultHistogram, (double, double, int, GUIntBig *))
+TSRB_READ_ONLY_METHOD(SetDefaultRAT, (const GDALRasterAttributeTable *))
+TSRB_READ_ONLY_METHOD(CreateMaskBand, (int))
+TSRB_READ_ONLY_METHOD(IWriteBlock, (int, int, void *))
+
+#undef TSRB_READ_ONLY_METHOD
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::FlushCache(bool bAtClosing)
+{
+    // Wait for the readers of blocks of other threads, which also means that
+    // no block is being read, and prevent new ones until the flush is done.
+    CPL_EXCLUSIVE_LOCK oFlushLock(m_oFlushMutex);
+    return GDALRasterBand::FlushCache(bAtClosing);
+}
+
+/************************************************************************/
+/*                       Overviews and mask band                        */
+/************************************************************************/
+
+int GDALThreadSafeRasterBand::GetOverviewCount()
+{
+    return static_cast<int>(m_apoOverviews.size());
+}
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetOverview(int nIdx)
+{
+    if (nIdx < 0 || nIdx >= static_cast<int>(m_apoOverviews.size()))
+        return nullptr;
+    return m_apoOverviews[nIdx].get();
+}
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetRasterSampleOverview(GUIntBig nDesiredSamples)
+{
+    // Use the generic implementation, that selects among our overviews,
+    // and not the one of the underlying band, that would return one of its
+    // own overviews.
+    return GDALRasterBand::GetRasterSampleOverview(nDesiredSamples);
+}
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetMaskBand()
+{
+    return m_poMaskBand.get();
+}
+
+int GDALThreadSafeRasterBand::GetMaskFlags()
+{
+    if (m_bIsMask)
+        return GMF_ALL_VALID;
+    std::lock_guard<std::recursive_mutex> oLock(m_poTSDS->m_oPrototypeMutex);
+    return m_poPrototypeBand->GetMaskFlags();
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IReadBlock(int nXBlockOff, int nYBlockOff,
+                                            void *pImage)
+{
+    GDALRasterBand *poSrcBand = RefUnderlyingRasterBand();
+    if (poSrcBand == nullptr)
+        return CE_Failure;
+    const CPLErr eErr = poSrcBand->ReadBlock(nXBlockOff, nYBlockOff, pImage);
+    UnrefUnderlyingRasterBand(poSrcBand);
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GetSharedLockedBlockRef()                      */
+/************************************************************************/
+
+// Equivalent of GetLockedBlockRef() that can be called from several threads
+// simultaneously. The block is read from the clone of the current thread,
+// without holding any lock, and is then visible to all threads.
+GDALRasterBlock *
+GDALThreadSafeRasterBand::GetSharedLockedBlockRef(int nXBlockOff,
+                                                  int nYBlockOff)
+{
+    const std::pair<int, int> oKey(nXBlockOff, nYBlockOff);
+    std::unique_lock<std::mutex> oLock(m_oBlockMutex);
+    m_oBlockCond.wait(oLock, [this, &oKey]
+                      { return m_oSetBlocksBeingRead.count(oKey) == 0; });
+    GDALRasterBlock *poBlock = TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+    if (poBlock)
+        return poBlock;
+
+    poBlock = GetLockedBlockRef(nXBlockOff, nYBlockOff,
+                                /* bJustInitialize = */ TRUE);
+    if (poBlock == nullptr)
+        return nullptr;
+    m_oSetBlocksBeingRead.insert(oKey);
+    oLock.unlock();
+
+    const CPLErr eErr =
+        IReadBlock(nXBlockOff, nYBlockOff, poBlock->GetDataRef());
+
+    oLock.lock();
+    m_oSetBlocksBeingRead.erase(oKey);
+    if (eErr != CE_None)
+    {
+        poBlock->DropLock();
+        FlushBlock(nXBlockOff, nYBlockOff, /* bWriteDirtyBlock = */ FALSE);
+        poBlock = nullptr;
+    }
+    oLock.unlock();
+    m_oBlockCond.notify_all();
+    return poBlock;
+}
+
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+        return ReportReadOnly("IRasterIO");
+
+    // Requests with resampling are served by the clone of the current
+    // thread, that may use its overviews.
+    if (nXSize != nBufXSize || nYSize != nBufYSize)
+    {
+        return GDALProxyRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+    }
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nYBlockStart = nYOff / nBlockYSize;
+    const int nYBlockEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    const int nXBlockStart = nXOff / nBlockXSize;
+    const int nXBlockEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    for (int iYBlock = nYBlockStart; iYBlock <= nYBlockEnd; ++iYBlock)
+    {
+        const int nYStart = std::max(nYOff, iYBlock * nBlockYSize);
+        const int nYEnd = std::min(nYOff + nYSize, (iYBlock + 1) * nBlockYSize);
+        {
+            // Released before the progress callback, which may flush the
+            // cache.
+            CPL_SHARED_LOCK oFlushLock(m_oFlushMutex);
+            for (int iXBlock = nXBlockStart; iXBlock <= nXBlockEnd; ++iXBlock)
+            {
+                GDALRasterBlock *poBlock =
+                    GetSharedLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                    return CE_Failure;
+
+                const int nXStart = std::max(nXOff, iXBlock * nBlockXSize);
+                const int nXEnd =
+                    std::min(nXOff + nXSize, (iXBlock + 1) * nBlockXSize);
+                const GByte *pabyBlock =
+                    static_cast<const GByte *>(poBlock->GetDataRef());
+                for (int iY = nYStart; iY < nYEnd; ++iY)
+                {
+                    const size_t nSrcOffset =
+                        (static_cast<size_t>(iY - iYBlock * nBlockYSize) *
+                             nBlockXSize +
+                         (nXStart - iXBlock * nBlockXSize)) *
+                        nDTSize;
+                    GDALCopyWords64(pabyBlock + nSrcOffset, eDataType, nDTSize,
+                                    static_cast<GByte *>(pData) +
+                                        (iY - nYOff) * nLineSpace +
+                                        (nXStart - nXOff) * nPixelSpace,
+                                    eBufType, static_cast<int>(nPixelSpace),
+                                    nXEnd - nXStart);
+                }
+                poBlock->DropLock();
+            }
+        }
+
+        if (psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress(1.0 * (nYEnd - nYOff) / nYSize, "",
+                                     psExtraArg->pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                      GDALGetThreadSafeDataset()                      */
+/************************************************************************/
+
+/** Return a dataset that can be used simultaneously from several threads,
+ * for read-only access.
+ *
+ * If poDS->IsThreadSafe(nScopeFlags) is true, a new reference on poDS is
+ * returned. Otherwise, poDS must be a read-only dataset for which
+ * poDS->CanBeCloned(nScopeFlags) is true, which is the case of datasets
+ * opened with GDALOpenEx() (without GDAL_OF_UPDATE). A new dataset is then
+ * returned, that gives to each thread that reads pixels its own instance of
+ * the dataset (see GDALDataset::Clone()), opened lazily, except the calling
+ * thread, which reads pixels from poDS. The blocks read by all threads are
+ * stored in a single block cache, and the metadata, spatial reference system,
+ * geotransform, etc. are those of poDS, accessed under a mutex. Resampled
+ * RasterIO() requests and statistics computations are served by the instance
+ * of the calling thread. FlushCache() can be called from any thread, and waits
+ * for the reads of blocks in progress in the other threads. Write operations
+ * fail.
+ *
+ * The returned dataset holds a reference on poDS, which must not be modified
+ * nor used directly while the returned dataset is alive. The caller must
+ * release its own reference on poDS and the returned dataset, for example
+ * with GDALClose().
+ *
+ * The GDAL_OF_THREAD_SAFE flag of GDALOpenEx() can also be used to directly
+ * get such a dataset.
+ *
+ * This is the same as the C function GDALGetThreadSafeDataset().
+ *
+ * @param poDS Dataset to make thread-safe.
+ * @param nScopeFlags Must be GDAL_OF_RASTER.
+ * @return a new thread-safe dataset, or nullptr in case of error.
+ * @since GDAL 3.10
+ */
+GDALDataset *GDALGetThreadSafeDataset(GDALDataset *poDS, int nScopeFlags)
+{
+    if (nScopeFlags != GDAL_OF_RASTER)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALGetThreadSafeDataset(): only GDAL_OF_RASTER is "
+                 "supported as nScopeFlags");
+        return nullptr;
+    }
+    if (poDS->IsThreadSafe(nScopeFlags))
+    {
+        poDS->Reference();
+        return poDS;
+    }
+    if (poDS->GetAccess() != GA_ReadOnly)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALGetThreadSafeDataset(): %s is not opened in read-only "
+                 "mode",
+                 poDS->GetDescription());
+        return nullptr;
+    }
+    if (!poDS->CanBeCloned(nScopeFlags))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALGetThreadSafeDataset(): %s cannot be cloned. Only "
+                 "datasets opened with GDALOpenEx() are supported",
+                 poDS->GetDescription());
+        return nullptr;
+    }
+
+    return new GDALThreadSafeDataset(poDS, nScopeFlags);
+}
+
+/************************************************************************/
+/*                      GDALGetThreadSafeDataset()                      */
+/************************************************************************/
+
+/** Return a dataset that can be used simultaneously from several threads,
+ * for read-only access.
+ *
+ * This is the same as the C++ function GDALGetThreadSafeDataset(), that
+ * must be referred to for the details.
+ *
+ * @param hDS Dataset to make thread-safe.
+ * @param nScopeFlags Must be GDAL_OF_RASTER.
+ * @param papszOptions Options. None currently.
+ * @return a new thread-safe dataset, to be closed with GDALClose(), or NULL
+ * in case of error.
+ * @since GDAL 3.10
+ */
+GDALDatasetH GDALGetThreadSafeDataset(GDALDatasetH hDS, int nScopeFlags,
+                                      CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, __func__, nullptr);
+    CPL_IGNORE_RET_VAL(papszOptions);
+    return GDALDataset::ToHandle(
+        GDALGetThreadSafeDataset(GDALDataset::FromHandle(hDS), nScopeFlags));
+}
+
+/************************************************************************/
+/*                       GDALDatasetIsThreadSafe()                      */
+/************************************************************************/
+
+/** Return whether a dataset, and its related objects (typically raster
+ * bands), can be called for the intended scope from several threads
+ * simultaneously.
+ *
+ * This is the same as the C++ method GDALDataset::IsThreadSafe().
+ *
+ * @param hDS Dataset.
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Currently only GDAL_OF_RASTER is supported.
+ * @param papszOptions Options. None currently.
+ * @since GDAL 3.10
+ */
+bool GDALDatasetIsThreadSafe(GDALDatasetH hDS, int nScopeFlags,
+                             CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, __func__, false);
+    CPL_IGNORE_RET_VAL(papszOptions);
+    return GDALDataset::FromHandle(hDS)->IsThreadSafe(nScopeFlags);
+}
@@ -42,16 +42,21 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
@@ -227,6 +232,23 @@ CPLErr GDALRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return CE_Failure;
     }
 
+    /* ==================================================================== */
+    /*      Read the blocks concurrently if the driver allows it.           */
+    /* ==================================================================== */
+    if (eRWFlag == GF_Read && poDS != nullptr &&
+        poDS->m_bCanReadBlocksConcurrently && nBand >= 1 &&
+        poDS->GetRasterBand(nBand) == this)
+    {
+        int nBandNumber = nBand;
+        int bTried = FALSE;
+        const CPLErr eErr = poDS->TryMultiThreadedBlockRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, 1, &nBandNumber, nPixelSpace, nLineSpace, 0, psExtraArg,
+            /* bBlockBased = */ false, &bTried);
+        if (bTried)
+            return eErr;
+    }
+
     const int nBandDataSize = GDALGetDataTypeSizeBytes(eDataType);
     const int nBufDataSize = GDALGetDataTypeSizeBytes(eBufType);
     GByte dummyBlock[2] = {0, 0};
@@ -3261,6 +3283,10 @@ void CPL_STDCALL GDALCopyWords(const void *CPL_RESTRICT pSrcData,
                     nDstPixelStride, nWordCount);
 }
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include "rasterio_avx2.h"
+#endif
+
 /************************************************************************/
 /*                          GDALCopyWords64()                           */
 /************************************************************************/
@@ -3418,6 +3444,20 @@ void CPL_STDCALL GDALCopyWords64(const void *CPL_RESTRICT pSrcData,
         }
     }
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    // Use the AVX2 kernels for conversions between packed buffers, when the
+    // CPU supports them.
+    if (eSrcType != eDstType && nWordCount >= 32 &&
+        nSrcPixelStride == nSrcDataTypeSize &&
+        nDstPixelStride == nDstDataTypeSize && CPLHaveRuntimeAVX2() &&
+        GDALCopyWordsPacked_AVX2(pSrcData, eSrcType, pDstData, eDstType,
+                                 static_cast<size_t>(nWordCount)))
+    {
+        return;
+    }
+#endif
+
     // Handle the more general case -- deals with conversion of data types
     // directly.
     switch (eSrcType)
@@ -3905,6 +3945,295 @@ static int GDALDatasetGetBestOverviewLevel(GDALDataset *poDS, int &nXOff,
                                          psExtraArg);
 }
 
+/************************************************************************/
+/*                     GDALBlockReadJob::Process()                      */
+/************************************************************************/
+
+namespace
+{
+// Block allocated in the block cache by TryMultiThreadedBlockRasterIO()
+struct GDALBlockToRead
+{
+    GDALRasterBand *poBand = nullptr;
+    GDALRasterBlock *poBlock = nullptr;
+    int nXBlockOff = 0;
+    int nYBlockOff = 0;
+};
+
+// Read of consecutive blocks by TryMultiThreadedBlockRasterIO()
+struct GDALBlockReadJob
+{
+    const GDALBlockToRead *pasBlocks = nullptr;
+    size_t nBlocks = 0;
+    CPLErr eErr = CE_None;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+
+    static void Process(void *pData);
+};
+
+void GDALBlockReadJob::Process(void *pData)
+{
+    auto psJob = static_cast<GDALBlockReadJob *>(pData);
+    // Errors are re-emitted from the calling thread.
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    for (size_t i = 0; psJob->eErr == CE_None && i < psJob->nBlocks; ++i)
+    {
+        const GDALBlockToRead &sBlock = psJob->pasBlocks[i];
+        psJob->eErr = sBlock.poBand->ReadBlock(sBlock.nXBlockOff,
+                                               sBlock.nYBlockOff,
+                                               sBlock.poBlock->GetDataRef());
+    }
+    CPLUninstallErrorHandlerAccumulator();
+}
+}  // namespace
+
+/************************************************************************/
+/*                    TryMultiThreadedBlockRasterIO()                   */
+/*                                                                      */
+/*      For datasets whose driver has set m_bCanReadBlocksConcurrently, */
+/*      split a read request at full resolution in strips of blocks.    */
+/*      The blocks of each strip that are not in the block cache are    */
+/*      first read concurrently on the global thread pool, for all      */
+/*      bands, and the strip is then served from the block cache by     */
+/*      BlockBasedRasterIO() or BandBasedRasterIO().                    */
+/*                                                                      */
+/*      *pbTried is set to FALSE when the request is not eligible, in   */
+/*      which case the caller must go on with its usual processing.     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+CPLErr GDALDataset::TryMultiThreadedBlockRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, int *panBandMap, GSpacing nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg, bool bBlockBased,
+    int *pbTried)
+{
+    *pbTried = FALSE;
+    if (!m_bCanReadBlocksConcurrently || m_bInMultiThreadedBlockRasterIO ||
+        eRWFlag != GF_Read || eAccess != GA_ReadOnly || nXSize != nBufXSize ||
+        nYSize != nBufYSize ||
+        (psExtraArg->bFloatingPointWindowValidity &&
+         (nXOff != psExtraArg->dfXOff || nYOff != psExtraArg->dfYOff ||
+          nXSize != psExtraArg->dfXSize || nYSize != psExtraArg->dfYSize)))
+    {
+        return CE_None;
+    }
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                     : atoi(pszThreads));
+    if (nThreads <= 1)
+        return CE_None;
+
+    // All bands must be full resolution bands of this dataset with the same
+    // block size.
+    std::vector<GDALRasterBand *> apoBands;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GIntBig nBytesPerBlockRow = 0;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        GDALRasterBand *poBand = GetRasterBand(panBandMap[i]);
+        if (poBand == nullptr || poBand->poDS != this)
+            return CE_None;
+        int nThisBlockXSize = 0;
+        int nThisBlockYSize = 0;
+        poBand->GetBlockSize(&nThisBlockXSize, &nThisBlockYSize);
+        if (i == 0)
+        {
+            nBlockXSize = nThisBlockXSize;
+            nBlockYSize = nThisBlockYSize;
+            if (nBlockXSize <= 0 || nBlockYSize <= 0)
+                return CE_None;
+        }
+        else if (nThisBlockXSize != nBlockXSize ||
+                 nThisBlockYSize != nBlockYSize)
+        {
+            return CE_None;
+        }
+        nBytesPerBlockRow +=
+            static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+            GDALGetDataTypeSizeBytes(poBand->GetRasterDataType());
+        apoBands.push_back(poBand);
+    }
+
+    const int nXBlockStart = nXOff / nBlockXSize;
+    const int nXBlockEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nYBlockStart = nYOff / nBlockYSize;
+    const int nYBlockEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    if (static_cast<GIntBig>(nXBlockEnd - nXBlockStart + 1) *
+            (nYBlockEnd - nYBlockStart + 1) * nBandCount <
+        2)
+    {
+        return CE_None;
+    }
+
+    // The blocks read concurrently must remain in the block cache until the
+    // strip has been served, so limit a strip to a fraction of its size.
+    nBytesPerBlockRow *= nXBlockEnd - nXBlockStart + 1;
+    const GIntBig nMaxStripBytes = GDALGetCacheMax64() / 4;
+    if (nBytesPerBlockRow > nMaxStripBytes)
+        return CE_None;
+    const int nBlockRowsPerStrip = static_cast<int>(std::min<GIntBig>(
+        nYBlockEnd - nYBlockStart + 1, nMaxStripBytes / nBytesPerBlockRow));
+
+    // If the thread pool cannot be created, blocks are read by the calling
+    // thread.
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (auto poThreadPool = GDALGetGlobalThreadPool(nThreads))
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    *pbTried = TRUE;
+    m_bInMultiThreadedBlockRasterIO = true;
+
+    GDALProgressFunc pfnProgressGlobal = psExtraArg->pfnProgress;
+    void *pProgressDataGlobal = psExtraArg->pProgressData;
+    GDALRasterIOExtraArg sExtraArg;
+    GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+    sExtraArg.bFloatingPointWindowValidity = FALSE;
+
+    CPLErr eErr = CE_None;
+    std::vector<GDALBlockToRead> asBlocks;
+    std::vector<GDALBlockReadJob> asJobs;
+    for (int iYBlock = nYBlockStart; eErr == CE_None && iYBlock <= nYBlockEnd;
+         iYBlock += nBlockRowsPerStrip)
+    {
+        const int nYBlockLast =
+            std::min(nYBlockEnd, iYBlock + nBlockRowsPerStrip - 1);
+
+        // Allocate in the block cache all the blocks to read, before
+        // starting any read, so that the allocation of a block cannot evict
+        // a block being read.
+        asBlocks.clear();
+        for (GDALRasterBand *poBand : apoBands)
+        {
+            for (int iY = iYBlock; eErr == CE_None && iY <= nYBlockLast; ++iY)
+            {
+                for (int iX = nXBlockStart; iX <= nXBlockEnd; ++iX)
+                {
+                    GDALRasterBlock *poBlock =
+                        poBand->TryGetLockedBlockRef(iX, iY);
+                    if (poBlock)
+                    {
+                        poBlock->DropLock();
+                        continue;
+                    }
+                    poBlock = poBand->GetLockedBlockRef(
+                        iX, iY, /* bJustInitialize = */ TRUE);
+                    if (poBlock == nullptr)
+                    {
+                        eErr = CE_Failure;
+                        break;
+                    }
+                    GDALBlockToRead sBlock;
+                    sBlock.poBand = poBand;
+                    sBlock.poBlock = poBlock;
+                    sBlock.nXBlockOff = iX;
+                    sBlock.nYBlockOff = iY;
+                    asBlocks.push_back(sBlock);
+                }
+            }
+        }
+
+        // Each job reads consecutive blocks, that is typically several rows
+        // of blocks of a band, to limit the scheduling overhead for small
+        // blocks, while keeping a few jobs per thread to balance the load.
+        asJobs.clear();
+        if (eErr == CE_None && !asBlocks.empty())
+        {
+            const size_t nBlocksPerJob = DIV_ROUND_UP(
+                asBlocks.size(), static_cast<size_t>(nThreads) * 4);
+            for (size_t i = 0; i < asBlocks.size(); i += nBlocksPerJob)
+            {
+                GDALBlockReadJob sJob;
+                sJob.pasBlocks = asBlocks.data() + i;
+                sJob.nBlocks = std::min(nBlocksPerJob, asBlocks.size() - i);
+                asJobs.push_back(std::move(sJob));
+            }
+            for (auto &sJob : asJobs)
+            {
+                if (!poJobQueue || asJobs.size() == 1 ||
+                    !poJobQueue->SubmitJob(GDALBlockReadJob::Process, &sJob))
+                {
+                    GDALBlockReadJob::Process(&sJob);
+                }
+            }
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
+        }
+
+        for (const auto &sJob : asJobs)
+        {
+            for (const auto &oError : sJob.aoErrors)
+            {
+                ReportError(oError.type, oError.no, "%s", oError.msg.c_str());
+            }
+            if (sJob.eErr != CE_None)
+                eErr = CE_Failure;
+        }
+
+        // Blocks that could not be read must not remain in the cache.
+        for (const auto &sBlock : asBlocks)
+        {
+            sBlock.poBlock->DropLock();
+            if (eErr != CE_None)
+            {
+                sBlock.poBand->FlushBlock(sBlock.nXBlockOff, sBlock.nYBlockOff,
+                                          /* bWriteDirtyBlock = */ FALSE);
+            }
+        }
+        if (eErr != CE_None)
+            break;
+
+        // Serve the strip from the block cache.
+        const int nStripYOff = std::max(nYOff, iYBlock * nBlockYSize);
+        const int nStripYEnd =
+            std::min(nYOff + nYSize, (nYBlockLast + 1) * nBlockYSize);
+        const int nStripYSize = nStripYEnd - nStripYOff;
+        const bool bScaledProgress =
+            pfnProgressGlobal != nullptr && nStripYSize < nYSize;
+        if (bScaledProgress)
+        {
+            sExtraArg.pfnProgress = GDALScaledProgress;
+            sExtraArg.pProgressData = GDALCreateScaledProgress(
+                1.0 * (nStripYOff - nYOff) / nYSize,
+                1.0 * (nStripYEnd - nYOff) / nYSize, pfnProgressGlobal,
+                pProgressDataGlobal);
+            if (sExtraArg.pProgressData == nullptr)
+                sExtraArg.pfnProgress = nullptr;
+        }
+        GByte *pabyStripData = static_cast<GByte *>(pData) +
+                               (nStripYOff - nYOff) * nLineSpace;
+        if (bBlockBased)
+        {
+            eErr = BlockBasedRasterIO(
+                eRWFlag, nXOff, nStripYOff, nXSize, nStripYSize, pabyStripData,
+                nBufXSize, nStripYSize, eBufType, nBandCount, panBandMap,
+                nPixelSpace, nLineSpace, nBandSpace, &sExtraArg);
+        }
+        else
+        {
+            eErr = BandBasedRasterIO(
+                eRWFlag, nXOff, nStripYOff, nXSize, nStripYSize, pabyStripData,
+                nBufXSize, nStripYSize, eBufType, nBandCount, panBandMap,
+                nPixelSpace, nLineSpace, nBandSpace, &sExtraArg);
+        }
+        if (bScaledProgress)
+        {
+            GDALDestroyScaledProgress(sExtraArg.pProgressData);
+            sExtraArg.pfnProgress = pfnProgressGlobal;
+            sExtraArg.pProgressData = pProgressDataGlobal;
+        }
+    }
+
+    m_bInMultiThreadedBlockRasterIO = false;
+    return eErr;
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                         BlockBasedRasterIO()                         */
 /*                                                                      */
@@ -4001,6 +4330,20 @@ CPLErr GDALDataset::BlockBasedRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Read the blocks concurrently if the driver allows it.           */
+    /* -------------------------------------------------------------------- */
+    if (m_bCanReadBlocksConcurrently)
+    {
+        int bTried = FALSE;
+        eErr = TryMultiThreadedBlockRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace,
+            nBandSpace, psExtraArg, /* bBlockBased = */ true, &bTried);
+        if (bTried)
+            return eErr;
+    }
+
     /* ==================================================================== */
     /*      In this special case at full resolution we step through in      */
     /*      blocks, turning the request over to the per-band                */
@@ -0,0 +1,626 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <cfloat>
+#include <cstring>
+
+#include <immintrin.h>
+
+// This file is compiled with AVX2 code generation enabled, and its functions
+// are only called after a runtime check of the CPU capabilities. Hence it
+// must not include headers, like gdal_priv_templates.hpp or C++ standard
+// library ones, defining inline functions or templates that could be
+// instantiated here with AVX2 instructions, and then selected by the linker
+// for callers running on CPUs lacking them.
+
+namespace
+{
+
+/************************************************************************/
+/*                          Helper functions                            */
+/************************************************************************/
+
+inline __m128i LoadLow32(const void *p)
+{
+    int n;
+    memcpy(&n, p, sizeof(n));
+    return _mm_cvtsi32_si128(n);
+}
+
+inline __m128i LoadLow64(const void *p)
+{
+    return _mm_loadl_epi64(static_cast<const __m128i *>(p));
+}
+
+inline __m128i Load128(const void *p)
+{
+    return _mm_loadu_si128(static_cast<const __m128i *>(p));
+}
+
+inline __m256i Load256(const void *p)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+
+inline void Store128(void *p, __m128i xmm)
+{
+    _mm_storeu_si128(static_cast<__m128i *>(p), xmm);
+}
+
+inline void Store256(void *p, __m256i ymm)
+{
+    _mm256_storeu_si256(static_cast<__m256i *>(p), ymm);
+}
+
+// Converts 8 float values to int32, with the same rounding and clamping as
+// GDALCopyWord() for a destination of unsigned type whose maximum value is
+// ymm_max. NaN is converted to 0.
+inline __m256i RoundClampUnsigned(__m256 ymm, __m256 ymm_max)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    ymm = _mm256_add_ps(ymm, _mm256_set1_ps(0.5f));
+    // _mm256_max_ps() returns its second operand if one of them is NaN
+    ymm = _mm256_min_ps(_mm256_max_ps(ymm, zero), ymm_max);
+    return _mm256_cvttps_epi32(ymm);
+}
+
+// Same as above for a destination of type Int16
+inline __m256i RoundClampInt16(__m256 ymm)
+{
+    // Set NaN to 0
+    ymm = _mm256_and_ps(ymm, _mm256_cmp_ps(ymm, ymm, _CMP_ORD_Q));
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 m0d5 = _mm256_set1_ps(-0.5f);
+    // f >= 0 ? f + 0.5f : f - 0.5f
+    ymm = _mm256_add_ps(
+        ymm, _mm256_blendv_ps(m0d5, p0d5, _mm256_cmp_ps(
+                                              ymm, _mm256_setzero_ps(),
+                                              _CMP_GE_OQ)));
+    ymm = _mm256_min_ps(_mm256_max_ps(ymm, _mm256_set1_ps(-32768.0f)),
+                        _mm256_set1_ps(32767.0f));
+    return _mm256_cvttps_epi32(ymm);
+}
+
+// Converts 4 double values to int32, with the same rounding and clamping as
+// GDALCopyWord() for a destination of unsigned type whose maximum value is
+// ymm_max. NaN is converted to 0.
+inline __m128i RoundClampUnsigned(__m256d ymm, __m256d ymm_max)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    ymm = _mm256_add_pd(ymm, _mm256_set1_pd(0.5));
+    // _mm256_max_pd() returns its second operand if one of them is NaN
+    ymm = _mm256_min_pd(_mm256_max_pd(ymm, zero), ymm_max);
+    return _mm256_cvttpd_epi32(ymm);
+}
+
+// Same as above for a destination of type Int16
+inline __m128i RoundClampInt16(__m256d ymm)
+{
+    // Set NaN to 0
+    ymm = _mm256_and_pd(ymm, _mm256_cmp_pd(ymm, ymm, _CMP_ORD_Q));
+    const __m256d p0d5 = _mm256_set1_pd(0.5);
+    const __m256d m0d5 = _mm256_set1_pd(-0.5);
+    // d > 0 ? d + 0.5 : d - 0.5
+    ymm = _mm256_add_pd(
+        ymm, _mm256_blendv_pd(m0d5, p0d5, _mm256_cmp_pd(
+                                              ymm, _mm256_setzero_pd(),
+                                              _CMP_GT_OQ)));
+    ymm = _mm256_min_pd(_mm256_max_pd(ymm, _mm256_set1_pd(-32768.0)),
+                        _mm256_set1_pd(32767.0));
+    return _mm256_cvttpd_epi32(ymm);
+}
+
+// Reorders the result of a 256-bit pack operation, whose 128-bit lanes
+// interleave the values coming from its two operands.
+inline __m256i FixPackOrder(__m256i ymm)
+{
+    return _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+}
+
+/************************************************************************/
+/*                              Kernels                                 */
+/************************************************************************/
+
+// Each kernel converts N consecutive values.
+
+// Widening conversions
+
+struct ByteToUInt16
+{
+    static constexpr size_t N = 16;
+
+    template <class Tout> static inline void f(const GByte *pSrc, Tout *pDst)
+    {
+        Store256(pDst, _mm256_cvtepu8_epi16(Load128(pSrc)));
+    }
+};
+
+struct ByteToUInt32
+{
+    static constexpr size_t N = 16;
+
+    template <class Tout> static inline void f(const GByte *pSrc, Tout *pDst)
+    {
+        Store256(pDst, _mm256_cvtepu8_epi32(LoadLow64(pSrc)));
+        Store256(pDst + 8, _mm256_cvtepu8_epi32(LoadLow64(pSrc + 8)));
+    }
+};
+
+struct ByteToFloat32
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const GByte *pSrc, float *pDst)
+    {
+        _mm256_storeu_ps(pDst, _mm256_cvtepi32_ps(
+                                   _mm256_cvtepu8_epi32(LoadLow64(pSrc))));
+        _mm256_storeu_ps(pDst + 8, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(
+                                       LoadLow64(pSrc + 8))));
+    }
+};
+
+struct ByteToFloat64
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const GByte *pSrc, double *pDst)
+    {
+        for (size_t i = 0; i < N; i += 4)
+        {
+            _mm256_storeu_pd(pDst + i, _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(
+                                           LoadLow32(pSrc + i))));
+        }
+    }
+};
+
+template <bool bSigned> struct Int16ToInt32
+{
+    static constexpr size_t N = 16;
+
+    static inline __m256i Widen(__m128i xmm)
+    {
+        return bSigned ? _mm256_cvtepi16_epi32(xmm)
+                       : _mm256_cvtepu16_epi32(xmm);
+    }
+
+    template <class Tin, class Tout>
+    static inline void f(const Tin *pSrc, Tout *pDst)
+    {
+        Store256(pDst, Widen(Load128(pSrc)));
+        Store256(pDst + 8, Widen(Load128(pSrc + 8)));
+    }
+};
+
+template <bool bSigned> struct Int16ToFloat32
+{
+    static constexpr size_t N = 16;
+
+    template <class Tin> static inline void f(const Tin *pSrc, float *pDst)
+    {
+        _mm256_storeu_ps(pDst, _mm256_cvtepi32_ps(Int16ToInt32<bSigned>::Widen(
+                                   Load128(pSrc))));
+        _mm256_storeu_ps(pDst + 8,
+                         _mm256_cvtepi32_ps(Int16ToInt32<bSigned>::Widen(
+                             Load128(pSrc + 8))));
+    }
+};
+
+template <bool bSigned> struct Int16ToFloat64
+{
+    static constexpr size_t N = 16;
+
+    static inline __m128i Widen(__m128i xmm)
+    {
+        return bSigned ? _mm_cvtepi16_epi32(xmm) : _mm_cvtepu16_epi32(xmm);
+    }
+
+    template <class Tin> static inline void f(const Tin *pSrc, double *pDst)
+    {
+        for (size_t i = 0; i < N; i += 4)
+        {
+            _mm256_storeu_pd(pDst + i, _mm256_cvtepi32_pd(
+                                           Widen(LoadLow64(pSrc + i))));
+        }
+    }
+};
+
+struct Int32ToFloat32
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const GInt32 *pSrc, float *pDst)
+    {
+        _mm256_storeu_ps(pDst, _mm256_cvtepi32_ps(Load256(pSrc)));
+        _mm256_storeu_ps(pDst + 8, _mm256_cvtepi32_ps(Load256(pSrc + 8)));
+    }
+};
+
+struct Int32ToFloat64
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const GInt32 *pSrc, double *pDst)
+    {
+        for (size_t i = 0; i < N; i += 4)
+        {
+            _mm256_storeu_pd(pDst + i,
+                             _mm256_cvtepi32_pd(Load128(pSrc + i)));
+        }
+    }
+};
+
+struct Float32ToFloat64
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const float *pSrc, double *pDst)
+    {
+        for (size_t i = 0; i < N; i += 4)
+        {
+            _mm256_storeu_pd(pDst + i, _mm256_cvtps_pd(_mm_loadu_ps(pSrc + i)));
+        }
+    }
+};
+
+// Narrowing conversions
+
+struct Float32ToByte
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const float *pSrc, GByte *pDst)
+    {
+        const __m256 ymm_max = _mm256_set1_ps(255.0f);
+        const __m256i ymm0 =
+            RoundClampUnsigned(_mm256_loadu_ps(pSrc), ymm_max);
+        const __m256i ymm1 =
+            RoundClampUnsigned(_mm256_loadu_ps(pSrc + 8), ymm_max);
+        const __m256i ymm = FixPackOrder(_mm256_packus_epi32(ymm0, ymm1));
+        Store128(pDst, _mm_packus_epi16(_mm256_castsi256_si128(ymm),
+                                        _mm256_extracti128_si256(ymm, 1)));
+    }
+};
+
+struct Float32ToUInt16
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const float *pSrc, GUInt16 *pDst)
+    {
+        const __m256 ymm_max = _mm256_set1_ps(65535.0f);
+        const __m256i ymm0 =
+            RoundClampUnsigned(_mm256_loadu_ps(pSrc), ymm_max);
+        const __m256i ymm1 =
+            RoundClampUnsigned(_mm256_loadu_ps(pSrc + 8), ymm_max);
+        Store256(pDst, FixPackOrder(_mm256_packus_epi32(ymm0, ymm1)));
+    }
+};
+
+struct Float32ToInt16
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const float *pSrc, GInt16 *pDst)
+    {
+        const __m256i ymm0 = RoundClampInt16(_mm256_loadu_ps(pSrc));
+        const __m256i ymm1 = RoundClampInt16(_mm256_loadu_ps(pSrc + 8));
+        Store256(pDst, FixPackOrder(_mm256_packs_epi32(ymm0, ymm1)));
+    }
+};
+
+struct Float64ToByte
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const double *pSrc, GByte *pDst)
+    {
+        const __m256d ymm_max = _mm256_set1_pd(255.0);
+        const __m128i xmm0 =
+            RoundClampUnsigned(_mm256_loadu_pd(pSrc), ymm_max);
+        const __m128i xmm1 =
+            RoundClampUnsigned(_mm256_loadu_pd(pSrc + 4), ymm_max);
+        const __m128i xmm2 =
+            RoundClampUnsigned(_mm256_loadu_pd(pSrc + 8), ymm_max);
+        const __m128i xmm3 =
+            RoundClampUnsigned(_mm256_loadu_pd(pSrc + 12), ymm_max);
+        Store128(pDst, _mm_packus_epi16(_mm_packus_epi32(xmm0, xmm1),
+                                        _mm_packus_epi32(xmm2, xmm3)));
+    }
+};
+
+struct Float64ToUInt16
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const double *pSrc, GUInt16 *pDst)
+    {
+        const __m256d ymm_max = _mm256_set1_pd(65535.0);
+        for (size_t i = 0; i < N; i += 8)
+        {
+            const __m128i xmm0 =
+                RoundClampUnsigned(_mm256_loadu_pd(pSrc + i), ymm_max);
+            const __m128i xmm1 =
+                RoundClampUnsigned(_mm256_loadu_pd(pSrc + i + 4), ymm_max);
+            Store128(pDst + i, _mm_packus_epi32(xmm0, xmm1));
+        }
+    }
+};
+
+struct Float64ToInt16
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const double *pSrc, GInt16 *pDst)
+    {
+        for (size_t i = 0; i < N; i += 8)
+        {
+            const __m128i xmm0 = RoundClampInt16(_mm256_loadu_pd(pSrc + i));
+            const __m128i xmm1 =
+                RoundClampInt16(_mm256_loadu_pd(pSrc + i + 4));
+            Store128(pDst + i, _mm_packs_epi32(xmm0, xmm1));
+        }
+    }
+};
+
+struct Float64ToFloat32
+{
+    static constexpr size_t N = 16;
+
+    static inline void f(const double *pSrc, float *pDst)
+    {
+        // Values out of the float range are converted to infinity, like
+        // GDALCopyWord() does, instead of being rounded to +/- FLT_MAX
+        const __m256d ymm_max = _mm256_set1_pd(FLT_MAX);
+        const __m256d ymm_min = _mm256_set1_pd(-FLT_MAX);
+        const __m256d ymm_inf =
+            _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FF0000000000000LL));
+        const __m256d ymm_minf = _mm256_sub_pd(_mm256_setzero_pd(), ymm_inf);
+        for (size_t i = 0; i < N; i += 4)
+        {
+            __m256d ymm = _mm256_loadu_pd(pSrc + i);
+            ymm = _mm256_blendv_pd(ymm, ymm_inf,
+                                   _mm256_cmp_pd(ymm, ymm_max, _CMP_GT_OQ));
+            ymm = _mm256_blendv_pd(ymm, ymm_minf,
+                                   _mm256_cmp_pd(ymm, ymm_min, _CMP_LT_OQ));
+            _mm_storeu_ps(pDst + i, _mm256_cvtpd_ps(ymm));
+        }
+    }
+};
+
+struct Int16ToByte
+{
+    static constexpr size_t N = 32;
+
+    static inline void f(const GInt16 *pSrc, GByte *pDst)
+    {
+        Store256(pDst, FixPackOrder(_mm256_packus_epi16(
+                           Load256(pSrc), Load256(pSrc + 16))));
+    }
+};
+
+struct UInt16ToByte
+{
+    static constexpr size_t N = 32;
+
+    static inline void f(const GUInt16 *pSrc, GByte *pDst)
+    {
+        const __m256i ymm_max = _mm256_set1_epi16(255);
+        const __m256i ymm0 = _mm256_min_epu16(Load256(pSrc), ymm_max);
+        const __m256i ymm1 = _mm256_min_epu16(Load256(pSrc + 16), ymm_max);
+        Store256(pDst, FixPackOrder(_mm256_packus_epi16(ymm0, ymm1)));
+    }
+};
+
+struct Int16ToUInt16
+{
+    static constexpr size_t N = 32;
+
+    static inline void f(const GInt16 *pSrc, GUInt16 *pDst)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        Store256(pDst, _mm256_max_epi16(Load256(pSrc), zero));
+        Store256(pDst + 16, _mm256_max_epi16(Load256(pSrc + 16), zero));
+    }
+};
+
+struct UInt16ToInt16
+{
+    static constexpr size_t N = 32;
+
+    static inline void f(const GUInt16 *pSrc, GInt16 *pDst)
+    {
+        const __m256i ymm_max = _mm256_set1_epi16(32767);
+        Store256(pDst, _mm256_min_epu16(Load256(pSrc), ymm_max));
+        Store256(pDst + 16, _mm256_min_epu16(Load256(pSrc + 16), ymm_max));
+    }
+};
+
+/************************************************************************/
+/*                            RunKernel()                               */
+/************************************************************************/
+
+// Runs Kernel on all values. The trailing values, if any, are processed by
+// running the kernel once more on a zero-padded temporary buffer, so that
+// they get exactly the same conversion as the other ones.
+template <class Kernel, class Tin, class Tout>
+void RunKernel(const void *pSrcData, void *pDstData, size_t nWordCount)
+{
+    constexpr size_t N = Kernel::N;
+    const Tin *CPL_RESTRICT pSrc = static_cast<const Tin *>(pSrcData);
+    Tout *CPL_RESTRICT pDst = static_cast<Tout *>(pDstData);
+    size_t i = 0;
+    for (; i + N <= nWordCount; i += N)
+    {
+        Kernel::f(pSrc + i, pDst + i);
+    }
+    if (i < nWordCount)
+    {
+        Tin aSrc[N];
+        Tout aDst[N];
+        memset(aSrc, 0, sizeof(aSrc));
+        memcpy(aSrc, pSrc + i, (nWordCount - i) * sizeof(Tin));
+        Kernel::f(aSrc, aDst);
+        memcpy(pDst + i, aDst, (nWordCount - i) * sizeof(Tout));
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALCopyWordsPacked_AVX2()                      */
+/************************************************************************/
+
+bool GDALCopyWordsPacked_AVX2(const void *CPL_RESTRICT pSrcData,
+                              GDALDataType eSrcType,
+                              void *CPL_RESTRICT pDstData,
+                              GDALDataType eDstType, size_t nWordCount)
+{
+#define RUN(Kernel, Tin, Tout)                                                 \
+    RunKernel<Kernel, Tin, Tout>(pSrcData, pDstData, nWordCount);              \
+    return true
+
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            switch (eDstType)
+            {
+                case GDT_UInt16:
+                    RUN(ByteToUInt16, GByte, GUInt16);
+                case GDT_Int16:
+                    RUN(ByteToUInt16, GByte, GInt16);
+                case GDT_UInt32:
+                    RUN(ByteToUInt32, GByte, GUInt32);
+                case GDT_Int32:
+                    RUN(ByteToUInt32, GByte, GInt32);
+                case GDT_Float32:
+                    RUN(ByteToFloat32, GByte, float);
+                case GDT_Float64:
+                    RUN(ByteToFloat64, GByte, double);
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_UInt16:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    RUN(UInt16ToByte, GUInt16, GByte);
+                case GDT_Int16:
+                    RUN(UInt16ToInt16, GUInt16, GInt16);
+                case GDT_UInt32:
+                    RUN(Int16ToInt32<false>, GUInt16, GUInt32);
+                case GDT_Int32:
+                    RUN(Int16ToInt32<false>, GUInt16, GInt32);
+                case GDT_Float32:
+                    RUN(Int16ToFloat32<false>, GUInt16, float);
+                case GDT_Float64:
+                    RUN(Int16ToFloat64<false>, GUInt16, double);
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Int16:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    RUN(Int16ToByte, GInt16, GByte);
+                case GDT_UInt16:
+                    RUN(Int16ToUInt16, GInt16, GUInt16);
+                case GDT_Int32:
+                    RUN(Int16ToInt32<true>, GInt16, GInt32);
+                case GDT_Float32:
+                    RUN(Int16ToFloat32<true>, GInt16, float);
+                case GDT_Float64:
+                    RUN(Int16ToFloat64<true>, GInt16, double);
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Int32:
+            switch (eDstType)
+            {
+                case GDT_Float32:
+                    RUN(Int32ToFloat32, GInt32, float);
+                case GDT_Float64:
+                    RUN(Int32ToFloat64, GInt32, double);
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Float32:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    RUN(Float32ToByte, float, GByte);
+                case GDT_UInt16:
+                    RUN(Float32ToUInt16, float, GUInt16);
+                case GDT_Int16:
+                    RUN(Float32ToInt16, float, GInt16);
+                case GDT_Float64:
+                    RUN(Float32ToFloat64, float, double);
+                default:
+                    break;
+            }
+            break;
+
+        case GDT_Float64:
+            switch (eDstType)
+            {
+                case GDT_Byte:
+                    RUN(Float64ToByte, double, GByte);
+                case GDT_UInt16:
+                    RUN(Float64ToUInt16, double, GUInt16);
+                case GDT_Int16:
+                    RUN(Float64ToInt16, double, GInt16);
+                case GDT_Float32:
+                    RUN(Float64ToFloat32, double, float);
+                default:
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
+#undef RUN
+
+    return false;
+}
+
+#endif
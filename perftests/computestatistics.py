@@ -5,41 +5,39 @@ import timeit
 
 from osgeo import gdal
 
+data_types = (
+    "Byte",
+    "UInt16",
+    "Int16",
+    "UInt32",
+    "Int32",
+    "Float32",
+    "Float64",
+)
+
 tab_ds = {}
-for dt in (
-    gdal.GDT_Byte,
-    gdal.GDT_UInt16,
-    gdal.GDT_Int16,
-    gdal.GDT_Float32,
-    gdal.GDT_Float64,
-):
-    tab_ds[dt] = gdal.GetDriverByName("MEM").Create("", 10000, 1000, 1, dt)
-    tab_ds[dt].GetRasterBand(1).Fill(1)
+for dt in data_types:
+    for variant in ("", "Nodata", "Mask"):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", 10000, 1000, 1, gdal.GetDataTypeByName(dt)
+        )
+        ds.GetRasterBand(1).Fill(1)
+        if variant == "Nodata":
+            ds.GetRasterBand(1).SetNoDataValue(0)
+        elif variant == "Mask":
+            ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+            ds.GetRasterBand(1).GetMaskBand().Fill(255)
+        tab_ds[dt + variant] = ds
 
 
-def test(dt):
-    tab_ds[dt].GetRasterBand(1).ComputeStatistics(False)
+def test(key):
+    tab_ds[key].GetRasterBand(1).ComputeStatistics(False)
 
 
 NITERS = 500
-setup = "from osgeo import gdal; from __main__ import test"
-print(
-    "testByte(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Byte)", setup=setup, number=NITERS)
-)
-print(
-    "testUInt16(): %.3f"
-    % timeit.timeit("test(gdal.GDT_UInt16)", setup=setup, number=NITERS)
-)
-print(
-    "testInt16(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Int16)", setup=setup, number=NITERS)
-)
-print(
-    "testFloat32(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Float32)", setup=setup, number=NITERS)
-)
-print(
-    "testFloat64(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Float64)", setup=setup, number=NITERS)
-)
+setup = "from __main__ import test"
+for key in tab_ds:
+    print(
+        "test%s(): %.3f"
+        % (key, timeit.timeit("test('%s')" % key, setup=setup, number=NITERS))
+    )
@@ -0,0 +1,43 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2024 GDAL contributors
+
+import timeit
+
+from osgeo import gdal
+
+data_types = (
+    "Byte",
+    "UInt16",
+    "Int16",
+    "UInt32",
+    "Int32",
+    "Float32",
+    "Float64",
+)
+
+tab_ds = {}
+for dt in data_types:
+    for variant in ("", "Nodata", "Mask"):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", 10000, 1000, 1, gdal.GetDataTypeByName(dt)
+        )
+        ds.GetRasterBand(1).Fill(1)
+        if variant == "Nodata":
+            ds.GetRasterBand(1).SetNoDataValue(0)
+        elif variant == "Mask":
+            ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+            ds.GetRasterBand(1).GetMaskBand().Fill(255)
+        tab_ds[dt + variant] = ds
+
+
+def test(key):
+    tab_ds[key].GetRasterBand(1).GetHistogram(-0.5, 255.5, 256, False, False)
+
+
+NITERS = 500
+setup = "from __main__ import test"
+for key in tab_ds:
+    print(
+        "test%s(): %.3f"
+        % (key, timeit.timeit("test('%s')" % key, setup=setup, number=NITERS))
+    )
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of the global raster block cache, with random
+ *           reads done from several threads.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Typical use:
+//   testperfblockcache -threads 32
+//   testperfblockcache -threads 32 --config GDAL_RB_CACHE_PARTITIONS ALL_CPUS
+
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "gdal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfblockcache [-threads X] [-iters X] [-size X] "
+           "[-blocksize X] [-window X]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nThreads = CPLGetNumCPUs();
+    int nIters = 1000 * 1000;
+    int nSize = 4096;
+    int nBlockSize = 64;
+    int nWindow = 16;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-blocksize") && i + 1 < argc)
+            nBlockSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-window") && i + 1 < argc)
+            nWindow = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    if (nThreads <= 0 || nIters <= 0 || nSize <= 0 || nBlockSize <= 0 ||
+        nWindow <= 0 || nWindow > nSize)
+        Usage();
+
+    GDALAllRegister();
+
+    // Each thread uses its own dataset handle, and all of them must fit into
+    // the block cache, so that we only measure the cost of cache management.
+    const GIntBig nCacheNeeded = static_cast<GIntBig>(nSize) * nSize * 2 *
+                                 static_cast<GIntBig>(nThreads);
+    if (GDALGetCacheMax64() < nCacheNeeded)
+        GDALSetCacheMax64(nCacheNeeded);
+
+    const char *pszFilename = "/vsimem/testperfblockcache.tif";
+    {
+        GDALDriverH hDrv = GDALGetDriverByName("GTiff");
+        if (hDrv == nullptr)
+        {
+            fprintf(stderr, "GTiff driver not available\n");
+            exit(1);
+        }
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", nBlockSize));
+        aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", nBlockSize));
+        GDALDatasetH hDS = GDALCreate(hDrv, pszFilename, nSize, nSize, 1,
+                                      GDT_Byte, aosOptions.List());
+        GDALFillRaster(GDALGetRasterBand(hDS, 1), 1, 0);
+        GDALClose(hDS);
+    }
+
+    std::vector<GDALDatasetH> ahDS;
+    for (int i = 0; i < nThreads; ++i)
+    {
+        ahDS.push_back(GDALOpen(pszFilename, GA_ReadOnly));
+        // Warm up the cache
+        std::vector<GByte> abyBuffer(static_cast<size_t>(nSize) * nSize);
+        CPL_IGNORE_RET_VAL(GDALRasterIO(GDALGetRasterBand(ahDS.back(), 1),
+                                        GF_Read, 0, 0, nSize, nSize,
+                                        abyBuffer.data(), nSize, nSize,
+                                        GDT_Byte, 0, 0));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < nThreads; ++i)
+    {
+        aoThreads.emplace_back(
+            [i, nIters, nSize, nWindow, &ahDS]()
+            {
+                GDALRasterBandH hBand = GDALGetRasterBand(ahDS[i], 1);
+                std::vector<GByte> abyBuffer(static_cast<size_t>(nWindow) *
+                                             nWindow);
+                unsigned nSeed = static_cast<unsigned>(i) + 1;
+                for (int iIter = 0; iIter < nIters; ++iIter)
+                {
+                    nSeed = nSeed * 1103515245U + 12345U;
+                    const int nXOff =
+                        static_cast<int>((nSeed >> 8) % (nSize - nWindow + 1));
+                    nSeed = nSeed * 1103515245U + 12345U;
+                    const int nYOff =
+                        static_cast<int>((nSeed >> 8) % (nSize - nWindow + 1));
+                    CPL_IGNORE_RET_VAL(GDALRasterIO(
+                        hBand, GF_Read, nXOff, nYOff, nWindow, nWindow,
+                        abyBuffer.data(), nWindow, nWindow, GDT_Byte, 0, 0));
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    printf("GDAL_RB_CACHE_PARTITIONS=%s, %d threads, %d reads/thread of "
+           "%dx%d pixels: %.2f s, %.0f reads/s\n",
+           CPLGetConfigOption("GDAL_RB_CACHE_PARTITIONS", "1"), nThreads,
+           nIters, nWindow, nWindow, dfElapsed,
+           static_cast<double>(nIters) * nThreads / dfElapsed);
+
+    for (auto hDS : ahDS)
+        GDALClose(hDS);
+    VSIUnlink(pszFilename);
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+
+    return 0;
+}
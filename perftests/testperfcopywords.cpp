@@ -44,38 +44,51 @@ int main(int /* argc */, char * /* argv */[])
 
     clock_t start, end;
 
+    // Table of timings per pair of data types, for a 16-byte stride and for
+    // packed buffers. GDAL_USE_AVX2 is only honored in DEBUG builds, where the
+    // timing for packed buffers with the AVX2 kernels disabled is added.
+#ifdef DEBUG
+    constexpr int N_TIMINGS = 3;
+    printf("%-10s -> %-10s | %10s | %10s | %10s\n", "in", "out",
+           "stride 16", "packed", "no AVX2");
+#else
+    constexpr int N_TIMINGS = 2;
+    printf("%-10s -> %-10s | %10s | %10s\n", "in", "out", "stride 16",
+           "packed");
+#endif
     for (intype = GDT_Byte; intype < GDT_TypeCount; intype++)
     {
         for (outtype = GDT_Byte; outtype < GDT_TypeCount; outtype++)
         {
-            start = clock();
-
-            for (i = 0; i < 1000; i++)
-                GDALCopyWords(in, (GDALDataType)intype, 16, out,
-                              (GDALDataType)outtype, 16, 256 * 256);
-
-            end = clock();
-
-            printf("%s -> %s : %.2f s\n",
-                   GDALGetDataTypeName((GDALDataType)intype),
-                   GDALGetDataTypeName((GDALDataType)outtype),
-                   (end - start) * 1.0 / CLOCKS_PER_SEC);
-
-            start = clock();
-
-            for (i = 0; i < 1000; i++)
-                GDALCopyWords(in, (GDALDataType)intype,
-                              GDALGetDataTypeSize((GDALDataType)intype) / 8,
-                              out, (GDALDataType)outtype,
-                              GDALGetDataTypeSize((GDALDataType)outtype) / 8,
-                              256 * 256);
-
-            end = clock();
-
-            printf("%s -> %s (packed) : %.2f s\n",
-                   GDALGetDataTypeName((GDALDataType)intype),
-                   GDALGetDataTypeName((GDALDataType)outtype),
-                   (end - start) * 1.0 / CLOCKS_PER_SEC);
+            const int nInSize = GDALGetDataTypeSizeBytes((GDALDataType)intype);
+            const int nOutSize =
+                GDALGetDataTypeSizeBytes((GDALDataType)outtype);
+            double adfTimes[N_TIMINGS];
+
+            for (int k = 0; k < N_TIMINGS; k++)
+            {
+                if (k == 2)
+                    CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+
+                start = clock();
+
+                for (i = 0; i < 1000; i++)
+                    GDALCopyWords(in, (GDALDataType)intype,
+                                  k == 0 ? 16 : nInSize, out,
+                                  (GDALDataType)outtype,
+                                  k == 0 ? 16 : nOutSize, 256 * 256);
+
+                end = clock();
+
+                adfTimes[k] = (end - start) * 1.0 / CLOCKS_PER_SEC;
+            }
+            CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+
+            printf("%-10s -> %-10s", GDALGetDataTypeName((GDALDataType)intype),
+                   GDALGetDataTypeName((GDALDataType)outtype));
+            for (int k = 0; k < N_TIMINGS; k++)
+                printf(" | %8.2f s", adfTimes[k]);
+            printf("\n");
         }
     }
 
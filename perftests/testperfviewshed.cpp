@@ -0,0 +1,147 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Algorithms
+ * Purpose:  Test performance of cumulative viewshed generation, in observers
+ *           per second.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Typical use:
+//   testperfviewshed -threads 1
+//   testperfviewshed -threads 8 -observers 1000 -md 1000
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+#include "viewshed.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfviewshed [-threads X] [-size X] [-observers X] "
+           "[-md X]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nThreads = CPLGetNumCPUs();
+    int nSize = 2048;
+    int nObservers = 100;
+    double dfMaxDistance = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-observers") && i + 1 < argc)
+            nObservers = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-md") && i + 1 < argc)
+            dfMaxDistance = CPLAtof(argv[++i]);
+        else
+            Usage();
+    }
+    if (nThreads <= 0 || nSize <= 0 || nObservers <= 0 || dfMaxDistance < 0)
+        Usage();
+
+    GDALAllRegister();
+
+    // Synthetic DEM, with 10 m pixels
+    auto poMEMDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDrv == nullptr)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        exit(1);
+    }
+    std::unique_ptr<GDALDataset> poDEM(
+        poMEMDrv->Create("", nSize, nSize, 1, GDT_Float32, nullptr));
+    double adfGeoTransform[] = {0, 10, 0, 10.0 * nSize, 0, -10};
+    poDEM->SetGeoTransform(adfGeoTransform);
+    {
+        std::vector<float> afLine(nSize);
+        for (int iLine = 0; iLine < nSize; ++iLine)
+        {
+            for (int i = 0; i < nSize; ++i)
+            {
+                afLine[i] = static_cast<float>(
+                    500 * std::sin(i * 0.01) * std::cos(iLine * 0.013) +
+                    30 * std::sin(i * 0.17 + iLine * 0.11));
+            }
+            CPL_IGNORE_RET_VAL(poDEM->GetRasterBand(1)->RasterIO(
+                GF_Write, 0, iLine, nSize, 1, afLine.data(), nSize, 1,
+                GDT_Float32, 0, 0, nullptr));
+        }
+    }
+
+    std::vector<gdal::Viewshed::Point> aoObservers;
+    unsigned nSeed = 1;
+    for (int i = 0; i < nObservers; ++i)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        const double dfX = 10.0 * ((nSeed >> 8) % nSize) + 5;
+        nSeed = nSeed * 1103515245U + 12345U;
+        const double dfY = 10.0 * ((nSeed >> 8) % nSize) + 5;
+        aoObservers.push_back({dfX, dfY, 2.0});
+    }
+
+    gdal::Viewshed::Options oOpts;
+    oOpts.outputFormat = "MEM";
+    oOpts.maxDistance = dfMaxDistance;
+    oOpts.numThreads = nThreads;
+
+    const auto start = std::chrono::steady_clock::now();
+    gdal::Viewshed oViewshed(oOpts);
+    if (!oViewshed.runCumulative(
+            GDALRasterBand::ToHandle(poDEM->GetRasterBand(1)), aoObservers,
+            nullptr))
+    {
+        exit(1);
+    }
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    printf("%d threads, %d observers on a %dx%d DEM, max distance %.0f: "
+           "%.2f s, %.1f observers/s\n",
+           nThreads, nObservers, nSize, nSize, dfMaxDistance, dfElapsed,
+           nObservers / dfElapsed);
+
+    oViewshed.output().reset();
+    poDEM.reset();
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of the /vsimem/ file system, with files
+ *           created, written, read and deleted from several threads.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// Typical use:
+//   testperfvsimem -threads 32
+//   testperfvsimem -threads 32 -scratch
+
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfvsimem [-threads X] [-iters X] [-size X] "
+           "[-scratch]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nThreads = CPLGetNumCPUs();
+    int nIters = 100 * 1000;
+    int nSize = 4096;
+    bool bScratch = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-scratch"))
+            bScratch = true;
+        else
+            Usage();
+    }
+    if (nThreads <= 0 || nIters <= 0 || nSize <= 0)
+        Usage();
+
+    // Some long-lived files, so that lookups do not happen in an empty
+    // namespace.
+    for (int i = 0; i < 1000; ++i)
+    {
+        VSILFILE *fp =
+            VSIFOpenL(CPLSPrintf("/vsimem/testperfvsimem/static_%d", i), "wb");
+        if (fp)
+            VSIFCloseL(fp);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    std::vector<int> anErrors(nThreads);
+    for (int i = 0; i < nThreads; ++i)
+    {
+        aoThreads.emplace_back(
+            [i, nIters, nSize, bScratch, &anErrors]()
+            {
+                std::vector<GByte> abyBuffer(nSize, static_cast<GByte>(i));
+                for (int iIter = 0; iIter < nIters; ++iIter)
+                {
+                    const std::string osFilename(CPLSPrintf(
+                        "/vsimem/testperfvsimem/thread_%d_%d", i, iIter));
+                    VSILFILE *fp = bScratch
+                                       ? VSIMemCreateScratchFile()
+                                       : VSIFOpenL(osFilename.c_str(), "wb+");
+                    if (fp == nullptr ||
+                        VSIFWriteL(abyBuffer.data(), 1, nSize, fp) !=
+                            static_cast<size_t>(nSize) ||
+                        VSIFSeekL(fp, 0, SEEK_SET) != 0 ||
+                        VSIFReadL(abyBuffer.data(), 1, nSize, fp) !=
+                            static_cast<size_t>(nSize))
+                    {
+                        anErrors[i]++;
+                    }
+                    if (fp)
+                        VSIFCloseL(fp);
+                    if (!bScratch)
+                    {
+                        VSIStatBufL sStat;
+                        if (VSIStatL(osFilename.c_str(), &sStat) != 0 ||
+                            VSIUnlink(osFilename.c_str()) != 0)
+                        {
+                            anErrors[i]++;
+                        }
+                    }
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const double dfElapsed = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+    int nErrors = 0;
+    for (int nThreadErrors : anErrors)
+        nErrors += nThreadErrors;
+
+    printf("%s, %d threads, %d files/thread of %d bytes: %.2f s, "
+           "%.0f files/s, %d errors\n",
+           bScratch ? "scratch files" : "named files", nThreads, nIters, nSize,
+           dfElapsed, static_cast<double>(nIters) * nThreads / dfElapsed,
+           nErrors);
+
+    VSIRmdirRecursive("/vsimem/testperfvsimem");
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+
+    return nErrors == 0 ? 0 : 1;
+}
@@ -1910,6 +1910,60 @@ static int CPLHTTPCurlDebugFunction(CURL *handle, curl_infotype type,
     return 0;
 }
 
+/************************************************************************/
+/*                   CPLHTTPIsConnectionPoolEnabled()                   */
+/************************************************************************/
+
+bool CPLHTTPIsConnectionPoolEnabled()
+{
+    return CPLTestBool(CPLGetConfigOption("GDAL_HTTP_CONNECTION_POOL", "NO"));
+}
+
+/************************************************************************/
+/*                       CPLHTTPGetShareHandle()                        */
+/************************************************************************/
+
+// Process-wide share handle through which TLS sessions and DNS entries are
+// shared between all easy handles, whatever the thread they are used from.
+// Connections themselves are not shared this way (libcurl does not support
+// sharing them between threads), but through the connection pool of
+// cpl_vsil_curl.cpp.
+static CURLSH *ghShareHandle = nullptr;
+static std::mutex goShareHandleMutex;
+static std::array<std::mutex, CURL_LOCK_DATA_LAST> gaoShareLockMutexes;
+
+static void CPLHTTPShareLock(CURL *, curl_lock_data data, curl_lock_access,
+                             void *)
+{
+    gaoShareLockMutexes[data].lock();
+}
+
+static void CPLHTTPShareUnlock(CURL *, curl_lock_data data, void *)
+{
+    gaoShareLockMutexes[data].unlock();
+}
+
+static CURLSH *CPLHTTPGetShareHandle()
+{
+    std::lock_guard<std::mutex> oLock(goShareHandleMutex);
+    if (ghShareHandle == nullptr)
+    {
+        ghShareHandle = curl_share_init();
+        if (ghShareHandle)
+        {
+            curl_share_setopt(ghShareHandle, CURLSHOPT_LOCKFUNC,
+                              CPLHTTPShareLock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_UNLOCKFUNC,
+                              CPLHTTPShareUnlock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_DNS);
+        }
+    }
+    return ghShareHandle;
+}
+
 /************************************************************************/
 /*                         CPLHTTPSetOptions()                          */
 /************************************************************************/
@@ -1930,6 +1984,15 @@ void *CPLHTTPSetOptions(void *pcurl, const char *pszURL,
 
     unchecked_curl_easy_setopt(http_handle, CURLOPT_URL, pszURL);
 
+    const bool bConnectionPool = CPLHTTPIsConnectionPoolEnabled();
+    if (bConnectionPool)
+    {
+        CURLSH *hShareHandle = CPLHTTPGetShareHandle();
+        if (hShareHandle)
+            unchecked_curl_easy_setopt(http_handle, CURLOPT_SHARE,
+                                       hShareHandle);
+    }
+
     if (CPLTestBool(CPLGetConfigOption("CPL_CURL_VERBOSE", "NO")))
     {
         unchecked_curl_easy_setopt(http_handle, CURLOPT_VERBOSE, 1);
@@ -1968,8 +2031,10 @@ void *CPLHTTPSetOptions(void *pcurl, const char *pszURL,
             // Only enable this mode if explicitly required, or if the
             // machine is a GCE instance. On other networks, requesting a
             // file in HTTP/2 is found to be significantly slower than HTTP/1.1
-            // for unknown reasons.
-            if (pszHttpVersion != nullptr || CPLIsMachineForSureGCEInstance())
+            // for unknown reasons. The connection pool is pointless without
+            // HTTP/2 multiplexing, so it also enables it.
+            if (pszHttpVersion != nullptr || bConnectionPool ||
+                CPLIsMachineForSureGCEInstance())
             {
                 static bool bDebugEmitted = false;
                 if (!bDebugEmitted)
@@ -2569,6 +2634,14 @@ void CPLHTTPCleanup()
     CPLDestroyMutex(hSessionMapMutex);
     hSessionMapMutex = nullptr;
 
+    {
+        std::lock_guard<std::mutex> oLock(goShareHandleMutex);
+        // Fails with CURLSHE_IN_USE if an easy handle still references it,
+        // in which case it is better to leak it.
+        if (ghShareHandle && curl_share_cleanup(ghShareHandle) == CURLSHE_OK)
+            ghShareHandle = nullptr;
+    }
+
 #if defined(_WIN32) && defined(HAVE_OPENSSL_CRYPTO)
     // This cleanup must be absolutely done before CPLOpenSSLCleanup()
     // for some unknown reason, but otherwise X509_free() in
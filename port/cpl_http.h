@@ -184,6 +184,7 @@ double CPLHTTPGetNewRetryDelay(int response_code, double dfOldDelay,
 void CPL_DLL *CPLHTTPIgnoreSigPipe();
 void CPL_DLL CPLHTTPRestoreSigPipeHandler(void *old_handler);
 bool CPLMultiPerformWait(void *hCurlMultiHandle, int &repeats);
+bool CPLHTTPIsConnectionPoolEnabled();
 /*! @endcond */
 
 bool CPL_DLL CPLIsMachinePotentiallyGCEInstance();
@@ -188,6 +188,16 @@ typedef enum
 VSIRangeStatus CPL_DLL VSIFGetRangeStatusL(VSILFILE *fp, vsi_l_offset nStart,
                                            vsi_l_offset nLength);
 
+/** Opaque type for a read-only view of a range of a file.
+ * @since GDAL 3.10
+ */
+typedef struct VSIMappedRange VSIMappedRange;
+
+VSIMappedRange CPL_DLL *VSIFMapRangeL(VSILFILE *fp, vsi_l_offset nOffset,
+                                      size_t nSize) CPL_WARN_UNUSED_RESULT;
+const void CPL_DLL *VSIMappedRangeGetData(const VSIMappedRange *psRange);
+void CPL_DLL VSIMappedRangeFree(VSIMappedRange *psRange);
+
 int CPL_DLL VSIIngestFile(VSILFILE *fp, const char *pszFilename,
                           GByte **ppabyRet, vsi_l_offset *pnSize,
                           GIntBig nMaxSize) CPL_WARN_UNUSED_RESULT;
@@ -471,6 +481,10 @@ GIntBig CPL_DLL VSIGetDiskFreeSpace(const char *pszDirname);
 void CPL_DLL VSINetworkStatsReset(void);
 char CPL_DLL *VSINetworkStatsGetAsSerializedJSON(char **papszOptions);
 
+void CPL_DLL VSICachedFileStatsReset(void);
+char CPL_DLL *VSICachedFileStatsGetAsSerializedJSON(char **papszOptions);
+void CPL_DLL VSICachedFileClearSharedCache(void);
+
 /* ==================================================================== */
 /*      Install special file access handlers.                           */
 /* ==================================================================== */
@@ -521,6 +535,7 @@ VSIFileFromMemBuffer(const char *pszFilename, GByte *pabyData,
 GByte CPL_DLL *VSIGetMemFileBuffer(const char *pszFilename,
                                    vsi_l_offset *pnDataLength,
                                    int bUnlinkAndSeize);
+VSILFILE CPL_DLL *VSIMemCreateScratchFile(void) CPL_WARN_UNUSED_RESULT;
 
 /** Callback used by VSIStdoutSetRedirection() */
 typedef size_t (*VSIWriteFunction)(const void *ptr, size_t size, size_t nmemb,
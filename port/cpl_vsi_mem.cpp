@@ -43,10 +43,14 @@
 #endif
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <memory>
+#include <vector>
 
 #include <mutex>
 // c++17 or VS2017
@@ -73,11 +77,12 @@
 /*
 ** Notes on Multithreading:
 **
-** VSIMemFilesystemHandler: This class maintains a mutex to protect
-** access and update of the oFileList array which has all the "files" in
-** the memory filesystem area.  It is expected that multiple threads would
-** want to create and read different files at the same time and so might
-** collide access oFileList without the mutex.
+** VSIMemFilesystemHandler: The "files" of the memory filesystem area are
+** distributed among shards, from a hash of their path, each shard having
+** its own map and (shared) mutex. It is expected that multiple threads would
+** want to create and read different files at the same time, and they will
+** then mostly take different locks. Operations on several files (Rename(),
+** ReadDirEx()) lock all shards, or each of them in turn.
 **
 ** VSIMemFile: A mutex protects accesses to the file
 **
@@ -116,6 +121,10 @@ class VSIMemFile
     time_t mTime = 0;
     CPL_SHARED_MUTEX_TYPE m_oMutex{};
 
+    // Number of VSIMappedRange pointing into pabyData, which must not be
+    // reallocated while it is not zero.
+    std::atomic<int> nMappedRanges{0};
+
     VSIMemFile();
     virtual ~VSIMemFile();
 
@@ -157,6 +166,9 @@ class VSIMemHandle final : public VSIVirtualHandle
 
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+
+    std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                             size_t nSize) override;
 };
 
 /************************************************************************/
@@ -170,10 +182,43 @@ class VSIMemFilesystemHandler final : public VSIFilesystemHandler
     const std::string m_osPrefix;
     CPL_DISALLOW_COPY_ASSIGN(VSIMemFilesystemHandler)
 
-  public:
-    std::map<CPLString, std::shared_ptr<VSIMemFile>> oFileList{};
-    CPLMutex *hMutex = nullptr;
+    struct Shard
+    {
+        CPL_SHARED_MUTEX_TYPE m_oMutex{};
+        std::unordered_map<std::string, std::shared_ptr<VSIMemFile>>
+            m_oMapFiles{};
+    };
+
+    static constexpr int SHARD_COUNT = 64;
+    std::array<Shard, SHARD_COUNT> m_aoShards{};
+
+    Shard &GetShard(const std::string &osFilename)
+    {
+        return m_aoShards[std::hash<std::string>()(osFilename) % SHARD_COUNT];
+    }
+
+    // Locks all shards exclusively, in a fixed order.
+    struct AllShardsLock
+    {
+        CPL_DISALLOW_COPY_ASSIGN(AllShardsLock)
+
+        VSIMemFilesystemHandler *m_poHandler;
+
+        explicit AllShardsLock(VSIMemFilesystemHandler *poHandler)
+            : m_poHandler(poHandler)
+        {
+            for (auto &oShard : m_poHandler->m_aoShards)
+                oShard.m_oMutex.lock();
+        }
+
+        ~AllShardsLock()
+        {
+            for (int i = SHARD_COUNT - 1; i >= 0; --i)
+                m_poHandler->m_aoShards[i].m_oMutex.unlock();
+        }
+    };
 
+  public:
     explicit VSIMemFilesystemHandler(const char *pszPrefix)
         : m_osPrefix(pszPrefix)
     {
@@ -198,7 +243,9 @@ class VSIMemFilesystemHandler final : public VSIFilesystemHandler
 
     static std::string NormalizePath(const std::string &in);
 
-    int Unlink_unlocked(const char *pszFilename);
+    std::shared_ptr<VSIMemFile> GetFile(const std::string &osFilename);
+    void SetFile(const std::shared_ptr<VSIMemFile> &poFile);
+    std::shared_ptr<VSIMemFile> RemoveFile(const std::string &osFilename);
 
     VSIFilesystemHandler *Duplicate(const char *pszPrefix) override
     {
@@ -262,6 +309,14 @@ bool VSIMemFile::SetLength(vsi_l_offset nNewLength)
             return false;
         }
 
+        if (nMappedRanges > 0)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Cannot extend in-memory file while ranges of it are "
+                     "mapped");
+            return false;
+        }
+
         const vsi_l_offset nNewAlloc = (nNewLength + nNewLength / 10) + 5000;
         GByte *pabyNewData = nullptr;
         if (static_cast<vsi_l_offset>(static_cast<size_t>(nNewAlloc)) ==
@@ -448,6 +503,29 @@ size_t VSIMemHandle::PRead(void *pBuffer, size_t nSize,
     return 0;
 }
 
+/************************************************************************/
+/*                             MapRange()                               */
+/************************************************************************/
+
+std::unique_ptr<VSIMappedRange> VSIMemHandle::MapRange(vsi_l_offset nOffset,
+                                                       size_t nSize)
+{
+    CPL_SHARED_LOCK oLock(poFile->m_oMutex);
+
+    if (nOffset > poFile->nLength || nSize > poFile->nLength - nOffset)
+        return nullptr;
+    // The buffer is kept alive by the VSIMemFile object, even if the file
+    // is unlinked, and it cannot be reallocated until the range is freed.
+    ++poFile->nMappedRanges;
+    auto poKeepFile = poFile;
+    std::shared_ptr<const void> poOwner(
+        poFile.get(),
+        [poKeepFile](const void *) { --poKeepFile->nMappedRanges; });
+    return std::make_unique<VSIMappedRange>(
+        poFile->pabyData + static_cast<size_t>(nOffset), nSize,
+        std::move(poOwner));
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -543,11 +621,61 @@ int VSIMemHandle::Truncate(vsi_l_offset nNewSize)
 VSIMemFilesystemHandler::~VSIMemFilesystemHandler()
 
 {
-    oFileList.clear();
+    for (auto &oShard : m_aoShards)
+        oShard.m_oMapFiles.clear();
+}
+
+/************************************************************************/
+/*                              GetFile()                               */
+/************************************************************************/
+
+// Returns the file or directory of the (normalized) path, or nullptr.
+std::shared_ptr<VSIMemFile>
+VSIMemFilesystemHandler::GetFile(const std::string &osFilename)
+{
+    auto &oShard = GetShard(osFilename);
+    CPL_SHARED_LOCK oLock(oShard.m_oMutex);
+    auto oIter = oShard.m_oMapFiles.find(osFilename);
+    if (oIter == oShard.m_oMapFiles.end())
+        return nullptr;
+    return oIter->second;
+}
+
+/************************************************************************/
+/*                              SetFile()                               */
+/************************************************************************/
+
+// Registers the file under its name, replacing any existing one.
+void VSIMemFilesystemHandler::SetFile(const std::shared_ptr<VSIMemFile> &poFile)
+{
+    auto &oShard = GetShard(poFile->osFilename);
+    std::shared_ptr<VSIMemFile> poOldFile;
+    {
+        CPL_EXCLUSIVE_LOCK oLock(oShard.m_oMutex);
+        auto &poSlot = oShard.m_oMapFiles[poFile->osFilename];
+        // Destroy the previous file, if no longer used, out of the lock
+        std::swap(poOldFile, poSlot);
+        poSlot = poFile;
+    }
+}
 
-    if (hMutex != nullptr)
-        CPLDestroyMutex(hMutex);
-    hMutex = nullptr;
+/************************************************************************/
+/*                             RemoveFile()                             */
+/************************************************************************/
+
+// Unregisters the file of the (normalized) path and returns it, or nullptr.
+// The file object stays alive as long as handles on it remain open.
+std::shared_ptr<VSIMemFile>
+VSIMemFilesystemHandler::RemoveFile(const std::string &osFilename)
+{
+    auto &oShard = GetShard(osFilename);
+    CPL_EXCLUSIVE_LOCK oLock(oShard.m_oMutex);
+    auto oIter = oShard.m_oMapFiles.find(osFilename);
+    if (oIter == oShard.m_oMapFiles.end())
+        return nullptr;
+    auto poFile = std::move(oIter->second);
+    oShard.m_oMapFiles.erase(oIter);
+    return poFile;
 }
 
 /************************************************************************/
@@ -560,7 +688,6 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
                                                 CSLConstList /* papszOptions */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
     const CPLString osFilename = NormalizePath(pszFilename);
     if (osFilename.empty())
         return nullptr;
@@ -576,11 +703,7 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
     /* -------------------------------------------------------------------- */
     /*      Get the filename we are opening, create if needed.              */
     /* -------------------------------------------------------------------- */
-    std::shared_ptr<VSIMemFile> poFile = nullptr;
-    if (oFileList.find(osFilename) != oFileList.end())
-    {
-        poFile = oFileList[osFilename];
-    }
+    std::shared_ptr<VSIMemFile> poFile = GetFile(osFilename);
 
     // If no file and opening in read, error out.
     if (strstr(pszAccess, "w") == nullptr &&
@@ -595,32 +718,45 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
     }
 
     // Create.
+    bool bCreated = false;
     if (poFile == nullptr)
     {
-        const char *pszFileDir = CPLGetPath(osFilename.c_str());
-        if (VSIMkdirRecursive(pszFileDir, 0755) == -1)
+        // No lock is held here, as creating the directories goes through
+        // the file manager. Files directly in the root directory, which is
+        // always there, skip that step.
+        const CPLString osFileDir(CPLGetPath(osFilename.c_str()));
+        if (osFileDir + '/' != m_osPrefix &&
+            VSIMkdirRecursive(osFileDir.c_str(), 0755) == -1)
         {
             if (bSetError)
             {
                 VSIError(VSIE_FileError,
                          "Could not create directory %s for writing",
-                         pszFileDir);
+                         osFileDir.c_str());
             }
             errno = ENOENT;
             return nullptr;
         }
 
-        poFile = std::make_shared<VSIMemFile>();
-        poFile->osFilename = osFilename;
-        oFileList[poFile->osFilename] = poFile;
+        auto &oShard = GetShard(osFilename);
+        CPL_EXCLUSIVE_LOCK oLock(oShard.m_oMutex);
+        // The file might have been created by another thread in between
+        auto &poSlot = oShard.m_oMapFiles[osFilename];
+        if (poSlot == nullptr)
+        {
+            poSlot = std::make_shared<VSIMemFile>();
+            poSlot->osFilename = osFilename;
+            poSlot->nMaxLength = nMaxLength;
+            bCreated = true;
+        }
+        poFile = poSlot;
 #ifdef DEBUG_VERBOSE
         CPLDebug("VSIMEM", "Creating file %s: ref_count=%d", pszFilename,
                  static_cast<int>(poFile.use_count()));
 #endif
-        poFile->nMaxLength = nMaxLength;
     }
     // Overwrite
-    else if (strstr(pszAccess, "w"))
+    if (!bCreated && strstr(pszAccess, "w"))
     {
         CPL_EXCLUSIVE_LOCK oLock(poFile->m_oMutex);
         poFile->SetLength(0);
@@ -665,8 +801,6 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
                                   VSIStatBufL *pStatBuf, int /* nFlags */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osFilename = NormalizePath(pszFilename);
 
     memset(pStatBuf, 0, sizeof(VSIStatBufL));
@@ -678,17 +812,13 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
         return 0;
     }
 
-    auto oIter = oFileList.find(osFilename);
-    if (oIter == oFileList.end())
+    std::shared_ptr<VSIMemFile> poFile = GetFile(osFilename);
+    if (poFile == nullptr)
     {
         errno = ENOENT;
         return -1;
     }
 
-    std::shared_ptr<VSIMemFile> poFile = oIter->second;
-
-    memset(pStatBuf, 0, sizeof(VSIStatBufL));
-
     CPL_SHARED_LOCK oLock(poFile->m_oMutex);
     if (poFile->bIsDirectory)
     {
@@ -711,33 +841,21 @@ int VSIMemFilesystemHandler::Stat(const char *pszFilename,
 
 int VSIMemFilesystemHandler::Unlink(const char *pszFilename)
 
-{
-    CPLMutexHolder oHolder(&hMutex);
-    return Unlink_unlocked(pszFilename);
-}
-
-/************************************************************************/
-/*                           Unlink_unlocked()                          */
-/************************************************************************/
-
-int VSIMemFilesystemHandler::Unlink_unlocked(const char *pszFilename)
-
 {
     const CPLString osFilename = NormalizePath(pszFilename);
 
-    auto oIter = oFileList.find(osFilename);
-    if (oIter == oFileList.end())
+    // The file is destroyed, if no longer used, once out of the lock.
+    std::shared_ptr<VSIMemFile> poFile = RemoveFile(osFilename);
+    if (poFile == nullptr)
     {
         errno = ENOENT;
         return -1;
     }
 
 #ifdef DEBUG_VERBOSE
-    std::shared_ptr<VSIMemFile> poFile = oIter->second;
     CPLDebug("VSIMEM", "Unlink %s: ref_count=%d (before)", pszFilename,
              static_cast<int>(poFile.use_count()));
 #endif
-    oFileList.erase(oIter);
 
     return 0;
 }
@@ -749,20 +867,22 @@ int VSIMemFilesystemHandler::Unlink_unlocked(const char *pszFilename)
 int VSIMemFilesystemHandler::Mkdir(const char *pszPathname, long /* nMode */)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osPathname = NormalizePath(pszPathname);
 
-    if (oFileList.find(osPathname) != oFileList.end())
+    auto &oShard = GetShard(osPathname);
+    CPL_EXCLUSIVE_LOCK oLock(oShard.m_oMutex);
+
+    auto &poSlot = oShard.m_oMapFiles[osPathname];
+    if (poSlot != nullptr)
     {
         errno = EEXIST;
         return -1;
     }
 
-    std::shared_ptr<VSIMemFile> poFile = std::make_shared<VSIMemFile>();
-    poFile->osFilename = osPathname;
-    poFile->bIsDirectory = true;
-    oFileList[osPathname] = poFile;
+    poSlot = std::make_shared<VSIMemFile>();
+    poSlot->osFilename = osPathname;
+    poSlot->bIsDirectory = true;
+    const auto &poFile = poSlot;
 #ifdef DEBUG_VERBOSE
     CPLDebug("VSIMEM", "Mkdir on %s: ref_count=%d", pszPathname,
              static_cast<int>(poFile.use_count()));
@@ -788,48 +908,42 @@ int VSIMemFilesystemHandler::Rmdir(const char *pszPathname)
 char **VSIMemFilesystemHandler::ReadDirEx(const char *pszPath, int nMaxFiles)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osPath = NormalizePath(pszPath);
 
-    char **papszDir = nullptr;
     size_t nPathLen = osPath.size();
 
     if (nPathLen > 0 && osPath.back() == '/')
         nPathLen--;
 
-    // In case of really big number of files in the directory, CSLAddString
-    // can be slow (see #2158). We then directly build the list.
-    int nItems = 0;
-    int nAllocatedItems = 0;
-
-    for (const auto &iter : oFileList)
+    std::vector<std::string> aosNames;
+    for (auto &oShard : m_aoShards)
     {
-        const char *pszFilePath = iter.second->osFilename.c_str();
-        if (EQUALN(osPath, pszFilePath, nPathLen) &&
-            pszFilePath[nPathLen] == '/' &&
-            strstr(pszFilePath + nPathLen + 1, "/") == nullptr)
+        CPL_SHARED_LOCK oLock(oShard.m_oMutex);
+        for (const auto &iter : oShard.m_oMapFiles)
         {
-            if (nItems == 0)
-            {
-                papszDir = static_cast<char **>(CPLCalloc(2, sizeof(char *)));
-                nAllocatedItems = 1;
-            }
-            else if (nItems >= nAllocatedItems)
+            const char *pszFilePath = iter.first.c_str();
+            if (EQUALN(osPath, pszFilePath, nPathLen) &&
+                pszFilePath[nPathLen] == '/' &&
+                strstr(pszFilePath + nPathLen + 1, "/") == nullptr)
             {
-                nAllocatedItems = nAllocatedItems * 2;
-                papszDir = static_cast<char **>(CPLRealloc(
-                    papszDir, (nAllocatedItems + 2) * sizeof(char *)));
+                aosNames.emplace_back(pszFilePath + nPathLen + 1);
             }
-
-            papszDir[nItems] = CPLStrdup(pszFilePath + nPathLen + 1);
-            papszDir[nItems + 1] = nullptr;
-
-            nItems++;
-            if (nMaxFiles > 0 && nItems > nMaxFiles)
-                break;
         }
     }
+    if (aosNames.empty())
+        return nullptr;
+
+    // Return entries in a stable (sorted) order
+    std::sort(aosNames.begin(), aosNames.end());
+    if (nMaxFiles > 0 && aosNames.size() > static_cast<size_t>(nMaxFiles) + 1)
+        aosNames.resize(static_cast<size_t>(nMaxFiles) + 1);
+
+    // In case of really big number of files in the directory, CSLAddString
+    // can be slow (see #2158). We then directly build the list.
+    char **papszDir =
+        static_cast<char **>(CPLCalloc(aosNames.size() + 1, sizeof(char *)));
+    for (size_t i = 0; i < aosNames.size(); ++i)
+        papszDir[i] = CPLStrdup(aosNames[i].c_str());
 
     return papszDir;
 }
@@ -842,8 +956,6 @@ int VSIMemFilesystemHandler::Rename(const char *pszOldPath,
                                     const char *pszNewPath)
 
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const CPLString osOldPath = NormalizePath(pszOldPath);
     const CPLString osNewPath = NormalizePath(pszNewPath);
     if (!STARTS_WITH(pszNewPath, m_osPrefix.c_str()))
@@ -852,31 +964,50 @@ int VSIMemFilesystemHandler::Rename(const char *pszOldPath,
     if (osOldPath.compare(osNewPath) == 0)
         return 0;
 
-    if (oFileList.find(osOldPath) == oFileList.end())
+    // Files previously at the new paths are destroyed, if no longer used,
+    // once out of the lock.
+    std::vector<std::shared_ptr<VSIMemFile>> apoReplacedFiles;
+
+    AllShardsLock oLock(this);
+
+    if (GetShard(osOldPath).m_oMapFiles.count(osOldPath) == 0)
     {
         errno = ENOENT;
         return -1;
     }
 
-    std::map<CPLString, std::shared_ptr<VSIMemFile>>::iterator it =
-        oFileList.find(osOldPath);
-    while (it != oFileList.end() && it->first.ifind(osOldPath) == 0)
+    // Collect the file or directory, and all its content
+    std::vector<std::shared_ptr<VSIMemFile>> apoFiles;
+    for (auto &oShard : m_aoShards)
     {
-        const CPLString osRemainder = it->first.substr(osOldPath.size());
-        if (osRemainder.empty() || osRemainder[0] == '/')
-        {
-            const CPLString osNewFullPath = osNewPath + osRemainder;
-            Unlink_unlocked(osNewFullPath);
-            oFileList[osNewFullPath] = it->second;
-            it->second->osFilename = osNewFullPath;
-            oFileList.erase(it++);
-        }
-        else
+        for (auto it = oShard.m_oMapFiles.begin();
+             it != oShard.m_oMapFiles.end();)
         {
-            ++it;
+            if (it->first.compare(0, osOldPath.size(), osOldPath) == 0 &&
+                (it->first.size() == osOldPath.size() ||
+                 it->first[osOldPath.size()] == '/'))
+            {
+                apoFiles.push_back(std::move(it->second));
+                it = oShard.m_oMapFiles.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
     }
 
+    for (auto &poFile : apoFiles)
+    {
+        poFile->osFilename =
+            osNewPath + poFile->osFilename.substr(osOldPath.size());
+        auto &poSlot = GetShard(poFile->osFilename)
+                           .m_oMapFiles[poFile->osFilename];
+        if (poSlot)
+            apoReplacedFiles.push_back(std::move(poSlot));
+        poSlot = std::move(poFile);
+    }
+
     return 0;
 }
 
@@ -1045,9 +1176,7 @@ VSILFILE *VSIFileFromMemBuffer(const char *pszFilename, GByte *pabyData,
 
     if (!osFilename.empty())
     {
-        CPLMutexHolder oHolder(&poHandler->hMutex);
-        poHandler->Unlink_unlocked(osFilename);
-        poHandler->oFileList[poFile->osFilename] = poFile;
+        poHandler->SetFile(poFile);
 #ifdef DEBUG_VERBOSE
         CPLDebug("VSIMEM", "VSIFileFromMemBuffer() %s: ref_count=%d (after)",
                  poFile->osFilename.c_str(),
@@ -1077,6 +1206,9 @@ VSILFILE *VSIFileFromMemBuffer(const char *pszFilename, GByte *pabyData,
  * object will be deleted, and ownership of the buffer will pass to the
  * caller otherwise the underlying file will remain in existence.
  *
+ * When ownership of the buffer is taken, ranges of the file mapped with
+ * VSIFMapRangeL() must be freed before the buffer.
+ *
  * @param pszFilename the name of the file to grab the buffer of.
  * @param pnDataLength (file) length returned in this variable.
  * @param bUnlinkAndSeize TRUE to remove the file, or FALSE to leave unaltered.
@@ -1097,12 +1229,13 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
     const CPLString osFilename =
         VSIMemFilesystemHandler::NormalizePath(pszFilename);
 
-    CPLMutexHolder oHolder(&poHandler->hMutex);
-
-    if (poHandler->oFileList.find(osFilename) == poHandler->oFileList.end())
+    std::shared_ptr<VSIMemFile> poFile =
+        bUnlinkAndSeize ? poHandler->RemoveFile(osFilename)
+                        : poHandler->GetFile(osFilename);
+    if (poFile == nullptr)
         return nullptr;
 
-    std::shared_ptr<VSIMemFile> poFile = poHandler->oFileList[osFilename];
+    CPL_EXCLUSIVE_LOCK oLock(poFile->m_oMutex);
     GByte *pabyData = poFile->pabyData;
     if (pnDataLength != nullptr)
         *pnDataLength = poFile->nLength;
@@ -1115,7 +1248,6 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
         else
             poFile->bOwnData = false;
 
-        poHandler->oFileList.erase(poHandler->oFileList.find(osFilename));
 #ifdef DEBUG_VERBOSE
         CPLDebug("VSIMEM", "VSIGetMemFileBuffer() %s: ref_count=%d (before)",
                  poFile->osFilename.c_str(),
@@ -1128,3 +1260,37 @@ GByte *VSIGetMemFileBuffer(const char *pszFilename, vsi_l_offset *pnDataLength,
 
     return pabyData;
 }
+
+/************************************************************************/
+/*                      VSIMemCreateScratchFile()                       */
+/************************************************************************/
+
+/**
+ * \brief Create an anonymous memory "file".
+ *
+ * The file is empty, opened in update mode, and grows as data is written to
+ * it. It has no name and is not registered in the /vsimem/ filesystem, so
+ * creating, using and closing it does not involve any global lock or
+ * namespace lookup. This is intended for code that just needs a temporary
+ * in-memory handle. The file is destroyed when the handle is closed.
+ *
+ * The content can be read back with VSIFReadL(), or accessed without copy
+ * with VSIFMapRangeL().
+ *
+ * This is equivalent to VSIFileFromMemBuffer(nullptr, nullptr, 0, TRUE).
+ *
+ * @return open file handle on created file (see VSIFOpenL()).
+ *
+ * @since GDAL 3.10
+ */
+
+VSILFILE *VSIMemCreateScratchFile(void)
+
+{
+    auto poFile = std::make_shared<VSIMemFile>();
+
+    VSIMemHandle *poHandle = new VSIMemHandle;
+    poHandle->poFile = std::move(poFile);
+    poHandle->bUpdate = true;
+    return poHandle;
+}
@@ -54,6 +54,54 @@
 #undef CopyFile
 #endif
 
+/************************************************************************/
+/*                            VSIMappedRange                            */
+/************************************************************************/
+
+/** Read-only view of a range of a file, returned by
+ * VSIVirtualHandle::MapRange().
+ *
+ * The memory it points to remains valid until it is destroyed, even if the
+ * file handle is closed before. Its content is undefined if the file is
+ * modified or truncated in the meantime.
+ *
+ * @since GDAL 3.10
+ */
+struct CPL_DLL VSIMappedRange
+{
+    /** Constructor.
+     *
+     * @param pData Pointer to the first byte of the range.
+     * @param nSize Size of the range in bytes.
+     * @param poOwner Object that keeps the memory pointed by pData alive.
+     */
+    VSIMappedRange(const void *pData, size_t nSize,
+                   std::shared_ptr<const void> poOwner)
+        : m_pData(pData), m_nSize(nSize), m_poOwner(std::move(poOwner))
+    {
+    }
+
+    /** Return a pointer to the first byte of the range */
+    const void *GetData() const
+    {
+        return m_pData;
+    }
+
+    /** Return the size of the range in bytes */
+    size_t GetSize() const
+    {
+        return m_nSize;
+    }
+
+  private:
+    const void *m_pData;
+    size_t m_nSize;
+    std::shared_ptr<const void> m_poOwner;
+
+    VSIMappedRange(const VSIMappedRange &) = delete;
+    VSIMappedRange &operator=(const VSIMappedRange &) = delete;
+};
+
 /************************************************************************/
 /*                           VSIVirtualHandle                           */
 /************************************************************************/
@@ -135,6 +183,9 @@ struct CPL_DLL VSIVirtualHandle
     virtual size_t PRead(void *pBuffer, size_t nSize,
                          vsi_l_offset nOffset) const;
 
+    virtual std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                                     size_t nSize);
+
     // NOTE: when adding new methods, besides the "actual" implementations,
     // also consider the VSICachedFile one.
 
@@ -529,7 +580,8 @@ constexpr int VSI_CACHED_DEFAULT_CHUNK_SIZE = 32768;
 VSIVirtualHandle CPL_DLL *
 VSICreateCachedFile(VSIVirtualHandle *poBaseHandle,
                     size_t nChunkSize = VSI_CACHED_DEFAULT_CHUNK_SIZE,
-                    size_t nCacheSize = 0);
+                    size_t nCacheSize = 0, const char *pszFilename = nullptr,
+                    const char *pszETag = nullptr);
 
 const int CPL_DEFLATE_TYPE_GZIP = 0;
 const int CPL_DEFLATE_TYPE_ZLIB = 1;
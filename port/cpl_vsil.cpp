@@ -2723,6 +2723,75 @@ VSIRangeStatus VSIFGetRangeStatusL(VSILFILE *fp, vsi_l_offset nOffset,
     return fp->GetRangeStatus(nOffset, nLength);
 }
 
+/************************************************************************/
+/*                           VSIFMapRangeL()                            */
+/************************************************************************/
+
+/**
+ * \brief Return a read-only view of a range of a file.
+ *
+ * This gives access to the content of the range without copying it, when
+ * the file system supports it: local files are memory-mapped, /vsimem/ files
+ * return a pointer to their buffer, and network file systems (/vsicurl/ and
+ * derived) return a pointer to a chunk of their cache when the range fits in
+ * a single chunk. Otherwise the range is read into a newly allocated buffer.
+ *
+ * The returned memory remains valid until VSIMappedRangeFree() is called,
+ * even if the file handle is closed before. Its content is undefined if the
+ * file is modified or truncated in the meantime. /vsimem/ files cannot be
+ * extended while ranges of them are mapped.
+ *
+ * The current file offset is not affected by this function.
+ *
+ * This is the same as the C++ method VSIVirtualHandle::MapRange().
+ *
+ * @param fp file handle opened with VSIFOpenL().
+ * @param nOffset file offset of the start of the range.
+ * @param nSize size of the range in bytes.
+ *
+ * @return an object to free with VSIMappedRangeFree(), or NULL in case of
+ *         error, or if the range extends beyond the end of the file.
+ * @since GDAL 3.10
+ */
+
+VSIMappedRange *VSIFMapRangeL(VSILFILE *fp, vsi_l_offset nOffset, size_t nSize)
+{
+    return fp->MapRange(nOffset, nSize).release();
+}
+
+/************************************************************************/
+/*                        VSIMappedRangeGetData()                       */
+/************************************************************************/
+
+/**
+ * \brief Return a pointer to the first byte of a range returned by
+ * VSIFMapRangeL().
+ *
+ * @param psRange object returned by VSIFMapRangeL().
+ * @since GDAL 3.10
+ */
+
+const void *VSIMappedRangeGetData(const VSIMappedRange *psRange)
+{
+    return psRange->GetData();
+}
+
+/************************************************************************/
+/*                         VSIMappedRangeFree()                         */
+/************************************************************************/
+
+/**
+ * \brief Free an object returned by VSIFMapRangeL().
+ *
+ * @param psRange object returned by VSIFMapRangeL(), or NULL.
+ * @since GDAL 3.10
+ */
+
+void VSIMappedRangeFree(VSIMappedRange *psRange)
+{
+    delete psRange;
+}
+
 /************************************************************************/
 /*                           VSIIngestFile()                            */
 /************************************************************************/
@@ -3474,7 +3543,10 @@ void VSICleanupFileManager()
 
 #ifdef HAVE_CURL
     VSICURLDestroyCacheFileProp();
+    VSICURLDestroyConnectionPool();
 #endif
+
+    VSICachedFileClearSharedCache();
 }
 
 /************************************************************************/
@@ -3583,3 +3655,50 @@ size_t VSIVirtualHandle::PRead(CPL_UNUSED void *pBuffer,
 {
     return 0;
 }
+
+/************************************************************************/
+/*                             MapRange()                               */
+/************************************************************************/
+
+/** Return a read-only view of a range of the file.
+ *
+ * Implementations avoid copying the data when possible: local files are
+ * memory-mapped, /vsimem/ files return a pointer to their buffer and
+ * network file systems return a pointer to a chunk of their cache. This
+ * base implementation reads the range in a newly allocated buffer.
+ *
+ * The current file offset is not affected by this method.
+ *
+ * @param nOffset file offset of the start of the range.
+ * @param nSize   size of the range in bytes.
+ * @return a new object, or nullptr in case of error, or if the range extends
+ *         beyond the end of the file.
+ * @since GDAL 3.10
+ */
+std::unique_ptr<VSIMappedRange> VSIVirtualHandle::MapRange(vsi_l_offset nOffset,
+                                                           size_t nSize)
+{
+    std::shared_ptr<GByte> pabyBuffer(
+        static_cast<GByte *>(VSI_MALLOC_VERBOSE(std::max<size_t>(1, nSize))),
+        VSIFree);
+    if (!pabyBuffer)
+        return nullptr;
+
+    size_t nRead;
+    if (HasPRead())
+    {
+        nRead = PRead(pabyBuffer.get(), nSize, nOffset);
+    }
+    else
+    {
+        const vsi_l_offset nCurOffset = Tell();
+        nRead = Seek(nOffset, SEEK_SET) == 0 ? Read(pabyBuffer.get(), 1, nSize)
+                                             : 0;
+        Seek(nCurOffset, SEEK_SET);
+    }
+    if (nRead != nSize)
+        return nullptr;
+    const void *pData = pabyBuffer.get();
+    return std::make_unique<VSIMappedRange>(pData, nSize,
+                                            std::move(pabyBuffer));
+}
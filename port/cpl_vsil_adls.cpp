@@ -278,7 +278,8 @@ class VSIADLSFSHandler final : public IVSIS3LikeFSHandler
                            const std::vector<std::string> & /* aosEtags */,
                            vsi_l_offset nTotalSize,
                            IVSIS3LikeHandleHelper *poS3HandleHelper,
-                           int nMaxRetry, double dfRetryDelay) override
+                           int nMaxRetry, double dfRetryDelay,
+                           CSLConstList /* papszOptions */) override
     {
         return UploadFile(osFilename, Event::FLUSH, nTotalSize, nullptr, 0,
                           poS3HandleHelper, nMaxRetry, dfRetryDelay, nullptr);
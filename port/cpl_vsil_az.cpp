@@ -603,7 +603,7 @@ class VSIAzureFSHandler final : public IVSIS3LikeFSHandler
     bool PutBlockList(const std::string &osFilename,
                       const std::vector<std::string> &aosBlockIds,
                       IVSIS3LikeHandleHelper *poS3HandleHelper, int nMaxRetry,
-                      double dfRetryDelay);
+                      double dfRetryDelay, CSLConstList papszOptions);
 
     // Multipart upload (mapping of S3 interface to PutBlock/PutBlockList)
 
@@ -639,10 +639,11 @@ class VSIAzureFSHandler final : public IVSIS3LikeFSHandler
                            const std::vector<std::string> &aosEtags,
                            vsi_l_offset /* nTotalSize */,
                            IVSIS3LikeHandleHelper *poS3HandleHelper,
-                           int nMaxRetry, double dfRetryDelay) override
+                           int nMaxRetry, double dfRetryDelay,
+                           CSLConstList papszOptions) override
     {
         return PutBlockList(osFilename, aosEtags, poS3HandleHelper, nMaxRetry,
-                            dfRetryDelay);
+                            dfRetryDelay, papszOptions);
     }
 
     bool AbortMultipart(const std::string & /* osFilename */,
@@ -653,6 +654,12 @@ class VSIAzureFSHandler final : public IVSIS3LikeFSHandler
         return true;
     }
 
+    struct curl_slist *
+    AddSinglePartPUTHeaders(struct curl_slist *headers) const override
+    {
+        return curl_slist_append(headers, "x-ms-blob-type: BlockBlob");
+    }
+
     std::string
     GetStreamingFilename(const std::string &osFilename) const override;
 
@@ -730,6 +737,24 @@ VSIVirtualHandleUniquePtr
 VSIAzureFSHandler::CreateWriteHandle(const char *pszFilename,
                                      CSLConstList papszOptions)
 {
+    // When several upload threads are requested, create a block blob from
+    // blocks uploaded in parallel, instead of appending sequentially to an
+    // append blob.
+    if (GetUploadNumThreads(pszFilename) > 1)
+    {
+        auto poS3HandleHelper =
+            CreateHandleHelper(pszFilename + GetFSPrefix().size(), false);
+        if (poS3HandleHelper == nullptr)
+            return nullptr;
+        auto poHandle = std::make_unique<VSIS3WriteHandle>(
+            this, pszFilename, poS3HandleHelper, false, papszOptions);
+        if (!poHandle->IsOK())
+        {
+            return nullptr;
+        }
+        return VSIVirtualHandleUniquePtr(poHandle.release());
+    }
+
     VSIAzureBlobHandleHelper *poHandleHelper =
         VSIAzureBlobHandleHelper::BuildFromURI(
             pszFilename + GetFSPrefix().size(), GetFSPrefix().c_str());
@@ -2313,6 +2338,44 @@ std::string VSIAzureFSHandler::PutBlock(
     return osBlockId;
 }
 
+/************************************************************************/
+/*                    SetPutBlockListHeadersFromOptions()               */
+/************************************************************************/
+
+// The properties of the blob are given to Put Block List with x-ms-blob-
+// prefixed headers, instead of the standard ones used by Put Blob.
+static struct curl_slist *
+SetPutBlockListHeadersFromOptions(struct curl_slist *headers,
+                                  CSLConstList papszOptions,
+                                  const char *pszPath)
+{
+    struct curl_slist *creationHeaders =
+        VSICurlSetCreationHeadersFromOptions(nullptr, papszOptions, pszPath);
+    for (struct curl_slist *psIter = creationHeaders; psIter;
+         psIter = psIter->next)
+    {
+        const char *pszHeader = psIter->data;
+        if (STARTS_WITH_CI(pszHeader, "Content-Type:") ||
+            STARTS_WITH_CI(pszHeader, "Content-Encoding:") ||
+            STARTS_WITH_CI(pszHeader, "Content-Language:") ||
+            STARTS_WITH_CI(pszHeader, "Content-Disposition:") ||
+            STARTS_WITH_CI(pszHeader, "Cache-Control:"))
+        {
+            const char *pszColon = strchr(pszHeader, ':');
+            std::string osHeader("x-ms-blob-");
+            osHeader += CPLString(std::string(pszHeader, pszColon)).tolower();
+            osHeader += pszColon;
+            headers = curl_slist_append(headers, osHeader.c_str());
+        }
+        else
+        {
+            headers = curl_slist_append(headers, pszHeader);
+        }
+    }
+    curl_slist_free_all(creationHeaders);
+    return headers;
+}
+
 /************************************************************************/
 /*                           PutBlockList()                             */
 /************************************************************************/
@@ -2320,7 +2383,7 @@ std::string VSIAzureFSHandler::PutBlock(
 bool VSIAzureFSHandler::PutBlockList(
     const std::string &osFilename, const std::vector<std::string> &aosBlockIds,
     IVSIS3LikeHandleHelper *poS3HandleHelper, int nMaxRetry,
-    double dfRetryDelay)
+    double dfRetryDelay, CSLConstList papszOptions)
 {
     bool bSuccess = true;
 
@@ -2367,6 +2430,8 @@ bool VSIAzureFSHandler::PutBlockList(
         struct curl_slist *headers = static_cast<struct curl_slist *>(
             CPLHTTPSetOptions(hCurlHandle, poS3HandleHelper->GetURL().c_str(),
                               aosHTTPOptions.List()));
+        headers = SetPutBlockListHeadersFromOptions(headers, papszOptions,
+                                                    osFilename.c_str());
         headers = curl_slist_append(headers, osContentLength.c_str());
         headers = VSICurlMergeHeaders(
             headers, poS3HandleHelper->GetCurlHeaders(
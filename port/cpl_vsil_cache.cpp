@@ -30,6 +30,7 @@
 #include "cpl_port.h"
 #include "cpl_vsi_virtual.h"
 
+#include <cctype>
 #include <cstddef>
 #include <cstring>
 #if HAVE_FCNTL_H
@@ -37,13 +38,21 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_json.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_mem_cache.h"
@@ -51,6 +60,235 @@
 
 //! @cond Doxygen_Suppress
 
+typedef std::shared_ptr<const cpl::NonCopyableVector<GByte>> VSICachedChunkPtr;
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSICachedFileSharedCache                       */
+/* ==================================================================== */
+/************************************************************************/
+
+// Process-wide cache of chunks, shared by all VSICachedFile handles opened
+// in shared mode (VSI_CACHE_SHARED=YES). Chunks are keyed by the identity of
+// the file (see VSICreateCachedFile()), the chunk size and the chunk index,
+// so that handles on the same file, from any thread, reuse the chunks
+// loaded by others. Entries are spread among partitions, each with its own
+// mutex and least-recently-used list, and the memory budget is split evenly
+// between them.
+class VSICachedFileSharedCache
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSICachedFileSharedCache)
+
+  public:
+    struct Key
+    {
+        std::shared_ptr<const std::string> poFileKey{};
+        size_t nFileKeyHash = 0;
+        vsi_l_offset nBlock = 0;
+
+        bool operator==(const Key &other) const
+        {
+            return nBlock == other.nBlock &&
+                   nFileKeyHash == other.nFileKeyHash &&
+                   (poFileKey == other.poFileKey ||
+                    *poFileKey == *other.poFileKey);
+        }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key &k) const
+        {
+            return k.nFileKeyHash ^
+                   std::hash<vsi_l_offset>()(k.nBlock * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    VSICachedFileSharedCache() = default;
+
+    static VSICachedFileSharedCache &Get();
+
+    void SetMaxSize(size_t nMaxSize)
+    {
+        m_nMaxSize = nMaxSize;
+    }
+
+    bool Contains(const Key &oKey);
+    VSICachedChunkPtr Lookup(const Key &oKey);
+    void Insert(const Key &oKey, VSICachedChunkPtr &&poChunk);
+    void Clear();
+    void ResetStats();
+    std::string GetStatsAsSerializedJSON();
+
+    void LogHit(size_t nCount)
+    {
+        m_nHits += nCount;
+    }
+
+    void LogMiss(size_t nCount)
+    {
+        m_nMisses += nCount;
+    }
+
+  private:
+    static constexpr int PARTITION_COUNT = 16;
+
+    typedef std::list<std::pair<Key, VSICachedChunkPtr>> LRUList;
+
+    struct Partition
+    {
+        std::mutex oMutex{};
+        LRUList oList{};  // most recently used first
+        std::unordered_map<Key, LRUList::iterator, KeyHasher> oMap{};
+        size_t nSize = 0;
+    };
+
+    std::array<Partition, PARTITION_COUNT> m_aoPartitions{};
+    std::atomic<size_t> m_nMaxSize{0};
+
+    std::atomic<GUIntBig> m_nHits{0};
+    std::atomic<GUIntBig> m_nMisses{0};
+    std::atomic<GUIntBig> m_nEvictions{0};
+    std::atomic<GUIntBig> m_nEvictedBytes{0};
+
+    Partition &GetPartition(const Key &oKey)
+    {
+        return m_aoPartitions[KeyHasher()(oKey) % PARTITION_COUNT];
+    }
+};
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+VSICachedFileSharedCache &VSICachedFileSharedCache::Get()
+{
+    static VSICachedFileSharedCache oCache;
+    return oCache;
+}
+
+/************************************************************************/
+/*                              Contains()                              */
+/************************************************************************/
+
+bool VSICachedFileSharedCache::Contains(const Key &oKey)
+{
+    auto &oPartition = GetPartition(oKey);
+    std::lock_guard<std::mutex> oLock(oPartition.oMutex);
+    return oPartition.oMap.find(oKey) != oPartition.oMap.end();
+}
+
+/************************************************************************/
+/*                               Lookup()                               */
+/************************************************************************/
+
+VSICachedChunkPtr VSICachedFileSharedCache::Lookup(const Key &oKey)
+{
+    auto &oPartition = GetPartition(oKey);
+    std::lock_guard<std::mutex> oLock(oPartition.oMutex);
+    auto oIter = oPartition.oMap.find(oKey);
+    if (oIter == oPartition.oMap.end())
+        return nullptr;
+    oPartition.oList.splice(oPartition.oList.begin(), oPartition.oList,
+                            oIter->second);
+    return oIter->second->second;
+}
+
+/************************************************************************/
+/*                               Insert()                               */
+/************************************************************************/
+
+void VSICachedFileSharedCache::Insert(const Key &oKey,
+                                      VSICachedChunkPtr &&poChunk)
+{
+    // Evicted chunks are released out of the lock
+    std::vector<VSICachedChunkPtr> apoEvicted;
+
+    auto &oPartition = GetPartition(oKey);
+    std::lock_guard<std::mutex> oLock(oPartition.oMutex);
+    auto oIter = oPartition.oMap.find(oKey);
+    if (oIter != oPartition.oMap.end())
+    {
+        // Already loaded by another handle
+        oPartition.oList.splice(oPartition.oList.begin(), oPartition.oList,
+                                oIter->second);
+        return;
+    }
+
+    oPartition.nSize += poChunk->size();
+    oPartition.oList.emplace_front(oKey, std::move(poChunk));
+    oPartition.oMap[oKey] = oPartition.oList.begin();
+
+    // Always keep the most recently inserted chunk, even if it exceeds the
+    // budget of the partition on its own.
+    const size_t nMaxPartitionSize = m_nMaxSize / PARTITION_COUNT;
+    while (oPartition.nSize > nMaxPartitionSize &&
+           oPartition.oList.size() > 1)
+    {
+        auto &oLast = oPartition.oList.back();
+        const size_t nChunkSize = oLast.second->size();
+        oPartition.nSize -= nChunkSize;
+        m_nEvictions++;
+        m_nEvictedBytes += nChunkSize;
+        oPartition.oMap.erase(oLast.first);
+        apoEvicted.push_back(std::move(oLast.second));
+        oPartition.oList.pop_back();
+    }
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+void VSICachedFileSharedCache::Clear()
+{
+    for (auto &oPartition : m_aoPartitions)
+    {
+        std::lock_guard<std::mutex> oLock(oPartition.oMutex);
+        oPartition.oMap.clear();
+        oPartition.oList.clear();
+        oPartition.nSize = 0;
+    }
+}
+
+/************************************************************************/
+/*                             ResetStats()                             */
+/************************************************************************/
+
+void VSICachedFileSharedCache::ResetStats()
+{
+    m_nHits = 0;
+    m_nMisses = 0;
+    m_nEvictions = 0;
+    m_nEvictedBytes = 0;
+}
+
+/************************************************************************/
+/*                      GetStatsAsSerializedJSON()                      */
+/************************************************************************/
+
+std::string VSICachedFileSharedCache::GetStatsAsSerializedJSON()
+{
+    size_t nSize = 0;
+    size_t nChunkCount = 0;
+    for (auto &oPartition : m_aoPartitions)
+    {
+        std::lock_guard<std::mutex> oLock(oPartition.oMutex);
+        nSize += oPartition.nSize;
+        nChunkCount += oPartition.oList.size();
+    }
+
+    CPLJSONObject oStats;
+    oStats.Add("max_size", static_cast<GInt64>(m_nMaxSize.load()));
+    oStats.Add("size", static_cast<GInt64>(nSize));
+    oStats.Add("chunk_count", static_cast<GInt64>(nChunkCount));
+    oStats.Add("hit_count", static_cast<GInt64>(m_nHits.load()));
+    oStats.Add("miss_count", static_cast<GInt64>(m_nMisses.load()));
+    oStats.Add("eviction_count", static_cast<GInt64>(m_nEvictions.load()));
+    oStats.Add("evicted_bytes", static_cast<GInt64>(m_nEvictedBytes.load()));
+    return oStats.Format(CPLJSONObject::PrettyFormat::Pretty);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                             VSICachedFile                            */
@@ -65,6 +303,8 @@ class VSICachedFile final : public VSIVirtualHandle
     VSICachedFile(VSIVirtualHandle *poBaseHandle, size_t nChunkSize,
                   size_t nCacheSize);
 
+    void SetSharedCacheKey(const std::string &osFileKey);
+
     ~VSICachedFile() override
     {
         VSICachedFile::Close();
@@ -79,9 +319,27 @@ class VSICachedFile final : public VSIVirtualHandle
     vsi_l_offset m_nFileSize = 0;
 
     size_t m_nChunkSize = 0;
-    lru11::Cache<vsi_l_offset, cpl::NonCopyableVector<GByte>>
+    lru11::Cache<vsi_l_offset, VSICachedChunkPtr>
         m_oCache;  // can only been initialized in constructor
 
+    // Set when the process-wide cache is used instead of m_oCache
+    VSICachedFileSharedCache *m_poSharedCache = nullptr;
+    std::shared_ptr<const std::string> m_poSharedCacheFileKey{};
+    size_t m_nSharedCacheFileKeyHash = 0;
+
+    VSICachedFileSharedCache::Key GetSharedCacheKey(vsi_l_offset nBlock) const
+    {
+        VSICachedFileSharedCache::Key oKey;
+        oKey.poFileKey = m_poSharedCacheFileKey;
+        oKey.nFileKeyHash = m_nSharedCacheFileKeyHash;
+        oKey.nBlock = nBlock;
+        return oKey;
+    }
+
+    bool HasBlock(vsi_l_offset nBlock);
+    VSICachedChunkPtr GetBlock(vsi_l_offset nBlock);
+    void PutBlock(vsi_l_offset nBlock, cpl::NonCopyableVector<GByte> &&oData);
+
     bool m_bEOF = false;
 
     int Seek(vsi_l_offset nOffset, int nWhence) override;
@@ -117,6 +375,12 @@ class VSICachedFile final : public VSIVirtualHandle
     {
         return m_poBase->PRead(pBuffer, nSize, nOffset);
     }
+
+    std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                             size_t nSize) override
+    {
+        return m_poBase->MapRange(nOffset, nSize);
+    }
 };
 
 /************************************************************************/
@@ -157,6 +421,61 @@ VSICachedFile::VSICachedFile(VSIVirtualHandle *poBaseHandle, size_t nChunkSize,
     m_nFileSize = m_poBase->Tell();
 }
 
+/************************************************************************/
+/*                         SetSharedCacheKey()                          */
+/************************************************************************/
+
+// Switch to the process-wide cache, with osFileKey identifying the content
+// of the file.
+void VSICachedFile::SetSharedCacheKey(const std::string &osFileKey)
+{
+    // Chunks of different sizes must not be mixed
+    m_poSharedCacheFileKey = std::make_shared<const std::string>(
+        osFileKey + '\0' + std::to_string(m_nChunkSize));
+    m_nSharedCacheFileKeyHash =
+        std::hash<std::string>()(*m_poSharedCacheFileKey);
+    m_poSharedCache = &VSICachedFileSharedCache::Get();
+    m_oCache.clear();
+}
+
+/************************************************************************/
+/*                              HasBlock()                              */
+/************************************************************************/
+
+bool VSICachedFile::HasBlock(vsi_l_offset nBlock)
+{
+    if (m_poSharedCache)
+        return m_poSharedCache->Contains(GetSharedCacheKey(nBlock));
+    return m_oCache.contains(nBlock);
+}
+
+/************************************************************************/
+/*                              GetBlock()                              */
+/************************************************************************/
+
+VSICachedChunkPtr VSICachedFile::GetBlock(vsi_l_offset nBlock)
+{
+    if (m_poSharedCache)
+        return m_poSharedCache->Lookup(GetSharedCacheKey(nBlock));
+    const VSICachedChunkPtr *ppoData = m_oCache.getPtr(nBlock);
+    return ppoData ? *ppoData : nullptr;
+}
+
+/************************************************************************/
+/*                              PutBlock()                              */
+/************************************************************************/
+
+void VSICachedFile::PutBlock(vsi_l_offset nBlock,
+                             cpl::NonCopyableVector<GByte> &&oData)
+{
+    auto poData =
+        std::make_shared<const cpl::NonCopyableVector<GByte>>(std::move(oData));
+    if (m_poSharedCache)
+        m_poSharedCache->Insert(GetSharedCacheKey(nBlock), std::move(poData));
+    else
+        m_oCache.insert(nBlock, std::move(poData));
+}
+
 /************************************************************************/
 /*                               Close()                                */
 /************************************************************************/
@@ -243,7 +562,7 @@ bool VSICachedFile::LoadBlocks(vsi_l_offset nStartBlock, size_t nBlockCount,
                 return false;
             oData.resize(nDataRead);
 
-            m_oCache.insert(nStartBlock, std::move(oData));
+            PutBlock(nStartBlock, std::move(oData));
         }
         catch (const std::exception &)
         {
@@ -320,7 +639,7 @@ bool VSICachedFile::LoadBlocks(vsi_l_offset nStartBlock, size_t nBlockCount,
             memcpy(oData.data(), pabyWorkBuffer + i * m_nChunkSize,
                    nDataFilled);
 
-            m_oCache.insert(iBlock, std::move(oData));
+            PutBlock(iBlock, std::move(oData));
         }
         catch (const std::exception &)
         {
@@ -372,17 +691,25 @@ size_t VSICachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
 
     for (vsi_l_offset iBlock = nStartBlock; iBlock <= nEndBlock; iBlock++)
     {
-        if (!m_oCache.contains(iBlock))
+        if (!HasBlock(iBlock))
         {
             size_t nBlocksToLoad = 1;
             while (iBlock + nBlocksToLoad <= nEndBlock &&
-                   !m_oCache.contains(iBlock + nBlocksToLoad))
+                   !HasBlock(iBlock + nBlocksToLoad))
             {
                 nBlocksToLoad++;
             }
 
+            if (m_poSharedCache)
+                m_poSharedCache->LogMiss(nBlocksToLoad);
             if (!LoadBlocks(iBlock, nBlocksToLoad, pBuffer, nRequestedBytes))
                 break;
+            // Skip the blocks just loaded
+            iBlock += nBlocksToLoad - 1;
+        }
+        else if (m_poSharedCache)
+        {
+            m_poSharedCache->LogHit(1);
         }
     }
 
@@ -394,14 +721,14 @@ size_t VSICachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
     while (nAmountCopied < nRequestedBytes)
     {
         const vsi_l_offset iBlock = (m_nOffset + nAmountCopied) / m_nChunkSize;
-        const cpl::NonCopyableVector<GByte> *poData = m_oCache.getPtr(iBlock);
+        VSICachedChunkPtr poData = GetBlock(iBlock);
         if (poData == nullptr)
         {
             // We can reach that point when the amount to read exceeds
             // the cache size.
             LoadBlocks(iBlock, 1, static_cast<GByte *>(pBuffer) + nAmountCopied,
                        std::min(nRequestedBytes - nAmountCopied, m_nChunkSize));
-            poData = m_oCache.getPtr(iBlock);
+            poData = GetBlock(iBlock);
             if (poData == nullptr)
             {
                 break;
@@ -476,6 +803,104 @@ int VSICachedFile::Flush()
     return 0;
 }
 
+/************************************************************************/
+/*                         IsContentHashETag()                          */
+/************************************************************************/
+
+// Whether the ETag is a MD5 hash of the content of the object, as returned
+// by S3 and compatible services for objects uploaded in a single part, or
+// a hash of the MD5 of its parts ("<md5>-<part_count>") for multipart
+// uploads. Such an ETag identifies the content whatever the URL used to
+// access it.
+static bool IsContentHashETag(const char *pszETag)
+{
+    int i = 0;
+    for (; i < 32; ++i)
+    {
+        if (!isxdigit(static_cast<unsigned char>(pszETag[i])))
+            return false;
+    }
+    if (pszETag[i] == '-')
+    {
+        ++i;
+        if (!isdigit(static_cast<unsigned char>(pszETag[i])))
+            return false;
+        while (isdigit(static_cast<unsigned char>(pszETag[i])))
+            ++i;
+    }
+    return pszETag[i] == '\0';
+}
+
+/************************************************************************/
+/*                          CreateCachedFile()                          */
+/************************************************************************/
+
+static VSIVirtualHandle *CreateCachedFile(VSIVirtualHandle *poBaseHandle,
+                                          size_t nChunkSize, size_t nCacheSize,
+                                          const char *pszFilename,
+                                          const char *pszETag, bool bShared)
+{
+    auto poFile = new VSICachedFile(poBaseHandle, nChunkSize, nCacheSize);
+    if (!bShared || pszFilename == nullptr)
+        return poFile;
+
+    std::string osFileKey;
+    const std::string osSize(std::to_string(poFile->m_nFileSize));
+    if (pszETag && IsContentHashETag(pszETag))
+    {
+        osFileKey = std::string("etag:").append(pszETag).append(":").append(
+            osSize);
+    }
+    else if (pszETag && pszETag[0])
+    {
+        osFileKey = std::string(pszFilename)
+                        .append(":")
+                        .append(osSize)
+                        .append(":etag:")
+                        .append(pszETag);
+    }
+    else
+    {
+        VSIStatBufL sStat;
+        if (VSIStatExL(pszFilename, &sStat, VSI_STAT_SIZE_FLAG) != 0 ||
+            static_cast<vsi_l_offset>(sStat.st_size) != poFile->m_nFileSize)
+        {
+            CPLDebug("VSI", "Cannot use shared cache for %s", pszFilename);
+            return poFile;
+        }
+        // A file replaced by another one, or rewritten in place with the
+        // same size within the same second, must not get the same key, so
+        // also use the device and inode numbers, and the sub-second part of
+        // the modification time, when they are available.
+        GIntBig nMTimeNanoSec = 0;
+#if defined(__linux__)
+        nMTimeNanoSec = static_cast<GIntBig>(sStat.st_mtim.tv_nsec);
+#elif defined(__APPLE__)
+        nMTimeNanoSec = static_cast<GIntBig>(sStat.st_mtimespec.tv_nsec);
+#endif
+        osFileKey = std::string(pszFilename)
+                        .append(":")
+                        .append(osSize)
+                        .append(":mtime:")
+                        .append(std::to_string(sStat.st_mtime))
+                        .append(".")
+                        .append(std::to_string(nMTimeNanoSec))
+                        .append(":dev:")
+                        .append(std::to_string(sStat.st_dev))
+                        .append(":ino:")
+                        .append(std::to_string(sStat.st_ino));
+    }
+
+    auto &oSharedCache = VSICachedFileSharedCache::Get();
+    oSharedCache.SetMaxSize(static_cast<size_t>(
+        std::min(static_cast<GUIntBig>(std::numeric_limits<size_t>::max() / 2),
+                 CPLScanUIntBig(CPLGetConfigOption("VSI_CACHE_SHARED_SIZE",
+                                                   "100000000"),
+                                40))));
+    poFile->SetSharedCacheKey(osFileKey);
+    return poFile;
+}
+
 /************************************************************************/
 /*                      VSICachedFilesystemHandler                      */
 /************************************************************************/
@@ -484,7 +909,8 @@ class VSICachedFilesystemHandler final : public VSIFilesystemHandler
 {
     static bool AnalyzeFilename(const char *pszFilename,
                                 std::string &osUnderlyingFilename,
-                                size_t &nChunkSize, size_t &nCacheSize);
+                                size_t &nChunkSize, size_t &nCacheSize,
+                                const char **ppszShared = nullptr);
 
   public:
     VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
@@ -554,7 +980,7 @@ static bool ParseSize(const char *pszKey, const char *pszValue, size_t nMaxVal,
 
 bool VSICachedFilesystemHandler::AnalyzeFilename(
     const char *pszFilename, std::string &osUnderlyingFilename,
-    size_t &nChunkSize, size_t &nCacheSize)
+    size_t &nChunkSize, size_t &nCacheSize, const char **ppszShared)
 {
 
     if (!STARTS_WITH(pszFilename, "/vsicached?"))
@@ -566,6 +992,8 @@ bool VSICachedFilesystemHandler::AnalyzeFilename(
     osUnderlyingFilename.clear();
     nChunkSize = 0;
     nCacheSize = 0;
+    if (ppszShared)
+        *ppszShared = nullptr;
 
     for (int i = 0; i < aosTokens.size(); ++i)
     {
@@ -599,6 +1027,11 @@ bool VSICachedFilesystemHandler::AnalyzeFilename(
                     return false;
                 }
             }
+            else if (strcmp(pszKey, "shared") == 0)
+            {
+                if (ppszShared)
+                    *ppszShared = CPLTestBool(pszValue) ? "YES" : "NO";
+            }
             else
             {
                 CPLError(CE_Warning, CPLE_NotSupported,
@@ -628,8 +1061,9 @@ VSIVirtualHandle *VSICachedFilesystemHandler::Open(const char *pszFilename,
     std::string osUnderlyingFilename;
     size_t nChunkSize = 0;
     size_t nCacheSize = 0;
+    const char *pszShared = nullptr;
     if (!AnalyzeFilename(pszFilename, osUnderlyingFilename, nChunkSize,
-                         nCacheSize))
+                         nCacheSize, &pszShared))
         return nullptr;
     if (strcmp(pszAccess, "r") != 0 && strcmp(pszAccess, "rb") != 0)
     {
@@ -645,7 +1079,13 @@ VSIVirtualHandle *VSICachedFilesystemHandler::Open(const char *pszFilename,
                            papszOptions);
     if (!fp)
         return nullptr;
-    return VSICreateCachedFile(fp, nChunkSize, nCacheSize);
+
+    // The shared option overrides VSI_CACHE_SHARED
+    const bool bShared =
+        CPLTestBool(pszShared ? pszShared
+                              : CPLGetConfigOption("VSI_CACHE_SHARED", "NO"));
+    return CreateCachedFile(fp, nChunkSize, nCacheSize,
+                            osUnderlyingFilename.c_str(), nullptr, bShared);
 }
 
 /************************************************************************/
@@ -693,18 +1133,89 @@ char **VSICachedFilesystemHandler::ReadDirEx(const char *pszDirname,
  * the content of the cache is discarded when the file handle is closed.
  * The cache is a least-recently used lists of blocks of 32KB each.
  *
+ * Starting with GDAL 3.10, if pszFilename is set and the VSI_CACHE_SHARED
+ * configuration option is set to YES, a process-wide cache, shared by all
+ * handles opened that way, is used instead of a cache private to the handle.
+ * Its size is set by the VSI_CACHE_SHARED_SIZE configuration option (100 MB
+ * by default), and nCacheSize is then ignored. Chunks are keyed by the
+ * identity of the file: its filename, size, and ETag or modification time.
+ * When pszETag is a hash of the content (as the ETag of S3 objects), the
+ * filename is not part of that identity, so that different URLs of the same
+ * object share chunks.
+ *
  * @param poBaseHandle base handle
  * @param nChunkSize chunk size, in bytes. If 0, defaults to 32 KB
  * @param nCacheSize total size of the cache for the file, in bytes.
  *                   If 0, defaults to the value of the VSI_CACHE_SIZE
  *                   configuration option, which defaults to 25 MB.
+ * @param pszFilename filename of the base handle, or nullptr.
+ *                    (added in GDAL 3.10)
+ * @param pszETag ETag of the file, or nullptr. (added in GDAL 3.10)
  * @return a new handle
  */
 VSIVirtualHandle *VSICreateCachedFile(VSIVirtualHandle *poBaseHandle,
-                                      size_t nChunkSize, size_t nCacheSize)
+                                      size_t nChunkSize, size_t nCacheSize,
+                                      const char *pszFilename,
+                                      const char *pszETag)
+
+{
+    return CreateCachedFile(
+        poBaseHandle, nChunkSize, nCacheSize, pszFilename, pszETag,
+        CPLTestBool(CPLGetConfigOption("VSI_CACHE_SHARED", "NO")));
+}
 
+/************************************************************************/
+/*                     VSICachedFileStatsReset()                        */
+/************************************************************************/
+
+/**
+ * \brief Clear statistics of the process-wide cache of cached files.
+ *
+ * @see VSICachedFileStatsGetAsSerializedJSON()
+ * @since GDAL 3.10
+ */
+void VSICachedFileStatsReset(void)
+{
+    VSICachedFileSharedCache::Get().ResetStats();
+}
+
+/************************************************************************/
+/*                VSICachedFileStatsGetAsSerializedJSON()               */
+/************************************************************************/
+
+/**
+ * \brief Return statistics of the process-wide cache of cached files.
+ *
+ * That cache is used when the VSI_CACHE_SHARED configuration option is set
+ * to YES, or with the shared=yes option of /vsicached?.
+ *
+ * The statistics are returned as a JSON object with the following members:
+ * max_size, size (in bytes), chunk_count, hit_count, miss_count (number of
+ * chunks looked up by reads, found or not in the cache), eviction_count and
+ * evicted_bytes.
+ *
+ * @param papszOptions Unused.
+ * @return a JSON serialized string to free with VSIFree(), or nullptr
+ * @since GDAL 3.10
+ */
+char *VSICachedFileStatsGetAsSerializedJSON(CPL_UNUSED char **papszOptions)
+{
+    return CPLStrdup(
+        VSICachedFileSharedCache::Get().GetStatsAsSerializedJSON().c_str());
+}
+
+/************************************************************************/
+/*                  VSICachedFileClearSharedCache()                     */
+/************************************************************************/
+
+/**
+ * \brief Discard the content of the process-wide cache of cached files.
+ *
+ * @since GDAL 3.10
+ */
+void VSICachedFileClearSharedCache(void)
 {
-    return new VSICachedFile(poBaseHandle, nChunkSize, nCacheSize);
+    VSICachedFileSharedCache::Get().Clear();
 }
 
 /************************************************************************/
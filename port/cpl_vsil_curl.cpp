@@ -481,6 +481,8 @@ VSICurlHandle::VSICurlHandle(VSICurlFilesystemHandlerBase *poFSIn,
     }
 
     m_bCached = poFSIn->AllowCachedDataFor(pszFilename);
+    if (m_bCached)
+        m_poDiskCache = VSICurlDiskCache::Get();
     poFS->GetCachedFileProp(m_pszURL, oFileProp);
 }
 
@@ -494,6 +496,7 @@ VSICurlHandle::~VSICurlHandle()
     {
         m_oThreadAdviseRead.join();
     }
+    StopReadAhead();
 
     if (!m_bCached)
     {
@@ -640,6 +643,7 @@ void VSICURLInitWriteFuncStruct(cpl::WriteFuncStruct *psStruct, VSILFILE *fp,
     psStruct->bError = false;
     psStruct->bDetectRangeDownloadingError = true;
     psStruct->nTimestampDate = 0;
+    psStruct->osDeferredError.clear();
 
     psStruct->fp = fp;
     psStruct->pfnReadCbk = pfnReadCbk;
@@ -647,6 +651,10 @@ void VSICURLInitWriteFuncStruct(cpl::WriteFuncStruct *psStruct, VSILFILE *fp,
     psStruct->bInterrupted = false;
 }
 
+// Set in the thread of the connection pool, whose curl callbacks must not
+// emit errors on behalf of the requesting threads.
+static thread_local bool gbInConnectionPoolThread = false;
+
 /************************************************************************/
 /*                       VSICurlHandleWriteFunc()                       */
 /************************************************************************/
@@ -728,9 +736,12 @@ size_t VSICurlHandleWriteFunc(void *buffer, size_t count, size_t nmemb,
                          10 * (psStruct->nEndOffset - psStruct->nStartOffset +
                                1)))
                 {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Range downloading not supported by this "
-                             "server!");
+                    const char *pszMsg =
+                        "Range downloading not supported by this server!";
+                    if (gbInConnectionPoolThread)
+                        psStruct->osDeferredError = pszMsg;
+                    else
+                        CPLError(CE_Failure, CPLE_AppDefined, "%s", pszMsg);
                     psStruct->bError = true;
                     return 0;
                 }
@@ -828,12 +839,261 @@ static GIntBig VSICurlGetExpiresFromS3LikeSignedURL(const char *pszURL)
     return CPLYMDHMSToUnixTime(&brokendowntime) + nDelay;
 }
 
+/************************************************************************/
+/*                       VSICurlConnectionPool                          */
+/************************************************************************/
+
+namespace
+{
+
+// Process-wide manager of the connections used by single requests when
+// GDAL_HTTP_CONNECTION_POOL is enabled. All requests, whatever their
+// originating thread, are driven by a single multi handle owned by a
+// dedicated thread, so that they are multiplexed over a small number of
+// HTTP/2 connections per host, instead of each thread (and each handle)
+// opening its own connections.
+// The callbacks of the requests (write, header, read and progress functions,
+// hence also the ones installed with VSICurlInstallReadCbk()) are invoked
+// from the thread of the pool, while the calling thread waits for the
+// completion of its request. They must thus not rely on thread-local state
+// of the calling thread, such as its error handlers.
+// Callers of Get() keep the returned reference during Perform(), so that
+// Destroy() only releases the process-wide instance, which is deleted, and
+// its thread stopped, once the last in-flight request has returned.
+class VSICurlConnectionPool
+{
+  public:
+    static std::shared_ptr<VSICurlConnectionPool> Get();
+    static void Destroy();
+
+    ~VSICurlConnectionPool();
+
+    void Perform(CURL *hEasyHandle);
+
+  private:
+    struct Request
+    {
+        CURL *hEasyHandle = nullptr;
+        bool bDone = false;
+        bool bPerformed = false;
+        std::condition_variable oCV{};
+    };
+
+    static std::mutex goInstanceMutex;
+    static std::shared_ptr<VSICurlConnectionPool> gpoInstance;
+
+    CURLM *m_hCurlMultiHandle = nullptr;
+    std::mutex m_oMutex{};
+    std::vector<Request *> m_apoPendingRequests{};
+    bool m_bStop = false;
+    std::thread m_oThread{};
+
+    VSICurlConnectionPool();
+    void ThreadFunc();
+
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlConnectionPool)
+};
+
+std::mutex VSICurlConnectionPool::goInstanceMutex{};
+std::shared_ptr<VSICurlConnectionPool> VSICurlConnectionPool::gpoInstance{};
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+std::shared_ptr<VSICurlConnectionPool> VSICurlConnectionPool::Get()
+{
+    std::lock_guard<std::mutex> oLock(goInstanceMutex);
+    if (!gpoInstance)
+        gpoInstance.reset(new VSICurlConnectionPool());
+    return gpoInstance;
+}
+
+/************************************************************************/
+/*                              Destroy()                               */
+/************************************************************************/
+
+void VSICurlConnectionPool::Destroy()
+{
+    // Release the instance outside of the lock, as its destructor waits for
+    // the running requests.
+    std::shared_ptr<VSICurlConnectionPool> poInstance;
+    {
+        std::lock_guard<std::mutex> oLock(goInstanceMutex);
+        std::swap(poInstance, gpoInstance);
+    }
+}
+
+/************************************************************************/
+/*                       VSICurlConnectionPool()                        */
+/************************************************************************/
+
+VSICurlConnectionPool::VSICurlConnectionPool()
+    : m_hCurlMultiHandle(curl_multi_init())
+{
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        curl_multi_setopt(m_hCurlMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+    const long nMaxHostConnections = std::max(
+        1, atoi(CPLGetConfigOption("GDAL_HTTP_MAX_HOST_CONNECTIONS", "6")));
+    curl_multi_setopt(m_hCurlMultiHandle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      nMaxHostConnections);
+    CPLDebug("VSICURL", "Starting connection pool with %ld connections/host",
+             nMaxHostConnections);
+
+    m_oThread = std::thread([this]() { ThreadFunc(); });
+}
+
+/************************************************************************/
+/*                      ~VSICurlConnectionPool()                        */
+/************************************************************************/
+
+VSICurlConnectionPool::~VSICurlConnectionPool()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bStop = true;
+    }
+    curl_multi_wakeup(m_hCurlMultiHandle);
+    m_oThread.join();
+    VSICURLMultiCleanup(m_hCurlMultiHandle);
+}
+
+/************************************************************************/
+/*                              Perform()                               */
+/************************************************************************/
+
+void VSICurlConnectionPool::Perform(CURL *hEasyHandle)
+{
+    // Wait for a connection that can be multiplexed rather than opening a
+    // new one.
+    unchecked_curl_easy_setopt(hEasyHandle, CURLOPT_PIPEWAIT, 1);
+
+    Request oRequest;
+    oRequest.hEasyHandle = hEasyHandle;
+
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        if (!m_bStop)
+        {
+            m_apoPendingRequests.push_back(&oRequest);
+            curl_multi_wakeup(m_hCurlMultiHandle);
+            oRequest.oCV.wait(oLock, [&oRequest] { return oRequest.bDone; });
+        }
+    }
+
+    // The pool is being stopped and has not started the request: perform
+    // it from the calling thread.
+    if (!oRequest.bPerformed)
+    {
+        void *old_handler = CPLHTTPIgnoreSigPipe();
+        curl_easy_perform(hEasyHandle);
+        CPLHTTPRestoreSigPipeHandler(old_handler);
+    }
+}
+
+/************************************************************************/
+/*                             ThreadFunc()                             */
+/************************************************************************/
+
+void VSICurlConnectionPool::ThreadFunc()
+{
+    gbInConnectionPoolThread = true;
+
+    std::map<CURL *, Request *> oMapRunningRequests;
+    std::vector<Request *> apoNewRequests;
+    const auto NotifyDone = [this](Request *poRequest)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        poRequest->bDone = true;
+        poRequest->bPerformed = true;
+        poRequest->oCV.notify_one();
+    };
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            if (m_bStop)
+            {
+                // Requests not started yet are given back to their calling
+                // thread, and the running ones are completed.
+                for (Request *poRequest : m_apoPendingRequests)
+                {
+                    poRequest->bDone = true;
+                    poRequest->oCV.notify_one();
+                }
+                m_apoPendingRequests.clear();
+                if (oMapRunningRequests.empty())
+                    break;
+            }
+            std::swap(apoNewRequests, m_apoPendingRequests);
+        }
+        for (Request *poRequest : apoNewRequests)
+        {
+            curl_multi_add_handle(m_hCurlMultiHandle, poRequest->hEasyHandle);
+            oMapRunningRequests[poRequest->hEasyHandle] = poRequest;
+        }
+        apoNewRequests.clear();
+
+        void *old_handler = CPLHTTPIgnoreSigPipe();
+        int still_running = 0;
+        while (curl_multi_perform(m_hCurlMultiHandle, &still_running) ==
+               CURLM_CALL_MULTI_PERFORM)
+        {
+            // loop
+        }
+        CPLHTTPRestoreSigPipeHandler(old_handler);
+
+        int msgq = 0;
+        while (CURLMsg *msg = curl_multi_info_read(m_hCurlMultiHandle, &msgq))
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            CURL *hEasyHandle = msg->easy_handle;
+            curl_multi_remove_handle(m_hCurlMultiHandle, hEasyHandle);
+            auto oIter = oMapRunningRequests.find(hEasyHandle);
+            if (oIter != oMapRunningRequests.end())
+            {
+                NotifyDone(oIter->second);
+                oMapRunningRequests.erase(oIter);
+            }
+        }
+
+        curl_multi_poll(m_hCurlMultiHandle, nullptr, 0, 1000, nullptr);
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                    VSICURLDestroyConnectionPool()                    */
+/************************************************************************/
+
+void VSICURLDestroyConnectionPool()
+{
+    VSICurlConnectionPool::Destroy();
+}
+
 /************************************************************************/
 /*                       VSICURLMultiPerform()                          */
 /************************************************************************/
 
 void VSICURLMultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
 {
+    // Single requests go through the process-wide connection pool when it
+    // is enabled.
+    if (hEasyHandle && CPLHTTPIsConnectionPoolEnabled())
+    {
+        // Holding the reference keeps the pool alive until the request is
+        // done, even if VSICURLDestroyConnectionPool() is called meanwhile.
+        const auto poPool = VSICurlConnectionPool::Get();
+        poPool->Perform(hEasyHandle);
+        return;
+    }
+
     int repeats = 0;
 
     if (hEasyHandle)
@@ -1060,6 +1320,33 @@ vsi_l_offset VSICurlHandle::GetFileSizeOrHeaders(bool bSetError,
     if (oFileProp.bHasComputedFileSize && !bGetHeaders)
         return oFileProp.fileSize;
 
+    // Use the file properties persisted in the disk cache if they have been
+    // validated recently enough, or revalidate them with a conditional
+    // request otherwise.
+    FileProp oDiskFileProp;
+    bool bHasDiskFileProp = false;
+    if (m_poDiskCache && !bGetHeaders)
+    {
+        GIntBig nValidationTime = 0;
+        if (m_poDiskCache->GetFileProp(m_pszURL, oDiskFileProp,
+                                       nValidationTime))
+        {
+            if (static_cast<GIntBig>(time(nullptr)) - nValidationTime <
+                m_poDiskCache->GetMaxAge())
+            {
+                oFileProp.eExists = EXIST_YES;
+                oFileProp.bIsDirectory = false;
+                oFileProp.fileSize = oDiskFileProp.fileSize;
+                oFileProp.ETag = oDiskFileProp.ETag;
+                oFileProp.mTime = oDiskFileProp.mTime;
+                oFileProp.bHasComputedFileSize = true;
+                poFS->SetCachedFileProp(m_pszURL, oFileProp);
+                return oFileProp.fileSize;
+            }
+            bHasDiskFileProp = STARTS_WITH(m_pszURL, "http");
+        }
+    }
+
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix().c_str());
     NetworkStatisticsFile oContextFile(m_osFilename.c_str());
     NetworkStatisticsAction oContextAction("GetFileSize");
@@ -1147,6 +1434,30 @@ retry:
     szCurlErrBuf[0] = '\0';
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER, szCurlErrBuf);
 
+    // Conditional request to revalidate the properties of the disk cache
+    // (before GetCurlHeaders(), so that it is included in signatures)
+    std::string osConditionalHeader;  // leave in this scope !
+    if (bHasDiskFileProp)
+    {
+        if (!oDiskFileProp.ETag.empty())
+        {
+            osConditionalHeader = "If-None-Match: \"";
+            osConditionalHeader += oDiskFileProp.ETag;
+            osConditionalHeader += '"';
+        }
+        else
+        {
+            struct tm brokenDown;
+            CPLUnixTimeToYMDHMS(oDiskFileProp.mTime, &brokenDown);
+            char szDate[64] = {};
+            CPLPrintTime(szDate, sizeof(szDate) - 1,
+                         "%a, %d %b %Y %H:%M:%S GMT", &brokenDown, "C");
+            osConditionalHeader = "If-Modified-Since: ";
+            osConditionalHeader += szDate;
+        }
+        headers = curl_slist_append(headers, osConditionalHeader.c_str());
+    }
+
     headers = VSICurlMergeHeaders(headers, GetCurlHeaders(osVerb, headers));
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
@@ -1384,7 +1695,19 @@ retry:
             }
         }
 
-        if (UseLimitRangeGetInsteadOfHead() && response_code == 206)
+        if (bHasDiskFileProp && response_code == 304)
+        {
+            CPLDebug(poFS->GetDebugKey(),
+                     "File properties of %s revalidated from disk cache",
+                     m_pszURL);
+            oFileProp.eExists = EXIST_YES;
+            oFileProp.bIsDirectory = false;
+            oFileProp.fileSize = oDiskFileProp.fileSize;
+            oFileProp.ETag = oDiskFileProp.ETag;
+            oFileProp.mTime = oDiskFileProp.mTime;
+            mtime = 0;
+        }
+        else if (UseLimitRangeGetInsteadOfHead() && response_code == 206)
         {
             oFileProp.eExists = EXIST_NO;
             oFileProp.fileSize = 0;
@@ -1407,6 +1730,8 @@ retry:
                 // Add first bytes to cache
                 if (sWriteFuncData.pBuffer != nullptr)
                 {
+                    if (mtime > 0)
+                        oFileProp.mTime = mtime;
                     size_t nOffset = 0;
                     while (nOffset < sWriteFuncData.nSize)
                     {
@@ -1415,6 +1740,12 @@ retry:
                                              knDOWNLOAD_CHUNK_SIZE);
                         poFS->AddRegion(m_pszURL, nOffset, nToCache,
                                         sWriteFuncData.pBuffer + nOffset);
+                        if (m_poDiskCache && oFileProp.eExists == EXIST_YES)
+                        {
+                            m_poDiskCache->PutChunk(
+                                m_pszURL, oFileProp, nOffset,
+                                sWriteFuncData.pBuffer + nOffset, nToCache);
+                        }
                         nOffset += nToCache;
                     }
                 }
@@ -1554,6 +1885,14 @@ retry:
         oFileProp.mTime = mtime;
     poFS->SetCachedFileProp(m_pszURL, oFileProp);
 
+    if (m_poDiskCache && !bGetHeaders)
+    {
+        if (oFileProp.eExists == EXIST_YES)
+            m_poDiskCache->PutFileProp(m_pszURL, oFileProp);
+        else if (bHasDiskFileProp && oFileProp.eExists == EXIST_NO)
+            m_poDiskCache->RemoveFileProp(m_pszURL);
+    }
+
     return oFileProp.fileSize;
 }
 
@@ -1871,6 +2210,10 @@ retry:
 
     VSICURLMultiPerform(hCurlMultiHandle, hCurlHandle);
 
+    if (!sWriteFuncHeaderData.osDeferredError.empty())
+        CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                 sWriteFuncHeaderData.osDeferredError.c_str());
+
     VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
 
     curl_slist_free_all(headers);
@@ -2188,6 +2531,11 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
         const size_t nChunkSize =
             std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
         poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
+        if (m_poDiskCache)
+        {
+            m_poDiskCache->PutChunk(m_pszURL, oFileProp, l_startOffset,
+                                    pBuffer, nChunkSize);
+        }
         l_startOffset += nChunkSize;
         pBuffer += nChunkSize;
         nSize -= nChunkSize;
@@ -2219,10 +2567,16 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     vsi_l_offset iterOffset = curOffset;
     const int knMAX_REGIONS = GetMaxRegions();
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const bool bReadAhead = IsReadAheadEnabled();
+    if (bReadAhead)
+        UpdateAccessPattern(curOffset, nBufferRequestSize);
     while (nBufferRequestSize)
     {
         // Don't try to read after end of file.
         poFS->GetCachedFileProp(m_pszURL, oFileProp);
+        // The disk cache needs the ETag or modification time of the file.
+        if (m_poDiskCache && !oFileProp.bHasComputedFileSize)
+            GetFileSize(false);
         if (oFileProp.bHasComputedFileSize && iterOffset >= oFileProp.fileSize)
         {
             if (iterOffset == curOffset)
@@ -2240,10 +2594,24 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         std::string osRegion;
         std::shared_ptr<std::string> psRegion =
             poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        if (psRegion == nullptr && bReadAhead &&
+            WaitForReadAhead(nOffsetToDownload))
+        {
+            psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        }
         if (psRegion != nullptr)
         {
+            if (bReadAhead)
+                MarkReadAheadConsumed(nOffsetToDownload);
             osRegion = *psRegion;
         }
+        else if (m_poDiskCache &&
+                 m_poDiskCache->GetChunk(m_pszURL, oFileProp,
+                                         nOffsetToDownload, osRegion))
+        {
+            poFS->AddRegion(m_pszURL, nOffsetToDownload, osRegion.size(),
+                            osRegion.data());
+        }
         else
         {
             if (nOffsetToDownload == lastDownloadedOffset)
@@ -2279,10 +2647,14 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             // this should not cause bugs. Just missed optimization.
             for (int i = 1; i < nBlocksToDownload; i++)
             {
-                if (poFS->GetRegion(m_pszURL, nOffsetToDownload +
-                                                  static_cast<vsi_l_offset>(i) *
-                                                      knDOWNLOAD_CHUNK_SIZE) !=
-                    nullptr)
+                const vsi_l_offset nBlockOffset =
+                    nOffsetToDownload +
+                    static_cast<vsi_l_offset>(i) * knDOWNLOAD_CHUNK_SIZE;
+                if (poFS->GetRegion(m_pszURL, nBlockOffset) != nullptr ||
+                    (m_poDiskCache &&
+                     m_poDiskCache->HasChunk(m_pszURL, oFileProp,
+                                             nBlockOffset)) ||
+                    (bReadAhead && IsReadAheadInFlight(nBlockOffset)))
                 {
                     nBlocksToDownload = i;
                     break;
@@ -2295,6 +2667,12 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload > knMAX_REGIONS)
                 nBlocksToDownload = knMAX_REGIONS;
 
+            if (bReadAhead && m_nAccessPatternCount >= 2 &&
+                m_eAccessPattern != AccessPattern::RANDOM)
+            {
+                NetworkStatisticsLogger::LogReadAheadMiss();
+            }
+
             osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
             if (osRegion.empty())
             {
@@ -2337,9 +2715,513 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
 
     curOffset = iterOffset;
 
+    if (bReadAhead)
+        LaunchReadAhead();
+
     return ret;
 }
 
+/************************************************************************/
+/*                        IsReadAheadEnabled()                          */
+/************************************************************************/
+
+bool VSICurlHandle::IsReadAheadEnabled()
+{
+    if (m_nReadAheadEnabled < 0)
+    {
+        m_nReadAheadEnabled =
+            CanReadAhead() &&
+            CPLTestBool(CPLGetConfigOption("CPL_VSIL_CURL_READ_AHEAD", "NO"));
+    }
+    return m_nReadAheadEnabled == TRUE;
+}
+
+/************************************************************************/
+/*                        UpdateAccessPattern()                         */
+/************************************************************************/
+
+// Classifies the access pattern of the handle from the offsets of the
+// successive Read() calls.
+void VSICurlHandle::UpdateAccessPattern(vsi_l_offset nOffset, size_t nSize)
+{
+    const vsi_l_offset knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    AccessPattern ePattern = AccessPattern::RANDOM;
+    GIntBig nStride = 0;
+    if (m_nLastReadOffset != VSI_L_OFFSET_MAX)
+    {
+        // Small forward gaps and backward hops, as emitted by readers that
+        // skip padding or re-read a few bytes, keep the access sequential.
+        const vsi_l_offset nLastEnd = m_nLastReadOffset + m_nLastReadSize;
+        if (nOffset + knDOWNLOAD_CHUNK_SIZE >= nLastEnd &&
+            nOffset <= nLastEnd + knDOWNLOAD_CHUNK_SIZE)
+        {
+            ePattern = AccessPattern::SEQUENTIAL;
+        }
+        else
+        {
+            nStride = static_cast<GIntBig>(nOffset) -
+                      static_cast<GIntBig>(m_nLastReadOffset);
+            if (nStride == m_nLastReadStride)
+                ePattern = AccessPattern::STRIDED;
+        }
+    }
+
+    if (ePattern == m_eAccessPattern)
+    {
+        if (m_nAccessPatternCount < INT_MAX)
+            m_nAccessPatternCount++;
+    }
+    else
+    {
+        m_eAccessPattern = ePattern;
+        m_nAccessPatternCount = 1;
+        m_nReadAheadBlocks = 0;
+
+        // Forget the windows of the previous pattern
+        m_oSetReadAheadChunks.clear();
+        std::lock_guard<std::mutex> oLock(m_oReadAheadMutex);
+        if (m_poReadAhead && m_poReadAhead->bDone)
+            m_poReadAhead.reset();
+    }
+    m_nLastReadOffset = nOffset;
+    m_nLastReadSize = nSize;
+    m_nLastReadStride = nStride;
+}
+
+/************************************************************************/
+/*                        IsReadAheadInFlight()                         */
+/************************************************************************/
+
+bool VSICurlHandle::IsReadAheadInFlight(vsi_l_offset nOffset)
+{
+    std::lock_guard<std::mutex> oLock(m_oReadAheadMutex);
+    return m_poReadAhead && !m_poReadAhead->bDone &&
+           nOffset >= m_poReadAhead->nStartOffset &&
+           (nOffset - m_poReadAhead->nStartOffset) /
+                   VSICURLGetDownloadChunkSize() <
+               static_cast<vsi_l_offset>(m_poReadAhead->nBlocks);
+}
+
+/************************************************************************/
+/*                         WaitForReadAhead()                           */
+/************************************************************************/
+
+// Waits for the completion of the read-ahead in flight if it covers nOffset.
+// Returns true if it did.
+bool VSICurlHandle::WaitForReadAhead(vsi_l_offset nOffset)
+{
+    std::unique_lock<std::mutex> oLock(m_oReadAheadMutex);
+    if (!m_poReadAhead || m_poReadAhead->bDone ||
+        nOffset < m_poReadAhead->nStartOffset ||
+        (nOffset - m_poReadAhead->nStartOffset) /
+                VSICURLGetDownloadChunkSize() >=
+            static_cast<vsi_l_offset>(m_poReadAhead->nBlocks))
+    {
+        return false;
+    }
+    // coverity[missing_lock:FALSE]
+    while (!m_poReadAhead->bDone)
+    {
+        m_oReadAheadCV.wait(oLock);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       MarkReadAheadConsumed()                        */
+/************************************************************************/
+
+void VSICurlHandle::MarkReadAheadConsumed(vsi_l_offset nOffset)
+{
+    if (m_oSetReadAheadChunks.erase(nOffset) > 0)
+        NetworkStatisticsLogger::LogReadAheadHit();
+}
+
+/************************************************************************/
+/*                          LaunchReadAhead()                           */
+/************************************************************************/
+
+// Once a sequential or strided access pattern has been confirmed, prefetch
+// in a background thread the chunks the next Read() calls will need, while
+// the caller processes the current ones. Only one read-ahead request is in
+// flight per handle, and the downloaded chunks go to the region cache.
+void VSICurlHandle::LaunchReadAhead()
+{
+    if (m_nAccessPatternCount < 2 ||
+        m_eAccessPattern == AccessPattern::RANDOM ||
+        m_eAccessPattern == AccessPattern::UNKNOWN || pfnReadCbk ||
+        bInterrupted || oFileProp.eExists == EXIST_NO)
+    {
+        return;
+    }
+
+    bool bPreviousConsumed = false;
+    {
+        std::lock_guard<std::mutex> oLock(m_oReadAheadMutex);
+        if (m_poReadAhead)
+        {
+            if (!m_poReadAhead->bDone)
+                return;
+            bPreviousConsumed = m_oSetReadAheadChunks.find(
+                                    m_poReadAhead->nStartOffset) ==
+                                m_oSetReadAheadChunks.end();
+            // Do not get more than one window ahead of the reader
+            if (m_poReadAhead->bSuccess && !bPreviousConsumed)
+                return;
+        }
+    }
+
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    // Keep the window well below the capacity of the region cache, so that
+    // prefetched chunks are not evicted before being read.
+    constexpr int MAX_READ_AHEAD_BLOCKS = 128;
+    const int nMaxBlocks =
+        std::max(1, std::min(MAX_READ_AHEAD_BLOCKS, GetMaxRegions() / 2));
+
+    vsi_l_offset nStartOffset;
+    int nBlocks;
+    if (m_eAccessPattern == AccessPattern::SEQUENTIAL)
+    {
+        // Double the window each time the reader catches up with the
+        // previous one.
+        const int nReadBlocks = static_cast<int>(
+            std::min<size_t>(nMaxBlocks, 1 + m_nLastReadSize /
+                                                 knDOWNLOAD_CHUNK_SIZE));
+        if (m_nReadAheadBlocks == 0)
+            m_nReadAheadBlocks = std::max(2, nReadBlocks);
+        else if (bPreviousConsumed)
+            m_nReadAheadBlocks *= 2;
+        m_nReadAheadBlocks = std::min(m_nReadAheadBlocks, nMaxBlocks);
+        nStartOffset =
+            (curOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        nBlocks = m_nReadAheadBlocks;
+    }
+    else
+    {
+        // Predict that the next read will be one stride away, with the
+        // same size.
+        if (m_nLastReadStride < 0 &&
+            m_nLastReadOffset < static_cast<vsi_l_offset>(-m_nLastReadStride))
+        {
+            return;
+        }
+        const vsi_l_offset nNextOffset = m_nLastReadOffset + m_nLastReadStride;
+        nStartOffset =
+            (nNextOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+        const vsi_l_offset nEndOffset = nNextOffset + m_nLastReadSize;
+        nBlocks = static_cast<int>(std::min<vsi_l_offset>(
+            nMaxBlocks,
+            (nEndOffset - nStartOffset + knDOWNLOAD_CHUNK_SIZE - 1) /
+                knDOWNLOAD_CHUNK_SIZE));
+    }
+
+    const auto IsCached = [this](vsi_l_offset nOffset)
+    {
+        return poFS->GetRegion(m_pszURL, nOffset) != nullptr ||
+               (m_poDiskCache &&
+                m_poDiskCache->HasChunk(m_pszURL, oFileProp, nOffset));
+    };
+
+    // Skip the leading chunks that are already available, and stop the
+    // window at the next available one.
+    while (nBlocks > 0 && IsCached(nStartOffset))
+    {
+        nStartOffset += knDOWNLOAD_CHUNK_SIZE;
+        nBlocks--;
+    }
+    for (int i = 1; i < nBlocks; i++)
+    {
+        if (IsCached(nStartOffset +
+                     static_cast<vsi_l_offset>(i) * knDOWNLOAD_CHUNK_SIZE))
+        {
+            nBlocks = i;
+            break;
+        }
+    }
+    if (nBlocks == 0)
+        return;
+
+    vsi_l_offset nEndOffset =
+        nStartOffset +
+        static_cast<vsi_l_offset>(nBlocks) * knDOWNLOAD_CHUNK_SIZE - 1;
+    if (oFileProp.bHasComputedFileSize)
+    {
+        if (nStartOffset >= oFileProp.fileSize)
+            return;
+        if (nEndOffset >= oFileProp.fileSize)
+            nEndOffset = oFileProp.fileSize - 1;
+    }
+
+    ManagePlanetaryComputerSigning();
+
+    bool bHasExpired = false;
+    const std::string osURL(GetRedirectURLIfValid(bHasExpired));
+    if (bHasExpired)
+        return;
+
+    // Everything that depends on the state of the handle, including the
+    // authentication headers, is prepared here, so that the read-ahead
+    // thread only has to run the request.
+    auto poReq = std::make_unique<ReadAheadRequest>();
+    poReq->nStartOffset = nStartOffset;
+    poReq->nBlocks = nBlocks;
+    poReq->oFileProp = oFileProp;
+
+    CURL *hCurlHandle = curl_easy_init();
+    poReq->hCurlHandle = hCurlHandle;
+    struct curl_slist *headers =
+        VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
+
+    if (!AllowAutomaticRedirection())
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_FOLLOWLOCATION, 0);
+
+    VSICURLInitWriteFuncStruct(&poReq->sWriteFuncData, nullptr, nullptr,
+                               nullptr);
+    unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                               &poReq->sWriteFuncData);
+    unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                               VSICurlHandleWriteFunc);
+
+    VSICURLInitWriteFuncStruct(&poReq->sWriteFuncHeaderData, nullptr, nullptr,
+                               nullptr);
+    unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                               &poReq->sWriteFuncHeaderData);
+    unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                               VSICurlHandleWriteFunc);
+    // The response code is checked by the read-ahead thread, which must not
+    // emit errors.
+    poReq->sWriteFuncHeaderData.bDetectRangeDownloadingError = false;
+    poReq->sWriteFuncHeaderData.bIsHTTP = STARTS_WITH(m_pszURL, "http");
+    poReq->sWriteFuncHeaderData.nStartOffset = nStartOffset;
+    poReq->sWriteFuncHeaderData.nEndOffset = nEndOffset;
+
+    char rangeStr[512] = {};
+    snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+             nStartOffset, nEndOffset);
+
+    if (ENABLE_DEBUG)
+        CPLDebug(poFS->GetDebugKey(), "Read-ahead of %s (%s access) (%s)...",
+                 rangeStr,
+                 m_eAccessPattern == AccessPattern::SEQUENTIAL ? "sequential"
+                                                               : "strided",
+                 osURL.c_str());
+
+    if (poReq->sWriteFuncHeaderData.bIsHTTP)
+    {
+        // So it gets included in Azure signature
+        headers = curl_slist_append(
+            headers, CPLSPrintf("Range: bytes=%s", rangeStr));
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+    }
+    else
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+
+    headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+    unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+    poReq->headers = headers;
+
+    // Only chunks close to the current position are worth remembering
+    if (m_oSetReadAheadChunks.size() > static_cast<size_t>(2 * nMaxBlocks))
+        m_oSetReadAheadChunks.clear();
+    for (int i = 0; i < nBlocks; i++)
+    {
+        m_oSetReadAheadChunks.insert(nStartOffset +
+                                     static_cast<vsi_l_offset>(i) *
+                                         knDOWNLOAD_CHUNK_SIZE);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oReadAheadMutex);
+        m_poReadAhead = std::move(poReq);
+        m_oReadAheadCV.notify_all();
+    }
+    if (!m_oThreadReadAhead.joinable())
+    {
+        m_oThreadReadAhead = std::thread([this]() { ReadAheadThreadFunc(); });
+    }
+}
+
+/************************************************************************/
+/*                        ReadAheadThreadFunc()                         */
+/************************************************************************/
+
+void VSICurlHandle::ReadAheadThreadFunc()
+{
+    // Owned by this thread, so that connections are reused between the
+    // successive read-ahead requests of the handle.
+    CURLM *hCurlMultiHandle = curl_multi_init();
+
+    std::unique_lock<std::mutex> oLock(m_oReadAheadMutex);
+    while (true)
+    {
+        // coverity[missing_lock:FALSE]
+        while (!m_bStopReadAhead && (!m_poReadAhead || m_poReadAhead->bDone))
+        {
+            m_oReadAheadCV.wait(oLock);
+        }
+        if (m_bStopReadAhead)
+            break;
+
+        // The request cannot be replaced by the main thread until bDone is
+        // set.
+        ReadAheadRequest *poReq = m_poReadAhead.get();
+        oLock.unlock();
+
+        {
+            NetworkStatisticsFileSystem oContextFS(
+                poFS->GetFSPrefix().c_str());
+            NetworkStatisticsFile oContextFile(m_osFilename.c_str());
+            NetworkStatisticsAction oContextAction("ReadAhead");
+
+            // Coordinate with downloads of the same region by other handles
+            CurrentDownload currentDownload(
+                poFS, m_pszURL, poReq->nStartOffset, poReq->nBlocks);
+            if (currentDownload.HasAlreadyDownloadedData())
+            {
+                poReq->bSuccess =
+                    !currentDownload.GetAlreadyDownloadedData().empty();
+            }
+            else
+            {
+                VSICURLMultiPerform(hCurlMultiHandle, poReq->hCurlHandle);
+
+                NetworkStatisticsLogger::LogGET(poReq->sWriteFuncData.nSize);
+
+                long response_code = 0;
+                curl_easy_getinfo(poReq->hCurlHandle, CURLINFO_HTTP_CODE,
+                                  &response_code);
+                const auto &sHeader = poReq->sWriteFuncHeaderData;
+                size_t nSize = poReq->sWriteFuncData.nSize;
+                if ((response_code == 206 || response_code == 225) &&
+                    nSize == sHeader.nEndOffset - sHeader.nStartOffset + 1)
+                {
+                    const int knDOWNLOAD_CHUNK_SIZE =
+                        VSICURLGetDownloadChunkSize();
+                    const char *pBuffer = poReq->sWriteFuncData.pBuffer;
+                    vsi_l_offset nOffset = poReq->nStartOffset;
+                    while (nSize > 0)
+                    {
+                        const size_t nChunkSize = std::min(
+                            static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
+                        poFS->AddRegion(m_pszURL, nOffset, nChunkSize, pBuffer);
+                        if (m_poDiskCache)
+                        {
+                            m_poDiskCache->PutChunk(m_pszURL, poReq->oFileProp,
+                                                    nOffset, pBuffer,
+                                                    nChunkSize);
+                        }
+                        nOffset += nChunkSize;
+                        pBuffer += nChunkSize;
+                        nSize -= nChunkSize;
+                    }
+                    currentDownload.SetData(
+                        std::string(poReq->sWriteFuncData.pBuffer,
+                                    poReq->sWriteFuncData.nSize));
+                    poReq->bSuccess = true;
+                }
+                else if (ENABLE_DEBUG)
+                {
+                    CPLDebug(poFS->GetDebugKey(),
+                             "Read-ahead of " CPL_FRMT_GUIB "-" CPL_FRMT_GUIB
+                             " failed with response_code=%d",
+                             sHeader.nStartOffset, sHeader.nEndOffset,
+                             static_cast<int>(response_code));
+                }
+            }
+        }
+
+        // Release the resources of the request as soon as possible
+        VSICURLResetHeaderAndWriterFunctions(poReq->hCurlHandle);
+        curl_easy_cleanup(poReq->hCurlHandle);
+        poReq->hCurlHandle = nullptr;
+        CPLFree(poReq->sWriteFuncData.pBuffer);
+        poReq->sWriteFuncData.pBuffer = nullptr;
+
+        oLock.lock();
+        poReq->bDone = true;
+        m_oReadAheadCV.notify_all();
+    }
+    oLock.unlock();
+
+    VSICURLMultiCleanup(hCurlMultiHandle);
+}
+
+/************************************************************************/
+/*                           StopReadAhead()                            */
+/************************************************************************/
+
+void VSICurlHandle::StopReadAhead()
+{
+    if (m_oThreadReadAhead.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oReadAheadMutex);
+            m_bStopReadAhead = true;
+            m_oReadAheadCV.notify_all();
+        }
+        m_oThreadReadAhead.join();
+    }
+    m_poReadAhead.reset();
+}
+
+/************************************************************************/
+/*                         ~ReadAheadRequest()                          */
+/************************************************************************/
+
+VSICurlHandle::ReadAheadRequest::~ReadAheadRequest()
+{
+    if (hCurlHandle)
+    {
+        VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
+        curl_easy_cleanup(hCurlHandle);
+    }
+    curl_slist_free_all(headers);
+    CPLFree(sWriteFuncData.pBuffer);
+    CPLFree(sWriteFuncHeaderData.pBuffer);
+}
+
+/************************************************************************/
+/*                             MapRange()                               */
+/************************************************************************/
+
+// Ranges that fit in a single chunk point to the chunk in the region cache,
+// which is kept alive by its std::shared_ptr even if evicted from the cache.
+std::unique_ptr<VSIMappedRange> VSICurlHandle::MapRange(vsi_l_offset nOffset,
+                                                        size_t nSize)
+{
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const vsi_l_offset nChunkOffset =
+        (nOffset / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
+    const size_t nOffsetInChunk = static_cast<size_t>(nOffset - nChunkOffset);
+    if (nSize == 0 ||
+        nSize > static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE) - nOffsetInChunk)
+    {
+        return VSIVirtualHandle::MapRange(nOffset, nSize);
+    }
+
+    std::shared_ptr<std::string> psRegion =
+        poFS->GetRegion(m_pszURL, nChunkOffset);
+    if (psRegion == nullptr)
+    {
+        // Download the chunk through Read(), which adds it to the region
+        // cache.
+        const vsi_l_offset nCurOffset = curOffset;
+        const bool bEOFBackup = bEOF;
+        GByte byDummy = 0;
+        if (Seek(nOffset, SEEK_SET) == 0)
+            CPL_IGNORE_RET_VAL(Read(&byDummy, 1, 1));
+        Seek(nCurOffset, SEEK_SET);
+        bEOF = bEOFBackup;
+        psRegion = poFS->GetRegion(m_pszURL, nChunkOffset);
+        if (psRegion == nullptr)
+            return VSIVirtualHandle::MapRange(nOffset, nSize);
+    }
+    if (psRegion->size() < nOffsetInChunk + nSize)
+        return nullptr;
+    const void *pData = psRegion->data() + nOffsetInChunk;
+    return std::make_unique<VSIMappedRange>(pData, nSize, std::move(psRegion));
+}
+
 /************************************************************************/
 /*                           ReadMultiRange()                           */
 /************************************************************************/
@@ -2373,6 +3255,126 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
                                                 panSizes);
     }
 
+    if (m_poDiskCache)
+        return ReadMultiRangeDiskCache(nRanges, ppData, panOffsets, panSizes);
+
+    return ReadMultiRangeParallel(nRanges, ppData, panOffsets, panSizes);
+}
+
+/************************************************************************/
+/*                      ReadMultiRangeDiskCache()                       */
+/************************************************************************/
+
+// Serves the ranges found in the persistent disk cache, and downloads the
+// missing ones by whole chunks so that they can be stored into it.
+int VSICurlHandle::ReadMultiRangeDiskCache(int const nRanges,
+                                           void **const ppData,
+                                           const vsi_l_offset *const panOffsets,
+                                           const size_t *const panSizes)
+{
+    // The disk cache needs the ETag or modification time of the file.
+    if (!oFileProp.bHasComputedFileSize)
+        GetFileSize(false);
+    if (!oFileProp.bHasComputedFileSize)
+        return ReadMultiRangeParallel(nRanges, ppData, panOffsets, panSizes);
+
+    std::vector<int> anMissingRanges;
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aoChunkRanges;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        size_t nRead = 0;
+        if (panSizes[i] == 0 ||
+            (ReadFromDiskCache(ppData[i], panSizes[i], panOffsets[i],
+                               oFileProp, nRead) &&
+             nRead == panSizes[i]))
+        {
+            continue;
+        }
+        anMissingRanges.push_back(i);
+        vsi_l_offset nOffset = panOffsets[i];
+        size_t nSize = panSizes[i];
+        AlignRangeOnDiskCacheChunks(nOffset, nSize, oFileProp);
+        aoChunkRanges.emplace_back(nOffset, nOffset + nSize);
+    }
+    if (anMissingRanges.empty())
+        return 0;
+
+    // Merge overlapping or consecutive chunk ranges
+    std::sort(aoChunkRanges.begin(), aoChunkRanges.end());
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    vsi_l_offset nCurStart = aoChunkRanges[0].first;
+    vsi_l_offset nCurEnd = aoChunkRanges[0].second;
+    for (size_t i = 1; i <= aoChunkRanges.size(); ++i)
+    {
+        if (i < aoChunkRanges.size() && aoChunkRanges[i].first <= nCurEnd)
+        {
+            nCurEnd = std::max(nCurEnd, aoChunkRanges[i].second);
+            continue;
+        }
+        anOffsets.push_back(nCurStart);
+        anSizes.push_back(static_cast<size_t>(nCurEnd - nCurStart));
+        if (i < aoChunkRanges.size())
+        {
+            nCurStart = aoChunkRanges[i].first;
+            nCurEnd = aoChunkRanges[i].second;
+        }
+    }
+
+    std::vector<std::vector<GByte>> aabyChunks;
+    std::vector<void *> apChunkData;
+    try
+    {
+        aabyChunks.resize(anOffsets.size());
+        for (size_t i = 0; i < anOffsets.size(); ++i)
+        {
+            aabyChunks[i].resize(anSizes[i]);
+            apChunkData.push_back(aabyChunks[i].data());
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in VSICurlHandle::ReadMultiRange()");
+        return -1;
+    }
+
+    const int nRet = ReadMultiRangeParallel(static_cast<int>(anOffsets.size()),
+                                            apChunkData.data(),
+                                            anOffsets.data(), anSizes.data());
+    if (nRet != 0)
+        return nRet;
+
+    for (size_t i = 0; i < anOffsets.size(); ++i)
+    {
+        PutRangeInDiskCache(aabyChunks[i].data(), anSizes[i], anOffsets[i],
+                            oFileProp, false);
+    }
+
+    for (const int i : anMissingRanges)
+    {
+        const size_t iChunk = static_cast<size_t>(
+            std::upper_bound(anOffsets.begin(), anOffsets.end(),
+                             panOffsets[i]) -
+            anOffsets.begin() - 1);
+        memcpy(ppData[i],
+               aabyChunks[iChunk].data() +
+                   static_cast<size_t>(panOffsets[i] - anOffsets[iChunk]),
+               panSizes[i]);
+    }
+
+    return 0;
+}
+
+/************************************************************************/
+/*                       ReadMultiRangeParallel()                       */
+/************************************************************************/
+
+int VSICurlHandle::ReadMultiRangeParallel(int const nRanges,
+                                          void **const ppData,
+                                          const vsi_l_offset *const panOffsets,
+                                          const size_t *const panSizes)
+{
     ManagePlanetaryComputerSigning();
 
     bool bHasExpired = false;
@@ -2708,6 +3710,10 @@ int VSICurlHandle::ReadMultiRangeSingleGet(int const nRanges,
 
     VSICURLMultiPerform(hCurlMultiHandle, hCurlHandle);
 
+    if (!sWriteFuncHeaderData.osDeferredError.empty())
+        CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                 sWriteFuncHeaderData.osDeferredError.c_str());
+
     VSICURLResetHeaderAndWriterFunctions(hCurlHandle);
 
     curl_slist_free_all(headers);
@@ -2983,6 +3989,112 @@ end:
     return nRet;
 }
 
+/************************************************************************/
+/*                    AlignRangeOnDiskCacheChunks()                     */
+/************************************************************************/
+
+void VSICurlHandle::AlignRangeOnDiskCacheChunks(vsi_l_offset &nOffset,
+                                                size_t &nSize,
+                                                const FileProp &oProp) const
+{
+    const vsi_l_offset nChunkSize = VSICURLGetDownloadChunkSize();
+    const vsi_l_offset nEndOffset = nOffset + nSize;
+    vsi_l_offset nAlignedEndOffset =
+        ((nEndOffset + nChunkSize - 1) / nChunkSize) * nChunkSize;
+    if (oProp.bHasComputedFileSize)
+    {
+        nAlignedEndOffset = std::max(
+            nEndOffset, std::min(nAlignedEndOffset, oProp.fileSize));
+    }
+    nOffset = (nOffset / nChunkSize) * nChunkSize;
+    nSize = static_cast<size_t>(nAlignedEndOffset - nOffset);
+}
+
+/************************************************************************/
+/*                         IsRangeInDiskCache()                         */
+/************************************************************************/
+
+bool VSICurlHandle::IsRangeInDiskCache(vsi_l_offset nOffset, size_t nSize,
+                                       const FileProp &oProp) const
+{
+    const vsi_l_offset nChunkSize = VSICURLGetDownloadChunkSize();
+    for (vsi_l_offset nChunkOffset = (nOffset / nChunkSize) * nChunkSize;
+         nChunkOffset < nOffset + nSize; nChunkOffset += nChunkSize)
+    {
+        if (!m_poDiskCache->HasChunk(m_pszURL, oProp, nChunkOffset))
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadFromDiskCache()                          */
+/************************************************************************/
+
+// Returns true if the range, or its part before the end of file, could be
+// entirely read from the disk cache.
+bool VSICurlHandle::ReadFromDiskCache(void *pBuffer, size_t nSize,
+                                      vsi_l_offset nOffset,
+                                      const FileProp &oProp,
+                                      size_t &nRead) const
+{
+    const size_t nChunkSize = VSICURLGetDownloadChunkSize();
+    nRead = 0;
+    while (nRead < nSize)
+    {
+        const vsi_l_offset nCurOffset = nOffset + nRead;
+        const vsi_l_offset nChunkOffset =
+            (nCurOffset / nChunkSize) * nChunkSize;
+        std::string osData;
+        if (!m_poDiskCache->GetChunk(m_pszURL, oProp, nChunkOffset, osData))
+            return false;
+        const size_t nOffsetInChunk =
+            static_cast<size_t>(nCurOffset - nChunkOffset);
+        if (nOffsetInChunk >= osData.size())
+            break;
+        const size_t nToCopy =
+            std::min(nSize - nRead, osData.size() - nOffsetInChunk);
+        memcpy(static_cast<GByte *>(pBuffer) + nRead,
+               osData.data() + nOffsetInChunk, nToCopy);
+        nRead += nToCopy;
+        // Only the last chunk of the file may be incomplete
+        if (osData.size() < nChunkSize)
+            break;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        PutRangeInDiskCache()                         */
+/************************************************************************/
+
+// Stores the whole download chunks contained in the range. The final
+// incomplete chunk is only stored if it ends at the end of the file.
+void VSICurlHandle::PutRangeInDiskCache(const void *pData, size_t nSize,
+                                        vsi_l_offset nOffset,
+                                        const FileProp &oProp,
+                                        bool bReachesEOF) const
+{
+    const vsi_l_offset nChunkSize = VSICURLGetDownloadChunkSize();
+    const vsi_l_offset nEndOffset = nOffset + nSize;
+    if (oProp.bHasComputedFileSize && nEndOffset >= oProp.fileSize)
+        bReachesEOF = true;
+    for (vsi_l_offset nChunkOffset =
+             ((nOffset + nChunkSize - 1) / nChunkSize) * nChunkSize;
+         nChunkOffset < nEndOffset; nChunkOffset += nChunkSize)
+    {
+        const size_t nChunk = static_cast<size_t>(
+            std::min(nChunkSize, nEndOffset - nChunkOffset));
+        if (nChunk < nChunkSize && !bReachesEOF)
+            break;
+        m_poDiskCache->PutChunk(
+            m_pszURL, oProp, nChunkOffset,
+            static_cast<const char *>(pData) +
+                static_cast<size_t>(nChunkOffset - nOffset),
+            nChunk);
+    }
+}
+
 /************************************************************************/
 /*                              PRead()                                 */
 /************************************************************************/
@@ -3029,6 +4141,19 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     if (oFileProp.eExists == EXIST_NO)
         return static_cast<size_t>(-1);
 
+    // When the persistent disk cache is enabled, the request is extended to
+    // whole download chunks, so that they can be stored into it.
+    vsi_l_offset nDownloadOffset = nOffset;
+    size_t nDownloadSize = nSize;
+    const bool bUseDiskCache = m_poDiskCache && oFileProp.bHasComputedFileSize;
+    if (bUseDiskCache)
+    {
+        size_t nRead = 0;
+        if (ReadFromDiskCache(pBuffer, nSize, nOffset, oFileProp, nRead))
+            return nRead;
+        AlignRangeOnDiskCacheChunks(nDownloadOffset, nDownloadSize, oFileProp);
+    }
+
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix().c_str());
     NetworkStatisticsFile oContextFile(m_osFilename.c_str());
     NetworkStatisticsAction oContextAction("PRead");
@@ -3060,9 +4185,9 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
                                VSICurlHandleWriteFunc);
     sWriteFuncHeaderData.bIsHTTP = STARTS_WITH(m_pszURL, "http");
-    sWriteFuncHeaderData.nStartOffset = nOffset;
+    sWriteFuncHeaderData.nStartOffset = nDownloadOffset;
 
-    sWriteFuncHeaderData.nEndOffset = nOffset + nSize - 1;
+    sWriteFuncHeaderData.nEndOffset = nDownloadOffset + nDownloadSize - 1;
 
     char rangeStr[512] = {};
     snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
@@ -3133,9 +4258,18 @@ size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
     }
     else
     {
-        nRet = std::min(sWriteFuncData.nSize, nSize);
+        if (bUseDiskCache)
+        {
+            PutRangeInDiskCache(sWriteFuncData.pBuffer, sWriteFuncData.nSize,
+                                nDownloadOffset, oFileProp,
+                                sWriteFuncData.nSize < nDownloadSize);
+        }
+        const size_t nSkip = static_cast<size_t>(nOffset - nDownloadOffset);
+        nRet = sWriteFuncData.nSize > nSkip
+                   ? std::min(sWriteFuncData.nSize - nSkip, nSize)
+                   : 0;
         if (nRet > 0)
-            memcpy(pBuffer, sWriteFuncData.pBuffer, nRet);
+            memcpy(pBuffer, sWriteFuncData.pBuffer + nSkip, nRet);
     }
 
     curl_multi_remove_handle(hMultiHandle, hCurlHandle);
@@ -3212,6 +4346,11 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
     const bool bMergeConsecutiveRanges = CPLTestBool(
         CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
 
+    // When the persistent disk cache is enabled, ranges are extended to
+    // whole download chunks, and those already in it are not fetched.
+    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    const bool bUseDiskCache = m_poDiskCache && oFileProp.bHasComputedFileSize;
+
     try
     {
         m_aoAdviseReadRanges.resize(nRanges);
@@ -3232,8 +4371,7 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                 nEndOffset = panOffsets[iNext] + panSizes[iNext];
             }
             CPLAssert(panOffsets[i] <= nEndOffset);
-            const size_t nSize =
-                static_cast<size_t>(nEndOffset - panOffsets[i]);
+            size_t nSize = static_cast<size_t>(nEndOffset - panOffsets[i]);
 
             if (nSize == 0)
             {
@@ -3241,12 +4379,40 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                 continue;
             }
 
+            vsi_l_offset nStartOffset = panOffsets[i];
+            if (bUseDiskCache)
+            {
+                AlignRangeOnDiskCacheChunks(nStartOffset, nSize, oFileProp);
+                if (IsRangeInDiskCache(nStartOffset, nSize, oFileProp))
+                {
+                    i = iNext + 1;
+                    continue;
+                }
+                // Merge with the previous range if they share a chunk
+                if (iRequest > 0)
+                {
+                    auto &poPrevRange = m_aoAdviseReadRanges[iRequest - 1];
+                    const auto nPrevEndOffset =
+                        poPrevRange->nStartOffset + poPrevRange->nSize;
+                    if (nStartOffset >= poPrevRange->nStartOffset &&
+                        nStartOffset <= nPrevEndOffset)
+                    {
+                        poPrevRange->nSize = static_cast<size_t>(
+                            std::max(nPrevEndOffset, nStartOffset + nSize) -
+                            poPrevRange->nStartOffset);
+                        poPrevRange->abyData.resize(poPrevRange->nSize);
+                        i = iNext + 1;
+                        continue;
+                    }
+                }
+            }
+
             if (m_aoAdviseReadRanges[iRequest] == nullptr)
                 m_aoAdviseReadRanges[iRequest] =
                     std::make_unique<AdviseReadRange>();
             // coverity[missing_lock]
             m_aoAdviseReadRanges[iRequest]->bDone = false;
-            m_aoAdviseReadRanges[iRequest]->nStartOffset = panOffsets[i];
+            m_aoAdviseReadRanges[iRequest]->nStartOffset = nStartOffset;
             m_aoAdviseReadRanges[iRequest]->nSize = nSize;
             m_aoAdviseReadRanges[iRequest]->abyData.resize(nSize);
 
@@ -3270,7 +4436,8 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
              static_cast<unsigned>(m_aoAdviseReadRanges.size()));
 #endif
 
-    const auto task = [this](const std::string &osURL)
+    const auto task =
+        [this, bUseDiskCache, oProp = oFileProp](const std::string &osURL)
     {
         CURLM *hMultiHandle = curl_multi_init();
 
@@ -3382,8 +4549,9 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
 
         size_t nTotalDownloaded = 0;
         const auto DealWithRequest =
-            [this, &osURL, &nTotalDownloaded, &oMapHandleToIdx, &asCurlErrors,
-             &asWriteFuncHeaderData, &asWriteFuncData](CURL *hCurlHandle)
+            [this, bUseDiskCache, &oProp, &osURL, &nTotalDownloaded,
+             &oMapHandleToIdx, &asCurlErrors, &asWriteFuncHeaderData,
+             &asWriteFuncData](CURL *hCurlHandle)
         {
             auto oIter = oMapHandleToIdx.find(hCurlHandle);
             CPLAssert(oIter != oMapHandleToIdx.end());
@@ -3428,6 +4596,12 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                 memcpy(&m_aoAdviseReadRanges[iReq]->abyData[0],
                        asWriteFuncData[iReq].pBuffer, nSize);
                 m_aoAdviseReadRanges[iReq]->abyData.resize(nSize);
+                if (bUseDiskCache)
+                {
+                    const auto &poRange = m_aoAdviseReadRanges[iReq];
+                    PutRangeInDiskCache(poRange->abyData.data(), nSize,
+                                        poRange->nStartOffset, oProp, false);
+                }
 
                 nTotalDownloaded += nSize;
             }
@@ -3852,6 +5026,10 @@ void VSICurlFilesystemHandlerBase::InvalidateCachedData(const char *pszURL)
     poRegionCache->cwalk(lambda);
     for (const auto &key : keysToRemove)
         poRegionCache->remove(key);
+
+    // Force revalidation of the file properties persisted in the disk cache
+    if (auto poDiskCache = VSICurlDiskCache::Get())
+        poDiskCache->RemoveFileProp(osURL);
 }
 
 /************************************************************************/
@@ -4011,6 +5189,15 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' "                \
     "description='Size in bytes of the global /vsicurl/ cache' "               \
     "default='16384000'/>"                                                     \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' "             \
+    "description='Directory of the persistent disk cache of downloaded "       \
+    "data, shared by processes'/>"                                             \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' "           \
+    "description='Maximum size in bytes of the disk cache' "                   \
+    "default='1073741824'/>"                                                   \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_MAX_AGE' type='integer' "        \
+    "description='Number of seconds during which file properties from the "    \
+    "disk cache are used without being revalidated' default='0'/>"             \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' "    \
     "description='Whether to skip files with Glacier storage class in "        \
     "directory listing.' default='YES'/>"                                      \
@@ -4198,7 +5385,14 @@ VSIVirtualHandle *VSICurlFilesystemHandlerBase::Open(const char *pszFilename,
     }
 
     if (CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
-        return VSICreateCachedFile(poHandle);
+    {
+        // Fetch the file properties, including the ETag that may identify
+        // its content in the shared cache.
+        poHandle->GetFileSize(false);
+        const std::string osETag(poHandle->GetETag());
+        return VSICreateCachedFile(poHandle, VSI_CACHED_DEFAULT_CHUNK_SIZE, 0,
+                                   osFilename.c_str(), osETag.c_str());
+    }
     else
         return poHandle;
 }
@@ -5770,6 +6964,28 @@ void NetworkStatisticsLogger::LogDELETE()
     }
 }
 
+void NetworkStatisticsLogger::LogReadAheadHit()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nReadAheadHits++;
+    }
+}
+
+void NetworkStatisticsLogger::LogReadAheadMiss()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nReadAheadMisses++;
+    }
+}
+
 void NetworkStatisticsLogger::Reset()
 {
     std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
@@ -5799,6 +7015,10 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
     if (counters.nDELETE)
         oMethods.Add("DELETE/count", counters.nDELETE);
     oJSON.Add("methods", oMethods);
+    if (counters.nReadAheadHits)
+        oJSON.Add("read_ahead/hit_count", counters.nReadAheadHits);
+    if (counters.nReadAheadMisses)
+        oJSON.Add("read_ahead/miss_count", counters.nReadAheadMisses);
     CPLJSONObject oFiles;
     bool bFilesAdded = false;
     for (const auto &kv : children)
@@ -6146,6 +7366,9 @@ void VSIInstallCurlFileHandler(void)
  * mechanisms can prevent opening new files, or give an outdated version of
  * them.
  *
+ * This also closes the connections of the connection pool enabled with
+ * GDAL_HTTP_CONNECTION_POOL, which is restarted on the next request.
+ *
  * @since GDAL 2.2.1
  */
 
@@ -6166,6 +7389,8 @@ void VSICurlClearCache(void)
     CSLDestroy(papszPrefix);
 
     VSICurlStreamingClearCache();
+
+    VSICURLDestroyConnectionPool();
 }
 
 /************************************************************************/
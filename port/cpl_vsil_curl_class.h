@@ -57,6 +57,8 @@
 
 //! @cond Doxygen_Suppress
 
+class CPLWorkerThreadPool;
+
 // Leave it for backward compatibility, but deprecate.
 #define HAVE_CURLINFO_REDIRECT_URL
 
@@ -107,6 +109,64 @@ struct CachedDirList
     CPLStringList oFileList{}; /* only file name without path */
 };
 
+/************************************************************************/
+/*                           VSICurlDiskCache                           */
+/************************************************************************/
+
+// Persistent cache of downloaded chunks and file properties, in a local
+// directory that may be shared by several processes.
+// Chunks are keyed by the URL, the ETag or Last-Modified validator of the
+// file, and their offset. Each entry is a file written atomically, with a
+// checksum, and entries are evicted in least-recently-used order when the
+// total size exceeds the limit.
+class VSICurlDiskCache
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlDiskCache)
+
+    const std::string m_osDirectory;
+    const GIntBig m_nMaxSize;
+    const int m_nMaxAge;
+
+    std::mutex m_oMutex{};
+    bool m_bTrimDone = false;
+    bool m_bTrimInProgress = false;
+    GIntBig m_nBytesWrittenSinceTrim = 0;
+
+    std::string GetEntryFilename(const std::string &osKey,
+                                 const char *pszExtension) const;
+    bool ReadEntry(const std::string &osFilename, const std::string &osKey,
+                   std::string &osData);
+    void WriteEntry(const std::string &osFilename, const std::string &osKey,
+                    const char *pData, size_t nSize);
+    void Trim();
+
+  public:
+    VSICurlDiskCache(const std::string &osDirectory, GIntBig nMaxSize,
+                     int nMaxAge);
+
+    // Returns nullptr if CPL_VSIL_CURL_DISK_CACHE_DIR is not set.
+    static std::shared_ptr<VSICurlDiskCache> Get();
+
+    // Number of seconds during which persisted file properties are used
+    // without being revalidated.
+    int GetMaxAge() const
+    {
+        return m_nMaxAge;
+    }
+
+    bool GetChunk(const std::string &osURL, const FileProp &oFileProp,
+                  vsi_l_offset nOffset, std::string &osData);
+    bool HasChunk(const std::string &osURL, const FileProp &oFileProp,
+                  vsi_l_offset nOffset) const;
+    void PutChunk(const std::string &osURL, const FileProp &oFileProp,
+                  vsi_l_offset nOffset, const char *pData, size_t nSize);
+
+    bool GetFileProp(const std::string &osURL, FileProp &oFileProp,
+                     GIntBig &nValidationTime);
+    void PutFileProp(const std::string &osURL, const FileProp &oFileProp);
+    void RemoveFileProp(const std::string &osURL);
+};
+
 struct WriteFuncStruct
 {
     char *pBuffer = nullptr;
@@ -122,6 +182,9 @@ struct WriteFuncStruct
     bool bInterruptDownload = false;
     bool bDetectRangeDownloadingError = false;
     GIntBig nTimestampDate = 0;  // Corresponds to Date: header field
+    // Error detected in the connection pool thread, to be emitted by the
+    // requesting thread.
+    std::string osDeferredError{};
 
     VSILFILE *fp = nullptr;
     VSICurlReadCbkFunc pfnReadCbk = nullptr;
@@ -375,6 +438,9 @@ class VSICurlHandle : public VSIVirtualHandle
 
     bool m_bCached = true;
 
+    // Persistent disk cache, or nullptr if not enabled.
+    std::shared_ptr<VSICurlDiskCache> m_poDiskCache{};
+
     mutable FileProp oFileProp{};
 
     mutable std::mutex m_oMutex{};
@@ -420,8 +486,26 @@ class VSICurlHandle : public VSIVirtualHandle
     int ReadMultiRangeSingleGet(int nRanges, void **ppData,
                                 const vsi_l_offset *panOffsets,
                                 const size_t *panSizes);
+    int ReadMultiRangeParallel(int nRanges, void **ppData,
+                               const vsi_l_offset *panOffsets,
+                               const size_t *panSizes);
+    int ReadMultiRangeDiskCache(int nRanges, void **ppData,
+                                const vsi_l_offset *panOffsets,
+                                const size_t *panSizes);
     std::string GetRedirectURLIfValid(bool &bHasExpired) const;
 
+    // Used by PRead(), ReadMultiRange() and AdviseRead() to work with the
+    // persistent disk cache, which stores whole download chunks.
+    void AlignRangeOnDiskCacheChunks(vsi_l_offset &nOffset, size_t &nSize,
+                                     const FileProp &oProp) const;
+    bool IsRangeInDiskCache(vsi_l_offset nOffset, size_t nSize,
+                            const FileProp &oProp) const;
+    bool ReadFromDiskCache(void *pBuffer, size_t nSize, vsi_l_offset nOffset,
+                           const FileProp &oProp, size_t &nRead) const;
+    void PutRangeInDiskCache(const void *pData, size_t nSize,
+                             vsi_l_offset nOffset, const FileProp &oProp,
+                             bool bReachesEOF) const;
+
     void UpdateRedirectInfo(CURL *hCurlHandle,
                             const WriteFuncStruct &sWriteFuncHeaderData);
 
@@ -439,6 +523,58 @@ class VSICurlHandle : public VSIVirtualHandle
     std::vector<std::unique_ptr<AdviseReadRange>> m_aoAdviseReadRanges{};
     std::thread m_oThreadAdviseRead{};
 
+    // Used by the adaptive read-ahead of Read()
+    enum class AccessPattern
+    {
+        UNKNOWN,
+        SEQUENTIAL,
+        STRIDED,
+        RANDOM,
+    };
+
+    struct ReadAheadRequest
+    {
+        CPL_DISALLOW_COPY_ASSIGN(ReadAheadRequest)
+
+        bool bDone = false;
+        bool bSuccess = false;
+        vsi_l_offset nStartOffset = 0;
+        int nBlocks = 0;
+        CURL *hCurlHandle = nullptr;
+        struct curl_slist *headers = nullptr;
+        WriteFuncStruct sWriteFuncData{};
+        WriteFuncStruct sWriteFuncHeaderData{};
+        FileProp oFileProp{};
+
+        ReadAheadRequest() = default;
+        ~ReadAheadRequest();
+    };
+
+    int m_nReadAheadEnabled = -1;  // unknown state
+    AccessPattern m_eAccessPattern = AccessPattern::UNKNOWN;
+    int m_nAccessPatternCount = 0;
+    vsi_l_offset m_nLastReadOffset = VSI_L_OFFSET_MAX;
+    size_t m_nLastReadSize = 0;
+    GIntBig m_nLastReadStride = 0;
+    int m_nReadAheadBlocks = 0;
+    // Chunks fetched by read-ahead and not read yet
+    std::set<vsi_l_offset> m_oSetReadAheadChunks{};
+
+    std::mutex m_oReadAheadMutex{};
+    std::condition_variable m_oReadAheadCV{};
+    std::unique_ptr<ReadAheadRequest> m_poReadAhead{};
+    bool m_bStopReadAhead = false;
+    std::thread m_oThreadReadAhead{};
+
+    bool IsReadAheadEnabled();
+    void UpdateAccessPattern(vsi_l_offset nOffset, size_t nSize);
+    bool IsReadAheadInFlight(vsi_l_offset nOffset);
+    bool WaitForReadAhead(vsi_l_offset nOffset);
+    void MarkReadAheadConsumed(vsi_l_offset nOffset);
+    void LaunchReadAhead();
+    void ReadAheadThreadFunc();
+    void StopReadAhead();
+
   protected:
     virtual struct curl_slist *
     GetCurlHeaders(const std::string & /*osVerb*/,
@@ -468,6 +604,13 @@ class VSICurlHandle : public VSIVirtualHandle
         return false;
     }
 
+    // Whether a plain ranged GET on the URL returns the requested bytes,
+    // which is required by the background read-ahead.
+    virtual bool CanReadAhead() const
+    {
+        return true;
+    }
+
     virtual void ProcessGetFileSizeResult(const char * /* pszContent */)
     {
     }
@@ -503,6 +646,9 @@ class VSICurlHandle : public VSIVirtualHandle
     size_t PRead(void *pBuffer, size_t nSize,
                  vsi_l_offset nOffset) const override;
 
+    std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                             size_t nSize) override;
+
     void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                     const size_t *panSizes) override;
 
@@ -537,6 +683,11 @@ class VSICurlHandle : public VSIVirtualHandle
         return oFileProp.mTime;
     }
 
+    const std::string &GetETag() const
+    {
+        return oFileProp.ETag;
+    }
+
     const CPLStringList &GetHeaders()
     {
         return m_aosHeaders;
@@ -588,6 +739,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandler)
 
+    friend class VSIS3WriteHandle;
+
     virtual int MkdirInternal(const char *pszDirname, long nMode,
                               bool bDoStatCheck);
 
@@ -664,7 +817,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
                                    const std::vector<std::string> &aosEtags,
                                    vsi_l_offset nTotalSize,
                                    IVSIS3LikeHandleHelper *poS3HandleHelper,
-                                   int nMaxRetry, double dfRetryDelay);
+                                   int nMaxRetry, double dfRetryDelay,
+                                   CSLConstList papszOptions);
     virtual bool AbortMultipart(const std::string &osFilename,
                                 const std::string &osUploadID,
                                 IVSIS3LikeHandleHelper *poS3HandleHelper,
@@ -674,6 +828,15 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
 
     int GetUploadChunkSizeInBytes(const char *pszFilename,
                                   const char *pszSpecifiedValInBytes);
+    int GetUploadNumThreads(const char *pszFilename);
+
+    // Add the headers specific to the creation of an object with a single
+    // PUT request.
+    virtual struct curl_slist *
+    AddSinglePartPUTHeaders(struct curl_slist *headers) const
+    {
+        return headers;
+    }
 };
 
 /************************************************************************/
@@ -752,7 +915,20 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     double m_dfRetryDelay = 0.0;
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
+    // Parallel upload of parts. At most m_nUploadThreads parts are in
+    // flight, plus the one being filled by Write().
+    int m_nUploadThreads = 1;
+    std::mutex m_oMutexUpload{};
+    std::condition_variable m_oCVUpload{};
+    int m_nPartsInFlight = 0;
+    bool m_bAsyncUploadError = false;
+    std::vector<GByte *> m_apabyFreeBuffers{};
+    std::unique_ptr<CPLWorkerThreadPool> m_poUploadPool{};
+
     bool UploadPart();
+    bool SubmitUploadPart();
+    static void UploadPartFunc(void *pData);
+    bool WaitPendingUploadParts();
     bool DoSinglePartPUT();
 
     static size_t ReadCallBackBufferChunked(char *buffer, size_t size,
@@ -882,6 +1058,8 @@ class NetworkStatisticsLogger
         GIntBig nPUTUploadedBytes = 0;
         GIntBig nPOSTDownloadedBytes = 0;
         GIntBig nPOSTUploadedBytes = 0;
+        GIntBig nReadAheadHits = 0;
+        GIntBig nReadAheadMisses = 0;
     };
 
     enum class ContextPathType
@@ -961,6 +1139,10 @@ class NetworkStatisticsLogger
 
     static void LogDELETE();
 
+    static void LogReadAheadHit();
+
+    static void LogReadAheadMiss();
+
     static void Reset();
 
     static std::string GetReportAsSerializedJSON();
@@ -1025,6 +1207,7 @@ void VSICURLSetCachedFileProp(const char *pszURL, cpl::FileProp &oFileProp);
 void VSICURLInvalidateCachedFileProp(const char *pszURL);
 void VSICURLInvalidateCachedFilePropPrefix(const char *pszURL);
 void VSICURLDestroyCacheFileProp();
+void VSICURLDestroyConnectionPool();
 
 void VSICURLMultiCleanup(CURLM *hCurlMultiHandle);
 
@@ -0,0 +1,540 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Persistent local disk cache for /vsicurl/ and related file systems
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "cpl_vsil_curl_class.h"
+
+#ifdef HAVE_CURL
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_zlib_header.h"  // to avoid warnings when including zlib.h
+
+namespace cpl
+{
+
+// Entry file layout (little endian):
+// - magic (8 bytes)
+// - size of the key (uint32)
+// - size of the data (uint32)
+// - CRC32 of the key and the data (uint32)
+// - key
+// - data
+constexpr const char ENTRY_MAGIC[] = "GDALVCD1";
+constexpr size_t ENTRY_MAGIC_SIZE = sizeof(ENTRY_MAGIC) - 1;
+constexpr size_t ENTRY_HEADER_SIZE = ENTRY_MAGIC_SIZE + 3 * sizeof(GUInt32);
+
+// Entries whose last access is more recent than that are not touched when
+// read, to avoid rewriting them at each access.
+constexpr int TOUCH_DELAY_SEC = 60;
+
+// Temporary files older than that are assumed to be left by a killed process.
+constexpr int STALE_TMP_FILE_DELAY_SEC = 3600;
+
+/************************************************************************/
+/*                       VSICurlDiskCacheValidator()                    */
+/************************************************************************/
+
+// Returns an empty string if the file has no validator, in which case its
+// chunks cannot be cached, as a change of the remote file would not be
+// detected.
+static std::string VSICurlDiskCacheValidator(const FileProp &oFileProp)
+{
+    if (!oFileProp.ETag.empty())
+        return "ETag:" + oFileProp.ETag;
+    if (oFileProp.mTime > 0)
+        return CPLSPrintf("Last-Modified:" CPL_FRMT_GIB ",Size:" CPL_FRMT_GUIB,
+                          static_cast<GIntBig>(oFileProp.mTime),
+                          static_cast<GUIntBig>(oFileProp.fileSize));
+    return std::string();
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheChunkKey()                     */
+/************************************************************************/
+
+static std::string VSICurlDiskCacheChunkKey(const std::string &osURL,
+                                            const FileProp &oFileProp,
+                                            vsi_l_offset nOffset)
+{
+    const std::string osValidator = VSICurlDiskCacheValidator(oFileProp);
+    if (osValidator.empty())
+        return std::string();
+    std::string osKey("chunk\n");
+    osKey += osURL;
+    osKey += '\n';
+    osKey += osValidator;
+    osKey += CPLSPrintf("\n%d\n" CPL_FRMT_GUIB, VSICURLGetDownloadChunkSize(),
+                        static_cast<GUIntBig>(nOffset));
+    return osKey;
+}
+
+/************************************************************************/
+/*                          VSICurlDiskCache()                          */
+/************************************************************************/
+
+VSICurlDiskCache::VSICurlDiskCache(const std::string &osDirectory,
+                                   GIntBig nMaxSize, int nMaxAge)
+    : m_osDirectory(osDirectory), m_nMaxSize(nMaxSize), m_nMaxAge(nMaxAge)
+{
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+std::shared_ptr<VSICurlDiskCache> VSICurlDiskCache::Get()
+{
+    const char *pszDirectory =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if (pszDirectory == nullptr || pszDirectory[0] == '\0')
+        return nullptr;
+
+    constexpr GIntBig DEFAULT_MAX_SIZE = static_cast<GIntBig>(1024) * 1024 *
+                                         1024;  // 1 GB
+    const GIntBig nMaxSize = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption(
+               "CPL_VSIL_CURL_DISK_CACHE_SIZE",
+               CPLSPrintf(CPL_FRMT_GIB, DEFAULT_MAX_SIZE))));
+    const int nMaxAge = std::max(
+        0, atoi(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_MAX_AGE", "0")));
+
+    static std::mutex oMutex;
+    static std::shared_ptr<VSICurlDiskCache> poCache;
+    std::lock_guard<std::mutex> oLock(oMutex);
+    if (!poCache || poCache->m_osDirectory != pszDirectory ||
+        poCache->m_nMaxSize != nMaxSize || poCache->m_nMaxAge != nMaxAge)
+    {
+        poCache = std::make_shared<VSICurlDiskCache>(pszDirectory, nMaxSize,
+                                                     nMaxAge);
+    }
+    return poCache;
+}
+
+/************************************************************************/
+/*                          GetEntryFilename()                          */
+/************************************************************************/
+
+std::string VSICurlDiskCache::GetEntryFilename(const std::string &osKey,
+                                               const char *pszExtension) const
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    // Spread entries over 256 sub-directories, to keep directories small.
+    const std::string osSubDir =
+        CPLFormFilename(m_osDirectory.c_str(),
+                        std::string(pszHex, 2).c_str(), nullptr);
+    std::string osFilename =
+        CPLFormFilename(osSubDir.c_str(), pszHex + 2, pszExtension);
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                             ReadEntry()                              */
+/************************************************************************/
+
+bool VSICurlDiskCache::ReadEntry(const std::string &osFilename,
+                                 const std::string &osKey, std::string &osData)
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0 ||
+        static_cast<GIntBig>(sStat.st_size) <
+            static_cast<GIntBig>(ENTRY_HEADER_SIZE))
+    {
+        return false;
+    }
+
+    std::string osContent;
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+        if (fp == nullptr)
+            return false;
+        try
+        {
+            osContent.resize(static_cast<size_t>(sStat.st_size));
+        }
+        catch (const std::exception &)
+        {
+            VSIFCloseL(fp);
+            return false;
+        }
+        const bool bOK =
+            VSIFReadL(&osContent[0], 1, osContent.size(), fp) ==
+            osContent.size();
+        VSIFCloseL(fp);
+        if (!bOK)
+            return false;
+    }
+
+    GUInt32 nKeySize = 0;
+    GUInt32 nDataSize = 0;
+    GUInt32 nCRC = 0;
+    memcpy(&nKeySize, osContent.data() + ENTRY_MAGIC_SIZE, sizeof(GUInt32));
+    memcpy(&nDataSize, osContent.data() + ENTRY_MAGIC_SIZE + sizeof(GUInt32),
+           sizeof(GUInt32));
+    memcpy(&nCRC, osContent.data() + ENTRY_MAGIC_SIZE + 2 * sizeof(GUInt32),
+           sizeof(GUInt32));
+    CPL_LSBPTR32(&nKeySize);
+    CPL_LSBPTR32(&nDataSize);
+    CPL_LSBPTR32(&nCRC);
+    const char *pabyPayload = osContent.data() + ENTRY_HEADER_SIZE;
+    const size_t nPayloadSize = osContent.size() - ENTRY_HEADER_SIZE;
+    if (memcmp(osContent.data(), ENTRY_MAGIC, ENTRY_MAGIC_SIZE) != 0 ||
+        static_cast<GUIntBig>(nKeySize) + nDataSize != nPayloadSize ||
+        static_cast<GUInt32>(
+            crc32(0, reinterpret_cast<const Bytef *>(pabyPayload),
+                  static_cast<uInt>(nPayloadSize))) != nCRC)
+    {
+        CPLDebug("VSICURL", "Removing corrupted disk cache entry %s",
+                 osFilename.c_str());
+        VSIUnlink(osFilename.c_str());
+        return false;
+    }
+    // Hash collision, or entry of another key being written at the same
+    // path, which are both very unlikely.
+    if (nKeySize != osKey.size() ||
+        memcmp(pabyPayload, osKey.data(), nKeySize) != 0)
+    {
+        return false;
+    }
+
+    osData.assign(pabyPayload + nKeySize, nDataSize);
+
+    // Mark the entry as recently used, by rewriting its first byte, which
+    // updates its modification time.
+    if (sStat.st_mtime < time(nullptr) - TOUCH_DELAY_SEC)
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb+");
+        if (fp)
+        {
+            CPL_IGNORE_RET_VAL(VSIFWriteL(ENTRY_MAGIC, 1, 1, fp));
+            VSIFCloseL(fp);
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             WriteEntry()                             */
+/************************************************************************/
+
+void VSICurlDiskCache::WriteEntry(const std::string &osFilename,
+                                  const std::string &osKey, const char *pData,
+                                  size_t nSize)
+{
+    if (nSize > std::numeric_limits<GUInt32>::max() - osKey.size())
+        return;
+
+    std::string osContent;
+    try
+    {
+        osContent.reserve(ENTRY_HEADER_SIZE + osKey.size() + nSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    osContent.append(ENTRY_MAGIC, ENTRY_MAGIC_SIZE);
+    GUInt32 nKeySize = static_cast<GUInt32>(osKey.size());
+    GUInt32 nDataSize = static_cast<GUInt32>(nSize);
+    uLong nCRC = crc32(0, reinterpret_cast<const Bytef *>(osKey.data()),
+                       static_cast<uInt>(osKey.size()));
+    nCRC = crc32(nCRC, reinterpret_cast<const Bytef *>(pData),
+                 static_cast<uInt>(nSize));
+    GUInt32 nCRC32 = static_cast<GUInt32>(nCRC);
+    CPL_LSBPTR32(&nKeySize);
+    CPL_LSBPTR32(&nDataSize);
+    CPL_LSBPTR32(&nCRC32);
+    osContent.append(reinterpret_cast<const char *>(&nKeySize),
+                     sizeof(nKeySize));
+    osContent.append(reinterpret_cast<const char *>(&nDataSize),
+                     sizeof(nDataSize));
+    osContent.append(reinterpret_cast<const char *>(&nCRC32),
+                     sizeof(nCRC32));
+    osContent += osKey;
+    osContent.append(pData, nSize);
+
+    // Write to a temporary file that is then renamed, so that other
+    // processes never see a partially written entry.
+    static std::atomic<unsigned> nCounter{0};
+    const std::string osTmpFilename =
+        osFilename + CPLSPrintf(".%d." CPL_FRMT_GIB ".%u.tmp",
+                                CPLGetCurrentProcessID(), CPLGetPID(),
+                                nCounter++);
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        VSIMkdirRecursive(CPLGetPath(osFilename.c_str()), 0755);
+        fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+        if (fp == nullptr)
+        {
+            CPLDebug("VSICURL", "Cannot create %s", osTmpFilename.c_str());
+            return;
+        }
+    }
+    const bool bOK =
+        VSIFWriteL(osContent.data(), 1, osContent.size(), fp) ==
+            osContent.size() &&
+        VSIFCloseL(fp) == 0;
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        if (!bOK)
+            VSIFCloseL(fp);
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    bool bTrim = false;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nBytesWrittenSinceTrim += static_cast<GIntBig>(osContent.size());
+        // Check the total size at the first write, and then each time a
+        // tenth of the maximum size has been written.
+        if (!m_bTrimInProgress &&
+            (!m_bTrimDone || m_nBytesWrittenSinceTrim > m_nMaxSize / 10))
+        {
+            m_bTrimDone = true;
+            m_bTrimInProgress = true;
+            m_nBytesWrittenSinceTrim = 0;
+            bTrim = true;
+        }
+    }
+    if (bTrim)
+    {
+        Trim();
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bTrimInProgress = false;
+    }
+}
+
+/************************************************************************/
+/*                                Trim()                                */
+/************************************************************************/
+
+// Evict the least recently used entries, until the total size is below 80%
+// of the maximum size. Several processes may do that concurrently: failures
+// to remove entries already removed by another one are harmless.
+void VSICurlDiskCache::Trim()
+{
+    struct Entry
+    {
+        std::string osFilename{};
+        GIntBig nSize = 0;
+        GIntBig nMTime = 0;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const GIntBig nNow = static_cast<GIntBig>(time(nullptr));
+    VSIDIR *psDir = VSIOpenDir(m_osDirectory.c_str(), -1, nullptr);
+    if (psDir == nullptr)
+        return;
+    while (const VSIDIREntry *psEntry = VSIGetNextDirEntry(psDir))
+    {
+        if (!psEntry->bModeKnown || !VSI_ISREG(psEntry->nMode))
+            continue;
+        const char *pszExtension = CPLGetExtension(psEntry->pszName);
+        const std::string osFilename =
+            CPLFormFilename(m_osDirectory.c_str(), psEntry->pszName, nullptr);
+        if (EQUAL(pszExtension, "tmp"))
+        {
+            if (psEntry->bMTimeKnown &&
+                psEntry->nMTime < nNow - STALE_TMP_FILE_DELAY_SEC)
+            {
+                VSIUnlink(osFilename.c_str());
+            }
+        }
+        else if (EQUAL(pszExtension, "chunk") || EQUAL(pszExtension, "prop"))
+        {
+            Entry oEntry;
+            oEntry.osFilename = osFilename;
+            oEntry.nSize = static_cast<GIntBig>(psEntry->nSize);
+            oEntry.nMTime = psEntry->nMTime;
+            nTotalSize += oEntry.nSize;
+            aoEntries.push_back(std::move(oEntry));
+        }
+    }
+    VSICloseDir(psDir);
+
+    if (nTotalSize <= m_nMaxSize)
+        return;
+
+    CPLDebug("VSICURL",
+             "Disk cache size is " CPL_FRMT_GIB " bytes. Evicting entries",
+             nTotalSize);
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    const GIntBig nTargetSize = m_nMaxSize / 10 * 8;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+    }
+}
+
+/************************************************************************/
+/*                              GetChunk()                              */
+/************************************************************************/
+
+bool VSICurlDiskCache::GetChunk(const std::string &osURL,
+                                const FileProp &oFileProp,
+                                vsi_l_offset nOffset, std::string &osData)
+{
+    const std::string osKey =
+        VSICurlDiskCacheChunkKey(osURL, oFileProp, nOffset);
+    if (osKey.empty())
+        return false;
+    return ReadEntry(GetEntryFilename(osKey, "chunk"), osKey, osData) &&
+           !osData.empty();
+}
+
+/************************************************************************/
+/*                              HasChunk()                              */
+/************************************************************************/
+
+bool VSICurlDiskCache::HasChunk(const std::string &osURL,
+                                const FileProp &oFileProp,
+                                vsi_l_offset nOffset) const
+{
+    const std::string osKey =
+        VSICurlDiskCacheChunkKey(osURL, oFileProp, nOffset);
+    if (osKey.empty())
+        return false;
+    VSIStatBufL sStat;
+    return VSIStatExL(GetEntryFilename(osKey, "chunk").c_str(), &sStat,
+                      VSI_STAT_EXISTS_FLAG) == 0;
+}
+
+/************************************************************************/
+/*                              PutChunk()                              */
+/************************************************************************/
+
+void VSICurlDiskCache::PutChunk(const std::string &osURL,
+                                const FileProp &oFileProp,
+                                vsi_l_offset nOffset, const char *pData,
+                                size_t nSize)
+{
+    const std::string osKey =
+        VSICurlDiskCacheChunkKey(osURL, oFileProp, nOffset);
+    if (osKey.empty() || nSize == 0)
+        return;
+    WriteEntry(GetEntryFilename(osKey, "chunk"), osKey, pData, nSize);
+}
+
+/************************************************************************/
+/*                            GetFileProp()                             */
+/************************************************************************/
+
+// Only the file size, ETag and modification time are persisted.
+bool VSICurlDiskCache::GetFileProp(const std::string &osURL,
+                                   FileProp &oFileProp,
+                                   GIntBig &nValidationTime)
+{
+    const std::string osKey("prop\n" + osURL);
+    std::string osData;
+    if (!ReadEntry(GetEntryFilename(osKey, "prop"), osKey, osData))
+        return false;
+
+    const CPLStringList aosProps(
+        CSLTokenizeString2(osData.c_str(), "\n", 0));
+    const char *pszSize = aosProps.FetchNameValue("SIZE");
+    const char *pszValidationTime = aosProps.FetchNameValue("VALIDATED");
+    if (pszSize == nullptr || pszValidationTime == nullptr)
+        return false;
+    oFileProp.fileSize =
+        static_cast<vsi_l_offset>(CPLAtoGIntBig(pszSize));
+    oFileProp.ETag = aosProps.FetchNameValueDef("ETAG", "");
+    oFileProp.mTime = static_cast<time_t>(
+        CPLAtoGIntBig(aosProps.FetchNameValueDef("MTIME", "0")));
+    nValidationTime = CPLAtoGIntBig(pszValidationTime);
+    return !VSICurlDiskCacheValidator(oFileProp).empty();
+}
+
+/************************************************************************/
+/*                            PutFileProp()                             */
+/************************************************************************/
+
+void VSICurlDiskCache::PutFileProp(const std::string &osURL,
+                                   const FileProp &oFileProp)
+{
+    if (oFileProp.eExists != EXIST_YES || oFileProp.bIsDirectory ||
+        VSICurlDiskCacheValidator(oFileProp).empty())
+    {
+        return;
+    }
+    CPLStringList aosProps;
+    aosProps.SetNameValue(
+        "SIZE", CPLSPrintf(CPL_FRMT_GUIB,
+                           static_cast<GUIntBig>(oFileProp.fileSize)));
+    if (!oFileProp.ETag.empty())
+        aosProps.SetNameValue("ETAG", oFileProp.ETag.c_str());
+    aosProps.SetNameValue(
+        "MTIME",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(oFileProp.mTime)));
+    aosProps.SetNameValue(
+        "VALIDATED",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(time(nullptr))));
+    std::string osData;
+    for (const char *pszProp : aosProps)
+    {
+        osData += pszProp;
+        osData += '\n';
+    }
+    const std::string osKey("prop\n" + osURL);
+    WriteEntry(GetEntryFilename(osKey, "prop"), osKey, osData.data(),
+               osData.size());
+}
+
+/************************************************************************/
+/*                           RemoveFileProp()                           */
+/************************************************************************/
+
+void VSICurlDiskCache::RemoveFileProp(const std::string &osURL)
+{
+    const std::string osKey("prop\n" + osURL);
+    VSIUnlink(GetEntryFilename(osKey, "prop").c_str());
+}
+
+}  // namespace cpl
+
+#endif  // HAVE_CURL
@@ -45,6 +45,8 @@ typedef int (*VSICurlReadCbkFunc)(VSILFILE *fp, void *pabyBuffer,
 /* must be canceled after a first one has been stopped by the callback */
 /* function.  In that case, downloads will restart after uninstalling the */
 /* callback. */
+/* When GDAL_HTTP_CONNECTION_POOL is enabled, the callback is called from the */
+/* thread of the connection pool, not from the thread reading from fp. */
 int VSICurlInstallReadCbk(VSILFILE *fp, VSICurlReadCbkFunc pfnReadCbk,
                           void *pfnUserData,
                           int bStopOnInterruptUntilUninstall);
@@ -98,6 +98,7 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -109,6 +110,7 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
@@ -1931,6 +1933,1050 @@ int VSIDeflate64Handle::Close()
 }
 #endif
 
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSIGZipReadHandleMT                            */
+/* ==================================================================== */
+/************************************************************************/
+
+// Size of the compressed data of a block, beyond which we try to cut it.
+constexpr size_t GZIP_MT_MIN_BLOCK_SIZE = 1024 * 1024;
+// Maximum size of the compressed data of a block.
+constexpr size_t GZIP_MT_MAX_BLOCK_SIZE = 8 * 1024 * 1024;
+// Maximum size of the uncompressed data of a block.
+constexpr size_t GZIP_MT_MAX_UNCOMPRESSED_BLOCK_SIZE = 128 * 1024 * 1024;
+// Size of the reads done in the compressed stream to find blocks.
+constexpr size_t GZIP_MT_SCAN_CHUNK_SIZE = 1024 * 1024;
+// Size of the beginning of a non-BGZF stream where a full flush marker must
+// be found for the multi-threaded reader to be used. This covers a chunk
+// written by VSIGZipWriteHandleMT with the default settings, unless its
+// content is nearly incompressible.
+constexpr size_t GZIP_MT_PROBE_SIZE = 1024 * 1024;
+
+// Marker emitted by a Z_SYNC_FLUSH followed by a Z_FULL_FLUSH, as written by
+// VSIGZipWriteHandleMT and pigz --independent.
+constexpr char GZIP_FULL_FLUSH_MARKER[] = {0x00, 0x00, '\xFF', '\xFF', 0x00,
+                                           0x00, 0x00, '\xFF', '\xFF'};
+
+constexpr char GZIP_INDEX_MAGIC[] = "GDALGZI1";
+constexpr size_t GZIP_INDEX_HEADER_SIZE = 8 + 8 + 8 + 4 + 4;
+constexpr size_t GZIP_INDEX_ENTRY_SIZE = 3 * 8;
+constexpr GUInt32 GZIP_INDEX_FLAG_BGZF = 1;
+
+// Reader of .gz files made of independently compressed blocks, that are
+// inflated in parallel. Two layouts are recognized:
+// - BGZF files, that are a sequence of gzip members, each one advertising its
+//   size in a "BC" extra subfield. Consecutive members are grouped in a block.
+// - single member files where deflate chunks are terminated by a full flush
+//   marker, such as the ones written by VSIGZipWriteHandleMT. The marker might
+//   also appear by chance in the compressed data, so the decoding of each
+//   block is checked to end exactly on a deflate block boundary.
+// The location of blocks in the uncompressed stream is saved in a .idx
+// side-car file, once the whole file has been read, so that further opening
+// can seek directly to the block of interest.
+// If a block cannot be decoded independently, reading switches to a
+// VSIGZipHandle.
+
+class VSIGZipReadHandleMT final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipReadHandleMT)
+
+    struct Block
+    {
+        vsi_l_offset nCompressedOffset = 0;
+        vsi_l_offset nCompressedSize = 0;
+        vsi_l_offset nUncompressedOffset = 0;
+        vsi_l_offset nUncompressedSize = 0;
+    };
+
+    struct Job
+    {
+        VSIGZipReadHandleMT *poParent = nullptr;
+        bool bLastBlock = false;
+        std::string osCompressed{};
+        std::string osUncompressed{};
+        uLong nCRC = 0;
+        GUInt32 nTrailerCRC = 0;
+        GUInt32 nTrailerSize = 0;
+        bool bDone = false;
+        bool bOK = false;
+
+        bool InflateRaw();
+        bool InflateBGZF();
+    };
+
+    std::unique_ptr<VSIVirtualHandle> m_poBaseHandle{};
+    std::string m_osBaseFilename{};
+    vsi_l_offset m_nCompressedSize = 0;
+    GIntBig m_nMTime = 0;
+    bool m_bBGZF = false;
+    int m_nThreads = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPool{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+
+    std::vector<Block> m_aoBlocks{};
+    // Blocks [0, m_nBlocksWithKnownSize[ have their uncompressed offset and
+    // size set.
+    size_t m_nBlocksWithKnownSize = 0;
+    vsi_l_offset m_nUncompressedSize = 0;
+    uLong m_nCRC = 0;
+    bool m_bIndexComplete = false;
+    bool m_bIndexLoaded = false;
+
+    // Compressed data read, but not yet attributed to a block.
+    std::string m_osScanBuffer{};
+    vsi_l_offset m_nScanOffset = 0;
+    bool m_bDiscoveryFinished = false;
+    bool m_bDiscoveryError = false;
+
+    std::map<size_t, std::unique_ptr<Job>> m_oMapJobs{};
+
+    vsi_l_offset m_nCurPos = 0;
+    bool m_bEOF = false;
+    bool m_bError = false;
+    std::unique_ptr<VSIVirtualHandle> m_poFallback{};
+
+    VSIGZipReadHandleMT(VSIVirtualHandle *poBaseHandle,
+                        const char *pszBaseFilename, int nThreads);
+
+    static void InflateJob(void *pData);
+    bool FillScanBuffer(size_t nMinSize);
+    bool DiscoverNextBlock(std::string &osCompressed);
+    void SubmitJob(size_t iBlock, std::string &&osCompressed);
+    bool ScheduleJobs(size_t iFirst);
+    const Job *WaitBlock(size_t iBlock);
+    bool AdvanceKnownSize();
+    bool LocateBlock(vsi_l_offset nPos, size_t &iBlock);
+    bool SwitchToFallback();
+    std::string GetIndexFilename() const;
+    bool LoadIndex(size_t nHeaderSize);
+    void SaveIndex();
+
+  public:
+    ~VSIGZipReadHandleMT() override;
+
+    static VSIVirtualHandle *Create(const char *pszBaseFilename, int nThreads);
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Flush() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                        VSIGZipParseHeader()                          */
+/************************************************************************/
+
+// Parse the gzip member header at the start of pabyData, and return its size
+// in nHeaderSize. nBSize is set to the value of the BGZF "BC" extra subfield
+// (size of the member minus one), or -1 if there is none.
+static bool VSIGZipParseHeader(const GByte *pabyData, size_t nSize,
+                               size_t &nHeaderSize, int &nBSize)
+{
+    nBSize = -1;
+    if (nSize < 10 || pabyData[0] != gz_magic[0] ||
+        pabyData[1] != gz_magic[1] || pabyData[2] != Z_DEFLATED ||
+        (pabyData[3] & RESERVED) != 0)
+    {
+        return false;
+    }
+    const int nFlags = pabyData[3];
+    size_t nPos = 10;
+    if ((nFlags & EXTRA_FIELD) != 0)
+    {
+        if (nSize - nPos < 2)
+            return false;
+        const size_t nXLen = pabyData[nPos] | (pabyData[nPos + 1] << 8);
+        nPos += 2;
+        if (nSize - nPos < nXLen)
+            return false;
+        for (size_t i = 0; i + 4 <= nXLen;)
+        {
+            const GByte *pabySubField = pabyData + nPos + i;
+            const size_t nSubFieldLen =
+                pabySubField[2] | (pabySubField[3] << 8);
+            if (pabySubField[0] == 'B' && pabySubField[1] == 'C' &&
+                nSubFieldLen == 2 && i + 6 <= nXLen)
+            {
+                nBSize = pabySubField[4] | (pabySubField[5] << 8);
+            }
+            i += 4 + nSubFieldLen;
+        }
+        nPos += nXLen;
+    }
+    for (const int nFlag : {ORIG_NAME, COMMENT})
+    {
+        if ((nFlags & nFlag) != 0)
+        {
+            const GByte *pabyEnd = static_cast<const GByte *>(
+                memchr(pabyData + nPos, 0, nSize - nPos));
+            if (pabyEnd == nullptr)
+                return false;
+            nPos = static_cast<size_t>(pabyEnd - pabyData) + 1;
+        }
+    }
+    if ((nFlags & HEAD_CRC) != 0)
+    {
+        if (nSize - nPos < 2)
+            return false;
+        nPos += 2;
+    }
+    nHeaderSize = nPos;
+    return true;
+}
+
+/************************************************************************/
+/*                        VSIGZipInflateRaw()                           */
+/************************************************************************/
+
+// Inflate the raw deflate data of pabyIn and append it to osOut, without
+// letting it grow beyond GZIP_MT_MAX_UNCOMPRESSED_BLOCK_SIZE.
+// Returns the code of the last inflate() call.
+static int VSIGZipInflateRaw(z_stream &sStream, const GByte *pabyIn,
+                             size_t nInSize, std::string &osOut)
+{
+    sStream.next_in = const_cast<Bytef *>(pabyIn);
+    sStream.avail_in = static_cast<uInt>(nInSize);
+    size_t nRealSize = osOut.size();
+    int ret = Z_OK;
+    while (true)
+    {
+        if (nRealSize == osOut.size())
+        {
+            const size_t nIncrement =
+                std::min(std::max(static_cast<size_t>(Z_BUFSIZE), nRealSize),
+                         GZIP_MT_MAX_UNCOMPRESSED_BLOCK_SIZE - nRealSize);
+            if (nIncrement == 0)
+            {
+                ret = Z_MEM_ERROR;
+                break;
+            }
+            osOut.resize(nRealSize + nIncrement);
+        }
+        sStream.next_out = reinterpret_cast<Bytef *>(&osOut[nRealSize]);
+        sStream.avail_out = static_cast<uInt>(osOut.size() - nRealSize);
+        ret = inflate(&sStream, Z_NO_FLUSH);
+        nRealSize = osOut.size() - sStream.avail_out;
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            break;
+        if (sStream.avail_in == 0 && sStream.avail_out != 0)
+            break;
+    }
+    osOut.resize(nRealSize);
+    return ret;
+}
+
+/************************************************************************/
+/*                            InflateRaw()                              */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::Job::InflateRaw()
+{
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+        return false;
+
+    const GByte *pabyIn = reinterpret_cast<const GByte *>(osCompressed.data());
+    const int ret =
+        VSIGZipInflateRaw(sStream, pabyIn, osCompressed.size(), osUncompressed);
+    bool bValid;
+    if (bLastBlock)
+    {
+        // The deflate stream must be followed by exactly the gzip trailer.
+        bValid = ret == Z_STREAM_END && sStream.avail_in == 8;
+        if (bValid)
+        {
+            const GByte *pabyTrailer = pabyIn + osCompressed.size() - 8;
+            nTrailerCRC = CPL_LSBUINT32PTR(pabyTrailer);
+            nTrailerSize = CPL_LSBUINT32PTR(pabyTrailer + 4);
+        }
+    }
+    else
+    {
+        // Decoding must stop right at the start of a new deflate block, on a
+        // byte boundary (which is what data_type == 128 means). Otherwise
+        // the flush marker was just a coincidence in the compressed data.
+        // A reference to data of previous blocks would have been rejected
+        // by inflate() as being too far back.
+        bValid = (ret == Z_OK || ret == Z_BUF_ERROR) && sStream.avail_in == 0 &&
+              (sStream.data_type & 0x1FF) == 128;
+    }
+    inflateEnd(&sStream);
+
+    if (bValid)
+    {
+        nCRC = crc32(0U, reinterpret_cast<const Bytef *>(osUncompressed.data()),
+                     static_cast<uInt>(osUncompressed.size()));
+    }
+    return bValid;
+}
+
+/************************************************************************/
+/*                            InflateBGZF()                             */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::Job::InflateBGZF()
+{
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+        return false;
+
+    const GByte *pabyIn = reinterpret_cast<const GByte *>(osCompressed.data());
+    const size_t nInSize = osCompressed.size();
+    bool bValid = true;
+    for (size_t nPos = 0; bValid && nPos < nInSize;)
+    {
+        size_t nHeaderSize = 0;
+        int nBSize = 0;
+        if (!VSIGZipParseHeader(pabyIn + nPos, nInSize - nPos, nHeaderSize,
+                                nBSize) ||
+            nBSize < 0 || static_cast<size_t>(nBSize) + 1 < nHeaderSize + 8 ||
+            static_cast<size_t>(nBSize) + 1 > nInSize - nPos)
+        {
+            bValid = false;
+            break;
+        }
+        const size_t nMemberSize = static_cast<size_t>(nBSize) + 1;
+        const size_t nOutStart = osUncompressed.size();
+        inflateReset(&sStream);
+        const int ret = VSIGZipInflateRaw(sStream, pabyIn + nPos + nHeaderSize,
+                                          nMemberSize - nHeaderSize - 8,
+                                          osUncompressed);
+        const GByte *pabyTrailer = pabyIn + nPos + nMemberSize - 8;
+        const size_t nOutSize = osUncompressed.size() - nOutStart;
+        bValid = ret == Z_STREAM_END && sStream.avail_in == 0 &&
+              crc32(0U,
+                    reinterpret_cast<const Bytef *>(osUncompressed.data() +
+                                                    nOutStart),
+                    static_cast<uInt>(nOutSize)) ==
+                  CPL_LSBUINT32PTR(pabyTrailer) &&
+              static_cast<GUInt32>(nOutSize) ==
+                  CPL_LSBUINT32PTR(pabyTrailer + 4);
+        nPos += nMemberSize;
+    }
+    inflateEnd(&sStream);
+    return bValid;
+}
+
+/************************************************************************/
+/*                            InflateJob()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::InflateJob(void *pData)
+{
+    Job *psJob = static_cast<Job *>(pData);
+    VSIGZipReadHandleMT *poParent = psJob->poParent;
+    const bool bOK =
+        poParent->m_bBGZF ? psJob->InflateBGZF() : psJob->InflateRaw();
+    if (!bOK)
+        psJob->osUncompressed.clear();
+    psJob->osCompressed.clear();
+    psJob->osCompressed.shrink_to_fit();
+    {
+        std::lock_guard<std::mutex> oLock(poParent->m_oMutex);
+        psJob->bOK = bOK;
+        psJob->bDone = true;
+    }
+    poParent->m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                        VSIGZipReadHandleMT()                         */
+/************************************************************************/
+
+VSIGZipReadHandleMT::VSIGZipReadHandleMT(VSIVirtualHandle *poBaseHandle,
+                                         const char *pszBaseFilename,
+                                         int nThreads)
+    : m_poBaseHandle(poBaseHandle), m_osBaseFilename(pszBaseFilename),
+      m_nThreads(nThreads)
+{
+}
+
+/************************************************************************/
+/*                       ~VSIGZipReadHandleMT()                         */
+/************************************************************************/
+
+VSIGZipReadHandleMT::~VSIGZipReadHandleMT()
+{
+    VSIGZipReadHandleMT::Close();
+    if (m_poPool)
+        m_poPool->WaitCompletion();
+    if (m_poBaseHandle)
+        m_poBaseHandle->Close();
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+VSIVirtualHandle *VSIGZipReadHandleMT::Create(const char *pszBaseFilename,
+                                              int nThreads)
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(pszBaseFilename, &sStat) != 0)
+        return nullptr;
+
+    VSIVirtualHandle *poBaseHandle =
+        VSIFileManager::GetHandler(pszBaseFilename)
+            ->Open(pszBaseFilename, "rb");
+    if (poBaseHandle == nullptr)
+        return nullptr;
+
+    std::unique_ptr<VSIGZipReadHandleMT> poHandle(
+        new VSIGZipReadHandleMT(poBaseHandle, pszBaseFilename, nThreads));
+    if (poBaseHandle->Seek(0, SEEK_END) != 0)
+        return nullptr;
+    poHandle->m_nCompressedSize = poBaseHandle->Tell();
+    poHandle->m_nMTime = static_cast<GIntBig>(sStat.st_mtime);
+
+    // Enough to get the header, unless it has a very long file name.
+    poHandle->FillScanBuffer(65536);
+    size_t nHeaderSize = 0;
+    int nBSize = 0;
+    if (!VSIGZipParseHeader(
+            reinterpret_cast<const GByte *>(poHandle->m_osScanBuffer.data()),
+            poHandle->m_osScanBuffer.size(), nHeaderSize, nBSize))
+    {
+        return nullptr;
+    }
+    poHandle->m_bBGZF = nBSize >= 0;
+    if (!poHandle->m_bBGZF)
+    {
+        poHandle->m_osScanBuffer.erase(0, nHeaderSize);
+        poHandle->m_nScanOffset = nHeaderSize;
+    }
+
+    poHandle->m_poPool = std::make_unique<CPLWorkerThreadPool>();
+    if (!poHandle->m_poPool->Setup(nThreads, nullptr, nullptr, false))
+        return nullptr;
+
+    if (!poHandle->LoadIndex(nHeaderSize) && !poHandle->m_bBGZF)
+    {
+        // Check that there is at least a full flush marker at the beginning
+        // of the stream, otherwise the file is better read sequentially.
+        // Only a limited amount of data is looked at, so that plain .gz files
+        // do not get scanned over several megabytes before falling back.
+        poHandle->FillScanBuffer(GZIP_MT_PROBE_SIZE);
+        if (poHandle->m_osScanBuffer.find(
+                GZIP_FULL_FLUSH_MARKER, 0,
+                sizeof(GZIP_FULL_FLUSH_MARKER)) == std::string::npos)
+        {
+            return nullptr;
+        }
+        std::string osCompressed;
+        if (!poHandle->DiscoverNextBlock(osCompressed) ||
+            poHandle->m_bDiscoveryFinished)
+        {
+            return nullptr;
+        }
+        poHandle->SubmitJob(0, std::move(osCompressed));
+    }
+
+    return poHandle.release();
+}
+
+/************************************************************************/
+/*                          GetIndexFilename()                          */
+/************************************************************************/
+
+std::string VSIGZipReadHandleMT::GetIndexFilename() const
+{
+    return m_osBaseFilename + ".idx";
+}
+
+/************************************************************************/
+/*                             LoadIndex()                              */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::LoadIndex(size_t nHeaderSize)
+{
+    VSILFILE *fp = VSIFOpenL(GetIndexFilename().c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    const auto ReadUInt64 = [](const GByte *pabyData)
+    {
+        GUInt64 nVal;
+        memcpy(&nVal, pabyData, sizeof(nVal));
+        CPL_LSBPTR64(&nVal);
+        return nVal;
+    };
+
+    GByte abyHeader[GZIP_INDEX_HEADER_SIZE];
+    bool bOK = VSIFReadL(abyHeader, 1, sizeof(abyHeader), fp) ==
+                   sizeof(abyHeader) &&
+               memcmp(abyHeader, GZIP_INDEX_MAGIC, 8) == 0 &&
+               ReadUInt64(abyHeader + 8) == m_nCompressedSize &&
+               static_cast<GIntBig>(ReadUInt64(abyHeader + 16)) == m_nMTime &&
+               ((CPL_LSBUINT32PTR(abyHeader + 24) & GZIP_INDEX_FLAG_BGZF) !=
+                0) == m_bBGZF;
+    const GUInt32 nBlocks = bOK ? CPL_LSBUINT32PTR(abyHeader + 28) : 0;
+    bOK = bOK && nBlocks > 0 && nBlocks <= m_nCompressedSize;
+
+    std::vector<Block> aoBlocks;
+    vsi_l_offset nCompressedOffset = m_bBGZF ? 0 : nHeaderSize;
+    vsi_l_offset nUncompressedOffset = 0;
+    for (GUInt32 i = 0; bOK && i < nBlocks; ++i)
+    {
+        GByte abyEntry[GZIP_INDEX_ENTRY_SIZE];
+        Block oBlock;
+        bOK = VSIFReadL(abyEntry, 1, sizeof(abyEntry), fp) ==
+              sizeof(abyEntry);
+        if (!bOK)
+            break;
+        oBlock.nCompressedOffset = ReadUInt64(abyEntry);
+        oBlock.nCompressedSize = ReadUInt64(abyEntry + 8);
+        oBlock.nUncompressedSize = ReadUInt64(abyEntry + 16);
+        oBlock.nUncompressedOffset = nUncompressedOffset;
+        bOK = oBlock.nCompressedOffset == nCompressedOffset &&
+              oBlock.nCompressedSize > 0 &&
+              oBlock.nCompressedSize <=
+                  GZIP_MT_MIN_BLOCK_SIZE + GZIP_MT_MAX_BLOCK_SIZE &&
+              oBlock.nUncompressedSize <= GZIP_MT_MAX_UNCOMPRESSED_BLOCK_SIZE;
+        nCompressedOffset += oBlock.nCompressedSize;
+        nUncompressedOffset += oBlock.nUncompressedSize;
+        aoBlocks.push_back(oBlock);
+    }
+    bOK = bOK && nCompressedOffset == m_nCompressedSize;
+    CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+
+    if (!bOK)
+    {
+        CPLDebug("GZIP", "Ignoring invalid or outdated %s",
+                 GetIndexFilename().c_str());
+        return false;
+    }
+
+    m_aoBlocks = std::move(aoBlocks);
+    m_nBlocksWithKnownSize = m_aoBlocks.size();
+    m_nUncompressedSize = nUncompressedOffset;
+    m_bIndexComplete = true;
+    m_bIndexLoaded = true;
+    m_bDiscoveryFinished = true;
+    m_osScanBuffer.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                             SaveIndex()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::SaveIndex()
+{
+    VSILFILE *fp = VSIFOpenL(GetIndexFilename().c_str(), "wb");
+    if (fp == nullptr)
+        return;
+
+    const auto WriteUInt64 = [](GByte *pabyData, GUInt64 nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        memcpy(pabyData, &nVal, sizeof(nVal));
+    };
+
+    std::vector<GByte> abyIndex(GZIP_INDEX_HEADER_SIZE +
+                                m_aoBlocks.size() * GZIP_INDEX_ENTRY_SIZE);
+    GByte *pabyData = abyIndex.data();
+    memcpy(pabyData, GZIP_INDEX_MAGIC, 8);
+    WriteUInt64(pabyData + 8, m_nCompressedSize);
+    WriteUInt64(pabyData + 16, static_cast<GUInt64>(m_nMTime));
+    const GUInt32 nFlags =
+        CPL_LSBWORD32(m_bBGZF ? GZIP_INDEX_FLAG_BGZF : static_cast<GUInt32>(0));
+    memcpy(pabyData + 24, &nFlags, sizeof(nFlags));
+    const GUInt32 nBlocks =
+        CPL_LSBWORD32(static_cast<GUInt32>(m_aoBlocks.size()));
+    memcpy(pabyData + 28, &nBlocks, sizeof(nBlocks));
+    pabyData += GZIP_INDEX_HEADER_SIZE;
+    for (const auto &oBlock : m_aoBlocks)
+    {
+        WriteUInt64(pabyData, oBlock.nCompressedOffset);
+        WriteUInt64(pabyData + 8, oBlock.nCompressedSize);
+        WriteUInt64(pabyData + 16, oBlock.nUncompressedSize);
+        pabyData += GZIP_INDEX_ENTRY_SIZE;
+    }
+    CPL_IGNORE_RET_VAL(VSIFWriteL(abyIndex.data(), 1, abyIndex.size(), fp));
+    CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+}
+
+/************************************************************************/
+/*                           FillScanBuffer()                           */
+/************************************************************************/
+
+// Read compressed data until m_osScanBuffer has at least nMinSize bytes.
+// Returns false if the end of the file, or an error, is met before.
+bool VSIGZipReadHandleMT::FillScanBuffer(size_t nMinSize)
+{
+    while (m_osScanBuffer.size() < nMinSize)
+    {
+        const size_t nOldSize = m_osScanBuffer.size();
+        const vsi_l_offset nReadOffset = m_nScanOffset + nOldSize;
+        if (nReadOffset >= m_nCompressedSize)
+            return false;
+        const size_t nToRead = static_cast<size_t>(
+            std::min(static_cast<vsi_l_offset>(std::max(
+                         GZIP_MT_SCAN_CHUNK_SIZE, nMinSize - nOldSize)),
+                     m_nCompressedSize - nReadOffset));
+        m_osScanBuffer.resize(nOldSize + nToRead);
+        if (m_poBaseHandle->Seek(nReadOffset, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(&m_osScanBuffer[nOldSize], 1, nToRead) !=
+                nToRead)
+        {
+            m_osScanBuffer.resize(nOldSize);
+            m_bDiscoveryError = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         DiscoverNextBlock()                          */
+/************************************************************************/
+
+// Find the extent of the block following the last one of m_aoBlocks, append
+// it to m_aoBlocks, and return its compressed data.
+bool VSIGZipReadHandleMT::DiscoverNextBlock(std::string &osCompressed)
+{
+    if (m_bDiscoveryFinished || m_bDiscoveryError)
+        return false;
+
+    size_t nBlockSize = 0;
+    if (m_bBGZF)
+    {
+        while (nBlockSize < GZIP_MT_MIN_BLOCK_SIZE)
+        {
+            if (m_nScanOffset + nBlockSize == m_nCompressedSize)
+            {
+                m_bDiscoveryFinished = true;
+                break;
+            }
+            // A BGZF member is at most 65536 bytes large.
+            FillScanBuffer(nBlockSize + 65536);
+            if (m_bDiscoveryError)
+                return false;
+            size_t nHeaderSize = 0;
+            int nBSize = 0;
+            if (!VSIGZipParseHeader(reinterpret_cast<const GByte *>(
+                                        m_osScanBuffer.data() + nBlockSize),
+                                    m_osScanBuffer.size() - nBlockSize,
+                                    nHeaderSize, nBSize) ||
+                nBSize < 0 ||
+                static_cast<size_t>(nBSize) + 1 < nHeaderSize + 8 ||
+                static_cast<size_t>(nBSize) + 1 >
+                    m_osScanBuffer.size() - nBlockSize)
+            {
+                CPLDebug("GZIP", "%s: invalid BGZF member at " CPL_FRMT_GUIB,
+                         m_osBaseFilename.c_str(),
+                         static_cast<GUIntBig>(m_nScanOffset + nBlockSize));
+                m_bDiscoveryError = true;
+                return false;
+            }
+            nBlockSize += static_cast<size_t>(nBSize) + 1;
+        }
+        if (nBlockSize == 0)
+            return false;
+    }
+    else
+    {
+        constexpr size_t nMarkerSize = sizeof(GZIP_FULL_FLUSH_MARKER);
+        size_t nSearchPos = GZIP_MT_MIN_BLOCK_SIZE - nMarkerSize;
+        while (true)
+        {
+            if (m_osScanBuffer.size() > nSearchPos)
+            {
+                const size_t nMarkerPos = m_osScanBuffer.find(
+                    GZIP_FULL_FLUSH_MARKER, nSearchPos, nMarkerSize);
+                if (nMarkerPos != std::string::npos)
+                {
+                    nBlockSize = nMarkerPos + nMarkerSize;
+                    break;
+                }
+                nSearchPos = std::max(nSearchPos, m_osScanBuffer.size() -
+                                                      (nMarkerSize - 1));
+            }
+            if (m_nScanOffset + m_osScanBuffer.size() == m_nCompressedSize)
+            {
+                m_bDiscoveryFinished = true;
+                nBlockSize = m_osScanBuffer.size();
+                if (nBlockSize == 0)
+                    return false;
+                break;
+            }
+            if (m_osScanBuffer.size() >=
+                GZIP_MT_MIN_BLOCK_SIZE + GZIP_MT_MAX_BLOCK_SIZE)
+            {
+                CPLDebug("GZIP",
+                         "%s: no full flush marker found after " CPL_FRMT_GUIB,
+                         m_osBaseFilename.c_str(),
+                         static_cast<GUIntBig>(m_nScanOffset));
+                m_bDiscoveryError = true;
+                return false;
+            }
+            FillScanBuffer(m_osScanBuffer.size() + GZIP_MT_SCAN_CHUNK_SIZE);
+            if (m_bDiscoveryError)
+                return false;
+        }
+    }
+
+    Block oBlock;
+    oBlock.nCompressedOffset = m_nScanOffset;
+    oBlock.nCompressedSize = nBlockSize;
+    m_aoBlocks.push_back(oBlock);
+    osCompressed.assign(m_osScanBuffer, 0, nBlockSize);
+    m_osScanBuffer.erase(0, nBlockSize);
+    m_nScanOffset += nBlockSize;
+    return true;
+}
+
+/************************************************************************/
+/*                             SubmitJob()                              */
+/************************************************************************/
+
+void VSIGZipReadHandleMT::SubmitJob(size_t iBlock, std::string &&osCompressed)
+{
+    const Block &oBlock = m_aoBlocks[iBlock];
+    auto poJob = std::make_unique<Job>();
+    poJob->poParent = this;
+    poJob->bLastBlock = oBlock.nCompressedOffset + oBlock.nCompressedSize ==
+                        m_nCompressedSize;
+    poJob->osCompressed = std::move(osCompressed);
+    Job *psJob = poJob.get();
+    m_oMapJobs[iBlock] = std::move(poJob);
+    if (!m_poPool->SubmitJob(InflateJob, psJob))
+        InflateJob(psJob);
+}
+
+/************************************************************************/
+/*                            ScheduleJobs()                            */
+/************************************************************************/
+
+// Make sure that block iFirst, and the ones following it, are being decoded.
+bool VSIGZipReadHandleMT::ScheduleJobs(size_t iFirst)
+{
+    const size_t nReadAhead = 2 * static_cast<size_t>(m_nThreads);
+
+    // Release decoded blocks out of the read-ahead window, except the one
+    // just before it, which is likely to be needed by small backward seeks.
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        for (auto oIter = m_oMapJobs.begin(); oIter != m_oMapJobs.end();)
+        {
+            if ((oIter->first + 1 < iFirst ||
+                 oIter->first >= iFirst + nReadAhead) &&
+                oIter->second->bDone)
+            {
+                oIter = m_oMapJobs.erase(oIter);
+            }
+            else
+            {
+                ++oIter;
+            }
+        }
+    }
+
+    for (size_t i = iFirst; i < iFirst + nReadAhead; ++i)
+    {
+        if (m_oMapJobs.find(i) != m_oMapJobs.end())
+            continue;
+        std::string osCompressed;
+        if (i < m_aoBlocks.size())
+        {
+            const Block &oBlock = m_aoBlocks[i];
+            osCompressed.resize(static_cast<size_t>(oBlock.nCompressedSize));
+            if (m_poBaseHandle->Seek(oBlock.nCompressedOffset, SEEK_SET) != 0 ||
+                m_poBaseHandle->Read(&osCompressed[0], 1,
+                                     osCompressed.size()) !=
+                    osCompressed.size())
+            {
+                return i > iFirst;
+            }
+        }
+        else if (!DiscoverNextBlock(osCompressed))
+        {
+            return i > iFirst;
+        }
+        SubmitJob(i, std::move(osCompressed));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             WaitBlock()                              */
+/************************************************************************/
+
+const VSIGZipReadHandleMT::Job *VSIGZipReadHandleMT::WaitBlock(size_t iBlock)
+{
+    if (!ScheduleJobs(iBlock))
+        return nullptr;
+    const Job *psJob = m_oMapJobs[iBlock].get();
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    m_oCV.wait(oLock, [psJob] { return psJob->bDone; });
+    return psJob->bOK ? psJob : nullptr;
+}
+
+/************************************************************************/
+/*                          AdvanceKnownSize()                          */
+/************************************************************************/
+
+// Decode the first block whose uncompressed size is not known yet.
+bool VSIGZipReadHandleMT::AdvanceKnownSize()
+{
+    const size_t iBlock = m_nBlocksWithKnownSize;
+    const Job *psJob = WaitBlock(iBlock);
+    if (psJob == nullptr)
+    {
+        if (m_bDiscoveryFinished && iBlock >= m_aoBlocks.size())
+            m_bIndexComplete = true;
+        else
+            SwitchToFallback();
+        return false;
+    }
+
+    Block &oBlock = m_aoBlocks[iBlock];
+    if (iBlock > 0)
+    {
+        const Block &oPrevBlock = m_aoBlocks[iBlock - 1];
+        oBlock.nUncompressedOffset =
+            oPrevBlock.nUncompressedOffset + oPrevBlock.nUncompressedSize;
+    }
+    oBlock.nUncompressedSize = psJob->osUncompressed.size();
+    ++m_nBlocksWithKnownSize;
+    if (!m_bBGZF)
+    {
+        m_nCRC = crc32_combine(m_nCRC, psJob->nCRC,
+                               static_cast<uLong>(oBlock.nUncompressedSize));
+    }
+
+    if (oBlock.nCompressedOffset + oBlock.nCompressedSize == m_nCompressedSize)
+    {
+        m_nUncompressedSize =
+            oBlock.nUncompressedOffset + oBlock.nUncompressedSize;
+        if (!m_bBGZF &&
+            (psJob->nTrailerCRC != m_nCRC ||
+             psJob->nTrailerSize !=
+                 static_cast<GUInt32>(m_nUncompressedSize & 0xFFFFFFFFU)))
+        {
+            // Let VSIGZipHandle report the error.
+            SwitchToFallback();
+            return false;
+        }
+        m_bIndexComplete = true;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            LocateBlock()                             */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::LocateBlock(vsi_l_offset nPos, size_t &iBlock)
+{
+    while (true)
+    {
+        if (m_nBlocksWithKnownSize > 0)
+        {
+            const Block &oLastBlock = m_aoBlocks[m_nBlocksWithKnownSize - 1];
+            if (nPos <
+                oLastBlock.nUncompressedOffset + oLastBlock.nUncompressedSize)
+            {
+                const auto oIter = std::upper_bound(
+                    m_aoBlocks.begin(),
+                    m_aoBlocks.begin() + m_nBlocksWithKnownSize, nPos,
+                    [](vsi_l_offset nVal, const Block &oBlock)
+                    { return nVal < oBlock.nUncompressedOffset; });
+                iBlock = static_cast<size_t>(oIter - m_aoBlocks.begin()) - 1;
+                return true;
+            }
+        }
+        if (m_bIndexComplete || !AdvanceKnownSize())
+            return false;
+    }
+}
+
+/************************************************************************/
+/*                          SwitchToFallback()                          */
+/************************************************************************/
+
+bool VSIGZipReadHandleMT::SwitchToFallback()
+{
+    if (m_poFallback)
+        return true;
+    if (m_bError)
+        return false;
+    CPLDebug("GZIP",
+             "%s is not made of independent blocks. Switching to sequential "
+             "decompression",
+             m_osBaseFilename.c_str());
+
+    m_poPool->WaitCompletion();
+    m_oMapJobs.clear();
+
+    auto poGZipHandle = std::make_unique<VSIGZipHandle>(
+        m_poBaseHandle.release(), m_osBaseFilename.c_str());
+    if (!poGZipHandle->IsInitOK())
+    {
+        m_bError = true;
+        return false;
+    }
+    m_poFallback.reset(VSICreateBufferedReaderHandle(poGZipHandle.release()));
+    if (m_poFallback->Seek(m_nCurPos, SEEK_SET) != 0)
+    {
+        m_poFallback.reset();
+        m_bError = true;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    if (m_poFallback)
+        return m_poFallback->Seek(nOffset, nWhence);
+
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+    {
+        m_nCurPos = nOffset;
+    }
+    else if (nWhence == SEEK_CUR)
+    {
+        m_nCurPos += nOffset;
+    }
+    else
+    {
+        // Decode (in parallel) the rest of the file to know its size.
+        while (!m_bIndexComplete)
+        {
+            if (!AdvanceKnownSize())
+            {
+                if (m_poFallback)
+                    return m_poFallback->Seek(nOffset, nWhence);
+                if (!m_bIndexComplete)
+                    return -1;
+            }
+        }
+        m_nCurPos = m_nUncompressedSize + nOffset;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIGZipReadHandleMT::Tell()
+{
+    if (m_poFallback)
+        return m_poFallback->Tell();
+    return m_nCurPos;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIGZipReadHandleMT::Read(void *pBuffer, size_t nSize, size_t nMemb)
+{
+    if (m_poFallback)
+        return m_poFallback->Read(pBuffer, nSize, nMemb);
+    if (nSize == 0 || nMemb == 0)
+        return 0;
+
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    const size_t nToRead = nSize * nMemb;
+    size_t nRead = 0;
+    while (nRead < nToRead)
+    {
+        size_t iBlock = 0;
+        const Job *psJob =
+            LocateBlock(m_nCurPos, iBlock) ? WaitBlock(iBlock) : nullptr;
+        if (psJob == nullptr)
+        {
+            if (!m_bIndexComplete || m_nCurPos < m_nUncompressedSize)
+            {
+                if (SwitchToFallback())
+                {
+                    nRead += m_poFallback->Read(pabyBuffer + nRead, 1,
+                                                nToRead - nRead);
+                }
+            }
+            break;
+        }
+        const Block &oBlock = m_aoBlocks[iBlock];
+        const size_t nOffsetInBlock =
+            static_cast<size_t>(m_nCurPos - oBlock.nUncompressedOffset);
+        const size_t nToCopy =
+            std::min(nToRead - nRead,
+                     psJob->osUncompressed.size() - nOffsetInBlock);
+        memcpy(pabyBuffer + nRead,
+               psJob->osUncompressed.data() + nOffsetInBlock, nToCopy);
+        nRead += nToCopy;
+        m_nCurPos += nToCopy;
+    }
+    if (nRead < nToRead)
+        m_bEOF = true;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIGZipReadHandleMT::Write(const void * /* pBuffer */,
+                                  size_t /* nSize */, size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on GZip streams");
+    return 0;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Eof()
+{
+    if (m_poFallback)
+        return m_poFallback->Eof();
+    return m_bEOF;
+}
+
+/************************************************************************/
+/*                               Flush()                                */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Flush()
+{
+    return 0;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIGZipReadHandleMT::Close()
+{
+    if (m_bIndexComplete && !m_bIndexLoaded && !m_poFallback &&
+        m_aoBlocks.size() > 1 &&
+        !STARTS_WITH_CI(m_osBaseFilename.c_str(), "/vsicurl/") &&
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_GZIP_WRITE_INDEX", "YES")))
+    {
+        SaveIndex();
+        // Only once
+        m_bIndexLoaded = true;
+    }
+    return 0;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIGZipWriteHandleMT                           */
@@ -3001,6 +4047,22 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
     /*      Otherwise we are in the read access case.                       */
     /* -------------------------------------------------------------------- */
 
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads)
+    {
+        int nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                     : atoi(pszThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+        if (nThreads > 1)
+        {
+            // coverity[tainted_data]
+            VSIVirtualHandle *poHandle = VSIGZipReadHandleMT::Create(
+                pszFilename + strlen("/vsigzip/"), nThreads);
+            if (poHandle)
+                return poHandle;
+        }
+    }
+
     VSIGZipHandle *poGZIPHandle = OpenGZipReadOnly(pszFilename, pszAccess);
     if (poGZIPHandle)
         // Wrap the VSIGZipHandle inside a buffered reader that will
@@ -3249,11 +4311,14 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_WRITE_INDEX' type='boolean' "
+           "description='Whether to write a .idx side-car file with the "
+           "location of independently compressed blocks' default='YES'/>"
            "</Options>";
 }
 
@@ -3466,6 +4531,136 @@ int VSIZipReader::GotoFileOffset(VSIArchiveEntryFileOffset *pOffset)
     return TRUE;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSIZipCachedEntryHandle                        */
+/* ==================================================================== */
+/************************************************************************/
+
+// Read-only handle over the decompressed content of a zip entry held in
+// the entry cache of VSIZipFilesystemHandler. The content is shared with
+// the cache, and remains valid if it gets evicted while the handle is open.
+
+class VSIZipCachedEntryHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIZipCachedEntryHandle)
+
+    std::shared_ptr<const std::string> m_poData;
+    vsi_l_offset m_nOffset = 0;
+    bool m_bEOF = false;
+
+  public:
+    explicit VSIZipCachedEntryHandle(std::shared_ptr<const std::string> poData)
+        : m_poData(std::move(poData))
+    {
+    }
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+
+    vsi_l_offset Tell() override
+    {
+        return m_nOffset;
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+
+    size_t Write(const void *, size_t, size_t) override
+    {
+        errno = EACCES;
+        return 0;
+    }
+
+    int Eof() override
+    {
+        return m_bEOF;
+    }
+
+    int Flush() override
+    {
+        return 0;
+    }
+
+    int Close() override
+    {
+        return 0;
+    }
+
+    bool HasPRead() const override
+    {
+        return true;
+    }
+
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override;
+
+    std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                             size_t nSize) override;
+};
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIZipCachedEntryHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_CUR)
+        m_nOffset += nOffset;
+    else if (nWhence == SEEK_END)
+        m_nOffset = m_poData->size() + nOffset;
+    else
+        m_nOffset = nOffset;
+    return 0;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIZipCachedEntryHandle::Read(void *pBuffer, size_t nSize, size_t nMemb)
+{
+    const size_t nBytesToRead = nSize * nMemb;
+    if (nBytesToRead == 0)
+        return 0;
+    if (nMemb > 0 && nBytesToRead / nMemb != nSize)
+        return 0;
+
+    const size_t nRead = PRead(pBuffer, nBytesToRead, m_nOffset);
+    m_nOffset += nRead;
+    if (nRead < nBytesToRead)
+        m_bEOF = true;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+size_t VSIZipCachedEntryHandle::PRead(void *pBuffer, size_t nSize,
+                                      vsi_l_offset nOffset) const
+{
+    if (nOffset >= m_poData->size())
+        return 0;
+    const size_t nToCopy = static_cast<size_t>(std::min(
+        static_cast<vsi_l_offset>(m_poData->size() - nOffset),
+        static_cast<vsi_l_offset>(nSize)));
+    memcpy(pBuffer, m_poData->data() + static_cast<size_t>(nOffset), nToCopy);
+    return nToCopy;
+}
+
+/************************************************************************/
+/*                             MapRange()                               */
+/************************************************************************/
+
+std::unique_ptr<VSIMappedRange>
+VSIZipCachedEntryHandle::MapRange(vsi_l_offset nOffset, size_t nSize)
+{
+    if (nOffset > m_poData->size() || nSize > m_poData->size() - nOffset)
+        return nullptr;
+    return std::make_unique<VSIMappedRange>(
+        m_poData->data() + static_cast<size_t>(nOffset), nSize, m_poData);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIZipFilesystemHandler                  */
@@ -3482,9 +4677,10 @@ class VSIZipFilesystemHandler final : public VSIArchiveFilesystemHandler
     VSIVirtualHandle *OpenForWrite_unlocked(const char *pszFilename,
                                             const char *pszAccess);
 
-    struct VSIFileInZipInfo
+    // Description of an entry that does not depend on an open handle, and
+    // can thus be cached across GetFileInfo() calls.
+    struct VSIFileInZipEntryInfo
     {
-        VSIVirtualHandleUniquePtr poVirtualHandle{};
         std::map<std::string, std::string> oMapProperties{};
         int nCompressionMethod = 0;
         uint64_t nUncompressedSize = 0;
@@ -3500,8 +4696,53 @@ class VSIZipFilesystemHandler final : public VSIArchiveFilesystemHandler
         uint64_t nSOZIPStartData = 0;
     };
 
+    struct VSIFileInZipInfo : public VSIFileInZipEntryInfo
+    {
+        VSIVirtualHandleUniquePtr poVirtualHandle{};
+    };
+
     bool GetFileInfo(const char *pszFilename, VSIFileInZipInfo &info);
 
+    // LRU cache of entry descriptions, keyed by zip filename and entry name.
+    // Protected by hMutex.
+    struct VSIFileInZipCachedInfo
+    {
+        VSIFileInZipEntryInfo oInfo{};
+        time_t mTime = 0;
+        vsi_l_offset nFileSize = 0;
+    };
+
+    lru11::Cache<std::string, VSIFileInZipCachedInfo> oCacheEntryInfo{10000,
+                                                                      0};
+
+    void InvalidateEntryInfo(const std::string &osZipFilename);
+
+    // LRU cache of the decompressed content of small entries, whose total
+    // size is bounded by CPL_VSIL_ZIP_CACHE_SIZE. Protected by
+    // m_oEntryCacheMutex.
+    typedef std::pair<std::string, std::shared_ptr<const std::string>>
+        EntryCacheItem;
+    std::mutex m_oEntryCacheMutex{};
+    std::list<EntryCacheItem> m_oEntryCacheList{};
+    std::map<std::string, std::list<EntryCacheItem>::iterator>
+        m_oEntryCacheMap{};
+    size_t m_nEntryCacheSize = 0;
+    // Sized from GDAL_NUM_THREADS, and recreated if it changes.
+    std::shared_ptr<CPLWorkerThreadPool> m_poPool{};
+
+    static std::string GetEntryCacheKey(const char *pszFilename,
+                                        const VSIFileInZipEntryInfo &info);
+    std::shared_ptr<const std::string>
+    GetCachedEntry(const std::string &osKey);
+    void PutCachedEntry(const std::string &osKey,
+                        std::shared_ptr<const std::string> poData,
+                        size_t nMaxCacheSize);
+    static VSIVirtualHandle *CreateEntryHandle(VSIFileInZipInfo &info);
+    static std::shared_ptr<const std::string>
+    ReadEntry(VSIFileInZipInfo &info);
+    void ReadEntries(const char *pszFilename, VSIFileInZipInfo &info,
+                     size_t nMaxEntrySize, size_t nMaxCacheSize);
+
   public:
     VSIZipFilesystemHandler() = default;
     ~VSIZipFilesystemHandler() override;
@@ -3988,6 +5229,15 @@ bool VSIZipFilesystemHandler::GetFileInfo(const char *pszFilename,
     if (zipFilename == nullptr)
         return false;
 
+    // The description of the entry can be reused as long as the zip file
+    // does not change, which saves re-parsing its local header.
+    std::string osInfoKey(zipFilename);
+    osInfoKey += '\0';
+    osInfoKey += osZipInFileName;
+    VSIStatBufL sStat;
+    const bool bHasStat = VSIStatL(zipFilename, &sStat) == 0;
+    bool bInfoCached = false;
+
     {
         CPLMutexHolder oHolder(&hMutex);
         if (oMapZipWriteHandles.find(zipFilename) != oMapZipWriteHandles.end())
@@ -3997,13 +5247,35 @@ bool VSIZipFilesystemHandler::GetFileInfo(const char *pszFilename,
             CPLFree(zipFilename);
             return false;
         }
+
+        const auto psCachedInfo = oCacheEntryInfo.getPtr(osInfoKey);
+        if (psCachedInfo)
+        {
+            if (bHasStat &&
+                static_cast<time_t>(sStat.st_mtime) == psCachedInfo->mTime &&
+                static_cast<vsi_l_offset>(sStat.st_size) ==
+                    psCachedInfo->nFileSize)
+            {
+                static_cast<VSIFileInZipEntryInfo &>(info) =
+                    psCachedInfo->oInfo;
+                bInfoCached = true;
+            }
+            else
+            {
+                oCacheEntryInfo.remove(osInfoKey);
+            }
+        }
     }
 
-    VSIArchiveReader *poReader = OpenArchiveFile(zipFilename, osZipInFileName);
-    if (poReader == nullptr)
+    VSIArchiveReader *poReader = nullptr;
+    if (!bInfoCached)
     {
-        CPLFree(zipFilename);
-        return false;
+        poReader = OpenArchiveFile(zipFilename, osZipInFileName);
+        if (poReader == nullptr)
+        {
+            CPLFree(zipFilename);
+            return false;
+        }
     }
 
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(zipFilename);
@@ -4013,6 +5285,14 @@ bool VSIZipFilesystemHandler::GetFileInfo(const char *pszFilename,
     CPLFree(zipFilename);
     zipFilename = nullptr;
 
+    if (bInfoCached)
+    {
+        if (poVirtualHandle == nullptr)
+            return false;
+        info.poVirtualHandle.reset(poVirtualHandle);
+        return true;
+    }
+
     if (poVirtualHandle == nullptr)
     {
         delete poReader;
@@ -4224,9 +5504,42 @@ bool VSIZipFilesystemHandler::GetFileInfo(const char *pszFilename,
 
     info.poVirtualHandle.reset(poVirtualHandle);
 
+    if (bHasStat)
+    {
+        CPLMutexHolder oHolder(&hMutex);
+        VSIFileInZipCachedInfo oCachedInfo;
+        oCachedInfo.oInfo = info;
+        oCachedInfo.mTime = static_cast<time_t>(sStat.st_mtime);
+        oCachedInfo.nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+        oCacheEntryInfo.insert(osInfoKey, std::move(oCachedInfo));
+    }
+
     return true;
 }
 
+/************************************************************************/
+/*                        InvalidateEntryInfo()                         */
+/************************************************************************/
+
+// Must be called with hMutex held.
+void VSIZipFilesystemHandler::InvalidateEntryInfo(
+    const std::string &osZipFilename)
+{
+    std::string osPrefix(osZipFilename);
+    osPrefix += '\0';
+    std::vector<std::string> aosKeys;
+    const auto CollectKeys =
+        [&osPrefix, &aosKeys](
+            const lru11::KeyValuePair<std::string, VSIFileInZipCachedInfo> &kv)
+    {
+        if (kv.key.compare(0, osPrefix.size(), osPrefix) == 0)
+            aosKeys.push_back(kv.key);
+    };
+    oCacheEntryInfo.cwalk(CollectKeys);
+    for (const auto &osKey : aosKeys)
+        oCacheEntryInfo.remove(osKey);
+}
+
 /************************************************************************/
 /*                                 Open()                               */
 /************************************************************************/
@@ -4253,6 +5566,43 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
     if (!GetFileInfo(pszFilename, info))
         return nullptr;
 
+    // Small entries are decompressed once and served from memory afterwards.
+    const size_t nMaxCacheSize = static_cast<size_t>(std::min(
+        CPLScanUIntBig(
+            CPLGetConfigOption("CPL_VSIL_ZIP_CACHE_SIZE", "16777216"), 40),
+        static_cast<GUIntBig>(std::numeric_limits<size_t>::max() / 2)));
+    const size_t nMaxEntrySize = nMaxCacheSize / 16;
+    if (info.nUncompressedSize > 0 && info.nUncompressedSize <= nMaxEntrySize)
+    {
+        auto poData = GetCachedEntry(GetEntryCacheKey(pszFilename, info));
+        if (poData)
+        {
+            CPLDebug("VSIZIP", "%s served from the entry cache", pszFilename);
+        }
+        else
+        {
+            ReadEntries(pszFilename, info, nMaxEntrySize, nMaxCacheSize);
+            poData = GetCachedEntry(GetEntryCacheKey(pszFilename, info));
+        }
+        if (poData)
+            return new VSIZipCachedEntryHandle(std::move(poData));
+
+        // Decompression failed: go through the regular path so that the
+        // error is reported when the corrupted part of the entry is read.
+        if (!GetFileInfo(pszFilename, info))
+            return nullptr;
+    }
+
+    return CreateEntryHandle(info);
+}
+
+/************************************************************************/
+/*                         CreateEntryHandle()                          */
+/************************************************************************/
+
+VSIVirtualHandle *
+VSIZipFilesystemHandler::CreateEntryHandle(VSIFileInZipInfo &info)
+{
 #ifdef ENABLE_DEFLATE64
     if (info.nCompressionMethod == 9)
     {
@@ -4304,6 +5654,242 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
     }
 }
 
+/************************************************************************/
+/*                          GetEntryCacheKey()                          */
+/************************************************************************/
+
+std::string
+VSIZipFilesystemHandler::GetEntryCacheKey(const char *pszFilename,
+                                          const VSIFileInZipEntryInfo &info)
+{
+    // Include the characteristics of the entry, so that a stale content is
+    // not returned if the zip file has been modified.
+    return std::string(pszFilename)
+        .append(CPLSPrintf("|%d|" CPL_FRMT_GUIB "|" CPL_FRMT_GUIB
+                           "|" CPL_FRMT_GUIB "|%lu",
+                           info.nCompressionMethod,
+                           static_cast<GUIntBig>(info.nStartDataStream),
+                           static_cast<GUIntBig>(info.nCompressedSize),
+                           static_cast<GUIntBig>(info.nUncompressedSize),
+                           static_cast<unsigned long>(info.nCRC)));
+}
+
+/************************************************************************/
+/*                           GetCachedEntry()                           */
+/************************************************************************/
+
+std::shared_ptr<const std::string>
+VSIZipFilesystemHandler::GetCachedEntry(const std::string &osKey)
+{
+    std::lock_guard<std::mutex> oLock(m_oEntryCacheMutex);
+    auto oIter = m_oEntryCacheMap.find(osKey);
+    if (oIter == m_oEntryCacheMap.end())
+        return nullptr;
+    // Move to the front of the LRU list.
+    m_oEntryCacheList.splice(m_oEntryCacheList.begin(), m_oEntryCacheList,
+                             oIter->second);
+    return oIter->second->second;
+}
+
+/************************************************************************/
+/*                           PutCachedEntry()                           */
+/************************************************************************/
+
+void VSIZipFilesystemHandler::PutCachedEntry(
+    const std::string &osKey, std::shared_ptr<const std::string> poData,
+    size_t nMaxCacheSize)
+{
+    std::lock_guard<std::mutex> oLock(m_oEntryCacheMutex);
+    if (m_oEntryCacheMap.find(osKey) != m_oEntryCacheMap.end())
+        return;
+    m_nEntryCacheSize += poData->size();
+    m_oEntryCacheList.emplace_front(osKey, std::move(poData));
+    m_oEntryCacheMap[osKey] = m_oEntryCacheList.begin();
+    while (m_nEntryCacheSize > nMaxCacheSize)
+    {
+        const auto &oLast = m_oEntryCacheList.back();
+        m_nEntryCacheSize -= oLast.second->size();
+        m_oEntryCacheMap.erase(oLast.first);
+        m_oEntryCacheList.pop_back();
+    }
+}
+
+/************************************************************************/
+/*                              ReadEntry()                             */
+/************************************************************************/
+
+// Decompress the whole content of an entry, checking its CRC.
+// Returns nullptr in case of error.
+std::shared_ptr<const std::string>
+VSIZipFilesystemHandler::ReadEntry(VSIFileInZipInfo &info)
+{
+    VSIVirtualHandleUniquePtr poHandle(CreateEntryHandle(info));
+    if (!poHandle)
+        return nullptr;
+    auto poData = std::make_shared<std::string>();
+    try
+    {
+        poData->resize(static_cast<size_t>(info.nUncompressedSize));
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+    if (poHandle->Read(&(*poData)[0], 1, poData->size()) != poData->size())
+        return nullptr;
+    const uLong nCRC =
+        crc32(0, reinterpret_cast<const Bytef *>(poData->data()),
+              static_cast<uInt>(poData->size()));
+    if (nCRC != info.nCRC)
+        return nullptr;
+    return poData;
+}
+
+/************************************************************************/
+/*                             ReadEntries()                            */
+/************************************************************************/
+
+// Decompress an entry into the entry cache. When GDAL_NUM_THREADS is set,
+// the small entries located in the same directory and sharing the same
+// basename (typically the .shp, .shx, .dbf, etc. files of a shapefile),
+// which are likely to be opened just after, are decompressed in parallel.
+
+void VSIZipFilesystemHandler::ReadEntries(const char *pszFilename,
+                                          VSIFileInZipInfo &info,
+                                          size_t nMaxEntrySize,
+                                          size_t nMaxCacheSize)
+{
+    struct Job
+    {
+        std::string osKey{};
+        VSIFileInZipInfo oInfo{};
+        std::shared_ptr<const std::string> poData{};
+    };
+
+    std::vector<std::unique_ptr<Job>> apoJobs;
+    {
+        auto poJob = std::make_unique<Job>();
+        poJob->osKey = GetEntryCacheKey(pszFilename, info);
+        static_cast<VSIFileInZipEntryInfo &>(poJob->oInfo) = info;
+        poJob->oInfo.poVirtualHandle = std::move(info.poVirtualHandle);
+        apoJobs.push_back(std::move(poJob));
+    }
+
+    int nThreads = 1;
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads)
+    {
+        nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
+    CPLString osZipInFileName;
+    char *zipFilename = nThreads > 1
+                            ? SplitFilename(pszFilename, osZipInFileName, TRUE)
+                            : nullptr;
+    if (zipFilename)
+    {
+        const std::string osPath(CPLGetPath(osZipInFileName));
+        const std::string osBasename(CPLGetBasename(osZipInFileName));
+        std::vector<std::string> aosSiblings;
+        {
+            const VSIArchiveContent *content = GetContentOfArchive(zipFilename);
+            CPLMutexHolder oHolder(&hMutex);
+            for (int i = 0; content && i < content->nEntries; i++)
+            {
+                const VSIArchiveEntry &entry = content->entries[i];
+                if (!entry.bIsDir && entry.uncompressed_size > 0 &&
+                    entry.uncompressed_size <= nMaxEntrySize &&
+                    osZipInFileName != entry.fileName &&
+                    osPath == CPLGetPath(entry.fileName) &&
+                    osBasename == CPLGetBasename(entry.fileName))
+                {
+                    aosSiblings.push_back(entry.fileName);
+                }
+            }
+        }
+
+        // Decompressed entries are held in memory until all jobs are done,
+        // so do not go beyond what the cache can hold.
+        size_t nTotalSize = static_cast<size_t>(info.nUncompressedSize);
+        for (const auto &osSibling : aosSiblings)
+        {
+            std::string osSiblingFilename(GetPrefix());
+            osSiblingFilename += '/';
+            osSiblingFilename += zipFilename;
+            osSiblingFilename += '/';
+            osSiblingFilename += osSibling;
+
+            auto poJob = std::make_unique<Job>();
+            {
+                CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+                if (!GetFileInfo(osSiblingFilename.c_str(), poJob->oInfo))
+                    continue;
+            }
+            if (poJob->oInfo.nUncompressedSize > nMaxEntrySize ||
+                nTotalSize + poJob->oInfo.nUncompressedSize > nMaxCacheSize)
+                continue;
+            poJob->osKey =
+                GetEntryCacheKey(osSiblingFilename.c_str(), poJob->oInfo);
+            if (GetCachedEntry(poJob->osKey))
+                continue;
+            nTotalSize += static_cast<size_t>(poJob->oInfo.nUncompressedSize);
+            apoJobs.push_back(std::move(poJob));
+        }
+        CPLFree(zipFilename);
+    }
+
+    const auto JobFunc = [](void *pData)
+    {
+        Job *poJob = static_cast<Job *>(pData);
+        // Errors are reported when reading through the regular path.
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        poJob->poData = ReadEntry(poJob->oInfo);
+    };
+
+    // The pool is kept alive by poPool while the queue is in use, even if
+    // another thread replaces m_poPool.
+    std::shared_ptr<CPLWorkerThreadPool> poPool;
+    std::unique_ptr<CPLJobQueue> poQueue;
+    if (apoJobs.size() > 1)
+    {
+        std::lock_guard<std::mutex> oLock(m_oEntryCacheMutex);
+        if (!m_poPool || m_poPool->GetThreadCount() != nThreads)
+        {
+            auto poNewPool = std::make_shared<CPLWorkerThreadPool>();
+            // coverity[tainted_data]
+            if (poNewPool->Setup(nThreads, nullptr, nullptr, false))
+                m_poPool = std::move(poNewPool);
+        }
+        poPool = m_poPool;
+        if (poPool)
+            poQueue = poPool->CreateJobQueue();
+    }
+    if (poQueue)
+    {
+        CPLDebug("VSIZIP", "Decompressing %d entries in parallel",
+                 static_cast<int>(apoJobs.size()));
+        for (auto &poJob : apoJobs)
+        {
+            if (!poQueue->SubmitJob(JobFunc, poJob.get()))
+                break;
+        }
+        poQueue->WaitCompletion();
+    }
+    else
+    {
+        JobFunc(apoJobs[0].get());
+    }
+
+    for (auto &poJob : apoJobs)
+    {
+        if (poJob->poData)
+            PutCachedEntry(poJob->osKey, std::move(poJob->poData),
+                           nMaxCacheSize);
+    }
+}
+
 /************************************************************************/
 /*                          GetFileMetadata()                           */
 /************************************************************************/
@@ -4507,6 +6093,7 @@ VSIZipFilesystemHandler::OpenForWrite_unlocked(const char *pszFilename,
 
         oFileList.erase(iter);
     }
+    InvalidateEntryInfo(osZipFilename);
 
     if (oMapZipWriteHandles.find(osZipFilename) != oMapZipWriteHandles.end())
     {
@@ -4595,11 +6182,14 @@ const char *VSIZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_ZIP_CACHE_SIZE' type='integer' "
+           "description='Size in bytes of the cache of decompressed small "
+           "entries. 0 to disable it' default='16777216'/>"
            "</Options>";
 }
 
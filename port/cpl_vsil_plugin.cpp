@@ -149,7 +149,8 @@ VSIPluginFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
         return VSICreateCachedFile(
             new VSIPluginHandle(this, cbData), m_cb->nBufferSize,
             (m_cb->nCacheSize < m_cb->nBufferSize) ? m_cb->nBufferSize
-                                                   : m_cb->nCacheSize);
+                                                   : m_cb->nCacheSize,
+            pszFilename);
     }
 }
 
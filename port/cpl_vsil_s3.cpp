@@ -36,6 +36,7 @@
 #include "cpl_time.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <errno.h>
 
@@ -774,6 +775,9 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
                      "Cannot allocate working buffer for %s",
                      m_poFS->GetFSPrefix().c_str());
         }
+
+        if (poFS->SupportsParallelMultipartUpload())
+            m_nUploadThreads = poFS->GetUploadNumThreads(pszFilename);
     }
 }
 
@@ -813,6 +817,29 @@ int IVSIS3LikeFSHandler::GetUploadChunkSizeInBytes(
     return nChunkSize;
 }
 
+/************************************************************************/
+/*                        GetUploadNumThreads()                         */
+/************************************************************************/
+
+int IVSIS3LikeFSHandler::GetUploadNumThreads(const char *pszFilename)
+{
+#if defined(CPL_MULTIPROC_STUB)
+    (void)pszFilename;
+    return 1;
+#else
+    const char *pszValue = VSIGetPathSpecificOption(
+        pszFilename,
+        std::string("VSI")
+            .append(GetDebugKey())
+            .append("_NUM_UPLOAD_THREADS")
+            .c_str(),
+        "1");
+    const int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    return std::max(1, std::min(64, nThreads));
+#endif
+}
+
 /************************************************************************/
 /*                        ~VSIS3WriteHandle()                           */
 /************************************************************************/
@@ -820,8 +847,11 @@ int IVSIS3LikeFSHandler::GetUploadChunkSizeInBytes(
 VSIS3WriteHandle::~VSIS3WriteHandle()
 {
     VSIS3WriteHandle::Close();
+    m_poUploadPool.reset();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     if (m_hCurlMulti)
     {
         if (m_hCurl)
@@ -1001,11 +1031,13 @@ bool VSIS3WriteHandle::UploadPart()
             knMAX_PART_NUMBER, m_osFilename.c_str());
         return false;
     }
+    if (m_nUploadThreads > 1)
+        return SubmitUploadPart();
     const std::string osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
         m_pabyBuffer, m_nBufferOff, m_poS3HandleHelper, m_nMaxRetry,
-        m_dfRetryDelay, nullptr);
+        m_dfRetryDelay, m_aosOptions.List());
     m_nBufferOff = 0;
     if (!osEtag.empty())
     {
@@ -1014,6 +1046,148 @@ bool VSIS3WriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                          SubmitUploadPart()                          */
+/************************************************************************/
+
+namespace
+{
+struct VSIS3UploadPartJob
+{
+    VSIS3WriteHandle *poHandle = nullptr;
+    int nPartNumber = 0;
+    vsi_l_offset nPosition = 0;
+    GByte *pabyBuffer = nullptr;
+    size_t nBufferSize = 0;
+};
+}  // namespace
+
+// Upload the current buffer in a worker thread, and get a buffer for the
+// next part, possibly waiting for the upload of a previous part to finish.
+bool VSIS3WriteHandle::SubmitUploadPart()
+{
+    if (!m_poUploadPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(m_nUploadThreads, nullptr, nullptr, false))
+        {
+            m_bError = true;
+            return false;
+        }
+        m_poUploadPool = std::move(poPool);
+    }
+
+    auto poJob = std::make_unique<VSIS3UploadPartJob>();
+    poJob->poHandle = this;
+    poJob->nPartNumber = m_nPartNumber;
+    poJob->nPosition =
+        static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1);
+    poJob->pabyBuffer = m_pabyBuffer;
+    poJob->nBufferSize = m_nBufferOff;
+
+    std::unique_lock<std::mutex> oLock(m_oMutexUpload);
+    if (m_bAsyncUploadError)
+        return false;
+    m_aosEtags.resize(m_nPartNumber);
+    ++m_nPartsInFlight;
+    m_pabyBuffer = nullptr;
+    m_nBufferOff = 0;
+    if (!m_poUploadPool->SubmitJob(UploadPartFunc, poJob.get()))
+    {
+        --m_nPartsInFlight;
+        m_pabyBuffer = poJob->pabyBuffer;
+        return false;
+    }
+    poJob.release();
+
+    // No new part after the last one
+    if (m_bClosed)
+        return true;
+
+    while (true)
+    {
+        if (m_bAsyncUploadError)
+            return false;
+        if (!m_apabyFreeBuffers.empty())
+        {
+            m_pabyBuffer = m_apabyFreeBuffers.back();
+            m_apabyFreeBuffers.pop_back();
+            return true;
+        }
+        if (m_nPartsInFlight < m_nUploadThreads)
+        {
+            m_pabyBuffer = static_cast<GByte *>(VSIMalloc(m_nBufferSize));
+            if (m_pabyBuffer == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate working buffer for %s",
+                         m_poFS->GetFSPrefix().c_str());
+                return false;
+            }
+            return true;
+        }
+        m_oCVUpload.wait(oLock);
+    }
+}
+
+/************************************************************************/
+/*                           UploadPartFunc()                           */
+/************************************************************************/
+
+void VSIS3WriteHandle::UploadPartFunc(void *pData)
+{
+    std::unique_ptr<VSIS3UploadPartJob> poJob(
+        static_cast<VSIS3UploadPartJob *>(pData));
+    VSIS3WriteHandle *poThis = poJob->poHandle;
+
+    bool bSkip;
+    {
+        std::lock_guard<std::mutex> oLock(poThis->m_oMutexUpload);
+        bSkip = poThis->m_bAsyncUploadError;
+    }
+
+    std::string osEtag;
+    if (!bSkip)
+    {
+        // The handle helper is modified by UploadPart(), so each part
+        // needs its own one.
+        std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper(
+            poThis->m_poFS->CreateHandleHelper(
+                poThis->m_osFilename.c_str() +
+                    poThis->m_poFS->GetFSPrefix().size(),
+                false));
+        if (poS3HandleHelper)
+        {
+            osEtag = poThis->m_poFS->UploadPart(
+                poThis->m_osFilename, poJob->nPartNumber, poThis->m_osUploadID,
+                poJob->nPosition, poJob->pabyBuffer, poJob->nBufferSize,
+                poS3HandleHelper.get(), poThis->m_nMaxRetry,
+                poThis->m_dfRetryDelay, poThis->m_aosOptions.List());
+        }
+    }
+
+    std::lock_guard<std::mutex> oLock(poThis->m_oMutexUpload);
+    if (osEtag.empty())
+        poThis->m_bAsyncUploadError = true;
+    else
+        poThis->m_aosEtags[poJob->nPartNumber - 1] = std::move(osEtag);
+    poThis->m_apabyFreeBuffers.push_back(poJob->pabyBuffer);
+    --poThis->m_nPartsInFlight;
+    poThis->m_oCVUpload.notify_all();
+}
+
+/************************************************************************/
+/*                       WaitPendingUploadParts()                       */
+/************************************************************************/
+
+bool VSIS3WriteHandle::WaitPendingUploadParts()
+{
+    std::unique_lock<std::mutex> oLock(m_oMutexUpload);
+    while (m_nPartsInFlight > 0)
+        m_oCVUpload.wait(oLock);
+    return !m_bAsyncUploadError;
+}
+
 std::string IVSIS3LikeFSHandler::UploadPart(
     const std::string &osFilename, int nPartNumber,
     const std::string &osUploadID, vsi_l_offset /* nPosition */,
@@ -1490,7 +1664,7 @@ int VSIS3WriteHandle::Eof()
 
 void VSIS3WriteHandle::InvalidateParentDirectory()
 {
-    m_poFS->InvalidateCachedData(m_poS3HandleHelper->GetURL().c_str());
+    m_poFS->InvalidateCachedData(m_poS3HandleHelper->GetURLNoKVP().c_str());
 
     std::string osFilenameWithoutSlash(m_osFilename);
     if (!osFilenameWithoutSlash.empty() && osFilenameWithoutSlash.back() == '/')
@@ -1535,6 +1709,7 @@ bool VSIS3WriteHandle::DoSinglePartPUT()
                               m_aosHTTPOptions.List()));
         headers = VSICurlSetCreationHeadersFromOptions(
             headers, m_aosOptions.List(), m_osFilename.c_str());
+        headers = m_poFS->AddSinglePartPUTHeaders(headers);
         headers = VSICurlMergeHeaders(
             headers, m_poS3HandleHelper->GetCurlHeaders(
                          "PUT", headers, m_pabyBuffer, m_nBufferOff));
@@ -1624,7 +1799,7 @@ bool IVSIS3LikeFSHandler::CompleteMultipart(
     const std::string &osFilename, const std::string &osUploadID,
     const std::vector<std::string> &aosEtags, vsi_l_offset /* nTotalSize */,
     IVSIS3LikeHandleHelper *poS3HandleHelper, int nMaxRetry,
-    double dfRetryDelay)
+    double dfRetryDelay, CSLConstList /* papszOptions */)
 {
     bool bSuccess = true;
 
@@ -2044,6 +2219,8 @@ int VSIS3WriteHandle::Close()
         }
         else
         {
+            if (!WaitPendingUploadParts())
+                m_bError = true;
             if (m_bError)
             {
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
@@ -2053,9 +2230,17 @@ int VSIS3WriteHandle::Close()
             }
             else if (m_nBufferOff > 0 && !UploadPart())
                 nRet = -1;
+            else if (!WaitPendingUploadParts())
+            {
+                m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
+                                       m_poS3HandleHelper, m_nMaxRetry,
+                                       m_dfRetryDelay);
+                nRet = -1;
+            }
             else if (m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
-                         m_poS3HandleHelper, m_nMaxRetry, m_dfRetryDelay))
+                         m_poS3HandleHelper, m_nMaxRetry, m_dfRetryDelay,
+                         m_aosOptions.List()))
             {
                 InvalidateParentDirectory();
             }
@@ -4195,7 +4380,8 @@ int IVSIS3LikeFSHandler::CopyFileRestartable(
     }
 
     if (!CompleteMultipart(pszTarget, osUploadID, aosEtags, sStatBuf.st_size,
-                           poS3HandleHelper.get(), nMaxRetry, dfRetryDelay))
+                           poS3HandleHelper.get(), nMaxRetry, dfRetryDelay,
+                           nullptr))
     {
         AbortMultipart(pszTarget, osUploadID, poS3HandleHelper.get(), nMaxRetry,
                        dfRetryDelay);
@@ -5289,7 +5475,8 @@ bool IVSIS3LikeFSHandler::Sync(const char *pszSource, const char *pszTarget,
                 if (CompleteMultipart(kv.first, kv.second.osUploadID,
                                       kv.second.aosEtags, kv.second.nTotalSize,
                                       poS3HandleHelper.get(), nMaxRetry,
-                                      dfRetryDelay))
+                                      dfRetryDelay,
+                                      aosObjectCreationOptions.List()))
                 {
                     sJobQueue.ret = true;
                     oSetKeysToRemove.insert(kv.first);
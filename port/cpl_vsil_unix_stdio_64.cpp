@@ -81,6 +81,9 @@
 #ifdef HAVE_PREAD_BSD
 #include <sys/uio.h>
 #endif
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #if defined(__MACH__) && defined(__APPLE__)
 #define HAS_CASE_INSENSITIVE_FILE_SYSTEM
@@ -89,8 +92,13 @@
 #include <limits.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -98,6 +106,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi_error.h"
+#include "cpl_worker_thread_pool.h"
 
 #if defined(UNIX_STDIO_64)
 
@@ -170,6 +179,11 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     CPLMutex *hMutex = nullptr;
 #endif
 
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+    std::mutex m_oMutexThreadPool{};
+    std::unique_ptr<CPLWorkerThreadPool> m_poThreadPool{};
+#endif
+
   public:
     VSIUnixStdioFilesystemHandler() = default;
 #ifdef VSI_COUNT_BYTES_READ
@@ -203,6 +217,12 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     GetCanonicalFilename(const std::string &osFilename) const override;
 #endif
 
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+    int HasOptimizedReadMultiRange(const char *pszPath) override;
+
+    CPLWorkerThreadPool *GetReadThreadPool();
+#endif
+
 #ifdef VSI_COUNT_BYTES_READ
     void AddToTotal(vsi_l_offset nBytes);
 #endif
@@ -229,9 +249,14 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     // file and thus a call to our Seek(0, SEEK_SET) before a read will be a
     // no-op.
     bool bModeAppendReadWrite = false;
+    VSIUnixStdioFilesystemHandler *poFS = nullptr;
 #ifdef VSI_COUNT_BYTES_READ
     vsi_l_offset nTotalBytesRead = 0;
-    VSIUnixStdioFilesystemHandler *poFS = nullptr;
+#endif
+#if defined(HAVE_MMAP) && SIZEOF_VOIDP == 8
+    // Mapping of the whole file, shared by the ranges returned by MapRange()
+    std::shared_ptr<const void> m_poMapping{};
+    vsi_l_offset m_nMappingSize = 0;
 #endif
   public:
     VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn, FILE *fpIn,
@@ -257,6 +282,15 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     bool HasPRead() const override;
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+#endif
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+#if defined(HAVE_MMAP) && SIZEOF_VOIDP == 8
+    std::unique_ptr<VSIMappedRange> MapRange(vsi_l_offset nOffset,
+                                             size_t nSize) override;
 #endif
 };
 
@@ -264,18 +298,11 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
 /*                       VSIUnixStdioHandle()                           */
 /************************************************************************/
 
-VSIUnixStdioHandle::VSIUnixStdioHandle(
-#ifndef VSI_COUNT_BYTES_READ
-    CPL_UNUSED
-#endif
-        VSIUnixStdioFilesystemHandler *poFSIn,
-    FILE *fpIn, bool bReadOnlyIn, bool bModeAppendReadWriteIn)
+VSIUnixStdioHandle::VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn,
+                                       FILE *fpIn, bool bReadOnlyIn,
+                                       bool bModeAppendReadWriteIn)
     : fp(fpIn), bReadOnly(bReadOnlyIn),
-      bModeAppendReadWrite(bModeAppendReadWriteIn)
-#ifdef VSI_COUNT_BYTES_READ
-      ,
-      poFS(poFSIn)
-#endif
+      bModeAppendReadWrite(bModeAppendReadWriteIn), poFS(poFSIn)
 {
 }
 
@@ -663,6 +690,197 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
     return pread(fileno(fp), pBuffer, nSize, static_cast<off_t>(nOffset));
 #endif
 }
+
+/************************************************************************/
+/*                         VSIUnixStdioReadJob                          */
+/************************************************************************/
+
+namespace
+{
+struct VSIUnixStdioReadJob
+{
+    int fd = -1;
+    GByte *pabyData = nullptr;
+    vsi_l_offset nOffset = 0;
+    size_t nSize = 0;
+    std::atomic<bool> *pbError = nullptr;
+
+    static void Run(void *pData);
+};
+}  // namespace
+
+void VSIUnixStdioReadJob::Run(void *pData)
+{
+    auto psJob = static_cast<VSIUnixStdioReadJob *>(pData);
+    if (*(psJob->pbError))
+        return;
+    GByte *pabyData = psJob->pabyData;
+    vsi_l_offset nOffset = psJob->nOffset;
+    size_t nRemaining = psJob->nSize;
+    while (nRemaining > 0)
+    {
+#ifdef HAVE_PREAD64
+        const auto nRead = pread64(psJob->fd, pabyData, nRemaining, nOffset);
+#else
+        const auto nRead = pread(psJob->fd, pabyData, nRemaining,
+                                 static_cast<off_t>(nOffset));
+#endif
+        if (nRead < 0 && errno == EINTR)
+            continue;
+        if (nRead <= 0)
+        {
+            *(psJob->pbError) = true;
+            return;
+        }
+        pabyData += nRead;
+        nOffset += nRead;
+        nRemaining -= static_cast<size_t>(nRead);
+    }
+}
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+// Ranges are split into pieces of that size, so that a few large ranges
+// can also be read in parallel.
+constexpr size_t READ_MULTI_RANGE_PIECE_SIZE = 1024 * 1024;
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    size_t nPieces = 0;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        nPieces += (panSizes[i] + READ_MULTI_RANGE_PIECE_SIZE - 1) /
+                   READ_MULTI_RANGE_PIECE_SIZE;
+    }
+    // Data written through the FILE* might still be buffered: only read
+    // files opened in read-only mode with pread().
+    CPLWorkerThreadPool *poPool =
+        bReadOnly && nPieces > 1 ? poFS->GetReadThreadPool() : nullptr;
+    if (poPool == nullptr)
+    {
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    }
+
+    std::atomic<bool> bError{false};
+    std::vector<VSIUnixStdioReadJob> asJobs;
+    asJobs.reserve(nPieces);
+    const int fd = fileno(fp);
+    for (int i = 0; i < nRanges; ++i)
+    {
+        for (size_t nPieceOffset = 0; nPieceOffset < panSizes[i];
+             nPieceOffset += READ_MULTI_RANGE_PIECE_SIZE)
+        {
+            VSIUnixStdioReadJob sJob;
+            sJob.fd = fd;
+            sJob.pabyData = static_cast<GByte *>(ppData[i]) + nPieceOffset;
+            sJob.nOffset = panOffsets[i] + nPieceOffset;
+            sJob.nSize = std::min(READ_MULTI_RANGE_PIECE_SIZE,
+                                  panSizes[i] - nPieceOffset);
+            sJob.pbError = &bError;
+            asJobs.push_back(sJob);
+        }
+    }
+
+    auto poQueue = poPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+    {
+        if (!poQueue->SubmitJob(VSIUnixStdioReadJob::Run, &sJob))
+        {
+            bError = true;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+
+#ifdef VSI_COUNT_BYTES_READ
+    for (int i = 0; i < nRanges; ++i)
+        nTotalBytesRead += panSizes[i];
+#endif
+
+    return bError ? -1 : 0;
+}
+#endif
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(int nRanges,
+                                    const vsi_l_offset *panOffsets,
+                                    const size_t *panSizes)
+{
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+    // Let the kernel start reading the ranges asynchronously in the page
+    // cache.
+    const int fd = fileno(fp);
+    for (int i = 0; i < nRanges; ++i)
+    {
+#ifdef HAVE_PREAD64
+        posix_fadvise64(fd, panOffsets[i], panSizes[i], POSIX_FADV_WILLNEED);
+#else
+        // Ranges beyond what off_t can address are just not advised.
+        if (panOffsets[i] > static_cast<vsi_l_offset>(
+                                std::numeric_limits<off_t>::max()) -
+                                panSizes[i])
+            continue;
+        posix_fadvise(fd, static_cast<off_t>(panOffsets[i]),
+                      static_cast<off_t>(panSizes[i]), POSIX_FADV_WILLNEED);
+#endif
+    }
+#else
+    (void)nRanges;
+    (void)panOffsets;
+    (void)panSizes;
+#endif
+}
+
+/************************************************************************/
+/*                             MapRange()                               */
+/************************************************************************/
+
+#if defined(HAVE_MMAP) && SIZEOF_VOIDP == 8
+std::unique_ptr<VSIMappedRange>
+VSIUnixStdioHandle::MapRange(vsi_l_offset nOffset, size_t nSize)
+{
+    // Data written through the FILE* might still be buffered: only map
+    // files opened in read-only mode.
+    if (!bReadOnly || nSize == 0)
+        return VSIVirtualHandle::MapRange(nOffset, nSize);
+
+    if (nOffset > m_nMappingSize || nSize > m_nMappingSize - nOffset)
+    {
+        // Map the whole file, and map it again if it has grown since.
+        const int fd = fileno(fp);
+        struct stat sStat;
+        if (fstat(fd, &sStat) != 0 || !S_ISREG(sStat.st_mode))
+            return VSIVirtualHandle::MapRange(nOffset, nSize);
+        const vsi_l_offset nFileSize =
+            static_cast<vsi_l_offset>(sStat.st_size);
+        if (nOffset > nFileSize || nSize > nFileSize - nOffset)
+            return nullptr;
+        const size_t nMappingSize = static_cast<size_t>(nFileSize);
+        void *pMapping =
+            mmap(nullptr, nMappingSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            CPLDebug("VSI", "mmap() failed: %s", VSIStrerror(errno));
+            return VSIVirtualHandle::MapRange(nOffset, nSize);
+        }
+        m_poMapping = std::shared_ptr<const void>(
+            pMapping,
+            [nMappingSize](void *p) { munmap(p, nMappingSize); });
+        m_nMappingSize = nFileSize;
+    }
+
+    return std::make_unique<VSIMappedRange>(
+        static_cast<const GByte *>(m_poMapping.get()) + nOffset, nSize,
+        m_poMapping);
+}
 #endif
 
 /************************************************************************/
@@ -735,7 +953,8 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
     /* -------------------------------------------------------------------- */
     if (bReadOnly && CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
     {
-        return VSICreateCachedFile(poHandle);
+        return VSICreateCachedFile(poHandle, VSI_CACHED_DEFAULT_CHUNK_SIZE, 0,
+                                   pszFilename);
     }
 
     return poHandle;
@@ -1206,6 +1425,61 @@ begin:
     return &(entry);
 }
 
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+
+/************************************************************************/
+/*                    VSIUnixStdioGetReadNumThreads()                   */
+/************************************************************************/
+
+static int VSIUnixStdioGetReadNumThreads()
+{
+    const char *pszThreads =
+        CPLGetConfigOption("CPL_VSIL_LOCAL_READ_NUM_THREADS", "1");
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/*                     HasOptimizedReadMultiRange()                     */
+/************************************************************************/
+
+int VSIUnixStdioFilesystemHandler::HasOptimizedReadMultiRange(
+    const char * /* pszPath */)
+{
+    return VSIUnixStdioGetReadNumThreads() > 1;
+}
+
+/************************************************************************/
+/*                         GetReadThreadPool()                          */
+/************************************************************************/
+
+// Returns the thread pool used by ReadMultiRange(), or nullptr if
+// CPL_VSIL_LOCAL_READ_NUM_THREADS is not set to more than one thread.
+CPLWorkerThreadPool *VSIUnixStdioFilesystemHandler::GetReadThreadPool()
+{
+    const int nThreads = VSIUnixStdioGetReadNumThreads();
+    if (nThreads <= 1)
+        return nullptr;
+
+    std::lock_guard<std::mutex> oLock(m_oMutexThreadPool);
+    if (m_poThreadPool == nullptr)
+    {
+        auto poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poThreadPool->Setup(nThreads, nullptr, nullptr, false))
+            return nullptr;
+        m_poThreadPool = std::move(poThreadPool);
+    }
+    else if (nThreads > m_poThreadPool->GetThreadCount())
+    {
+        // Increase size of thread pool
+        m_poThreadPool->Setup(nThreads, nullptr, nullptr, false);
+    }
+    return m_poThreadPool.get();
+}
+
+#endif
+
 #ifdef VSI_COUNT_BYTES_READ
 /************************************************************************/
 /*                            AddToTotal()                              */
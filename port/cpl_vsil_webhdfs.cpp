@@ -136,6 +136,12 @@ class VSIWebHDFSHandle final : public VSICurlHandle
 
     std::string DownloadRegion(vsi_l_offset startOffset, int nBlocks) override;
 
+    // Ranges are passed in the query string
+    bool CanReadAhead() const override
+    {
+        return false;
+    }
+
   public:
     VSIWebHDFSHandle(VSIWebHDFSFSHandler *poFS, const char *pszFilename,
                      const char *pszURL);
@@ -826,7 +826,8 @@ VSIVirtualHandle *VSIWin32FilesystemHandler::Open(const char *pszFilename,
     if ((EQUAL(pszAccess, "r") || EQUAL(pszAccess, "rb")) &&
         CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
     {
-        return VSICreateCachedFile(poHandle);
+        return VSICreateCachedFile(poHandle, VSI_CACHED_DEFAULT_CHUNK_SIZE, 0,
+                                   pszFilename);
     }
     else
     {
@@ -214,6 +214,9 @@ void CPL_STDCALL PyCPLErrorHandler(CPLErr eErrClass, CPLErrorNum err_no, const c
 %rename (HasThreadSupport) wrapper_HasThreadSupport;
 %rename (NetworkStatsReset) VSINetworkStatsReset;
 %rename (NetworkStatsGetAsSerializedJSON) VSINetworkStatsGetAsSerializedJSON;
+%rename (CachedFileStatsReset) VSICachedFileStatsReset;
+%rename (CachedFileStatsGetAsSerializedJSON) VSICachedFileStatsGetAsSerializedJSON;
+%rename (CachedFileClearSharedCache) VSICachedFileClearSharedCache;
 
 %apply Pointer NONNULL {const char *pszScope};
 retStringAndCPLFree*
@@ -949,6 +952,10 @@ void VSICurlPartialClearCache( const char* utf8_path );
 void VSINetworkStatsReset();
 retStringAndCPLFree* VSINetworkStatsGetAsSerializedJSON( char** options = NULL );
 
+void VSICachedFileStatsReset();
+retStringAndCPLFree* VSICachedFileStatsGetAsSerializedJSON( char** options = NULL );
+void VSICachedFileClearSharedCache();
+
 #endif /* !defined(SWIGJAVA) */
 
 %apply (char **CSL) {char **};
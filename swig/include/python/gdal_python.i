@@ -3418,7 +3418,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
               zFactor=None, scale=None, azimuth=None, altitude=None,
               combined=False, multiDirectional=False, igor=False,
               slopeFormat=None, trigonometric=False, zeroForFlat=False,
-              addAlpha=None, colorSelection=None,
+              addAlpha=None, colorSelection=None, numThreads=None,
               callback=None, callback_data=None):
     """Create a DEMProcessingOptions() object that can be passed to gdal.DEMProcessing()
 
@@ -3462,6 +3462,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
         adds an alpha band to the output file (only for processing = 'color-relief')
     colorSelection:
         (color-relief only) Determines how color entries are selected from an input value. Can be "nearest_color_entry", "exact_color_entry" or "linear_interpolation". Defaults to "linear_interpolation"
+    numThreads:
+        number of worker threads, or "ALL_CPUS". Defaults to the GDAL_NUM_THREADS configuration option.
     callback:
         callback method
     callback_data:
@@ -3524,6 +3526,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
                 raise ValueError("Unsupported value for colorSelection")
         if addAlpha:
             new_options += ['-alpha']
+        if numThreads is not None:
+            new_options += ['-num_threads', str(numThreads)]
 
     if return_option_list:
         return new_options